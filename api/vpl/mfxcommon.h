@@ -596,9 +596,72 @@ typedef enum {
                                                     structure.*/
 #ifdef ONEVPL_EXPERIMENTAL
     MFX_IMPLCAPS_SURFACE_TYPES           = 5,  /*!< Deliver capabilities as mfxSurfaceTypesSupported structure. */
+    MFX_IMPLCAPS_FLAT                    = 6,  /*!< Deliver capabilities as mfxImplCapsFlat structure, built by the
+                                                    dispatcher as a single contiguous block. */
 #endif
 } mfxImplCapsDeliveryFormat;
 
+#ifdef ONEVPL_EXPERIMENTAL
+MFX_PACK_BEGIN_USUAL_STRUCT()
+/*! Describes one supported combination of codec or VPP filter, profile, memory type, and color format.
+    Entry of the tables in mfxImplCapsFlat. */
+typedef struct {
+    mfxU32      ID;                         /*!< CodecID for decoder and encoder, FilterFourCC for VPP. */
+    mfxU32      Profile;                    /*!< Codec profile. 0 for VPP. */
+    mfxU32      MemHandleType;              /*!< Memory type, see mfxResourceType enumerator. */
+    mfxU32      Format;                     /*!< Output color format for decoder, input color format for encoder and
+                                                 VPP. */
+    mfxU32      OutFormat;                  /*!< Output color format for VPP. 0 for decoder and encoder. */
+    mfxRange32U Width;                      /*!< Range of supported widths. */
+    mfxRange32U Height;                     /*!< Range of supported heights. */
+    mfxU16      MaxcodecLevel;              /*!< Maximum supported codec level. 0 for VPP. */
+    mfxU16      BiDirectionalPrediction;    /*!< Encoder support of bi-directional prediction. 0 for decoder and VPP. */
+    mfxU16      ReportedStats;              /*!< Encoder statistics which may be reported. 0 for decoder and VPP. */
+    mfxU16      MaxDelayInFrames;           /*!< Maximum VPP delay in frames. 0 for decoder and encoder. */
+    mfxU32      reserved[5];                /*!< Reserved for future use. */
+} mfxCapsFlatEntry;
+MFX_PACK_END()
+
+MFX_PACK_BEGIN_USUAL_STRUCT()
+/*! Describes a table of mfxCapsFlatEntry in mfxImplCapsFlat. Entries are sorted by ID, Profile, MemHandleType,
+    and Format in the Dec and Enc tables, and by ID, MemHandleType, Format, and OutFormat in the VPP table, so
+    they may be searched with a binary search. */
+typedef struct {
+    mfxU32 Offset;                          /*!< Offset of the first entry from the start of mfxImplCapsFlat, in
+                                                 bytes. */
+    mfxU32 NumEntries;                      /*!< Number of entries in the table. */
+} mfxCapsFlatTable;
+MFX_PACK_END()
+
+/*! The current version of mfxImplCapsFlat structure. */
+#define MFX_IMPLCAPSFLAT_VERSION MFX_STRUCT_VERSION(1, 0)
+
+MFX_PACK_BEGIN_USUAL_STRUCT()
+/*! This structure contains the capabilities of an implementation in a single contiguous block, which is built
+    by the dispatcher from mfxImplDescription. Each combination of codec or filter, profile, memory type, and
+    color format is one entry in a sorted table. The block contains no pointers, so it may be copied with
+    memcpy() or shared between processes. */
+typedef struct {
+    mfxStructVersion Version;                       /*!< Version of the structure. */
+    mfxU16           reserved1;                     /*!< Reserved for future use. */
+    mfxU32           Size;                          /*!< Size of the block in bytes, including all tables. */
+    mfxU32           Impl;                          /*!< Impl type, see mfxImplType enumerator. */
+    mfxU32           AccelerationMode;              /*!< Default hardware acceleration stack, see mfxAccelerationMode
+                                                         enumerator. */
+    mfxVersion       ApiVersion;                    /*!< Supported API version. */
+    mfxU32           VendorID;                      /*!< Standard vendor ID 0x8086 - Intel. */
+    mfxU32           VendorImplID;                  /*!< Vendor specific number with given implementation ID. */
+    mfxChar          ImplName[MFX_IMPL_NAME_LEN];   /*!< Null-terminated string with implementation name given by
+                                                         vendor. */
+    mfxChar          DeviceID[MFX_STRFIELD_LEN];    /*!< Null-terminated string with device ID. */
+    mfxCapsFlatTable Dec;                           /*!< Table of decoder capabilities. */
+    mfxCapsFlatTable Enc;                           /*!< Table of encoder capabilities. */
+    mfxCapsFlatTable VPP;                           /*!< Table of VPP capabilities. */
+    mfxU32           reserved[16];                  /*!< Reserved for future use. */
+} mfxImplCapsFlat;
+MFX_PACK_END()
+#endif
+
 MFX_PACK_BEGIN_STRUCT_W_PTR()
 /*! Specifies initialization parameters for API version starting from 2.0.
 */
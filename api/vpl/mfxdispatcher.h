@@ -25,6 +25,9 @@ typedef struct _mfxConfig *mfxConfig;
    @brief Creates the loader.
    @return Loader Loader handle or NULL if failed.
 
+   @note Functions which take the loader, or a config created for it, may be called from
+         multiple threads at the same time, except MFXUnload().
+
    @since This function is available since API version 2.0.
 */
 mfxLoader MFX_CDECL MFXLoad(void);
@@ -33,6 +36,8 @@ mfxLoader MFX_CDECL MFXLoad(void);
    @brief Destroys the dispatcher.
    @param[in] loader Loader handle.
 
+   @note No other thread may use the loader, or configs created for it, during or after this call.
+
    @since This function is available since API version 2.0.
 */
 void MFX_CDECL MFXUnload(mfxLoader loader);
@@ -147,6 +152,610 @@ mfxStatus MFX_CDECL MFXCreateSession(mfxLoader loader, mfxU32 i, mfxSession* ses
 */
 mfxStatus MFX_CDECL MFXDispReleaseImplDescription(mfxLoader loader, mfxHDL hdl);
 
+#ifdef ONEVPL_EXPERIMENTAL
+/*!
+   @brief
+      Destroys all mfxConfig objects associated with the loader and resets all filter properties.
+      Implementations which were already loaded and queried are kept, so the loader can be reused
+      with a new set of filters without searching for and loading runtimes again.
+
+   @note mfxConfig handles created for this loader before the call are no longer valid.
+
+   @param[in] loader   Loader handle.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If loader is NULL.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXResetConfigFilters(mfxLoader loader);
+
+/*!
+   @brief
+      Starts creating sessions for the implementation in the background and keeps up to
+      poolSize initialized sessions ready to be taken with MFXAcquireSession().
+      Sessions are created with the filters and special properties (device handle, NumThread,
+      ExtBuffer) which are set when this function is called. Later changes to the filters
+      are not applied to the pool.
+      The pool belongs to the implementation, not to the index. If the filters are changed,
+      MFXAcquireSession() uses the pool with the new index of the implementation.
+      If a pool already exists for the implementation, only its size is changed. If session
+      creation failed in the background, it is started again.
+
+   @note Sessions which were not taken are closed by MFXUnload().
+
+   @param[in] loader   Loader handle.
+   @param[in] i        Index of the implementation.
+   @param[in] poolSize Number of sessions to keep ready.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If loader is NULL. \n
+      MFX_ERR_NOT_FOUND      Provided index is out of possible range. \n
+      MFX_ERR_UNSUPPORTED    If poolSize is zero. \n
+      MFX_ERR_MEMORY_ALLOC   If the pool or its worker thread could not be created.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXCreateSessionPool(mfxLoader loader, mfxU32 i, mfxU32 poolSize);
+
+/*!
+   @brief
+      Takes a session from the pool created with MFXCreateSessionPool(). The pool is refilled
+      in the background. If the pool is empty, the session is created before returning, as
+      with MFXCreateSession().
+
+   @note The session must be closed with MFXClose().
+
+   @param[in]  loader   Loader handle.
+   @param[in]  i        Index of the implementation.
+   @param[out] session  Pointer to the session handle.
+
+   @return
+      MFX_ERR_NONE            The function completed successfully. The session contains a pointer
+                              to the session handle.\n
+      MFX_ERR_NULL_PTR        If loader or session is NULL. \n
+      MFX_ERR_NOT_FOUND       Provided index is out of possible range. \n
+      MFX_ERR_NOT_INITIALIZED If no pool was created for the implementation.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXAcquireSession(mfxLoader loader, mfxU32 i, mfxSession *session);
+
+/*! Request handle of a session created in the background with MFXCreateSessionAsync(). */
+typedef struct _mfxSessionRequest *mfxSessionRequest;
+
+/*!
+   @brief
+      Called by the dispatcher when a session requested with MFXCreateSessionAsync() was created,
+      or failed to be created. The callback is called on a dispatcher thread. The session may be
+      taken from the callback with MFXWaitSessionRequest(), which returns without waiting.
+
+   @note The callback must not call MFXReleaseSessionRequest() or any function with the loader
+         handle, since the loader may be waiting for the request to complete.
+
+   @param[in] request   Request handle.
+   @param[in] sts       Status of session creation, as returned by MFXCreateSession().
+   @param[in] user_data Pointer passed to MFXCreateSessionAsync().
+*/
+typedef void (MFX_CDECL *mfxSessionRequestCallback)(mfxSessionRequest request,
+                                                    mfxStatus sts,
+                                                    mfxHDL user_data);
+
+/*!
+   @brief
+      Starts creating a session with implementation i on a dispatcher thread, and returns without
+      waiting for the runtime to initialize. The session is created with the filters and special
+      properties (device handle, NumThread, ExtBuffer) which are set when this function is called,
+      so the filters may be changed by other threads while the session is created.
+      The session is taken with MFXWaitSessionRequest(), and the request is released with
+      MFXReleaseSessionRequest().
+
+   @note Requests which were not released are released by MFXUnload().
+
+   @param[in]  loader    Loader handle.
+   @param[in]  i         Index of the implementation.
+   @param[in]  callback  Function to call when the request completes, or NULL.
+   @param[in]  user_data Pointer passed to the callback.
+   @param[out] request   Pointer to the request handle.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If loader or request is NULL. \n
+      MFX_ERR_NOT_FOUND      Provided index is out of possible range. \n
+      MFX_ERR_MEMORY_ALLOC   If the request or its thread could not be created.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXCreateSessionAsync(mfxLoader loader,
+                                          mfxU32 i,
+                                          mfxSessionRequestCallback callback,
+                                          mfxHDL user_data,
+                                          mfxSessionRequest *request);
+
+/*!
+   @brief
+      Waits until the session requested with MFXCreateSessionAsync() is created, and returns it.
+      The session is returned only once.
+
+   @note The session must be closed with MFXClose().
+
+   @param[in]  request  Request handle.
+   @param[in]  wait     Time to wait in milliseconds. 0 returns without waiting, MFX_INFINITE
+                        waits until the request completes.
+   @param[out] session  Pointer to the session handle.
+
+   @return
+      MFX_ERR_NONE           The session was created. The session contains a pointer to the
+                             session handle. \n
+      MFX_ERR_NULL_PTR       If request or session is NULL. \n
+      MFX_WRN_IN_EXECUTION   If the session is still being created after the wait time. \n
+      MFX_ERR_NOT_FOUND      If the session was already returned by an earlier call. \n
+      Any other status       Session creation failed with this status, as in MFXCreateSession().
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXWaitSessionRequest(mfxSessionRequest request,
+                                          mfxU32 wait,
+                                          mfxSession *session);
+
+/*!
+   @brief
+      Releases a request created with MFXCreateSessionAsync(). If the session is still being
+      created, waits until it completes. A session which was not returned by
+      MFXWaitSessionRequest() is closed.
+
+   @param[in] request  Request handle.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If request is NULL.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXReleaseSessionRequest(mfxSessionRequest request);
+
+/*! The mfxConfigFilterPropertyId enumerator itemizes filter properties by numeric ID, for use with
+    MFXSetConfigFilterPropertyById(). Each ID is equivalent to the property name in its comment.
+    "..." stands for the enclosing structures of the group, e.g.
+    "mfxImplDescription.mfxDecoderDescription." for the decoder properties. */
+typedef enum {
+    /* General properties of mfxImplDescription and mfxDeviceDescription. */
+    MFX_FILTER_PROP_IMPL                         = 0x0001, /*!< mfxImplDescription.Impl */
+    MFX_FILTER_PROP_ACCELERATION_MODE            = 0x0002, /*!< mfxImplDescription.AccelerationMode */
+    MFX_FILTER_PROP_API_VERSION                  = 0x0003, /*!< mfxImplDescription.ApiVersion.Version */
+    MFX_FILTER_PROP_API_VERSION_MAJOR            = 0x0004, /*!< mfxImplDescription.ApiVersion.Major */
+    MFX_FILTER_PROP_API_VERSION_MINOR            = 0x0005, /*!< mfxImplDescription.ApiVersion.Minor */
+    MFX_FILTER_PROP_IMPL_NAME                    = 0x0006, /*!< mfxImplDescription.ImplName */
+    MFX_FILTER_PROP_LICENSE                      = 0x0007, /*!< mfxImplDescription.License */
+    MFX_FILTER_PROP_KEYWORDS                     = 0x0008, /*!< mfxImplDescription.Keywords */
+    MFX_FILTER_PROP_VENDOR_ID                    = 0x0009, /*!< mfxImplDescription.VendorID */
+    MFX_FILTER_PROP_VENDOR_IMPL_ID               = 0x000A, /*!< mfxImplDescription.VendorImplID */
+    MFX_FILTER_PROP_SURFACE_POOL_MODE            = 0x000B, /*!< mfxImplDescription.mfxSurfacePoolMode */
+    MFX_FILTER_PROP_DEVICE_ID                    = 0x000C, /*!< mfxImplDescription.mfxDeviceDescription.device.DeviceID */
+    MFX_FILTER_PROP_MEDIA_ADAPTER_TYPE           = 0x000D, /*!< mfxImplDescription.mfxDeviceDescription.device.MediaAdapterType */
+
+    /* Properties of mfxDecoderDescription. */
+    MFX_FILTER_PROP_DEC_CODEC_ID                 = 0x0100, /*!< ...decoder.CodecID */
+    MFX_FILTER_PROP_DEC_MAX_CODEC_LEVEL          = 0x0101, /*!< ...decoder.MaxcodecLevel */
+    MFX_FILTER_PROP_DEC_PROFILE                  = 0x0102, /*!< ...decoder.decprofile.Profile */
+    MFX_FILTER_PROP_DEC_MEM_HANDLE_TYPE          = 0x0103, /*!< ...decoder.decprofile.decmemdesc.MemHandleType */
+    MFX_FILTER_PROP_DEC_WIDTH                    = 0x0104, /*!< ...decoder.decprofile.decmemdesc.Width */
+    MFX_FILTER_PROP_DEC_HEIGHT                   = 0x0105, /*!< ...decoder.decprofile.decmemdesc.Height */
+    MFX_FILTER_PROP_DEC_COLOR_FORMATS            = 0x0106, /*!< ...decoder.decprofile.decmemdesc.ColorFormats */
+
+    /* Properties of mfxEncoderDescription. */
+    MFX_FILTER_PROP_ENC_CODEC_ID                 = 0x0200, /*!< ...encoder.CodecID */
+    MFX_FILTER_PROP_ENC_MAX_CODEC_LEVEL          = 0x0201, /*!< ...encoder.MaxcodecLevel */
+    MFX_FILTER_PROP_ENC_BIDIRECTIONAL_PREDICTION = 0x0202, /*!< ...encoder.BiDirectionalPrediction */
+    MFX_FILTER_PROP_ENC_REPORTED_STATS           = 0x0203, /*!< ...encoder.ReportedStats */
+    MFX_FILTER_PROP_ENC_PROFILE                  = 0x0204, /*!< ...encoder.encprofile.Profile */
+    MFX_FILTER_PROP_ENC_MEM_HANDLE_TYPE          = 0x0205, /*!< ...encoder.encprofile.encmemdesc.MemHandleType */
+    MFX_FILTER_PROP_ENC_WIDTH                    = 0x0206, /*!< ...encoder.encprofile.encmemdesc.Width */
+    MFX_FILTER_PROP_ENC_HEIGHT                   = 0x0207, /*!< ...encoder.encprofile.encmemdesc.Height */
+    MFX_FILTER_PROP_ENC_COLOR_FORMATS            = 0x0208, /*!< ...encoder.encprofile.encmemdesc.ColorFormats */
+
+    /* Properties of mfxVPPDescription. */
+    MFX_FILTER_PROP_VPP_FILTER_FOURCC            = 0x0300, /*!< ...filter.FilterFourCC */
+    MFX_FILTER_PROP_VPP_MAX_DELAY_IN_FRAMES      = 0x0301, /*!< ...filter.MaxDelayInFrames */
+    MFX_FILTER_PROP_VPP_MEM_HANDLE_TYPE          = 0x0302, /*!< ...filter.memdesc.MemHandleType */
+    MFX_FILTER_PROP_VPP_WIDTH                    = 0x0303, /*!< ...filter.memdesc.Width */
+    MFX_FILTER_PROP_VPP_HEIGHT                   = 0x0304, /*!< ...filter.memdesc.Height */
+    MFX_FILTER_PROP_VPP_IN_FORMAT                = 0x0305, /*!< ...filter.memdesc.format.InFormat */
+    MFX_FILTER_PROP_VPP_OUT_FORMAT               = 0x0306, /*!< ...filter.memdesc.format.OutFormat */
+
+    /* Properties of mfxExtendedDeviceId. */
+    MFX_FILTER_PROP_EXTDEV_VENDOR_ID             = 0x0400, /*!< mfxExtendedDeviceId.VendorID */
+    MFX_FILTER_PROP_EXTDEV_DEVICE_ID             = 0x0401, /*!< mfxExtendedDeviceId.DeviceID */
+    MFX_FILTER_PROP_EXTDEV_PCI_DOMAIN            = 0x0402, /*!< mfxExtendedDeviceId.PCIDomain */
+    MFX_FILTER_PROP_EXTDEV_PCI_BUS               = 0x0403, /*!< mfxExtendedDeviceId.PCIBus */
+    MFX_FILTER_PROP_EXTDEV_PCI_DEVICE            = 0x0404, /*!< mfxExtendedDeviceId.PCIDevice */
+    MFX_FILTER_PROP_EXTDEV_PCI_FUNCTION          = 0x0405, /*!< mfxExtendedDeviceId.PCIFunction */
+    MFX_FILTER_PROP_EXTDEV_DEVICE_LUID           = 0x0406, /*!< mfxExtendedDeviceId.DeviceLUID */
+    MFX_FILTER_PROP_EXTDEV_LUID_DEVICE_NODE_MASK = 0x0407, /*!< mfxExtendedDeviceId.LUIDDeviceNodeMask */
+    MFX_FILTER_PROP_EXTDEV_DRM_RENDER_NODE_NUM   = 0x0408, /*!< mfxExtendedDeviceId.DRMRenderNodeNum */
+    MFX_FILTER_PROP_EXTDEV_DRM_PRIMARY_NODE_NUM  = 0x0409, /*!< mfxExtendedDeviceId.DRMPrimaryNodeNum */
+    MFX_FILTER_PROP_EXTDEV_REVISION_ID           = 0x040A, /*!< mfxExtendedDeviceId.RevisionID */
+    MFX_FILTER_PROP_EXTDEV_DEVICE_NAME           = 0x040B, /*!< mfxExtendedDeviceId.DeviceName */
+
+    /* Properties of mfxSurfaceTypesSupported. */
+    MFX_FILTER_PROP_SURFACE_TYPE                 = 0x0500, /*!< mfxSurfaceTypesSupported.surftype.SurfaceType */
+    MFX_FILTER_PROP_SURFACE_COMPONENT            = 0x0501, /*!< ...surftype.surfcomp.SurfaceComponent */
+    MFX_FILTER_PROP_SURFACE_FLAGS                = 0x0502, /*!< ...surftype.surfcomp.SurfaceFlags */
+
+    /* Properties which are not part of a description structure. */
+    MFX_FILTER_PROP_HANDLE_TYPE                  = 0x0600, /*!< mfxHandleType */
+    MFX_FILTER_PROP_HANDLE                       = 0x0601, /*!< mfxHDL */
+    MFX_FILTER_PROP_NUM_THREAD                   = 0x0602, /*!< NumThread */
+    MFX_FILTER_PROP_DEVICE_COPY                  = 0x0603, /*!< DeviceCopy */
+    MFX_FILTER_PROP_EXT_BUFFER                   = 0x0604, /*!< ExtBuffer */
+    MFX_FILTER_PROP_DXGI_ADAPTER_INDEX           = 0x0605, /*!< DXGIAdapterIndex (Windows only) */
+    MFX_FILTER_PROP_FUNCTION_NAME                = 0x0606, /*!< mfxImplementedFunctions.FunctionsName */
+    MFX_FILTER_PROP_SESSION_PROFILE              = 0x0607, /*!< SessionProfile */
+} mfxConfigFilterPropertyId;
+
+/*!
+   @brief
+      Same as MFXSetConfigFilterProperty(), with the property given by numeric ID instead of name.
+      No string parsing is done, which helps applications which create many loaders with the same
+      filters.
+
+   @param[in] config Config handle.
+   @param[in] id     ID of the parameter (see mfxConfigFilterPropertyId).
+   @param[in] value  Value of the parameter.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If config is NULL. \n
+      MFX_ERR_NOT_FOUND      If id is not a known parameter ID. \n
+      MFX_ERR_UNSUPPORTED    If value data type does not equal the parameter with provided ID.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXSetConfigFilterPropertyById(mfxConfig config,
+                                                   mfxConfigFilterPropertyId id,
+                                                   mfxVariant value);
+
+/*! Name and value of a single filter property, used with MFXSetConfigFilterProperties(). */
+typedef struct {
+    const mfxU8 *Name;  /*!< Name of the parameter (see MFXSetConfigFilterProperty()). */
+    mfxVariant   Value; /*!< Value of the parameter. */
+} mfxConfigFilterProperty;
+
+/*!
+   @brief
+      Sets multiple filter properties of the configuration in one call. Each property is handled
+      as with MFXSetConfigFilterProperty(), but properties are only set if all of them are valid,
+      and the list of valid implementations is updated once for the whole set.
+
+   @param[in]  config   Config handle.
+   @param[in]  props    Array of numProps properties, set in array order.
+   @param[in]  numProps Number of properties.
+   @param[out] propSts  Optional array of numProps status codes, one for each property.
+                        May be NULL.
+
+   @return
+      MFX_ERR_NONE           All properties were set. \n
+      MFX_ERR_NULL_PTR       If config or props is NULL. \n
+      Otherwise the status of the first property which could not be set, as returned by
+      MFXSetConfigFilterProperty(). None of the properties are set in this case.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXSetConfigFilterProperties(mfxConfig config,
+                                                 const mfxConfigFilterProperty *props,
+                                                 mfxU32 numProps,
+                                                 mfxStatus *propSts);
+
+/*! Comparison used by MFXSetConfigFilterPropertyOp() to match a filter property. */
+typedef enum {
+    MFX_FILTER_OP_EQUAL      = 0, /*!< Value equals values[0], as when not using a comparison. */
+    MFX_FILTER_OP_NOT_EQUAL  = 1, /*!< Value does not equal values[0]. */
+    MFX_FILTER_OP_RANGE      = 2, /*!< Value is in the range values[0] to values[1], inclusive. */
+    MFX_FILTER_OP_IN_SET     = 3, /*!< Value equals one of the values. */
+    MFX_FILTER_OP_NOT_IN_SET = 4, /*!< Value does not equal any of the values. */
+} mfxConfigFilterOp;
+
+/*!
+   @brief
+      Sets a filter property which matches a set of values instead of a single value. The property
+      matches an implementation if the value reported by the implementation passes the comparison.
+      For properties of decoders, encoders, and VPP filters, at least one description must pass
+      all properties of the group, as with MFXSetConfigFilterProperty().
+
+      Only properties with a numeric value (MFX_VARIANT_TYPE_U16 or MFX_VARIANT_TYPE_U32) which is
+      compared with a single value of the implementation may be used. Bitmask properties
+      (ReportedStats, SurfaceFlags), AccelerationMode, API version, and properties which do not
+      filter implementations (such as NumThread) are not supported.
+
+   @param[in] config     Config handle.
+   @param[in] name       Name of the parameter (see MFXSetConfigFilterProperty()).
+   @param[in] op         Comparison to apply.
+   @param[in] values     Array of num_values values, each with the data type of the parameter.
+   @param[in] num_values Number of values: 1 for MFX_FILTER_OP_EQUAL and MFX_FILTER_OP_NOT_EQUAL,
+                         2 for MFX_FILTER_OP_RANGE, 1 or more for the set comparisons.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If config, name, or values is NULL. \n
+      MFX_ERR_NOT_FOUND      If name contains unknown parameter name. \n
+      MFX_ERR_UNSUPPORTED    If the parameter does not support op, the number of values does not
+                             match op, or a value data type does not equal the parameter.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXSetConfigFilterPropertyOp(mfxConfig config,
+                                                 const mfxU8 *name,
+                                                 mfxConfigFilterOp op,
+                                                 const mfxVariant *values,
+                                                 mfxU32 num_values);
+
+/*!
+   @brief
+      Creates an alternative set of filter properties for the configuration. A configuration with
+      alternatives matches an implementation if all of its own properties match, and all
+      properties of at least one of its alternatives match. Properties are set on the returned
+      handle with MFXSetConfigFilterProperty() or the other functions which set filter
+      properties, so several alternatives are checked in a single search for implementations
+      instead of creating a loader for each of them.
+
+      Properties which do not filter implementations (such as mfxHDL, NumThread, or ExtBuffer),
+      AccelerationMode, and API version may not be set in an alternative.
+      Alternatives are destroyed with their configuration.
+
+   @param[in] config Config handle. Must not be an alternative.
+
+   @return
+      Handle of the alternative, or NULL if config is NULL or an alternative, or if memory could
+      not be allocated.
+
+   @since This function is available since API version 2.14.
+*/
+mfxConfig MFX_CDECL MFXCreateConfigAlternative(mfxConfig config);
+
+/*!
+   @brief
+      Returns which alternative of the configuration matched implementation i. Alternatives are
+      numbered from 0 in the order they were created with MFXCreateConfigAlternative(), and the
+      first one which matches is returned.
+
+   @param[in]  loader      Loader handle.
+   @param[in]  i           Index of the implementation, as with MFXEnumImplementations().
+   @param[in]  config      Config handle created by MFXCreateConfig() for this loader.
+   @param[out] alternative Index of the alternative.
+
+   @return
+      MFX_ERR_NONE            The function completed successfully. \n
+      MFX_ERR_NULL_PTR        If loader, config, or alternative is NULL. \n
+      MFX_ERR_NOT_FOUND       Provided index is out of possible range. \n
+      MFX_ERR_INVALID_HANDLE  If config was not created for this loader. \n
+      MFX_ERR_NOT_INITIALIZED If config has no alternatives.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXQueryConfigAlternative(mfxLoader loader,
+                                              mfxU32 i,
+                                              mfxConfig config,
+                                              mfxU32 *alternative);
+
+/*!
+   @brief
+      Finds the first entry in a table of mfxImplCapsFlat (returned by MFXEnumImplementations() with
+      MFX_IMPLCAPS_FLAT) which supports the requested codec or filter, profile, memory type, color
+      format, and frame size. Tables are sorted, so the search is O(log n) if all of the key fields in
+      query are set.
+
+   @param[in]  caps  Capabilities of the implementation.
+   @param[in]  table Table to search: caps->Dec, caps->Enc, or caps->VPP.
+   @param[in]  query ID must be set. Profile, MemHandleType, Format, and OutFormat are ignored if 0.
+                     Width.Max and Height.Max are the required frame size, and are ignored if 0.
+                     Other fields are ignored.
+   @param[out] entry Pointer to the first matching entry in the table.
+
+   @return
+      MFX_ERR_NONE           A matching entry was found. \n
+      MFX_ERR_NULL_PTR       If caps, table, query, or entry is NULL. \n
+      MFX_ERR_UNSUPPORTED    If table is not a table of caps, or caps has an unknown version. \n
+      MFX_ERR_NOT_FOUND      If no entry matches the query.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXFindCapsFlatEntry(const mfxImplCapsFlat *caps,
+                                         const mfxCapsFlatTable *table,
+                                         const mfxCapsFlatEntry *query,
+                                         const mfxCapsFlatEntry **entry);
+
+/*! The mfxLoaderPhase enumerator itemizes the phases of loader startup and session creation which
+    are timed by the dispatcher. */
+typedef enum {
+    MFX_LOADER_PHASE_SEARCH          = 0, /*!< Search for candidate runtimes. */
+    MFX_LOADER_PHASE_LOAD            = 1, /*!< Loading of runtimes and their exported functions. */
+    MFX_LOADER_PHASE_QUERY_CAPS      = 2, /*!< Capability query of runtimes (MFXQueryImplsDescription). */
+    MFX_LOADER_PHASE_VALIDATE_CONFIG = 3, /*!< Matching of implementations with filter properties. */
+    MFX_LOADER_PHASE_PRIORITIZE      = 4, /*!< Sorting of implementations by priority. Also included in
+                                               the query and validate phases. */
+    MFX_LOADER_PHASE_CREATE_SESSION  = 5, /*!< Session initialization by the runtime (MFXInitialize). */
+} mfxLoaderPhase;
+
+/*! Number of values in mfxLoaderPhase. */
+#define MFX_LOADER_NUM_PHASES 6
+
+/*! The current version of mfxLoaderTimings structure. */
+#define MFX_LOADERTIMINGS_VERSION MFX_STRUCT_VERSION(1, 0)
+
+MFX_PACK_BEGIN_STRUCT_W_L_TYPE()
+/*! Total time spent by a loader in each phase, returned by MFXQueryLoaderTimings(). */
+typedef struct {
+    mfxStructVersion Version;                       /*!< Version of the structure. */
+    mfxU16           reserved1[3];                  /*!< Reserved for future use. */
+    mfxU64           TimeNs[MFX_LOADER_NUM_PHASES]; /*!< Total time of each phase in nanoseconds, indexed
+                                                         by mfxLoaderPhase. */
+    mfxU32           Count[MFX_LOADER_NUM_PHASES];  /*!< Number of times each phase ran, indexed by
+                                                         mfxLoaderPhase. */
+    mfxU32           reserved[16];                  /*!< Reserved for future use. */
+} mfxLoaderTimings;
+MFX_PACK_END()
+
+/*! The current version of mfxImplTimings structure. */
+#define MFX_IMPLTIMINGS_VERSION MFX_STRUCT_VERSION(1, 0)
+
+MFX_PACK_BEGIN_STRUCT_W_L_TYPE()
+/*! Time spent by a loader in the runtime library of an implementation, returned by
+    MFXQueryImplTimings(). */
+typedef struct {
+    mfxStructVersion Version;           /*!< Version of the structure. */
+    mfxU16           reserved1;         /*!< Reserved for future use. */
+    mfxU32           NumSessions;       /*!< Number of sessions created with the library. */
+    mfxU64           LoadTimeNs;        /*!< Time to load the library and its exported functions, in
+                                             nanoseconds. 0 if capabilities were taken from the caps
+                                             cache. */
+    mfxU64           QueryTimeNs;       /*!< Time of the capability query of the library, in
+                                             nanoseconds. */
+    mfxU64           SessionTimeNs;     /*!< Total time of session initialization by the library, in
+                                             nanoseconds. */
+    mfxU32           reserved[16];      /*!< Reserved for future use. */
+} mfxImplTimings;
+MFX_PACK_END()
+
+/*!
+   @brief
+      Returns the total time spent by the loader in each phase of startup and session creation.
+      Timing is enabled by setting the ONEVPL_STARTUP_TIMING environment variable to "ON", or by
+      enabling the dispatcher log, before MFXLoad() is called. Otherwise no time is measured.
+
+   @param[in]  loader  Loader handle.
+   @param[out] timings Pointer to the structure to fill in.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If loader or timings is NULL. \n
+      MFX_ERR_UNSUPPORTED    If timing is not enabled.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXQueryLoaderTimings(mfxLoader loader, mfxLoaderTimings *timings);
+
+/*!
+   @brief
+      Returns the time spent by the loader in the runtime library of implementation i. All
+      implementations from the same library report the same values.
+
+   @param[in]  loader  Loader handle.
+   @param[in]  i       Index of the implementation.
+   @param[out] timings Pointer to the structure to fill in.
+
+   @return
+      MFX_ERR_NONE           The function completed successfully. \n
+      MFX_ERR_NULL_PTR       If loader or timings is NULL. \n
+      MFX_ERR_NOT_FOUND      Provided index is out of possible range. \n
+      MFX_ERR_UNSUPPORTED    If timing is not enabled.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXQueryImplTimings(mfxLoader loader, mfxU32 i, mfxImplTimings *timings);
+
+/*!
+   @brief
+      Returns handles for all valid implementations in a single call. The handles are in the same
+      order as the indices of MFXEnumImplementations(), so idescs[i] is the handle which
+      MFXEnumImplementations() returns for implementation i. Each handle should be released with
+      MFXDispReleaseImplDescription().
+
+      If idescs is NULL, only the number of valid implementations is returned in num_impls.
+
+   @param[in]     loader    Loader handle.
+   @param[in]     format    Format in which capabilities are returned.
+   @param[out]    idescs    Array of handles to fill in, or NULL.
+   @param[in,out] num_impls Size of the idescs array in, number of valid implementations out.
+
+   @return
+      MFX_ERR_NONE              The function completed successfully. \n
+      MFX_ERR_NULL_PTR          If loader or num_impls is NULL. \n
+      MFX_ERR_NOT_FOUND         If no implementation passes the current filters. \n
+      MFX_ERR_NOT_ENOUGH_BUFFER If num_impls is less than the number of valid implementations. \n
+      MFX_ERR_UNSUPPORTED       If an implementation does not support the requested format.
+
+   @since This function is available since API version 2.14.
+*/
+mfxStatus MFX_CDECL MFXEnumAllImplementations(mfxLoader loader,
+                                              mfxImplCapsDeliveryFormat format,
+                                              mfxHDL *idescs,
+                                              mfxU32 *num_impls);
+
+/*! Number of latency buckets in mfxFunctionProfile. */
+#define MFX_PROFILE_NUM_LATENCY_BUCKETS 32
+/*! Number of status buckets in mfxFunctionProfile. */
+#define MFX_PROFILE_NUM_STATUS_BUCKETS  48
+/*! Status code counted in StatusCount[0] of mfxFunctionProfile is -MFX_PROFILE_STATUS_OFFSET. */
+#define MFX_PROFILE_STATUS_OFFSET       32
+
+MFX_PACK_BEGIN_STRUCT_W_L_TYPE()
+/*! Calls of one function in one session, returned by mfxDispatcherProfileInterface::GetFunctionProfile(). */
+typedef struct {
+    mfxU64 NumCalls;                                          /*!< Number of calls. */
+    mfxU64 TotalTimeNs;                                       /*!< Total time of all calls in nanoseconds. */
+    mfxU64 LatencyHistogram[MFX_PROFILE_NUM_LATENCY_BUCKETS]; /*!< LatencyHistogram[i] is the number of calls which took
+                                                                   2^i to 2^(i+1)-1 nanoseconds. The last bucket also
+                                                                   counts all longer calls. */
+    mfxU64 StatusCount[MFX_PROFILE_NUM_STATUS_BUCKETS];       /*!< StatusCount[i] is the number of calls which returned
+                                                                   status (i - MFX_PROFILE_STATUS_OFFSET). The first and
+                                                                   last bucket also count all lower and higher status
+                                                                   codes. */
+    mfxU64 reserved[8];                                       /*!< Reserved for future use. */
+} mfxFunctionProfile;
+MFX_PACK_END()
+
+/*! The current version of mfxDispatcherProfileInterface structure. */
+#define MFX_DISPATCHERPROFILEINTERFACE_VERSION MFX_STRUCT_VERSION(1, 0)
+
+MFX_PACK_BEGIN_STRUCT_W_PTR()
+/*! Per-session call statistics recorded by the dispatcher (Linux only).
+    Profiling is enabled for sessions created by MFXCreateSession() when the ONEVPL_SESSION_PROFILE
+    environment variable is set to "ON", or when the "SessionProfile" filter property is set to a
+    non-zero value. The interface is returned by MFXVideoCORE_GetHandle() with handle type
+    MFX_HANDLE_DISPATCHER_PROFILE_INTERFACE, and is valid until the session is closed. */
+typedef struct mfxDispatcherProfileInterface {
+    mfxHDL              Context; /*!< The context of the profile interface. User should not touch (change, set, null) this pointer. */
+    mfxStructVersion    Version; /*!< The version of the structure. */
+
+    /*! @brief
+       Returns the name and call statistics of a function. Functions are enumerated by index, starting from 0.
+
+       @param[in]  profile_interface  The valid interface returned by MFXVideoCORE_GetHandle().
+       @param[in]  index              Index of the function.
+       @param[out] name               Name of the function, valid until the session is closed.
+       @param[out] profile            Pointer to the structure to fill in.
+
+       @return
+          MFX_ERR_NONE       The function completed successfully.
+          MFX_ERR_NULL_PTR   If name or profile is NULL.
+          MFX_ERR_NOT_FOUND  If index is greater than or equal to the number of functions.
+
+       @since This function is available since API version 2.14.
+    */
+    mfxStatus (MFX_CDECL *GetFunctionProfile)(struct mfxDispatcherProfileInterface *profile_interface, mfxU32 index, const mfxChar **name, mfxFunctionProfile *profile);
+
+    /*! @brief
+       Clears the statistics of all functions.
+
+       @param[in]  profile_interface  The valid interface returned by MFXVideoCORE_GetHandle().
+
+       @return
+          MFX_ERR_NONE       The function completed successfully.
+
+       @since This function is available since API version 2.14.
+    */
+    mfxStatus (MFX_CDECL *ResetProfile)(struct mfxDispatcherProfileInterface *profile_interface);
+
+    mfxHDL     reserved[16];
+} mfxDispatcherProfileInterface;
+MFX_PACK_END()
+
+/*! Alias for returning interface of type mfxDispatcherProfileInterface. */
+#define MFXGetDispatcherProfileInterface(session, piface)  MFXVideoCORE_GetHandle((session), MFX_HANDLE_DISPATCHER_PROFILE_INTERFACE, (mfxHDL *)(piface))
+#endif
+
 /*!
    @brief
       Macro help to return UUID in the common oneAPI format.
@@ -388,6 +388,7 @@ typedef enum {
     MFX_HANDLE_CONFIG_INTERFACE                 = 1000,  /*!< Pointer to interface of type mfxConfigInterface. */
 #ifdef ONEVPL_EXPERIMENTAL
     MFX_HANDLE_MEMORY_INTERFACE                 = 1001,  /*!< Pointer to interface of type mfxMemoryInterface. */
+    MFX_HANDLE_DISPATCHER_PROFILE_INTERFACE     = 1002,  /*!< Pointer to interface of type mfxDispatcherProfileInterface. */
 #endif
 } mfxHandleType;
 
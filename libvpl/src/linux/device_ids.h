@@ -11,8 +11,14 @@
 //   https://github.com/Intel-Media-SDK/MediaSDK/blob/master/_studio/shared/src/libmfx_core_vaapi.cpp
 //   https://github.com/Intel-Media-SDK/MediaSDK/blob/master/_studio/shared/include/mfxstructures-int.h
 
+#include <dirent.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+
 #include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -365,78 +371,139 @@ static const mfx_device_item listLegalDevIDs[] = {
     { 0x4571, MFX_HW_EHL, MFX_GT2 },
 };
 
+// root of sysfs tree, may be overridden in get_devices() for testing
+#define DRM_SYSFS_ROOT "/sys"
+
 typedef struct {
     unsigned int vendor_id;
     unsigned int device_id;
     eMFXHWType platform;
+    unsigned int revision;
+    unsigned int render_node; // N in /dev/dri/renderDN
+    int numa_node; // -1 if unknown
+    std::string pci_bdf; // domain:bus:device.function, empty if unknown
 } Device;
 
 static inline eMFXHWType get_platform(unsigned int device_id) {
-    for (unsigned i = 0; i < sizeof(listLegalDevIDs) / sizeof(listLegalDevIDs[0]); ++i) {
-        if (listLegalDevIDs[i].device_id == device_id) {
-            return listLegalDevIDs[i].platform;
-        }
-    }
+    // sorted copy of listLegalDevIDs[], built on first use
+    // stable sort keeps the first entry if a device_id is listed twice
+    static const std::vector<mfx_device_item> sortedDevIDs = []() {
+        std::vector<mfx_device_item> devIDs(std::begin(listLegalDevIDs),
+                                            std::end(listLegalDevIDs));
+        std::stable_sort(devIDs.begin(),
+                         devIDs.end(),
+                         [](const mfx_device_item &a, const mfx_device_item &b) {
+                             return a.device_id < b.device_id;
+                         });
+        return devIDs;
+    }();
+
+    auto it = std::lower_bound(sortedDevIDs.begin(),
+                               sortedDevIDs.end(),
+                               device_id,
+                               [](const mfx_device_item &item, unsigned int id) {
+                                   return item.device_id < id;
+                               });
+
+    if (it != sortedDevIDs.end() && it->device_id == device_id)
+        return it->platform;
+
     return MFX_HW_UNKNOWN;
 }
 
-static mfxStatus get_devices(std::vector<Device> &allDevices) {
-    const char *dir            = "/sys/class/drm";
-    const char *device_id_file = "/device/device";
-    const char *vendor_id_file = "/device/vendor";
+// read first line of a sysfs attribute as an integer in the given base
+static inline bool read_sysfs_value(const std::string &path, int base, long &value) {
+    std::ifstream dev_str(path);
+    if (!dev_str.is_open())
+        return false;
 
-    int i = 0;
-    for (; i < 64; ++i) {
-        Device device;
-        std::string path = std::string(dir) + "/renderD" + std::to_string(128 + i) + vendor_id_file;
-        std::string line;
-        std::ifstream dev_str;
+    std::string line;
+    std::getline(dev_str, line);
+    try {
+        value = std::stol(line, 0, base);
+    }
+    catch (std::invalid_argument &) {
+        return false;
+    }
+    catch (std::out_of_range &) {
+        return false;
+    }
 
-        dev_str.open(path);
-        if (!dev_str.is_open()) {
-            continue;
-        }
-        std::getline(dev_str, line);
-        dev_str.close();
-        try {
-            device.vendor_id = std::stoul(line, 0, 16);
-        }
-        catch (std::invalid_argument &) {
+    return true;
+}
+
+// read PCI address of a render node from its uevent attribute
+static inline std::string read_sysfs_pci_bdf(const std::string &path) {
+    std::ifstream dev_str(path);
+    if (!dev_str.is_open())
+        return "";
+
+    const std::string key = "PCI_SLOT_NAME=";
+
+    std::string line;
+    while (std::getline(dev_str, line)) {
+        if (line.compare(0, key.size(), key) == 0)
+            return line.substr(key.size());
+    }
+
+    return "";
+}
+
+// enumerate Intel render nodes which exist under sysfsRoot/class/drm
+// devices are sorted by platform (unknown first), then by render node
+static inline mfxStatus get_devices(std::vector<Device> &allDevices,
+                                    const std::string &sysfsRoot) {
+    const std::string dir    = sysfsRoot + "/class/drm";
+    const std::string prefix = "renderD";
+
+    DIR *pDir = opendir(dir.c_str());
+    if (!pDir)
+        return MFX_ERR_NOT_FOUND;
+
+    struct dirent *entry;
+    while ((entry = readdir(pDir)) != NULL) {
+        std::string name = entry->d_name;
+        if (name.compare(0, prefix.size(), prefix) != 0 || name.size() == prefix.size() ||
+            name.find_first_not_of("0123456789", prefix.size()) != std::string::npos)
             continue;
-        }
-        catch (std::out_of_range &) {
+
+        // skip names with a node number out of range
+        errno                  = 0;
+        unsigned long node_num = strtoul(name.c_str() + prefix.size(), nullptr, 10);
+        if (errno == ERANGE || node_num > UINT_MAX)
             continue;
-        }
+
+        std::string path = dir + "/" + name + "/device/";
+
+        long value = 0;
+        Device device;
 
         // Filter out non-Intel devices
-        if (device.vendor_id != 0x8086)
+        if (!read_sysfs_value(path + "vendor", 16, value) || value != 0x8086)
             continue;
+        device.vendor_id = (unsigned int)value;
 
-        path = std::string(dir) + "/renderD" + std::to_string(128 + i) + device_id_file;
-        dev_str.open(path);
-        if (!dev_str.is_open()) {
+        if (!read_sysfs_value(path + "device", 16, value))
             continue;
-        }
-        std::getline(dev_str, line);
-        dev_str.close();
-        try {
-            device.device_id = std::stoul(line, 0, 16);
-        }
-        catch (std::invalid_argument &) {
-            continue;
-        }
-        catch (std::out_of_range &) {
-            continue;
-        }
+        device.device_id = (unsigned int)value;
 
-        device.platform = get_platform(device.device_id);
+        // optional attributes
+        device.revision  = read_sysfs_value(path + "revision", 16, value) ? (unsigned int)value : 0;
+        device.numa_node = read_sysfs_value(path + "numa_node", 10, value) ? (int)value : -1;
+        device.pci_bdf   = read_sysfs_pci_bdf(path + "uevent");
+
+        device.render_node = (unsigned int)node_num;
+        device.platform    = get_platform(device.device_id);
 
         allDevices.emplace_back(device);
     }
+    closedir(pDir);
 
     // sort by platform, unknown will appear at beginning
     std::sort(allDevices.begin(), allDevices.end(), [](const Device &a, const Device &b) {
-        return a.platform < b.platform;
+        if (a.platform != b.platform)
+            return a.platform < b.platform;
+        return a.render_node < b.render_node;
     });
 
     if (allDevices.size() == 0)
@@ -445,4 +512,15 @@ static mfxStatus get_devices(std::vector<Device> &allDevices) {
     return MFX_ERR_NONE;
 }
 
+// return device topology of this system
+// sysfs is only scanned on the first call, later calls return a copy of the result
+static inline mfxStatus get_devices(std::vector<Device> &allDevices) {
+    static std::vector<Device> cachedDevices;
+    static const mfxStatus cachedSts = get_devices(cachedDevices, DRM_SYSFS_ROOT);
+
+    allDevices = cachedDevices;
+
+    return cachedSts;
+}
+
 #endif // LIBVPL_SRC_LINUX_DEVICE_IDS_H_
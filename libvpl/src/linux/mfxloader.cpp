@@ -10,12 +10,15 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <utility>
 #include <vector>
 
+#include "vpl/mfxdispatcher.h"
 #include "vpl/mfxvideo.h"
 
 // internal implementation of mfxConfigInterface
@@ -126,6 +129,106 @@ static const FunctionsTable2 g_mfxFuncTable2[] = {
     { eMFXVideoVPP_ProcessFrameAsync, "MFXVideoVPP_ProcessFrameAsync", VERSION(2, 1) },
 };
 
+#ifdef ONEVPL_EXPERIMENTAL
+// session profile - per-function call statistics, recorded by wrappers which replace the
+//   runtime functions in the function table of a session, so the passthrough functions
+//   have no extra cost when profiling is disabled
+// wrappers are called with the profile in place of the runtime session
+
+// 2.x passthrough functions which are profiled (others are only called by the dispatcher)
+// all functions in mfxvideo_functions.h are profiled
+    #define PROFILE_FUNCTIONS2(FUNCTION2)                                              \
+        FUNCTION2(MFXMemory_GetSurfaceForVPP,                                          \
+                  (mfxSession session, mfxFrameSurface1 * *surface),                   \
+                  (session, surface))                                                  \
+        FUNCTION2(MFXMemory_GetSurfaceForVPPOut,                                       \
+                  (mfxSession session, mfxFrameSurface1 * *surface),                   \
+                  (session, surface))                                                  \
+        FUNCTION2(MFXMemory_GetSurfaceForEncode,                                       \
+                  (mfxSession session, mfxFrameSurface1 * *surface),                   \
+                  (session, surface))                                                  \
+        FUNCTION2(MFXMemory_GetSurfaceForDecode,                                       \
+                  (mfxSession session, mfxFrameSurface1 * *surface),                   \
+                  (session, surface))                                                  \
+        FUNCTION2(MFXVideoDECODE_VPP_Init,                                             \
+                  (mfxSession session,                                                 \
+                   mfxVideoParam * decode_par,                                         \
+                   mfxVideoChannelParam * *vpp_par_array,                              \
+                   mfxU32 num_vpp_par),                                                \
+                  (session, decode_par, vpp_par_array, num_vpp_par))                   \
+        FUNCTION2(MFXVideoDECODE_VPP_DecodeFrameAsync,                                 \
+                  (mfxSession session,                                                 \
+                   mfxBitstream * bs,                                                  \
+                   mfxU32 * skip_channels,                                             \
+                   mfxU32 num_skip_channels,                                           \
+                   mfxSurfaceArray * *surf_array_out),                                 \
+                  (session, bs, skip_channels, num_skip_channels, surf_array_out))     \
+        FUNCTION2(MFXVideoDECODE_VPP_Reset,                                            \
+                  (mfxSession session,                                                 \
+                   mfxVideoParam * decode_par,                                         \
+                   mfxVideoChannelParam * *vpp_par_array,                              \
+                   mfxU32 num_vpp_par),                                                \
+                  (session, decode_par, vpp_par_array, num_vpp_par))                   \
+        FUNCTION2(MFXVideoDECODE_VPP_GetChannelParam,                                  \
+                  (mfxSession session, mfxVideoChannelParam * par, mfxU32 channel_id), \
+                  (session, par, channel_id))                                          \
+        FUNCTION2(MFXVideoDECODE_VPP_Close, (mfxSession session), (session))           \
+        FUNCTION2(MFXVideoVPP_ProcessFrameAsync,                                       \
+                  (mfxSession session, mfxFrameSurface1 * in, mfxFrameSurface1 * *out), \
+                  (session, in, out))
+
+    #define PROFILE_FUNCTION2_ID(func_name, formal_param_list, actual_param_list) e##func_name,
+
+static const Function2 g_profileFuncTable2[] = { PROFILE_FUNCTIONS2(PROFILE_FUNCTION2_ID) };
+
+    // first function of mfxvideo_functions.h
+    #define PROFILE_FUNCTION_FIRST eMFXQueryIMPL
+    #define PROFILE_NUM_FUNCTIONS  (eFunctionsNum - PROFILE_FUNCTION_FIRST)
+    #define PROFILE_NUM_FUNCTIONS2 (sizeof(g_profileFuncTable2) / sizeof(g_profileFuncTable2[0]))
+
+struct FunctionProfile {
+    std::atomic<mfxU64> numCalls;
+    std::atomic<mfxU64> totalTimeNs;
+    std::atomic<mfxU64> latency[MFX_PROFILE_NUM_LATENCY_BUCKETS];
+    std::atomic<mfxU64> status[MFX_PROFILE_NUM_STATUS_BUCKETS];
+};
+
+class SessionProfile {
+public:
+    SessionProfile(mfxSession session, void *const table[], void *const table2[]);
+
+    static mfxU64 GetTimeNs() {
+        return (mfxU64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    void Record(FunctionProfile &fn, mfxStatus sts, mfxU64 startNs);
+    void Reset();
+
+    mfxDispatcherProfileInterface *GetInterface() {
+        return &m_interface;
+    }
+
+    // runtime session and functions
+    mfxSession m_session;
+    void *m_table[eFunctionsNum];
+    void *m_table2[eFunctionsNum2];
+
+    FunctionProfile m_functions[eFunctionsNum];
+    FunctionProfile m_functions2[eFunctionsNum2];
+
+private:
+    static mfxStatus MFX_CDECL GetFunctionProfile(mfxDispatcherProfileInterface *iface,
+                                                  mfxU32 index,
+                                                  const mfxChar **name,
+                                                  mfxFunctionProfile *profile);
+    static mfxStatus MFX_CDECL ResetProfile(mfxDispatcherProfileInterface *iface);
+
+    mfxDispatcherProfileInterface m_interface;
+};
+#endif
+
 class LoaderCtx {
 public:
     mfxStatus Init(mfxInitParam &par,
@@ -133,6 +236,10 @@ public:
                    mfxU16 *pDeviceID,
                    char *dllName,
                    bool bCloneSession = false);
+    mfxStatus InitFuncTable(const mfxVersion &version, char *dllName);
+    mfxStatus InitFromFuncTable(const LoaderCtx &funcTable,
+                                mfxInitParam &par,
+                                mfxInitializationParam &vplParam);
     mfxStatus Close();
 
     inline void *getFunction(Function func) const {
@@ -147,6 +254,12 @@ public:
         return m_session;
     }
 
+    // session to pass to functions in the function tables
+    // same as getSession(), unless the functions were replaced by profiling wrappers
+    inline mfxSession getCallSession() const {
+        return m_callSession;
+    }
+
     inline mfxIMPL getImpl() const {
         return m_implementation;
     }
@@ -165,21 +278,38 @@ public:
 
     // special operations to set session pointer and version from MFXCloneSession()
     inline void setSession(const mfxSession session) {
-        m_session = session;
+        m_session     = session;
+        m_callSession = session;
     }
 
     inline void setVersion(const mfxVersion version) {
         m_version = version;
     }
 
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxStatus EnableProfile();
+
+    inline SessionProfile *getProfile() const {
+        return m_profile.get();
+    }
+#endif
+
 private:
+    mfxStatus LoadFunctions(void *hdl, const mfxVersion &version);
+    mfxStatus CheckFunctions(const mfxVersion &version) const;
+    mfxStatus InitSession(mfxInitParam &par, mfxInitializationParam &vplParam);
+
     std::shared_ptr<void> m_dlh;
     mfxVersion m_version{};
     mfxIMPL m_implementation{};
-    mfxSession m_session = nullptr;
+    mfxSession m_session     = nullptr;
+    mfxSession m_callSession = nullptr;
     void *m_table[eFunctionsNum]{};
     void *m_table2[eFunctionsNum2]{};
     std::string m_libToLoad;
+#ifdef ONEVPL_EXPERIMENTAL
+    std::unique_ptr<SessionProfile> m_profile;
+#endif
 };
 
 std::shared_ptr<void> make_dlopen(const char *filename, int flags) {
@@ -256,83 +386,12 @@ mfxStatus LoaderCtx::Init(mfxInitParam &par,
     for (auto &lib : libs) {
         std::shared_ptr<void> hdl = make_dlopen(lib.c_str(), RTLD_LOCAL | RTLD_NOW);
         if (hdl) {
-            do {
-                /* Loading functions table */
-                bool wrong_version = false;
-                for (int i = 0; i < eFunctionsNum; ++i) {
-                    assert(i == g_mfxFuncTable[i].id);
-                    m_table[i] = dlsym(hdl.get(), g_mfxFuncTable[i].name);
-                    if (!m_table[i] && ((g_mfxFuncTable[i].version <= par.Version))) {
-                        wrong_version = true;
-                        break;
-                    }
-                }
-
-                // if version >= 2.0, load these functions as well
-                if (par.Version.Major >= 2) {
-                    for (int i = 0; i < eFunctionsNum2; ++i) {
-                        assert(i == g_mfxFuncTable2[i].id);
-                        m_table2[i] = dlsym(hdl.get(), g_mfxFuncTable2[i].name);
-                        if (!m_table2[i] && (g_mfxFuncTable2[i].version <= par.Version)) {
-                            wrong_version = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (wrong_version) {
-                    mfx_res = MFX_ERR_UNSUPPORTED;
-                    break;
-                }
-
-                if (bCloneSession == true) {
-                    // success - exit loop since caller will create session with MFXCloneSession()
-                    mfx_res = MFX_ERR_NONE;
-                    break;
-                }
-
-                if (par.Version.Major >= 2) {
-                    // for API >= 2.0 call MFXInitialize instead of MFXInitEx
-                    mfx_res =
-                        ((decltype(MFXInitialize) *)m_table2[eMFXInitialize])(vplParam, &m_session);
-                }
-                else {
-                    if (m_table[eMFXInitEx]) {
-                        // initialize with MFXInitEx if present (API >= 1.14)
-                        mfx_res = ((decltype(MFXInitEx) *)m_table[eMFXInitEx])(par, &m_session);
-                    }
-                    else {
-                        // initialize with MFXInit for API < 1.14
-                        mfx_res = ((decltype(MFXInit) *)m_table[eMFXInit])(par.Implementation,
-                                                                           &(par.Version),
-                                                                           &m_session);
-                    }
-                }
-
-                if (MFX_ERR_NONE != mfx_res) {
-                    break;
-                }
-
-                // Below we just get some data and double check that we got what we have expected
-                // to get. Some of these checks are done inside mediasdk init function
-                mfx_res =
-                    ((decltype(MFXQueryVersion) *)m_table[eMFXQueryVersion])(m_session, &m_version);
-                if (MFX_ERR_NONE != mfx_res) {
-                    break;
-                }
-
-                if (m_version < par.Version) {
-                    mfx_res = MFX_ERR_UNSUPPORTED;
-                    break;
-                }
-
-                mfx_res = ((decltype(MFXQueryIMPL) *)m_table[eMFXQueryIMPL])(m_session,
-                                                                             &m_implementation);
-                if (MFX_ERR_NONE != mfx_res) {
-                    mfx_res = MFX_ERR_UNSUPPORTED;
-                    break;
-                }
-            } while (false);
+            /* Loading functions table */
+            mfx_res = LoadFunctions(hdl.get(), par.Version);
+
+            // if bCloneSession, caller will create session with MFXCloneSession()
+            if (MFX_ERR_NONE == mfx_res && bCloneSession == false)
+                mfx_res = InitSession(par, vplParam);
 
             if (MFX_ERR_NONE == mfx_res) {
                 m_dlh = std::move(hdl);
@@ -347,6 +406,135 @@ mfxStatus LoaderCtx::Init(mfxInitParam &par,
     return mfx_res;
 }
 
+// load function tables from dllName without creating a session
+// the result may be passed to InitFromFuncTable() to create any number of sessions
+mfxStatus LoaderCtx::InitFuncTable(const mfxVersion &version, char *dllName) {
+    m_libToLoad = dllName;
+
+    std::shared_ptr<void> hdl = make_dlopen(dllName, RTLD_LOCAL | RTLD_NOW);
+    if (!hdl)
+        return MFX_ERR_NOT_FOUND;
+
+    mfxStatus mfx_res = LoadFunctions(hdl.get(), version);
+    if (MFX_ERR_NONE != mfx_res)
+        return mfx_res;
+
+    m_version = version;
+    m_dlh     = std::move(hdl);
+
+    return MFX_ERR_NONE;
+}
+
+// create session using library handle and function tables from funcTable
+// library is not loaded again and device query is skipped
+mfxStatus LoaderCtx::InitFromFuncTable(const LoaderCtx &funcTable,
+                                       mfxInitParam &par,
+                                       mfxInitializationParam &vplParam) {
+    // function tables were loaded for funcTable.m_version, check what this session requires
+    if (par.Version.Major >= 2 && funcTable.m_version.Major < 2)
+        return MFX_ERR_UNSUPPORTED;
+
+    mfxStatus mfx_res = funcTable.CheckFunctions(par.Version);
+    if (MFX_ERR_NONE != mfx_res)
+        return mfx_res;
+
+    std::copy(std::begin(funcTable.m_table), std::end(funcTable.m_table), std::begin(m_table));
+    if (par.Version.Major >= 2) {
+        std::copy(std::begin(funcTable.m_table2),
+                  std::end(funcTable.m_table2),
+                  std::begin(m_table2));
+    }
+
+    mfx_res = InitSession(par, vplParam);
+    if (MFX_ERR_NONE != mfx_res) {
+        Close();
+        return mfx_res;
+    }
+
+    // library stays loaded until the last session using it is closed
+    m_libToLoad = funcTable.m_libToLoad;
+    m_dlh       = funcTable.m_dlh;
+
+    return MFX_ERR_NONE;
+}
+
+// resolve exported functions, fail if any function required by version is missing
+mfxStatus LoaderCtx::LoadFunctions(void *hdl, const mfxVersion &version) {
+    for (int i = 0; i < eFunctionsNum; ++i) {
+        assert(i == g_mfxFuncTable[i].id);
+        m_table[i] = dlsym(hdl, g_mfxFuncTable[i].name);
+    }
+
+    // if version >= 2.0, load these functions as well
+    if (version.Major >= 2) {
+        for (int i = 0; i < eFunctionsNum2; ++i) {
+            assert(i == g_mfxFuncTable2[i].id);
+            m_table2[i] = dlsym(hdl, g_mfxFuncTable2[i].name);
+        }
+    }
+
+    return CheckFunctions(version);
+}
+
+mfxStatus LoaderCtx::CheckFunctions(const mfxVersion &version) const {
+    for (int i = 0; i < eFunctionsNum; ++i) {
+        if (!m_table[i] && ((g_mfxFuncTable[i].version <= version)))
+            return MFX_ERR_UNSUPPORTED;
+    }
+
+    if (version.Major >= 2) {
+        for (int i = 0; i < eFunctionsNum2; ++i) {
+            if (!m_table2[i] && (g_mfxFuncTable2[i].version <= version))
+                return MFX_ERR_UNSUPPORTED;
+        }
+    }
+
+    return MFX_ERR_NONE;
+}
+
+// create runtime session with the loaded function tables
+mfxStatus LoaderCtx::InitSession(mfxInitParam &par, mfxInitializationParam &vplParam) {
+    mfxStatus mfx_res = MFX_ERR_NONE;
+
+    if (par.Version.Major >= 2) {
+        // for API >= 2.0 call MFXInitialize instead of MFXInitEx
+        mfx_res = ((decltype(MFXInitialize) *)m_table2[eMFXInitialize])(vplParam, &m_session);
+    }
+    else {
+        if (m_table[eMFXInitEx]) {
+            // initialize with MFXInitEx if present (API >= 1.14)
+            mfx_res = ((decltype(MFXInitEx) *)m_table[eMFXInitEx])(par, &m_session);
+        }
+        else {
+            // initialize with MFXInit for API < 1.14
+            mfx_res = ((decltype(MFXInit) *)m_table[eMFXInit])(par.Implementation,
+                                                               &(par.Version),
+                                                               &m_session);
+        }
+    }
+
+    if (MFX_ERR_NONE != mfx_res)
+        return mfx_res;
+
+    m_callSession = m_session;
+
+    // Below we just get some data and double check that we got what we have expected
+    // to get. Some of these checks are done inside mediasdk init function
+    mfx_res = ((decltype(MFXQueryVersion) *)m_table[eMFXQueryVersion])(m_session, &m_version);
+    if (MFX_ERR_NONE != mfx_res)
+        return mfx_res;
+
+    if (m_version < par.Version)
+        return MFX_ERR_UNSUPPORTED;
+
+    mfx_res =
+        ((decltype(MFXQueryIMPL) *)m_table[eMFXQueryIMPL])(m_session, &m_implementation);
+    if (MFX_ERR_NONE != mfx_res)
+        return MFX_ERR_UNSUPPORTED;
+
+    return MFX_ERR_NONE;
+}
+
 mfxStatus LoaderCtx::Close() {
     auto proc         = (decltype(MFXClose) *)m_table[eMFXClose];
     mfxStatus mfx_res = (proc) ? (*proc)(m_session) : MFX_ERR_NONE;
@@ -354,28 +542,182 @@ mfxStatus LoaderCtx::Close() {
     m_implementation = {};
     m_version        = {};
     m_session        = nullptr;
+    m_callSession    = nullptr;
     std::fill(std::begin(m_table), std::end(m_table), nullptr);
+
+#ifdef ONEVPL_EXPERIMENTAL
+    // profiling wrappers may remain in m_table2, pass a null session like the runtime functions
+    if (m_profile) {
+        m_profile->m_session = nullptr;
+        m_callSession        = (mfxSession)m_profile.get();
+    }
+#endif
+
     return mfx_res;
 }
 
-} // namespace MFX
+#ifdef ONEVPL_EXPERIMENTAL
+SessionProfile::SessionProfile(mfxSession session, void *const table[], void *const table2[])
+        : m_session(session),
+          m_interface() {
+    std::copy(table, table + eFunctionsNum, m_table);
+    std::copy(table2, table2 + eFunctionsNum2, m_table2);
+
+    Reset();
+
+    m_interface.Context            = this;
+    m_interface.Version.Version    = MFX_DISPATCHERPROFILEINTERFACE_VERSION;
+    m_interface.GetFunctionProfile = GetFunctionProfile;
+    m_interface.ResetProfile       = ResetProfile;
+}
 
-// internal function - load a specific DLL, return unsupported if it fails
-// vplParam is required for API >= 2.0 (load via MFXInitialize)
-mfxStatus MFXInitEx2(mfxVersion version,
-                     mfxInitializationParam vplParam,
-                     mfxIMPL hwImpl,
-                     mfxSession *session,
-                     mfxU16 *deviceID,
-                     char *dllName) {
-    if (!session)
+static void ResetFunctionProfile(FunctionProfile &fn) {
+    fn.numCalls.store(0);
+    fn.totalTimeNs.store(0);
+    for (auto &bucket : fn.latency)
+        bucket.store(0);
+    for (auto &bucket : fn.status)
+        bucket.store(0);
+}
+
+void SessionProfile::Reset() {
+    for (auto &fn : m_functions)
+        ResetFunctionProfile(fn);
+    for (auto &fn : m_functions2)
+        ResetFunctionProfile(fn);
+}
+
+void SessionProfile::Record(FunctionProfile &fn, mfxStatus sts, mfxU64 startNs) {
+    mfxU64 timeNs = GetTimeNs() - startNs;
+
+    // log2 buckets, last bucket includes all longer calls
+    mfxU32 latencyIdx = 0;
+    while (latencyIdx < MFX_PROFILE_NUM_LATENCY_BUCKETS - 1 && (timeNs >> (latencyIdx + 1)))
+        latencyIdx++;
+
+    mfxI32 statusIdx = (mfxI32)sts + MFX_PROFILE_STATUS_OFFSET;
+    statusIdx        = std::max(0, std::min(statusIdx, MFX_PROFILE_NUM_STATUS_BUCKETS - 1));
+
+    fn.numCalls.fetch_add(1, std::memory_order_relaxed);
+    fn.totalTimeNs.fetch_add(timeNs, std::memory_order_relaxed);
+    fn.latency[latencyIdx].fetch_add(1, std::memory_order_relaxed);
+    fn.status[statusIdx].fetch_add(1, std::memory_order_relaxed);
+}
+
+mfxStatus MFX_CDECL SessionProfile::GetFunctionProfile(mfxDispatcherProfileInterface *iface,
+                                                       mfxU32 index,
+                                                       const mfxChar **name,
+                                                       mfxFunctionProfile *profile) {
+    if (!iface || !iface->Context)
+        return MFX_ERR_INVALID_HANDLE;
+
+    if (!name || !profile)
         return MFX_ERR_NULL_PTR;
 
-    *deviceID = 0;
+    SessionProfile *sessionProfile = (SessionProfile *)iface->Context;
 
-    // fill minimal 1.x parameters for Init to choose correct initialization path
-    mfxInitParam par = {};
-    par.Version      = version;
+    // functions from mfxvideo_functions.h, then profiled 2.x functions
+    const FunctionProfile *fn = nullptr;
+    if (index < PROFILE_NUM_FUNCTIONS) {
+        mfxU32 id = PROFILE_FUNCTION_FIRST + index;
+        *name     = g_mfxFuncTable[id].name;
+        fn        = &sessionProfile->m_functions[id];
+    }
+    else if (index - PROFILE_NUM_FUNCTIONS < PROFILE_NUM_FUNCTIONS2) {
+        Function2 id = g_profileFuncTable2[index - PROFILE_NUM_FUNCTIONS];
+        *name        = g_mfxFuncTable2[id].name;
+        fn           = &sessionProfile->m_functions2[id];
+    }
+    else {
+        return MFX_ERR_NOT_FOUND;
+    }
+
+    *profile             = {};
+    profile->NumCalls    = fn->numCalls.load(std::memory_order_relaxed);
+    profile->TotalTimeNs = fn->totalTimeNs.load(std::memory_order_relaxed);
+    for (mfxU32 i = 0; i < MFX_PROFILE_NUM_LATENCY_BUCKETS; i++)
+        profile->LatencyHistogram[i] = fn->latency[i].load(std::memory_order_relaxed);
+    for (mfxU32 i = 0; i < MFX_PROFILE_NUM_STATUS_BUCKETS; i++)
+        profile->StatusCount[i] = fn->status[i].load(std::memory_order_relaxed);
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus MFX_CDECL SessionProfile::ResetProfile(mfxDispatcherProfileInterface *iface) {
+    if (!iface || !iface->Context)
+        return MFX_ERR_INVALID_HANDLE;
+
+    ((SessionProfile *)iface->Context)->Reset();
+
+    return MFX_ERR_NONE;
+}
+
+    // profiling wrappers - session is the SessionProfile
+    #undef FUNCTION
+    #define FUNCTION(return_value, func_name, formal_param_list, actual_param_list)   \
+        static return_value MFX_CDECL Profile_##func_name formal_param_list {         \
+            SessionProfile *profile = (SessionProfile *)session;                      \
+            auto proc = (decltype(func_name) *)profile->m_table[e##func_name];        \
+            session   = profile->m_session;                                           \
+                                                                                      \
+            mfxU64 startNs   = SessionProfile::GetTimeNs();                           \
+            return_value sts = (*proc)actual_param_list;                              \
+            profile->Record(profile->m_functions[e##func_name], sts, startNs);        \
+            return sts;                                                               \
+        }
+
+    #include "src/linux/mfxvideo_functions.h" // NOLINT(build/include)
+
+    #define PROFILE_FUNCTION2(func_name, formal_param_list, actual_param_list)  \
+        static mfxStatus MFX_CDECL Profile_##func_name formal_param_list {      \
+            SessionProfile *profile = (SessionProfile *)session;                \
+            auto proc = (decltype(func_name) *)profile->m_table2[e##func_name]; \
+            session   = profile->m_session;                                     \
+                                                                                \
+            mfxU64 startNs = SessionProfile::GetTimeNs();                       \
+            mfxStatus sts  = (*proc)actual_param_list;                          \
+            profile->Record(profile->m_functions2[e##func_name], sts, startNs); \
+            return sts;                                                         \
+        }
+
+PROFILE_FUNCTIONS2(PROFILE_FUNCTION2)
+
+// replace runtime functions of this session with profiling wrappers
+mfxStatus LoaderCtx::EnableProfile() {
+    if (m_profile)
+        return MFX_ERR_NONE;
+
+    std::unique_ptr<SessionProfile> profile(new SessionProfile(m_session, m_table, m_table2));
+
+    #undef FUNCTION
+    #define FUNCTION(return_value, func_name, formal_param_list, actual_param_list) \
+        if (m_table[e##func_name])                                                  \
+            m_table[e##func_name] = reinterpret_cast<void *>(&Profile_##func_name);
+
+    #include "src/linux/mfxvideo_functions.h" // NOLINT(build/include)
+
+    #define PROFILE_FUNCTION2_SET(func_name, formal_param_list, actual_param_list) \
+        if (m_table2[e##func_name])                                                \
+            m_table2[e##func_name] = reinterpret_cast<void *>(&Profile_##func_name);
+
+    PROFILE_FUNCTIONS2(PROFILE_FUNCTION2_SET)
+
+    m_callSession = (mfxSession)profile.get();
+    m_profile     = std::move(profile);
+
+    return MFX_ERR_NONE;
+}
+#endif
+
+} // namespace MFX
+
+// fill minimal 1.x parameters for Init to choose correct initialization path
+static void FillInitParam(mfxVersion version,
+                          mfxInitializationParam &vplParam,
+                          mfxIMPL hwImpl,
+                          mfxInitParam &par) {
+    par         = {};
+    par.Version = version;
 
     // select first adapter if not specified
     // only relevant for MSDK-via-MFXLoad path
@@ -409,6 +751,23 @@ mfxStatus MFXInitEx2(mfxVersion version,
     //   flag in mfxInitParam for legacy RTs
     par.GPUCopy = vplParam.DeviceCopy;
 #endif
+}
+
+// internal function - load a specific DLL, return unsupported if it fails
+// vplParam is required for API >= 2.0 (load via MFXInitialize)
+mfxStatus MFXInitEx2(mfxVersion version,
+                     mfxInitializationParam vplParam,
+                     mfxIMPL hwImpl,
+                     mfxSession *session,
+                     mfxU16 *deviceID,
+                     char *dllName) {
+    if (!session)
+        return MFX_ERR_NULL_PTR;
+
+    *deviceID = 0;
+
+    mfxInitParam par = {};
+    FillInitParam(version, vplParam, hwImpl, par);
 
     try {
         std::unique_ptr<MFX::LoaderCtx> loader;
@@ -430,6 +789,93 @@ mfxStatus MFXInitEx2(mfxVersion version,
     }
 }
 
+// internal function - resolve function tables of a specific DLL once, so that
+//   sessions can be created with MFXInitFromFuncTable() without loading it again
+mfxStatus MFXCreateFuncTable(mfxVersion version, char *dllName, mfxHDL *funcTable) {
+    if (!dllName || !funcTable)
+        return MFX_ERR_NULL_PTR;
+
+    *funcTable = nullptr;
+
+    try {
+        std::unique_ptr<MFX::LoaderCtx> loader;
+
+        loader.reset(new MFX::LoaderCtx{});
+
+        mfxStatus mfx_res = loader->InitFuncTable(version, dllName);
+        if (MFX_ERR_NONE == mfx_res)
+            *funcTable = (mfxHDL)loader.release();
+
+        return mfx_res;
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+}
+
+// internal function - release function tables created with MFXCreateFuncTable()
+// sessions created from it remain valid
+mfxStatus MFXReleaseFuncTable(mfxHDL funcTable) {
+    if (!funcTable)
+        return MFX_ERR_NULL_PTR;
+
+    delete (MFX::LoaderCtx *)funcTable;
+
+    return MFX_ERR_NONE;
+}
+
+// internal function - create session with function tables from MFXCreateFuncTable()
+// equivalent to MFXInitEx2() with the same DLL, but does not load the DLL again
+//   or query graphics devices
+mfxStatus MFXInitFromFuncTable(mfxVersion version,
+                               mfxInitializationParam vplParam,
+                               mfxHDL funcTable,
+                               mfxSession *session) {
+    if (!session || !funcTable)
+        return MFX_ERR_NULL_PTR;
+
+    mfxInitParam par = {};
+    FillInitParam(version, vplParam, 0, par);
+
+    try {
+        std::unique_ptr<MFX::LoaderCtx> loader;
+
+        loader.reset(new MFX::LoaderCtx{});
+
+        mfxStatus mfx_res =
+            loader->InitFromFuncTable(*(MFX::LoaderCtx *)funcTable, par, vplParam);
+        if (MFX_ERR_NONE == mfx_res) {
+            *session = (mfxSession)loader.release();
+        }
+        else {
+            *session = nullptr;
+        }
+
+        return mfx_res;
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+}
+
+// internal function - record per-function call statistics for this session
+// statistics are returned by MFXVideoCORE_GetHandle(MFX_HANDLE_DISPATCHER_PROFILE_INTERFACE)
+mfxStatus MFXEnableSessionProfile(mfxSession session) {
+    if (!session)
+        return MFX_ERR_INVALID_HANDLE;
+
+#ifdef ONEVPL_EXPERIMENTAL
+    try {
+        return ((MFX::LoaderCtx *)session)->EnableProfile();
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+#else
+    return MFX_ERR_UNSUPPORTED;
+#endif
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -514,7 +960,7 @@ mfxStatus MFXMemory_GetSurfaceForVPP(mfxSession session, mfxFrameSurface1 **surf
         return MFX_ERR_INVALID_HANDLE;
     }
 
-    return (*proc)(loader->getSession(), surface);
+    return (*proc)(loader->getCallSession(), surface);
 }
 
 mfxStatus MFXMemory_GetSurfaceForVPPOut(mfxSession session, mfxFrameSurface1 **surface) {
@@ -529,7 +975,7 @@ mfxStatus MFXMemory_GetSurfaceForVPPOut(mfxSession session, mfxFrameSurface1 **s
         return MFX_ERR_INVALID_HANDLE;
     }
 
-    return (*proc)(loader->getSession(), surface);
+    return (*proc)(loader->getCallSession(), surface);
 }
 
 mfxStatus MFXMemory_GetSurfaceForEncode(mfxSession session, mfxFrameSurface1 **surface) {
@@ -544,7 +990,7 @@ mfxStatus MFXMemory_GetSurfaceForEncode(mfxSession session, mfxFrameSurface1 **s
         return MFX_ERR_INVALID_HANDLE;
     }
 
-    return (*proc)(loader->getSession(), surface);
+    return (*proc)(loader->getCallSession(), surface);
 }
 
 mfxStatus MFXMemory_GetSurfaceForDecode(mfxSession session, mfxFrameSurface1 **surface) {
@@ -559,7 +1005,7 @@ mfxStatus MFXMemory_GetSurfaceForDecode(mfxSession session, mfxFrameSurface1 **s
         return MFX_ERR_INVALID_HANDLE;
     }
 
-    return (*proc)(loader->getSession(), surface);
+    return (*proc)(loader->getCallSession(), surface);
 }
 
 mfxStatus MFXVideoDECODE_VPP_Init(mfxSession session,
@@ -577,7 +1023,7 @@ mfxStatus MFXVideoDECODE_VPP_Init(mfxSession session,
         return MFX_ERR_INVALID_HANDLE;
     }
 
-    return (*proc)(loader->getSession(), decode_par, vpp_par_array, num_vpp_par);
+    return (*proc)(loader->getCallSession(), decode_par, vpp_par_array, num_vpp_par);
 }
 
 mfxStatus MFXVideoDECODE_VPP_DecodeFrameAsync(mfxSession session,
@@ -596,7 +1042,7 @@ mfxStatus MFXVideoDECODE_VPP_DecodeFrameAsync(mfxSession session,
         return MFX_ERR_INVALID_HANDLE;
     }
 
-    return (*proc)(loader->getSession(), bs, skip_channels, num_skip_channels, surf_array_out);
+    return (*proc)(loader->getCallSession(), bs, skip_channels, num_skip_channels, surf_array_out);
 }
 
 mfxStatus MFXVideoDECODE_VPP_Reset(mfxSession session,
@@ -614,7 +1060,7 @@ mfxStatus MFXVideoDECODE_VPP_Reset(mfxSession session,
         return MFX_ERR_INVALID_HANDLE;
     }
 
-    return (*proc)(loader->getSession(), decode_par, vpp_par_array, num_vpp_par);
+    return (*proc)(loader->getCallSession(), decode_par, vpp_par_array, num_vpp_par);
 }
 
 mfxStatus MFXVideoDECODE_VPP_GetChannelParam(mfxSession session,
@@ -631,7 +1077,7 @@ mfxStatus MFXVideoDECODE_VPP_GetChannelParam(mfxSession session,
         return MFX_ERR_INVALID_HANDLE;
     }
 
-    return (*proc)(loader->getSession(), par, channel_id);
+    return (*proc)(loader->getCallSession(), par, channel_id);
 }
 
 mfxStatus MFXVideoDECODE_VPP_Close(mfxSession session) {
@@ -646,7 +1092,7 @@ mfxStatus MFXVideoDECODE_VPP_Close(mfxSession session) {
         return MFX_ERR_INVALID_HANDLE;
     }
 
-    return (*proc)(loader->getSession());
+    return (*proc)(loader->getCallSession());
 }
 
 mfxStatus MFXVideoVPP_ProcessFrameAsync(mfxSession session,
@@ -663,7 +1109,7 @@ mfxStatus MFXVideoVPP_ProcessFrameAsync(mfxSession session,
         return MFX_ERR_INVALID_HANDLE;
     }
 
-    return (*proc)(loader->getSession(), in, out);
+    return (*proc)(loader->getCallSession(), in, out);
 }
 
 // implement as a non-passthrough function so that we can catch dispatcher-level interface query requests
@@ -683,6 +1129,20 @@ mfxStatus MFXVideoCORE_GetHandle(mfxSession session, mfxHandleType type, mfxHDL
         return MFX_ERR_NONE;
     }
 
+#ifdef ONEVPL_EXPERIMENTAL
+    if (type == MFX_HANDLE_DISPATCHER_PROFILE_INTERFACE) {
+        if (!hdl)
+            return MFX_ERR_NULL_PTR;
+
+        if (!loader->getProfile())
+            return MFX_ERR_NOT_FOUND;
+
+        *hdl = (mfxHDL)(loader->getProfile()->GetInterface());
+
+        return MFX_ERR_NONE;
+    }
+#endif
+
     // passthrough to runtime
     auto proc =
         (decltype(MFXVideoCORE_GetHandle) *)loader->getFunction(MFX::eMFXVideoCORE_GetHandle);
@@ -829,8 +1289,8 @@ mfxStatus MFXCloneSession(mfxSession session, mfxSession *clone) {
         if (!proc)                                                                 \
             return MFX_ERR_INVALID_HANDLE;                                         \
                                                                                    \
-        /* get the real session pointer */                                         \
-        session = loader->getSession();                                            \
+        /* get the real session pointer (or profile) */                            \
+        session = loader->getCallSession();                                        \
         /* pass down the call */                                                   \
         return (*proc)actual_param_list;                                           \
     }
@@ -24,14 +24,54 @@ mfxLoader MFXLoad() {
     // initialize logging if appropriate environment variables are set
     loaderCtx->InitDispatcherLog();
 
+    // enable per-phase startup timing if appropriate environment variable is set
+    loaderCtx->InitStartupTiming();
+
+    // enable persistent caps cache if appropriate environment variable is set
+    loaderCtx->InitCapsCache();
+
+    // use fixed list of runtimes if a manifest is present (ONEVPL_MANIFEST)
+    loaderCtx->InitManifest();
+
+    // set number of threads used to probe runtimes (ONEVPL_PROBE_THREADS)
+    loaderCtx->InitProbeThreads();
+
+    // enable lazy enumeration if appropriate environment variable is set
+    loaderCtx->InitLazyEnum();
+
+    // enable shared catalog if appropriate environment variable is set
+    loaderCtx->InitSharedCatalog();
+
+    // disable session creation fast path if appropriate environment variable is set
+    loaderCtx->InitSessionFastPath();
+
+    // enable session profiling if appropriate environment variable is set
+    loaderCtx->InitSessionProfile();
+
+    // disable export check of candidate runtimes if appropriate environment variable is set
+    loaderCtx->InitExportCheck();
+
+    // rank implementations by measured encode throughput if appropriate environment variable is set
+    loaderCtx->InitRankPolicy();
+
+    // start searching for runtimes in the background if appropriate environment variable is set
+    // must be last, the thread uses the settings above
+    loaderCtx->InitWarmUp();
+
     return (mfxLoader)loaderCtx;
 }
 
 // unload libraries, destroy all created mfxConfig objects, free other memory
+// not locked - must not be called while other threads are using the loader
 void MFXUnload(mfxLoader loader) {
     if (loader) {
         LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
 
+        loaderCtx->FinishWarmUp();
+
+        // close sessions from asynchronous requests before their libraries are unloaded
+        loaderCtx->DestroySessionRequests();
+
         loaderCtx->UnloadAllLibraries();
 
         loaderCtx->FreeConfigFilters();
@@ -54,6 +94,8 @@ mfxConfig MFXCreateConfig(mfxLoader loader) {
     DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
     DISP_LOG_FUNCTION(dispLog);
 
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
     try {
         configCtx = loaderCtx->AddConfigFilter();
     }
@@ -75,6 +117,8 @@ mfxStatus MFXSetConfigFilterProperty(mfxConfig config, const mfxU8 *name, mfxVar
     DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
     DISP_LOG_FUNCTION(dispLog);
 
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
     mfxStatus sts = configCtx->SetFilterProperty(name, value);
     if (sts)
         return sts;
@@ -86,22 +130,124 @@ mfxStatus MFXSetConfigFilterProperty(mfxConfig config, const mfxU8 *name, mfxVar
     return sts;
 }
 
-// iterate over available implementations
-// capabilities are returned in idesc
-mfxStatus MFXEnumImplementations(mfxLoader loader,
-                                 mfxU32 i,
-                                 mfxImplCapsDeliveryFormat format,
-                                 mfxHDL *idesc) {
-    if (!loader || !idesc)
+#ifdef ONEVPL_EXPERIMENTAL
+// set a config property by ID, without parsing the property name
+mfxStatus MFXSetConfigFilterPropertyById(mfxConfig config,
+                                         mfxConfigFilterPropertyId id,
+                                         mfxVariant value) {
+    if (!config)
         return MFX_ERR_NULL_PTR;
 
-    LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+    ConfigCtxVPL *configCtx = (ConfigCtxVPL *)config;
+    LoaderCtxVPL *loaderCtx = configCtx->m_parentLoader;
+
+    DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+    DISP_LOG_FUNCTION(dispLog);
+
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    mfxStatus sts = configCtx->SetFilterPropertyById(id, value);
+    if (sts)
+        return sts;
+
+    loaderCtx->m_bNeedUpdateValidImpls = true;
+
+    sts = loaderCtx->UpdateLowLatency();
+
+    return sts;
+}
+
+// set multiple config properties, only if all of them are valid
+// filters are applied once for the whole set
+mfxStatus MFXSetConfigFilterProperties(mfxConfig config,
+                                       const mfxConfigFilterProperty *props,
+                                       mfxU32 numProps,
+                                       mfxStatus *propSts) {
+    if (!config || !props)
+        return MFX_ERR_NULL_PTR;
+
+    ConfigCtxVPL *configCtx = (ConfigCtxVPL *)config;
+    LoaderCtxVPL *loaderCtx = configCtx->m_parentLoader;
+
+    DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+    DISP_LOG_FUNCTION(dispLog);
+
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    mfxStatus sts = configCtx->SetFilterProperties(props, numProps, propSts);
+    if (sts)
+        return sts;
+
+    loaderCtx->m_bNeedUpdateValidImpls = true;
+
+    sts = loaderCtx->UpdateLowLatency();
+
+    return sts;
+}
+
+// set a config property which matches a range or set of values
+mfxStatus MFXSetConfigFilterPropertyOp(mfxConfig config,
+                                       const mfxU8 *name,
+                                       mfxConfigFilterOp op,
+                                       const mfxVariant *values,
+                                       mfxU32 num_values) {
+    if (!config)
+        return MFX_ERR_NULL_PTR;
+
+    ConfigCtxVPL *configCtx = (ConfigCtxVPL *)config;
+    LoaderCtxVPL *loaderCtx = configCtx->m_parentLoader;
 
     DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
     DISP_LOG_FUNCTION(dispLog);
 
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    mfxStatus sts = configCtx->SetFilterPropertyOp(name, op, values, num_values);
+    if (sts)
+        return sts;
+
+    loaderCtx->m_bNeedUpdateValidImpls = true;
+
+    sts = loaderCtx->UpdateLowLatency();
+
+    return sts;
+}
+
+// create an alternative set of properties, which is owned by the config
+mfxConfig MFXCreateConfigAlternative(mfxConfig config) {
+    if (!config)
+        return nullptr;
+
+    ConfigCtxVPL *configCtx = (ConfigCtxVPL *)config;
+    LoaderCtxVPL *loaderCtx = configCtx->m_parentLoader;
+
+    DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+    DISP_LOG_FUNCTION(dispLog);
+
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    ConfigCtxVPL *altCtx = configCtx->AddAlternative();
+    if (!altCtx)
+        return nullptr;
+
+    // an empty alternative matches every implementation, but disables low latency mode
+    loaderCtx->m_bNeedUpdateValidImpls = true;
+    loaderCtx->UpdateLowLatency();
+
+    return (mfxConfig)(altCtx);
+}
+#endif
+
+// load and query libraries if needed, and apply current filters
+//   so that implementation i may be enumerated
+// loader must be locked in exclusive mode
+static mfxStatus UpdateImplListForEnum(LoaderCtxVPL *loaderCtx, mfxU32 i) {
     mfxStatus sts = MFX_ERR_NONE;
 
+    // wait for libraries loaded by the warm-up thread
+    if (loaderCtx->m_bNeedFullQuery)
+        loaderCtx->FinishWarmUp();
+
     // load and query all libraries
     if (loaderCtx->m_bNeedFullQuery) {
         // if a session was already created in low-latency mode, unload all implementations
@@ -110,7 +256,13 @@ mfxStatus MFXEnumImplementations(mfxLoader loader,
             loaderCtx->UnloadAllLibraries();
         }
 
-        sts = loaderCtx->FullLoadAndQuery();
+        // in lazy mode only load libraries until implementation i is found
+        if (loaderCtx->m_bLazyEnum)
+            sts = loaderCtx->LazyLoadAndQuery(i);
+        else if (loaderCtx->m_bSharedCatalog)
+            sts = loaderCtx->AttachCatalog();
+        else
+            sts = loaderCtx->FullLoadAndQuery();
         if (sts)
             return MFX_ERR_NOT_FOUND;
     }
@@ -123,14 +275,48 @@ mfxStatus MFXEnumImplementations(mfxLoader loader,
             return MFX_ERR_NOT_FOUND;
     }
 
+    return MFX_ERR_NONE;
+}
+
+// iterate over available implementations
+// capabilities are returned in idesc
+mfxStatus MFXEnumImplementations(mfxLoader loader,
+                                 mfxU32 i,
+                                 mfxImplCapsDeliveryFormat format,
+                                 mfxHDL *idesc) {
+    if (!loader || !idesc)
+        return MFX_ERR_NULL_PTR;
+
+    LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+    DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+    DISP_LOG_FUNCTION(dispLog);
+
+    // implementation list is up to date, other threads may enumerate at the same time
+    {
+        SharedLockVPL lock(loaderCtx->m_loaderLock);
+        if (!loaderCtx->m_bNeedFullQuery && !loaderCtx->m_bNeedUpdateValidImpls)
+            return loaderCtx->QueryImpl(i, format, idesc);
+    }
+
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    mfxStatus sts = UpdateImplListForEnum(loaderCtx, i);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
     sts = loaderCtx->QueryImpl(i, format, idesc);
 
     return sts;
 }
 
-// create a new session with implementation i
-mfxStatus MFXCreateSession(mfxLoader loader, mfxU32 i, mfxSession *session) {
-    if (!loader || !session)
+#ifdef ONEVPL_EXPERIMENTAL
+// return handles of all valid implementations in one call
+mfxStatus MFXEnumAllImplementations(mfxLoader loader,
+                                    mfxImplCapsDeliveryFormat format,
+                                    mfxHDL *idescs,
+                                    mfxU32 *num_impls) {
+    if (!loader || !num_impls)
         return MFX_ERR_NULL_PTR;
 
     LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
@@ -138,11 +324,39 @@ mfxStatus MFXCreateSession(mfxLoader loader, mfxU32 i, mfxSession *session) {
     DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
     DISP_LOG_FUNCTION(dispLog);
 
+    // implementation list is up to date, other threads may enumerate at the same time
+    {
+        SharedLockVPL lock(loaderCtx->m_loaderLock);
+        if (!loaderCtx->m_bNeedFullQuery && !loaderCtx->m_bNeedUpdateValidImpls)
+            return loaderCtx->QueryAllImpls(format, idescs, num_impls);
+    }
+
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    // in lazy mode all candidate libraries must be loaded
+    mfxStatus sts = UpdateImplListForEnum(loaderCtx, (mfxU32)-1);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    return loaderCtx->QueryAllImpls(format, idescs, num_impls);
+}
+#endif
+
+// true if libraries must be loaded or filters applied before creating a session
+static bool NeedUpdateForSession(LoaderCtxVPL *loaderCtx) {
+    if (loaderCtx->m_bLowLatency)
+        return loaderCtx->m_bNeedLowLatencyQuery;
+
+    return (loaderCtx->m_bNeedFullQuery || loaderCtx->m_bNeedUpdateValidImpls);
+}
+
+// load and query libraries if needed, and apply current filters
+//   so that implementation i may be used to create a session
+// loader must be locked in exclusive mode
+static mfxStatus UpdateImplListForSession(LoaderCtxVPL *loaderCtx, mfxU32 i) {
     mfxStatus sts = MFX_ERR_NONE;
 
     if (loaderCtx->m_bLowLatency) {
-        DISP_LOG_MESSAGE(dispLog, "message:  low latency mode enabled");
-
         if (loaderCtx->m_bNeedLowLatencyQuery) {
             // load low latency libraries
             sts = loaderCtx->LoadLibsLowLatency();
@@ -156,11 +370,19 @@ mfxStatus MFXCreateSession(mfxLoader loader, mfxU32 i, mfxSession *session) {
         }
     }
     else {
-        DISP_LOG_MESSAGE(dispLog, "message:  low latency mode disabled");
+        // wait for libraries loaded by the warm-up thread
+        if (loaderCtx->m_bNeedFullQuery)
+            loaderCtx->FinishWarmUp();
 
         // load and query all libraries
+        // in lazy mode only load libraries until implementation i is found
         if (loaderCtx->m_bNeedFullQuery) {
-            sts = loaderCtx->FullLoadAndQuery();
+            if (loaderCtx->m_bLazyEnum)
+                sts = loaderCtx->LazyLoadAndQuery(i);
+            else if (loaderCtx->m_bSharedCatalog)
+                sts = loaderCtx->AttachCatalog();
+            else
+                sts = loaderCtx->FullLoadAndQuery();
             if (sts)
                 return MFX_ERR_NOT_FOUND;
         }
@@ -174,11 +396,179 @@ mfxStatus MFXCreateSession(mfxLoader loader, mfxU32 i, mfxSession *session) {
         }
     }
 
+    return MFX_ERR_NONE;
+}
+
+// create a new session with implementation i
+mfxStatus MFXCreateSession(mfxLoader loader, mfxU32 i, mfxSession *session) {
+    if (!loader || !session)
+        return MFX_ERR_NULL_PTR;
+
+    LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+    DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+    DISP_LOG_FUNCTION(dispLog);
+
+    // implementation list is up to date, other threads may create sessions at the same time
+    {
+        SharedLockVPL lock(loaderCtx->m_loaderLock);
+        if (!NeedUpdateForSession(loaderCtx)) {
+            DISP_LOG_MESSAGE(dispLog,
+                             "message:  low latency mode %s",
+                             loaderCtx->m_bLowLatency ? "enabled" : "disabled");
+
+            return loaderCtx->CreateSession(i, session);
+        }
+    }
+
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    DISP_LOG_MESSAGE(dispLog,
+                     "message:  low latency mode %s",
+                     loaderCtx->m_bLowLatency ? "enabled" : "disabled");
+
+    mfxStatus sts = UpdateImplListForSession(loaderCtx, i);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
     sts = loaderCtx->CreateSession(i, session);
 
     return sts;
 }
 
+#ifdef ONEVPL_EXPERIMENTAL
+// start creating sessions for implementation i in the background
+mfxStatus MFXCreateSessionPool(mfxLoader loader, mfxU32 i, mfxU32 poolSize) {
+    if (!loader)
+        return MFX_ERR_NULL_PTR;
+
+    if (poolSize == 0)
+        return MFX_ERR_UNSUPPORTED;
+
+    LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+    DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+    DISP_LOG_FUNCTION(dispLog);
+
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    mfxStatus sts = UpdateImplListForSession(loaderCtx, i);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    return loaderCtx->CreateSessionPool(i, poolSize);
+}
+
+// take a session from the pool created with MFXCreateSessionPool()
+mfxStatus MFXAcquireSession(mfxLoader loader, mfxU32 i, mfxSession *session) {
+    if (!loader || !session)
+        return MFX_ERR_NULL_PTR;
+
+    LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+    // index refers to the current filters, as in MFXCreateSession()
+    {
+        SharedLockVPL lock(loaderCtx->m_loaderLock);
+        if (!NeedUpdateForSession(loaderCtx))
+            return loaderCtx->AcquirePooledSession(i, session);
+    }
+
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    mfxStatus sts = UpdateImplListForSession(loaderCtx, i);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    return loaderCtx->AcquirePooledSession(i, session);
+}
+
+// start creating a session with implementation i on a worker thread
+mfxStatus MFXCreateSessionAsync(mfxLoader loader,
+                                mfxU32 i,
+                                mfxSessionRequestCallback callback,
+                                mfxHDL user_data,
+                                mfxSessionRequest *request) {
+    if (!loader || !request)
+        return MFX_ERR_NULL_PTR;
+
+    LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+    DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+    DISP_LOG_FUNCTION(dispLog);
+
+    SessionRequestVPL *req = nullptr;
+    mfxStatus sts          = MFX_ERR_NONE;
+
+    // session parameters are resolved with the loader locked, as in MFXCreateSession()
+    {
+        SharedLockVPL lock(loaderCtx->m_loaderLock);
+        if (!NeedUpdateForSession(loaderCtx)) {
+            sts = loaderCtx->CreateSessionAsync(i, callback, user_data, &req);
+            if (sts == MFX_ERR_NONE)
+                *request = (mfxSessionRequest)req;
+
+            return sts;
+        }
+    }
+
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    sts = UpdateImplListForSession(loaderCtx, i);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    sts = loaderCtx->CreateSessionAsync(i, callback, user_data, &req);
+    if (sts == MFX_ERR_NONE)
+        *request = (mfxSessionRequest)req;
+
+    return sts;
+}
+
+// wait for a session requested with MFXCreateSessionAsync()
+mfxStatus MFXWaitSessionRequest(mfxSessionRequest request, mfxU32 wait, mfxSession *session) {
+    if (!request || !session)
+        return MFX_ERR_NULL_PTR;
+
+    SessionRequestVPL *req = (SessionRequestVPL *)request;
+
+    return req->loaderCtx->WaitSessionRequest(req, wait, session);
+}
+
+// release a request created with MFXCreateSessionAsync()
+// shared lock keeps the libraries loaded until the worker is done
+mfxStatus MFXReleaseSessionRequest(mfxSessionRequest request) {
+    if (!request)
+        return MFX_ERR_NULL_PTR;
+
+    SessionRequestVPL *req  = (SessionRequestVPL *)request;
+    LoaderCtxVPL *loaderCtx = req->loaderCtx;
+
+    SharedLockVPL lock(loaderCtx->m_loaderLock);
+
+    return loaderCtx->ReleaseSessionRequest(req);
+}
+#endif
+
+#ifdef ONEVPL_EXPERIMENTAL
+// destroy all config objects created for this loader and reset filters
+// loaded implementations are kept, so the loader may be reused with new filters
+mfxStatus MFXResetConfigFilters(mfxLoader loader) {
+    if (!loader)
+        return MFX_ERR_NULL_PTR;
+
+    LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+    DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+    DISP_LOG_FUNCTION(dispLog);
+
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    loaderCtx->FinishWarmUp();
+
+    return loaderCtx->ResetConfigFilters();
+}
+#endif
+
 // release memory associated with implementation description hdl
 mfxStatus MFXDispReleaseImplDescription(mfxLoader loader, mfxHDL hdl) {
     if (!loader)
@@ -189,7 +579,83 @@ mfxStatus MFXDispReleaseImplDescription(mfxLoader loader, mfxHDL hdl) {
     DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
     DISP_LOG_FUNCTION(dispLog);
 
+    SharedLockVPL lock(loaderCtx->m_loaderLock);
+
     mfxStatus sts = loaderCtx->ReleaseImpl(hdl);
 
     return sts;
 }
+
+#ifdef ONEVPL_EXPERIMENTAL
+// return time spent in each loader phase so far
+mfxStatus MFXQueryLoaderTimings(mfxLoader loader, mfxLoaderTimings *timings) {
+    if (!loader || !timings)
+        return MFX_ERR_NULL_PTR;
+
+    LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+    DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+    DISP_LOG_FUNCTION(dispLog);
+
+    // phases run by the warm-up thread are complete
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    loaderCtx->FinishWarmUp();
+
+    return loaderCtx->GetLoaderTimings(timings);
+}
+
+// return load, query, and session creation times for implementation i
+mfxStatus MFXQueryImplTimings(mfxLoader loader, mfxU32 i, mfxImplTimings *timings) {
+    if (!loader || !timings)
+        return MFX_ERR_NULL_PTR;
+
+    LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+
+    DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+    DISP_LOG_FUNCTION(dispLog);
+
+    {
+        SharedLockVPL lock(loaderCtx->m_loaderLock);
+        if (!loaderCtx->m_bNeedFullQuery && !loaderCtx->m_bNeedUpdateValidImpls)
+            return loaderCtx->GetImplTimings(i, timings);
+    }
+
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    mfxStatus sts = UpdateImplListForEnum(loaderCtx, i);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    return loaderCtx->GetImplTimings(i, timings);
+}
+
+// return which alternative of config matched implementation i
+mfxStatus MFXQueryConfigAlternative(mfxLoader loader,
+                                    mfxU32 i,
+                                    mfxConfig config,
+                                    mfxU32 *alternative) {
+    if (!loader || !config || !alternative)
+        return MFX_ERR_NULL_PTR;
+
+    LoaderCtxVPL *loaderCtx = (LoaderCtxVPL *)loader;
+    ConfigCtxVPL *configCtx = (ConfigCtxVPL *)config;
+
+    DispatcherLogVPL *dispLog = loaderCtx->GetLogger();
+    DISP_LOG_FUNCTION(dispLog);
+
+    {
+        SharedLockVPL lock(loaderCtx->m_loaderLock);
+        if (!loaderCtx->m_bNeedFullQuery && !loaderCtx->m_bNeedUpdateValidImpls)
+            return loaderCtx->QueryConfigAlternative(i, configCtx, alternative);
+    }
+
+    std::lock_guard<RWLockVPL> lock(loaderCtx->m_loaderLock);
+
+    mfxStatus sts = UpdateImplListForEnum(loaderCtx, i);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    return loaderCtx->QueryConfigAlternative(i, configCtx, alternative);
+}
+#endif
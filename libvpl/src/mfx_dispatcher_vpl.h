@@ -8,11 +8,18 @@
 #define LIBVPL_SRC_MFX_DISPATCHER_VPL_H_
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "vpl/mfxdispatcher.h"
@@ -67,6 +74,8 @@ typedef char CHAR_TYPE;
 
 #define MAX_ENV_VAR_LEN 32768
 
+#define MAX_NUM_PROBE_THREADS 4 // default limit, may be overridden with ONEVPL_PROBE_THREADS
+
 #define DEVICE_ID_UNKNOWN   0xffffffff
 #define ADAPTER_IDX_UNKNOWN 0xffffffff
 
@@ -84,6 +93,25 @@ mfxStatus MFXInitEx2(mfxVersion version,
                      mfxU16 *deviceID,
                      CHAR_TYPE *dllName);
 
+// internal functions to create sessions without loading the dll again
+// function table is resolved once per dll, device query is skipped
+mfxStatus MFXCreateFuncTable(mfxVersion version, CHAR_TYPE *dllName, mfxHDL *funcTable);
+mfxStatus MFXReleaseFuncTable(mfxHDL funcTable);
+mfxStatus MFXInitFromFuncTable(mfxVersion version,
+                               mfxInitializationParam vplParam,
+                               mfxHDL funcTable,
+                               mfxSession *session);
+
+// internal function to record per-function call statistics for a session (Linux only)
+// returned by MFXVideoCORE_GetHandle(MFX_HANDLE_DISPATCHER_PROFILE_INTERFACE)
+mfxStatus MFXEnableSessionProfile(mfxSession session);
+
+// read environment variable, return false if it is not defined (or too long on Windows)
+bool GetEnvVar(const char *name, std::string &value);
+
+// return true if environment variable is set to "ON"
+bool IsEnvOn(const char *name);
+
 typedef void(MFX_CDECL *VPLFunctionPtr)(void);
 
 extern const mfxIMPL msdkImplTab[MAX_NUM_IMPL_MSDK];
@@ -172,9 +200,36 @@ enum PropRanges {
     NUM_PROP_RANGES
 };
 
+// filter properties are checked against library caps in groups
+// results are memoized per group (see ConfigResultVPL)
+enum PropGroup {
+    PROP_GROUP_GENERAL = 0,
+    PROP_GROUP_DEC,
+    PROP_GROUP_ENC,
+    PROP_GROUP_VPP,
+    PROP_GROUP_EXTDEV,
+    PROP_GROUP_SURFACE,
+    PROP_GROUP_FUNCTION,
+
+    // special properties do not filter implementations
+    PROP_GROUP_SPECIAL,
+
+    NUM_PROP_GROUPS
+};
+
+// internal variant type of a property set with SetFilterPropertyOp()
+// Data.Ptr points to the FilterOpVPL of the property in ConfigCtxVPL::m_filterOps
+#define VARIANT_TYPE_FILTER_OP ((mfxVariantType)0x100)
+
+// comparison (mfxConfigFilterOp) and values of a filter property, converted to U32
+struct FilterOpVPL {
+    mfxU32 op;
+    std::vector<mfxU32> values;
+};
+
 // must match eProp_TotalProps, is checked with static_assert in _config.cpp
 //   (should throw error at compile time if !=)
-#define NUM_TOTAL_FILTER_PROPS 59
+#define NUM_TOTAL_FILTER_PROPS 60
 
 // typedef child structures for easier reading
 typedef struct mfxDecoderDescription::decoder DecCodec;
@@ -230,6 +285,69 @@ struct SurfaceConfig {
     mfxU32 SurfaceFlags;
 };
 
+// range of entries in CapsIndexVPL with the same CodecID (dec/enc) or FilterFourCC (vpp)
+// masks are a superset of what the entries support, so groups which cannot match
+//   a filter are skipped without checking each entry
+struct CapsIndexGroup {
+    mfxU32 id;
+    mfxU32 first;
+    mfxU32 count;
+
+    // bit (1 << MemHandleType), values above 31 share the top bit
+    mfxU32 memTypeMask;
+
+    // bit (1 << index in CapsIndexVPL::formats), indices above 63 share the top bit
+    mfxU64 formatMask;
+};
+
+// flattened caps of a single implementation, built once when caps are queried
+//   and used for all later filter matching (see ConfigCtxVPL::ValidateConfig)
+struct CapsIndexVPL {
+    std::vector<DecConfig> dec;
+    std::vector<EncConfig> enc;
+    std::vector<VPPConfig> vpp;
+    std::vector<SurfaceConfig> surface;
+
+    std::vector<CapsIndexGroup> decGroups;
+    std::vector<CapsIndexGroup> encGroups;
+    std::vector<CapsIndexGroup> vppGroups;
+
+    // all color formats used by dec/enc/vpp entries, in order of first use
+    std::vector<mfxU32> formats;
+
+    // comma-separated License and Keywords strings, split into tokens
+    std::vector<std::string> licenseTokens;
+    std::vector<std::string> keywordTokens;
+
+#ifdef ONEVPL_EXPERIMENTAL
+    // MFX_IMPLCAPS_FLAT descriptor, built from the entries above on first query
+    //   (mutable since the index is otherwise shared as const)
+    // flatCapsBuf is allocated with the index, so its address is known before it is built
+    // flatCaps is set once flatCapsBuf is complete, so it may be read without the once flag
+    mutable std::once_flag flatCapsOnce;
+    mutable std::vector<mfxU64> flatCapsBuf;
+    mutable std::atomic<mfxImplCapsFlat *> flatCaps;
+
+    CapsIndexVPL() : flatCapsOnce(), flatCapsBuf(), flatCaps(nullptr) {}
+#endif
+};
+
+// memoized result of checking one config object vs. caps of one implementation
+// a group is re-checked only if the config changed a property in that group
+//   (groupGeneration differs from ConfigCtxVPL::m_groupGeneration)
+struct ConfigResultVPL {
+    mfxU64 configId;
+    mfxU32 groupGeneration[NUM_PROP_GROUPS];
+
+    // bit (1 << PropGroup) for each group which does not match
+    mfxU32 failMask;
+
+    // first alternative which matches (-1 if none), valid while altGeneration
+    //   equals ConfigCtxVPL::m_altGeneration
+    mfxU32 altGeneration;
+    mfxI32 altIdx;
+};
+
 // special props which are passed in via MFXSetConfigProperty()
 // these are updated with every call to ValidateConfig() and may
 //   be used in MFXCreateSession()
@@ -255,6 +373,9 @@ struct SpecialConfig {
     bool bIsSet_DeviceCopy;
     mfxU16 DeviceCopy;
 
+    bool bIsSet_SessionProfile;
+    mfxU16 SessionProfile;
+
     bool bIsSet_ExtBuffer;
     std::vector<mfxExtBuffer *> ExtBuffers;
 };
@@ -268,19 +389,60 @@ public:
     // set a single filter property (KV pair)
     mfxStatus SetFilterProperty(const mfxU8 *name, mfxVariant value);
 
+#ifdef ONEVPL_EXPERIMENTAL
+    // set a single filter property by public ID (mfxConfigFilterPropertyId)
+    mfxStatus SetFilterPropertyById(mfxU32 id, mfxVariant value);
+
+    // set multiple filter properties, none are set if any of them fail
+    mfxStatus SetFilterProperties(const mfxConfigFilterProperty *props,
+                                  mfxU32 numProps,
+                                  mfxStatus *propSts);
+
+    // set a single filter property which matches with a comparison (mfxConfigFilterOp)
+    mfxStatus SetFilterPropertyOp(const mfxU8 *name,
+                                  mfxU32 op,
+                                  const mfxVariant *values,
+                                  mfxU32 numValues);
+
+    // add an alternative set of filter properties, owned by this config
+    // returns nullptr if this config is itself an alternative
+    ConfigCtxVPL *AddAlternative();
+
+    // index of the alternative which matched, from results memoized by ValidateConfig()
+    mfxStatus GetMatchedAlternative(const std::vector<ConfigResultVPL> &configResults,
+                                    mfxU32 *alternative) const;
+#endif
+
     static bool CheckLowLatencyConfig(std::list<ConfigCtxVPL *> configCtxList,
                                       SpecialConfig *specialConfig);
 
+    // encoder requested by the filters, used to rank implementations by throughput
+    static bool GetRequestedEncoder(const std::list<ConfigCtxVPL *> &configCtxList,
+                                    mfxU32 &codecID,
+                                    mfxU32 &width,
+                                    mfxU32 &height);
+
     // compare library caps vs. set of configuration filters
+    // if capsIndex is null, a temporary index is built from libImplDesc
+    // if configResults is not null, results are memoized there for each config object
     static mfxStatus ValidateConfig(const mfxImplDescription *libImplDesc,
                                     const mfxImplementedFunctions *libImplFuncs,
                                     const mfxExtendedDeviceId *libImplExtDevID,
 #ifdef ONEVPL_EXPERIMENTAL
                                     const mfxSurfaceTypesSupported *libImplSurfTypes,
 #endif
-                                    std::list<ConfigCtxVPL *> configCtxList,
+                                    const CapsIndexVPL *capsIndex,
+                                    const std::list<ConfigCtxVPL *> &configCtxList,
                                     LibType libType,
-                                    SpecialConfig *specialConfig);
+                                    SpecialConfig *specialConfig,
+                                    std::vector<ConfigResultVPL> *configResults);
+
+    // flatten library caps into index used by ValidateConfig()
+    static mfxStatus BuildCapsIndex(const mfxImplDescription *libImplDesc,
+#ifdef ONEVPL_EXPERIMENTAL
+                                    const mfxSurfaceTypesSupported *libImplSurfTypes,
+#endif
+                                    CapsIndexVPL &capsIndex);
 
     // parse deviceID for x86 devices
     static bool ParseDeviceIDx86(mfxChar *cDeviceID, mfxU32 &deviceID, mfxU32 &adapterIdx);
@@ -290,58 +452,76 @@ public:
     //   MFXSetConfigFilterProperty()
     class LoaderCtxVPL *m_parentLoader;
 
-private:
-    static __inline std::string GetNextProp(std::list<std::string> &s) {
-        if (s.empty())
-            return "";
-        std::string t = s.front();
-        s.pop_front();
-        return t;
-    }
+    // config which this alternative belongs to, nullptr if not an alternative
+    ConfigCtxVPL *m_parentConfig;
 
+private:
     mfxStatus ValidateAndSetProp(mfxI32 idx, mfxVariant value);
-    mfxStatus SetFilterPropertyDec(std::list<std::string> &propParsedString, mfxVariant value);
-    mfxStatus SetFilterPropertyEnc(std::list<std::string> &propParsedString, mfxVariant value);
-    mfxStatus SetFilterPropertyVPP(std::list<std::string> &propParsedString, mfxVariant value);
-    mfxStatus SetFilterPropertySurface(std::list<std::string> &propParsedString, mfxVariant value);
+
+    // invalidate memoized results for the group, and for the alternatives of the parent
+    void InvalidateGroup(mfxU32 group);
 
     static mfxStatus GetFlatDescriptionsDec(const mfxImplDescription *libImplDesc,
-                                            std::list<DecConfig> &decConfigList);
+                                            std::vector<DecConfig> &decConfigList);
 
     static mfxStatus GetFlatDescriptionsEnc(const mfxImplDescription *libImplDesc,
-                                            std::list<EncConfig> &encConfigList);
+                                            std::vector<EncConfig> &encConfigList);
 
     static mfxStatus GetFlatDescriptionsVPP(const mfxImplDescription *libImplDesc,
-                                            std::list<VPPConfig> &vppConfigList);
+                                            std::vector<VPPConfig> &vppConfigList);
 #ifdef ONEVPL_EXPERIMENTAL
     static mfxStatus GetFlatDescriptionsSurface(const mfxSurfaceTypesSupported *libSurfaceTypes,
-                                                std::list<SurfaceConfig> &surfaceConfigList);
+                                                std::vector<SurfaceConfig> &surfaceConfigList);
+#endif
+
+    // check groups in groupMask, returns bit (1 << PropGroup) for each group which fails
+    mfxU32 CheckPropGroups(mfxU32 groupMask,
+                           const mfxImplDescription *libImplDesc,
+                           const mfxImplementedFunctions *libImplFuncs,
+                           const mfxExtendedDeviceId *libImplExtDevID,
+#ifdef ONEVPL_EXPERIMENTAL
+                           const mfxSurfaceTypesSupported *libImplSurfTypes,
 #endif
+                           const CapsIndexVPL &capsIndex,
+                           LibType libType) const;
 
     static mfxStatus CheckPropsGeneral(const mfxVariant cfgPropsAll[],
-                                       const mfxImplDescription *libImplDesc);
+                                       const mfxImplDescription *libImplDesc,
+                                       const CapsIndexVPL &capsIndex);
 
-    static mfxStatus CheckPropsDec(const mfxVariant cfgPropsAll[],
-                                   std::list<DecConfig> decConfigList);
+    static mfxStatus CheckPropsDec(const mfxVariant cfgPropsAll[], const CapsIndexVPL &capsIndex);
 
-    static mfxStatus CheckPropsEnc(const mfxVariant cfgPropsAll[],
-                                   std::list<EncConfig> encConfigList);
+    static mfxStatus CheckPropsEnc(const mfxVariant cfgPropsAll[], const CapsIndexVPL &capsIndex);
 
-    static mfxStatus CheckPropsVPP(const mfxVariant cfgPropsAll[],
-                                   std::list<VPPConfig> vppConfigList);
+    static mfxStatus CheckPropsVPP(const mfxVariant cfgPropsAll[], const CapsIndexVPL &capsIndex);
 
-    static mfxStatus CheckPropString(const mfxChar *implString, const std::string filtString);
+    static mfxStatus CheckPropString(const std::vector<std::string> &implTokens,
+                                     const std::string &filtString);
 
     static mfxStatus CheckPropsExtDevID(const mfxVariant cfgPropsAll[],
                                         const mfxExtendedDeviceId *libImplExtDevID);
 
 #ifdef ONEVPL_EXPERIMENTAL
     static mfxStatus CheckPropsSurface(const mfxVariant cfgPropsAll[],
-                                       std::list<SurfaceConfig> surfaceConfigList);
+                                       const CapsIndexVPL &capsIndex);
 #endif
 
     mfxVariant m_propVar[NUM_TOTAL_FILTER_PROPS];
 
+    // unique in process, so memoized results are never matched to a different config
+    mfxU64 m_configId;
+
+    // incremented each time a property in the group is set
+    mfxU32 m_groupGeneration[NUM_PROP_GROUPS];
+
+    // alternatives, in the order they were created
+    // m_altGeneration is incremented each time one is added or changed
+    std::list<ConfigCtxVPL *> m_altList;
+    mfxU32 m_altGeneration;
+
+    // comparisons of properties set with SetFilterPropertyOp(), by property index
+    std::unordered_map<mfxI32, FilterOpVPL> m_filterOps;
+
     // special containers for properties which are passed by pointer
     //   (save a copy of the whole object based on property name)
     mfxRange32U m_propRange32U[NUM_PROP_RANGES];
@@ -447,6 +627,178 @@ private:
     }
 };
 
+// capabilities of a single implementation, as returned by MFXQueryImplsDescription()
+//   or restored from the caps cache
+struct CachedImplCaps {
+    mfxHDL implDesc;
+    mfxHDL implFuncs;
+    mfxHDL implExtDeviceID;
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxHDL implSurfTypes;
+#endif
+};
+
+// capabilities of a single library restored from the caps cache
+// all descriptors point into buf, which is owned by this object
+struct CachedLibCaps {
+    // bit N is set if FunctionDesc2[N] is exported by the library
+    mfxU32 exportMask;
+
+    std::vector<CachedImplCaps> implCaps;
+    std::vector<mfxU64> buf;
+
+    CachedLibCaps() : exportMask(0), implCaps(), buf() {}
+};
+
+// persistent on-disk cache of runtime capabilities (Linux only)
+// enable by setting environment variable ONEVPL_CAPS_CACHE to "ON"
+// one file per library is stored in $XDG_CACHE_HOME/vpl (default = $HOME/.cache/vpl)
+//   and is only used if path, inode, size, mtime, and dispatcher version all match
+class CapsCacheVPL {
+public:
+    CapsCacheVPL();
+    ~CapsCacheVPL();
+
+    mfxStatus Init();
+    mfxStatus Init(const std::string &cacheDir);
+
+    bool IsEnabled() {
+        return m_bEnabled;
+    }
+
+    const std::string &GetCacheDir() {
+        return m_cacheDir;
+    }
+
+    // returns nullptr if library is not in the cache or the entry is stale
+    // caller takes ownership of the returned object
+    CachedLibCaps *Load(const STRING_TYPE &libNameFull);
+
+    mfxStatus Store(const STRING_TYPE &libNameFull,
+                    mfxU32 exportMask,
+                    const std::vector<CachedImplCaps> &implCaps);
+
+private:
+    std::string GetCacheFileName(const STRING_TYPE &libNameFull);
+
+    bool m_bEnabled;
+    std::string m_cacheDir;
+};
+
+#if !defined(_WIN32) && !defined(_WIN64)
+// exported functions of a shared library, read from its ELF dynamic symbol table
+//   without loading it (Linux only)
+// used to skip candidate runtimes which do not export the required functions, since
+//   dlopen() maps the whole library, resolves all relocations, and runs its constructors
+class ElfExportsVPL {
+public:
+    ElfExportsVPL();
+    ~ElfExportsVPL();
+
+    // map the library and locate its dynamic symbol and hash tables
+    // if this fails the exports are unknown, and the library should be loaded to check them
+    mfxStatus Open(const STRING_TYPE &libNameFull);
+    void Close();
+
+    // true if the library defines and exports function name
+    bool HasFunction(const char *name);
+
+private:
+    mfxStatus ParseDynamic();
+    const void *FindSymbol(const char *name);
+    const void *FindSymbolGnuHash(const char *name);
+    const void *FindSymbolSysvHash(const char *name);
+    const void *GetSymbol(mfxU32 idx);
+    bool IsInFile(const void *ptr, size_t size);
+    bool IsSymbolName(const void *sym, const char *name);
+
+    const mfxU8 *m_data;
+    size_t m_size;
+
+    const mfxU8 *m_dynSym;
+    const char *m_dynStr;
+    size_t m_dynStrSize;
+    const mfxU32 *m_gnuHash;
+    const mfxU32 *m_sysvHash;
+
+    // make this class non-copyable
+    ElfExportsVPL(const ElfExportsVPL &);
+    void operator=(const ElfExportsVPL &);
+};
+#endif
+
+// phases of loader startup and session creation which are timed when startup timing
+//   is enabled (same values as mfxLoaderPhase)
+enum LoaderPhaseVPL {
+    LOADER_PHASE_SEARCH          = 0,
+    LOADER_PHASE_LOAD            = 1,
+    LOADER_PHASE_QUERY_CAPS      = 2,
+    LOADER_PHASE_VALIDATE_CONFIG = 3,
+    LOADER_PHASE_PRIORITIZE      = 4,
+    LOADER_PHASE_CREATE_SESSION  = 5,
+
+    NUM_LOADER_PHASES
+};
+
+// total time spent in each phase - enabled with ONEVPL_STARTUP_TIMING environment variable
+//   or dispatcher log
+// totals may be updated by several threads (e.g. concurrent session creation)
+class StartupTimingVPL {
+public:
+    StartupTimingVPL();
+
+    mfxStatus Init(DispatcherLogVPL *dispLog);
+
+    bool IsEnabled() const {
+        return m_bEnabled;
+    }
+
+    static mfxU64 GetTimeNs() {
+        return (mfxU64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    void AddPhase(mfxU32 phase, mfxU64 timeNs);
+
+    mfxU64 GetPhaseTime(mfxU32 phase) const {
+        return m_timeNs[phase].load();
+    }
+
+    mfxU32 GetPhaseCount(mfxU32 phase) const {
+        return m_count[phase].load();
+    }
+
+private:
+    bool m_bEnabled;
+    DispatcherLogVPL *m_dispLog;
+
+    std::atomic<mfxU64> m_timeNs[NUM_LOADER_PHASES];
+    std::atomic<mfxU32> m_count[NUM_LOADER_PHASES];
+};
+
+// adds the time from construction to destruction to one phase
+// only checks whether timing is enabled if it is not
+class PhaseTimerVPL {
+public:
+    PhaseTimerVPL(StartupTimingVPL *timing, mfxU32 phase)
+            : m_timing(timing->IsEnabled() ? timing : nullptr),
+              m_phase(phase),
+              m_startNs(m_timing ? StartupTimingVPL::GetTimeNs() : 0) {}
+
+    ~PhaseTimerVPL() {
+        if (m_timing)
+            m_timing->AddPhase(m_phase, StartupTimingVPL::GetTimeNs() - m_startNs);
+    }
+
+private:
+    StartupTimingVPL *m_timing;
+    mfxU32 m_phase;
+    mfxU64 m_startNs;
+};
+
+#define STARTUP_PHASE_TIMER(timing, phase) PhaseTimerVPL _phaseTimer(timing, phase);
+
 struct LibInfo {
     // during search store candidate file names
     //   and priority based on rules in spec
@@ -468,6 +820,28 @@ struct LibInfo {
     // user-friendly version of path for MFX_IMPLCAPS_IMPLPATH query
     mfxChar implCapsPath[MAX_VPL_SEARCH_PATH];
 
+    // minimum API version required by the manifest entry for this library (0 = any)
+    mfxVersion minApiVersion;
+
+    // library was not loaded, since its ELF symbol table lacks the required functions
+    bool bMissingExports;
+
+    // if not null, caps were restored from the caps cache and the library
+    //   is not loaded (hModuleVPL and vplFuncTable are empty)
+    CachedLibCaps *cachedCaps;
+
+    // function table for session creation fast path, resolved on first MFXCreateSession()
+    // the once flag allows loaders attached to the shared catalog to create it safely
+    mfxHDL hFuncTable;
+    std::once_flag funcTableOnce;
+
+    // startup timing of this library, if enabled
+    // session totals may be updated by several threads
+    mfxU64 loadTimeNs;
+    mfxU64 queryTimeNs;
+    std::atomic<mfxU64> sessionTimeNs;
+    std::atomic<mfxU32> numSessions;
+
     // avoid warnings
     LibInfo()
             : libNameFull(),
@@ -477,7 +851,16 @@ struct LibInfo {
               vplFuncTable(),
               msdkCtx(),
               msdkVersion(),
-              implCapsPath() {}
+              implCapsPath(),
+              minApiVersion(),
+              bMissingExports(false),
+              cachedCaps(nullptr),
+              hFuncTable(nullptr),
+              funcTableOnce(),
+              loadTimeNs(0),
+              queryTimeNs(0),
+              sessionTimeNs(0),
+              numSessions(0) {}
 
 private:
     // make this class non-copyable
@@ -517,6 +900,18 @@ struct ImplInfo {
     // index of valid libraries - updates with every call to MFXSetConfigFilterProperty()
     mfxI32 validImplIdx;
 
+    // excluded during caps query regardless of filters (e.g. MSDK duplicate of 2.x runtime)
+    bool bExcludedByQuery;
+
+    // flattened caps used for filter matching, shared by copies of this ImplInfo
+    std::shared_ptr<const CapsIndexVPL> capsIndex;
+
+    // memoized results of ValidateConfig() for each config object
+    std::vector<ConfigResultVPL> configResults;
+
+    // measured time per frame in ns, keyed by (codec << 32 | resolution class)
+    std::unordered_map<mfxU64, mfxU64> rankScores;
+
     // avoid warnings
     ImplInfo()
             : libInfo(nullptr),
@@ -531,7 +926,234 @@ struct ImplInfo {
               msdkImplIdx(0),
               adapterIdx(ADAPTER_IDX_UNKNOWN),
               libImplIdx(0),
-              validImplIdx(-1) {
+              validImplIdx(-1),
+              bExcludedByQuery(false),
+              capsIndex(),
+              configResults(),
+              rankScores() {
+    }
+};
+
+// implementation and caps format of a descriptor handle, used to look up handles
+//   passed to MFXDispReleaseImplDescription()
+struct ImplHandleVPL {
+    ImplInfo *implInfo;
+    mfxImplCapsDeliveryFormat format;
+};
+
+// process-wide catalog of loaded libraries and implementations
+// shared by all loaders with ONEVPL_SHARED_CATALOG enabled, immutable once published
+struct CatalogVPL {
+    std::list<LibInfo *> libInfoList;
+    std::list<ImplInfo *> implInfoList;
+    bool bPriorityPathEnabled;
+
+    // number of attached loaders
+    mfxU32 refCount;
+
+    CatalogVPL() : libInfoList(), implInfoList(), bPriorityPathEnabled(false), refCount(0) {}
+};
+
+// candidate runtime listed in the manifest (see mfx_dispatcher_vpl_manifest.cpp)
+struct ManifestEntryVPL {
+    STRING_TYPE libNameFull;
+    mfxU32 libPriority;
+    mfxVersion minApiVersion;
+
+    ManifestEntryVPL() : libNameFull(), libPriority(0), minApiVersion() {}
+};
+
+// reader-writer lock which protects loader state
+// writers are preferred, so that filter updates are not starved by readers
+// method names follow the standard Lockable requirements, so std::lock_guard may be used
+class RWLockVPL {
+public:
+    RWLockVPL() : m_mutex(), m_cond(), m_numReaders(0), m_numWritersWaiting(0), m_bWriter(false) {}
+
+    void lock() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_numWritersWaiting++;
+        m_cond.wait(lock, [this]() {
+            return (!m_bWriter && m_numReaders == 0);
+        });
+        m_numWritersWaiting--;
+        m_bWriter = true;
+    }
+
+    void unlock() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bWriter = false;
+        m_cond.notify_all();
+    }
+
+    void lock_shared() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this]() {
+            return (!m_bWriter && m_numWritersWaiting == 0);
+        });
+        m_numReaders++;
+    }
+
+    void unlock_shared() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_numReaders--;
+        if (m_numReaders == 0)
+            m_cond.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    mfxU32 m_numReaders;
+    mfxU32 m_numWritersWaiting;
+    bool m_bWriter;
+};
+
+// holds RWLockVPL in shared (read) mode until destroyed
+class SharedLockVPL {
+public:
+    explicit SharedLockVPL(RWLockVPL &rwLock) : m_rwLock(rwLock) {
+        m_rwLock.lock_shared();
+    }
+
+    ~SharedLockVPL() {
+        m_rwLock.unlock_shared();
+    }
+
+private:
+    RWLockVPL &m_rwLock;
+};
+
+// everything needed to create a session for one implementation, resolved from
+//   the loader state and filters at the time it was filled in
+// does not reference loader state other than libInfo, so may be used from other threads
+struct SessionParamsVPL {
+    LibInfo *libInfo;
+    mfxVersion version;
+    mfxIMPL msdkImpl;
+    mfxInitializationParam vplParam;
+    bool bFastPath;
+    bool bProfile;
+
+    // extension buffers are copied, vplParam.ExtParam is set when the session is created
+    mfxExtThreadsParam extThreadsParam;
+    bool bSetThreadsParam;
+    std::vector<std::vector<mfxU8>> extBufData;
+
+    // device handle to pass to MFXVideoCORE_SetHandle(), if any
+    mfxHandleType deviceHandleType;
+    mfxHDL deviceHandle;
+
+    SessionParamsVPL()
+            : libInfo(nullptr),
+              version(),
+              msdkImpl(0),
+              vplParam(),
+              bFastPath(false),
+              bProfile(false),
+              extThreadsParam(),
+              bSetThreadsParam(false),
+              extBufData(),
+              deviceHandleType(),
+              deviceHandle(nullptr) {}
+};
+
+// sessions for one implementation which were created ahead of time by a worker thread
+// the worker creates sessions until the pool is full, and wakes up when one is taken
+struct SessionPoolVPL {
+    // pools follow the implementation, since indices change when filters are updated
+    ImplInfo *implInfo;
+    mfxU32 poolSize;
+    SessionParamsVPL params;
+
+    std::mutex poolMutex;
+    std::condition_variable poolCond;
+    std::deque<mfxSession> sessions;
+
+    // set on unload, or if the worker failed to create a session
+    bool bStop;
+    mfxStatus workerSts;
+
+    std::thread worker;
+
+    SessionPoolVPL()
+            : implInfo(nullptr),
+              poolSize(0),
+              params(),
+              poolMutex(),
+              poolCond(),
+              sessions(),
+              bStop(false),
+              workerSts(MFX_ERR_NONE),
+              worker() {}
+};
+
+#ifdef ONEVPL_EXPERIMENTAL
+// session created on a worker thread for MFXCreateSessionAsync()
+// parameters are resolved when the request is made, so later filter changes do not apply
+struct SessionRequestVPL {
+    LoaderCtxVPL *loaderCtx;
+    SessionParamsVPL params;
+
+    mfxSessionRequestCallback callback;
+    mfxHDL userData;
+
+    // result of session creation, session is cleared once it is returned to the application
+    std::mutex requestMutex;
+    std::condition_variable requestCond;
+    bool bDone;
+    mfxStatus sts;
+    mfxSession session;
+
+    std::thread worker;
+
+    SessionRequestVPL()
+            : loaderCtx(nullptr),
+              params(),
+              callback(nullptr),
+              userData(nullptr),
+              requestMutex(),
+              requestCond(),
+              bDone(false),
+              sts(MFX_ERR_NONE),
+              session(nullptr),
+              worker() {}
+};
+#endif
+
+// raw results of MFXQueryImplsDescription() for a single 2.x runtime
+// filled in by parallel query, then merged in search order
+struct LibCapsQuery {
+    bool bQueried;
+    mfxStatus sts;
+
+    mfxHDL *hImpl;
+    mfxU32 numImpls;
+
+    mfxHDL *hImplExtDeviceID;
+    mfxU32 numImplsExtDeviceID;
+
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxHDL *hImplSurfTypes;
+    mfxU32 numImplsSurfTypes;
+#endif
+
+    mfxHDL *hImplFuncs;
+    mfxU32 numImplsFuncs;
+
+    LibCapsQuery()
+            : bQueried(false),
+              sts(MFX_ERR_NONE),
+              hImpl(nullptr),
+              numImpls(0),
+              hImplExtDeviceID(nullptr),
+              numImplsExtDeviceID(0),
+#ifdef ONEVPL_EXPERIMENTAL
+              hImplSurfTypes(nullptr),
+              numImplsSurfTypes(0),
+#endif
+              hImplFuncs(nullptr),
+              numImplsFuncs(0) {
     }
 };
 
@@ -549,8 +1171,12 @@ public:
 
     // query capabilities of each implementation
     mfxStatus FullLoadAndQuery();
+    mfxStatus SearchAndQueryLibs();
     mfxStatus QueryImpl(mfxU32 idx, mfxImplCapsDeliveryFormat format, mfxHDL *idesc);
     mfxStatus ReleaseImpl(mfxHDL idesc);
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxStatus QueryAllImpls(mfxImplCapsDeliveryFormat format, mfxHDL *idescs, mfxU32 *numImpls);
+#endif
 
     // update list of valid implementations based on current filter props
     mfxStatus UpdateValidImplList(void);
@@ -562,11 +1188,71 @@ public:
     // manage configuration filters
     ConfigCtxVPL *AddConfigFilter();
     mfxStatus FreeConfigFilters();
+    mfxStatus ResetConfigFilters();
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxStatus QueryConfigAlternative(mfxU32 idx, ConfigCtxVPL *config, mfxU32 *alternative);
+#endif
 
     // manage logging
     mfxStatus InitDispatcherLog();
     DispatcherLogVPL *GetLogger();
 
+    // manage persistent caps cache
+    mfxStatus InitCapsCache();
+
+    // per-phase and per-library startup timing
+    mfxStatus InitStartupTiming();
+#ifdef ONEVPL_EXPERIMENTAL
+    mfxStatus GetLoaderTimings(mfxLoaderTimings *timings);
+    mfxStatus GetImplTimings(mfxU32 idx, mfxImplTimings *timings);
+#endif
+
+    // manage parallel probing of runtimes
+    mfxStatus InitProbeThreads();
+
+    // lazy enumeration - only load libraries until requested implementation is found
+    mfxStatus InitLazyEnum();
+    mfxStatus LazyLoadAndQuery(mfxU32 idx);
+
+    // shared catalog - reuse loaded libraries and caps across loaders
+    mfxStatus InitSharedCatalog();
+    mfxStatus AttachCatalog();
+
+    // create sessions with function table resolved by the loader (ONEVPL_SESSION_FAST_PATH)
+    mfxStatus InitSessionFastPath();
+
+    // record call statistics of new sessions in the dispatcher (ONEVPL_SESSION_PROFILE)
+    mfxStatus InitSessionProfile();
+
+    // check exports of candidate runtimes before loading them (ONEVPL_EXPORT_CHECK)
+    mfxStatus InitExportCheck();
+
+    // search and query runtimes on a background thread from MFXLoad (ONEVPL_WARMUP)
+    mfxStatus InitWarmUp();
+    mfxStatus FinishWarmUp();
+
+    // sort valid implementations by measured encode throughput (ONEVPL_RANK_POLICY)
+    mfxStatus InitRankPolicy();
+    mfxStatus RankImplList();
+
+    // pools of sessions created in the background
+    mfxStatus CreateSessionPool(mfxU32 idx, mfxU32 poolSize);
+    mfxStatus AcquirePooledSession(mfxU32 idx, mfxSession *session);
+
+#ifdef ONEVPL_EXPERIMENTAL
+    // sessions created asynchronously on worker threads
+    mfxStatus CreateSessionAsync(mfxU32 idx,
+                                 mfxSessionRequestCallback callback,
+                                 mfxHDL userData,
+                                 SessionRequestVPL **request);
+    mfxStatus WaitSessionRequest(SessionRequestVPL *request, mfxU32 waitMs, mfxSession *session);
+    mfxStatus ReleaseSessionRequest(SessionRequestVPL *request);
+#endif
+    mfxStatus DestroySessionRequests();
+
+    // manifest - fixed list of candidate runtimes, replaces directory search
+    mfxStatus InitManifest();
+
     // low latency initialization
     mfxStatus LoadLibsLowLatency();
     mfxStatus UpdateLowLatency();
@@ -576,12 +1262,38 @@ public:
     bool m_bNeedFullQuery;
     bool m_bNeedLowLatencyQuery;
     bool m_bPriorityPathEnabled;
+    bool m_bLazyEnum;
+    bool m_bSharedCatalog;
+    bool m_bSessionFastPath;
+    bool m_bSessionProfile;
+    bool m_bExportCheck;
+    bool m_bManifest;
+    bool m_bWarmUp;
+    bool m_bRankThroughput;
+
+    // public entry points hold this lock in exclusive mode if they modify loader state
+    //   (filters, implementation lists, libraries), and in shared mode if they only read it
+    RWLockVPL m_loaderLock;
 
 private:
     // helper functions
     mfxStatus LoadSingleLibrary(LibInfo *libInfo);
+    void ProbeSingleLibrary(LibInfo *libInfo);
+#if !defined(_WIN32) && !defined(_WIN64)
+    bool CheckLibraryExports(LibInfo *libInfo);
+#endif
+    mfxStatus QueryLibraryImplsVPL(LibInfo *libInfo, LibCapsQuery *capsQuery);
     mfxStatus UnloadSingleLibrary(LibInfo *libInfo);
     mfxStatus UnloadSingleImplementation(ImplInfo *implInfo);
+    mfxStatus IndexImplCaps(ImplInfo *implInfo);
+    mfxHDL GetImplHandle(ImplInfo *implInfo, mfxImplCapsDeliveryFormat format);
+    void RebuildImplIndex();
+    void RenumberValidImpls();
+    mfxU64 RunRankBenchmark(ImplInfo *implInfo, mfxU32 codecID, mfxU32 width, mfxU32 height);
+#ifdef ONEVPL_EXPERIMENTAL
+    static void AllocFlatCaps(CapsIndexVPL &capsIndex);
+    mfxImplCapsFlat *GetFlatCaps(ImplInfo *implInfo);
+#endif
     VPLFunctionPtr GetFunctionAddr(void *hModuleVPL, const char *pName);
 
     mfxU32 GetSearchPathsDriverStore(std::list<STRING_TYPE> &searchDirs, LibType libType);
@@ -603,7 +1315,8 @@ private:
                                bool bLoadVPLOnly = false);
 
     mfxU32 LoadAPIExports(LibInfo *libInfo, LibType libType);
-    mfxStatus ValidateAPIExports(VPLFunctionPtr *vplFuncTable, mfxVersion reportedVersion);
+    mfxU32 GetAPIExportMask(LibInfo *libInfo);
+    mfxStatus ValidateAPIExports(mfxU32 exportMask, mfxVersion reportedVersion);
     bool IsValidX86GPU(ImplInfo *implInfo, mfxU32 &deviceID, mfxU32 &adapterIdx);
     mfxStatus UpdateImplPath(LibInfo *libInfo);
 
@@ -616,9 +1329,31 @@ private:
     LibInfo *AddSingleLibrary(STRING_TYPE libPath, LibType libType);
     mfxStatus QuerySessionLowLatency(LibInfo *libInfo, mfxU32 adapterID, mfxVersion *ver);
 
+    mfxStatus AddManifestLibs();
+    mfxU32 GetNumValidImpls();
+    mfxStatus UnloadLazyLibraries();
+    mfxStatus DetachCatalog();
+    mfxHDL GetFuncTable(LibInfo *libInfo, mfxVersion version);
+    mfxStatus GetSessionParams(mfxU32 idx, SessionParamsVPL &params);
+    mfxStatus CreateSessionFromParams(const SessionParamsVPL &params, mfxSession *session);
+    SessionPoolVPL *FindSessionPool(mfxU32 idx);
+    mfxStatus ResizeSessionPool(SessionPoolVPL *pool, mfxU32 poolSize);
+    void RefillSessionPool(SessionPoolVPL *pool);
+    mfxStatus DestroySessionPools();
+#ifdef ONEVPL_EXPERIMENTAL
+    void RunSessionRequest(SessionRequestVPL *request);
+#endif
+    mfxStatus FinishSessionRequests();
+    void RunWarmUp();
+
     std::list<LibInfo *> m_libInfoList;
     std::list<ImplInfo *> m_implInfoList;
     std::list<ConfigCtxVPL *> m_configCtxList;
+
+    // valid implementations indexed by validImplIdx, and the implementation owning each
+    //   caps descriptor - rebuilt by RebuildImplIndex() whenever the indices change
+    std::vector<ImplInfo *> m_validImplList;
+    std::unordered_map<mfxHDL, ImplHandleVPL> m_implHandleMap;
     std::vector<DXGI1DeviceInfo> m_gpuAdapterInfo;
 
     SpecialConfig m_specialConfig;
@@ -629,6 +1364,42 @@ private:
 
     // logger object - enabled with ONEVPL_DISPATCHER_LOG environment variable
     DispatcherLogVPL m_dispLog;
+
+    // caps cache - enabled with ONEVPL_CAPS_CACHE environment variable
+    CapsCacheVPL m_capsCache;
+
+    // startup timing - enabled with ONEVPL_STARTUP_TIMING environment variable
+    StartupTimingVPL m_startupTiming;
+
+    // max number of threads used to probe runtimes
+    mfxU32 m_maxProbeThreads;
+
+    // candidate libraries not yet loaded in lazy enumeration mode, in static priority order
+    std::list<LibInfo *> m_lazyLibList;
+    bool m_bLazyListBuilt;
+
+    // shared catalog this loader is attached to, if any
+    CatalogVPL *m_catalog;
+
+    // session pools, at most one per implementation index
+    std::list<SessionPoolVPL *> m_sessionPoolList;
+
+#ifdef ONEVPL_EXPERIMENTAL
+    // requests from MFXCreateSessionAsync() which were not released
+    std::list<SessionRequestVPL *> m_sessionRequestList;
+    std::mutex m_sessionRequestMutex;
+#endif
+
+    // candidate runtimes read from the manifest, in file order
+    std::list<ManifestEntryVPL> m_manifestList;
+
+    // warm-up thread started by MFXLoad, joined by FinishWarmUp()
+    std::thread m_warmUpThread;
+    mfxStatus m_warmUpSts;
+
+    // scores read from the rank file in the caps cache directory, keyed by library and benchmark
+    std::unordered_map<std::string, mfxU64> m_rankFileScores;
+    bool m_bRankFileLoaded;
 };
 
 #endif // LIBVPL_SRC_MFX_DISPATCHER_VPL_H_
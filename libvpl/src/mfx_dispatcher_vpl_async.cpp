@@ -0,0 +1,164 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include "src/mfx_dispatcher_vpl.h"
+
+// Intel® VPL asynchronous session creation (experimental MFXCreateSessionAsync)
+//
+// Session parameters are resolved by the calling thread while the loader is
+//   locked, like MFXCreateSession(), so the request is not affected by filters
+//   which are changed after it is made.
+// A worker thread per request initializes the runtime, stores the result and
+//   calls the application callback.
+// Workers are joined before libraries are unloaded, since the parameters
+//   refer to the library of the implementation.
+
+#ifdef ONEVPL_EXPERIMENTAL
+mfxStatus LoaderCtxVPL::CreateSessionAsync(mfxU32 idx,
+                                           mfxSessionRequestCallback callback,
+                                           mfxHDL userData,
+                                           SessionRequestVPL **request) {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    std::unique_ptr<SessionRequestVPL> req;
+    try {
+        req.reset(new SessionRequestVPL{});
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    req->loaderCtx = this;
+    req->callback  = callback;
+    req->userData  = userData;
+
+    mfxStatus sts = GetSessionParams(idx, req->params);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    // add to the list first, so the request is released by MFXUnload() once the worker starts
+    std::lock_guard<std::mutex> lock(m_sessionRequestMutex);
+    try {
+        m_sessionRequestList.push_back(req.get());
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    try {
+        req->worker = std::thread(&LoaderCtxVPL::RunSessionRequest, this, req.get());
+    }
+    catch (...) {
+        m_sessionRequestList.pop_back();
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    DISP_LOG_MESSAGE(&m_dispLog, "message:  session request started -- implementation %d", idx);
+
+    *request = req.release();
+
+    return MFX_ERR_NONE;
+}
+
+// wait up to waitMs for the request to complete, and return the session
+// not locked - only accesses the request
+mfxStatus LoaderCtxVPL::WaitSessionRequest(SessionRequestVPL *request,
+                                           mfxU32 waitMs,
+                                           mfxSession *session) {
+    std::unique_lock<std::mutex> lock(request->requestMutex);
+
+    auto isDone = [request]() {
+        return request->bDone;
+    };
+
+    if (waitMs == MFX_INFINITE) {
+        request->requestCond.wait(lock, isDone);
+    }
+    else if (!request->requestCond.wait_for(lock, std::chrono::milliseconds(waitMs), isDone)) {
+        return MFX_WRN_IN_EXECUTION;
+    }
+
+    if (request->sts != MFX_ERR_NONE)
+        return request->sts;
+
+    // session was already returned
+    if (!request->session)
+        return MFX_ERR_NOT_FOUND;
+
+    *session         = request->session;
+    request->session = nullptr;
+
+    return MFX_ERR_NONE;
+}
+
+// wait for the worker, close the session if it was not taken, and free the request
+mfxStatus LoaderCtxVPL::ReleaseSessionRequest(SessionRequestVPL *request) {
+    {
+        std::lock_guard<std::mutex> lock(m_sessionRequestMutex);
+        m_sessionRequestList.remove(request);
+    }
+
+    if (request->worker.joinable())
+        request->worker.join();
+
+    if (request->session)
+        MFXClose(request->session);
+
+    delete request;
+
+    return MFX_ERR_NONE;
+}
+
+// worker thread - create the session, then notify waiting threads and the application
+void LoaderCtxVPL::RunSessionRequest(SessionRequestVPL *request) {
+    mfxSession session = nullptr;
+    mfxStatus sts      = CreateSessionFromParams(request->params, &session);
+
+    {
+        std::lock_guard<std::mutex> lock(request->requestMutex);
+        request->sts     = sts;
+        request->session = session;
+        request->bDone   = true;
+        request->requestCond.notify_all();
+    }
+
+    // callback may take the session with MFXWaitSessionRequest()
+    if (request->callback)
+        request->callback((mfxSessionRequest)request, sts, request->userData);
+}
+#endif
+
+// wait for all workers, requests are kept until released by the application
+mfxStatus LoaderCtxVPL::FinishSessionRequests() {
+#ifdef ONEVPL_EXPERIMENTAL
+    std::lock_guard<std::mutex> lock(m_sessionRequestMutex);
+
+    for (auto request : m_sessionRequestList) {
+        if (request->worker.joinable())
+            request->worker.join();
+    }
+#endif
+
+    return MFX_ERR_NONE;
+}
+
+// release all requests which were not released by the application
+// called before libraries are unloaded, so that untaken sessions can be closed
+mfxStatus LoaderCtxVPL::DestroySessionRequests() {
+#ifdef ONEVPL_EXPERIMENTAL
+    FinishSessionRequests();
+
+    for (auto request : m_sessionRequestList) {
+        if (request->session)
+            MFXClose(request->session);
+
+        delete request;
+    }
+    m_sessionRequestList.clear();
+#endif
+
+    return MFX_ERR_NONE;
+}
@@ -0,0 +1,665 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <fstream>
+
+#include "src/mfx_dispatcher_vpl.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    #include <sys/stat.h>
+    #include <sys/types.h>
+#endif
+
+#ifndef DISPATCHER_VERSION_STR
+    #define DISPATCHER_VERSION_STR "unknown"
+#endif
+
+// increment if the file layout or the serialized structures change
+#define CAPS_CACHE_FORMAT_VERSION 1
+#define CAPS_CACHE_MAGIC          0x4350564c // 'LVPC'
+
+// number of descriptors stored per implementation
+#ifdef ONEVPL_EXPERIMENTAL
+    #define CAPS_CACHE_NUM_DESC 4
+#else
+    #define CAPS_CACHE_NUM_DESC 3
+#endif
+
+typedef struct mfxDeviceDescription::subdevices DevSubDevice;
+
+#ifdef ONEVPL_EXPERIMENTAL
+typedef struct mfxSurfaceTypesSupported::surftype SurfType;
+typedef struct mfxSurfaceTypesSupported::surftype::surfcomp SurfComp;
+#endif
+
+// fixed-size header at the start of each cache file
+// followed by the library path (padded to 8 bytes), then for each implementation
+//   an array of CAPS_CACHE_NUM_DESC blob sizes followed by the blobs (each padded to 8 bytes)
+struct CapsCacheHeader {
+    mfxU32 magic;
+    mfxU32 formatVersion;
+    mfxU32 apiVersion;
+    mfxU32 ptrSize;
+    char dispatcherVersion[32];
+
+    // key of the library file when the entry was written
+    mfxU64 dev;
+    mfxU64 ino;
+    mfxU64 size;
+    mfxU64 mtimeSec;
+    mfxU64 mtimeNsec;
+
+    mfxU32 pathLen;
+    mfxU32 exportMask;
+    mfxU32 numImpls;
+    mfxU32 numDesc;
+};
+
+static size_t AlignSize(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+// relocatable copy of a caps descriptor
+// pointers are stored as offsets from the start of the blob (0 = null) so that the
+//   whole descriptor can be written to disk and later restored with a single allocation
+class CapsBlob {
+public:
+    // pack mode - deep copy of a descriptor returned by the runtime
+    CapsBlob() : m_bPack(true), m_buf(), m_base(nullptr), m_size(0) {}
+
+    // unpack mode - convert offsets back to pointers in place
+    CapsBlob(mfxU8 *base, size_t size) : m_bPack(false), m_buf(), m_base(base), m_size(size) {}
+
+    const std::vector<mfxU8> &GetBuf() {
+        return m_buf;
+    }
+
+    bool ImplDesc(const mfxImplDescription *src);
+    bool ImplFuncs(const mfxImplementedFunctions *src);
+    bool ExtDeviceID(const mfxExtendedDeviceId *src);
+#ifdef ONEVPL_EXPERIMENTAL
+    bool SurfTypes(const mfxSurfaceTypesSupported *src);
+#endif
+
+private:
+    mfxU8 *Base() {
+        return (m_bPack ? m_buf.data() : m_base);
+    }
+
+    template <typename T>
+    T *At(size_t off) {
+        return reinterpret_cast<T *>(Base() + off);
+    }
+
+    size_t Alloc(size_t size) {
+        size_t off = m_buf.size();
+        m_buf.resize(off + AlignSize(size), 0);
+        return off;
+    }
+
+    template <typename T>
+    bool Root(const T *src) {
+        if (m_bPack) {
+            if (!src)
+                return false;
+            Alloc(sizeof(T));
+            memcpy(Base(), src, sizeof(T));
+            return true;
+        }
+        return (m_size >= sizeof(T));
+    }
+
+    // pointer at fieldOff refers to an array of count elements of type T
+    // on return arrOff is the offset of the array in the blob, or 0 if count is 0
+    // a null pointer (offset 0) with a nonzero count is rejected, since the count field
+    //   in the descriptor is kept and would be used to index the array
+    template <typename T>
+    bool Array(size_t fieldOff, mfxU32 count, size_t &arrOff) {
+        T *ptr = nullptr;
+        memcpy(&ptr, Base() + fieldOff, sizeof(ptr));
+
+        arrOff = 0;
+        if (count && !ptr)
+            return false;
+
+        if (m_bPack) {
+            if (count) {
+                arrOff = Alloc(count * sizeof(T));
+                memcpy(Base() + arrOff, ptr, count * sizeof(T));
+            }
+            ptr = reinterpret_cast<T *>(arrOff);
+        }
+        else {
+            uintptr_t off = reinterpret_cast<uintptr_t>(ptr);
+            ptr           = nullptr;
+            if (count) {
+                if ((off % alignof(T)) || off >= m_size || count > (m_size - off) / sizeof(T))
+                    return false;
+                arrOff = off;
+                ptr    = At<T>(off);
+            }
+        }
+
+        memcpy(Base() + fieldOff, &ptr, sizeof(ptr));
+        return true;
+    }
+
+    // pointer at fieldOff refers to a null-terminated string
+    bool String(size_t fieldOff) {
+        mfxChar *ptr = nullptr;
+        memcpy(&ptr, Base() + fieldOff, sizeof(ptr));
+
+        if (m_bPack) {
+            size_t off = 0;
+            if (ptr) {
+                size_t len = strlen(ptr) + 1;
+                off        = Alloc(len);
+                memcpy(Base() + off, ptr, len);
+            }
+            ptr = reinterpret_cast<mfxChar *>(off);
+        }
+        else {
+            uintptr_t off = reinterpret_cast<uintptr_t>(ptr);
+            ptr           = nullptr;
+            if (off) {
+                if (off >= m_size || !memchr(m_base + off, 0, m_size - off))
+                    return false;
+                ptr = At<mfxChar>(off);
+            }
+        }
+
+        memcpy(Base() + fieldOff, &ptr, sizeof(ptr));
+        return true;
+    }
+
+    bool m_bPack;
+    std::vector<mfxU8> m_buf;
+    mfxU8 *m_base;
+    size_t m_size;
+};
+
+bool CapsBlob::ImplDesc(const mfxImplDescription *src) {
+    if (!Root(src))
+        return false;
+
+    size_t arr, arr2, arr3, arr4;
+    mfxU32 i, j, k, m;
+
+    // extension buffers are reserved and cannot be relocated, do not cache
+    if (At<mfxImplDescription>(0)->NumExtParam)
+        return false;
+    At<mfxImplDescription>(0)->ExtParams.ExtParam = nullptr;
+
+    // device
+    mfxU32 numSubDevices = At<mfxImplDescription>(0)->Dev.NumSubDevices;
+    if (!Array<DevSubDevice>(offsetof(mfxImplDescription, Dev) +
+                                 offsetof(mfxDeviceDescription, SubDevices),
+                             numSubDevices,
+                             arr))
+        return false;
+
+    // decoders
+    mfxU32 numDec = At<mfxImplDescription>(0)->Dec.NumCodecs;
+    if (!Array<DecCodec>(offsetof(mfxImplDescription, Dec) + offsetof(mfxDecoderDescription, Codecs),
+                         numDec,
+                         arr))
+        return false;
+
+    for (i = 0; i < numDec; i++) {
+        size_t codecOff    = arr + i * sizeof(DecCodec);
+        mfxU32 numProfiles = At<DecCodec>(codecOff)->NumProfiles;
+        if (!Array<DecProfile>(codecOff + offsetof(DecCodec, Profiles), numProfiles, arr2))
+            return false;
+
+        for (j = 0; j < numProfiles; j++) {
+            size_t profOff    = arr2 + j * sizeof(DecProfile);
+            mfxU32 numMemDesc = At<DecProfile>(profOff)->NumMemTypes;
+            if (!Array<DecMemDesc>(profOff + offsetof(DecProfile, MemDesc), numMemDesc, arr3))
+                return false;
+
+            for (k = 0; k < numMemDesc; k++) {
+                size_t memOff     = arr3 + k * sizeof(DecMemDesc);
+                mfxU32 numFormats = At<DecMemDesc>(memOff)->NumColorFormats;
+                if (!Array<mfxU32>(memOff + offsetof(DecMemDesc, ColorFormats), numFormats, arr4))
+                    return false;
+            }
+        }
+    }
+
+    // encoders
+    mfxU32 numEnc = At<mfxImplDescription>(0)->Enc.NumCodecs;
+    if (!Array<EncCodec>(offsetof(mfxImplDescription, Enc) + offsetof(mfxEncoderDescription, Codecs),
+                         numEnc,
+                         arr))
+        return false;
+
+    for (i = 0; i < numEnc; i++) {
+        size_t codecOff    = arr + i * sizeof(EncCodec);
+        mfxU32 numProfiles = At<EncCodec>(codecOff)->NumProfiles;
+        if (!Array<EncProfile>(codecOff + offsetof(EncCodec, Profiles), numProfiles, arr2))
+            return false;
+
+        for (j = 0; j < numProfiles; j++) {
+            size_t profOff    = arr2 + j * sizeof(EncProfile);
+            mfxU32 numMemDesc = At<EncProfile>(profOff)->NumMemTypes;
+            if (!Array<EncMemDesc>(profOff + offsetof(EncProfile, MemDesc), numMemDesc, arr3))
+                return false;
+
+            for (k = 0; k < numMemDesc; k++) {
+                size_t memOff     = arr3 + k * sizeof(EncMemDesc);
+                mfxU32 numFormats = At<EncMemDesc>(memOff)->NumColorFormats;
+                if (!Array<mfxU32>(memOff + offsetof(EncMemDesc, ColorFormats), numFormats, arr4))
+                    return false;
+            }
+        }
+    }
+
+    // VPP filters
+    mfxU32 numFilters = At<mfxImplDescription>(0)->VPP.NumFilters;
+    if (!Array<VPPFilter>(offsetof(mfxImplDescription, VPP) + offsetof(mfxVPPDescription, Filters),
+                          numFilters,
+                          arr))
+        return false;
+
+    for (i = 0; i < numFilters; i++) {
+        size_t filterOff  = arr + i * sizeof(VPPFilter);
+        mfxU32 numMemDesc = At<VPPFilter>(filterOff)->NumMemTypes;
+        if (!Array<VPPMemDesc>(filterOff + offsetof(VPPFilter, MemDesc), numMemDesc, arr2))
+            return false;
+
+        for (j = 0; j < numMemDesc; j++) {
+            size_t memOff     = arr2 + j * sizeof(VPPMemDesc);
+            mfxU32 numFormats = At<VPPMemDesc>(memOff)->NumInFormats;
+            if (!Array<VPPFormat>(memOff + offsetof(VPPMemDesc, Formats), numFormats, arr3))
+                return false;
+
+            for (m = 0; m < numFormats; m++) {
+                size_t fmtOff        = arr3 + m * sizeof(VPPFormat);
+                mfxU32 numOutFormats = At<VPPFormat>(fmtOff)->NumOutFormat;
+                if (!Array<mfxU32>(fmtOff + offsetof(VPPFormat, OutFormats), numOutFormats, arr4))
+                    return false;
+            }
+        }
+    }
+
+    // acceleration modes
+    mfxU32 numModes = At<mfxImplDescription>(0)->AccelerationModeDescription.NumAccelerationModes;
+    if (!Array<mfxAccelerationMode>(offsetof(mfxImplDescription, AccelerationModeDescription) +
+                                        offsetof(mfxAccelerationModeDescription, Mode),
+                                    numModes,
+                                    arr))
+        return false;
+
+    // mfxPoolAllocationPolicy added with struct version 1.2
+    if (At<mfxImplDescription>(0)->Version.Version >= MFX_STRUCT_VERSION(1, 2)) {
+        mfxU32 numPolicies = At<mfxImplDescription>(0)->PoolPolicies.NumPoolPolicies;
+        if (!Array<mfxPoolAllocationPolicy>(offsetof(mfxImplDescription, PoolPolicies) +
+                                                offsetof(mfxPoolPolicyDescription, Policy),
+                                            numPolicies,
+                                            arr))
+            return false;
+    }
+    else if (m_bPack) {
+        memset(&(At<mfxImplDescription>(0)->PoolPolicies), 0, sizeof(mfxPoolPolicyDescription));
+    }
+
+    return true;
+}
+
+bool CapsBlob::ImplFuncs(const mfxImplementedFunctions *src) {
+    if (!Root(src))
+        return false;
+
+    size_t arr;
+    mfxU32 numFunctions = At<mfxImplementedFunctions>(0)->NumFunctions;
+    if (!Array<mfxChar *>(offsetof(mfxImplementedFunctions, FunctionsName), numFunctions, arr))
+        return false;
+
+    for (mfxU32 i = 0; i < numFunctions; i++) {
+        if (!String(arr + i * sizeof(mfxChar *)))
+            return false;
+    }
+
+    return true;
+}
+
+bool CapsBlob::ExtDeviceID(const mfxExtendedDeviceId *src) {
+    // no pointers to relocate
+    return Root(src);
+}
+
+#ifdef ONEVPL_EXPERIMENTAL
+bool CapsBlob::SurfTypes(const mfxSurfaceTypesSupported *src) {
+    if (!Root(src))
+        return false;
+
+    size_t arr, arr2;
+    mfxU32 numSurfTypes = At<mfxSurfaceTypesSupported>(0)->NumSurfaceTypes;
+    if (!Array<SurfType>(offsetof(mfxSurfaceTypesSupported, SurfaceTypes), numSurfTypes, arr))
+        return false;
+
+    for (mfxU32 i = 0; i < numSurfTypes; i++) {
+        size_t typeOff  = arr + i * sizeof(SurfType);
+        mfxU32 numComps = At<SurfType>(typeOff)->NumSurfaceComponents;
+        if (!Array<SurfComp>(typeOff + offsetof(SurfType, SurfaceComponents), numComps, arr2))
+            return false;
+    }
+
+    return true;
+}
+#endif
+
+// pack (src != null) or unpack (src == null) descriptor number idx of one implementation
+static bool ProcessDesc(CapsBlob &blob, mfxU32 idx, mfxHDL src) {
+    switch (idx) {
+        case 0:
+            return blob.ImplDesc(reinterpret_cast<mfxImplDescription *>(src));
+        case 1:
+            return blob.ImplFuncs(reinterpret_cast<mfxImplementedFunctions *>(src));
+        case 2:
+            return blob.ExtDeviceID(reinterpret_cast<mfxExtendedDeviceId *>(src));
+#ifdef ONEVPL_EXPERIMENTAL
+        case 3:
+            return blob.SurfTypes(reinterpret_cast<mfxSurfaceTypesSupported *>(src));
+#endif
+        default:
+            return false;
+    }
+}
+
+static mfxHDL *GetDescHandle(CachedImplCaps &implCaps, mfxU32 idx) {
+    switch (idx) {
+        case 0:
+            return &implCaps.implDesc;
+        case 1:
+            return &implCaps.implFuncs;
+        case 2:
+            return &implCaps.implExtDeviceID;
+#ifdef ONEVPL_EXPERIMENTAL
+        case 3:
+            return &implCaps.implSurfTypes;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+CapsCacheVPL::CapsCacheVPL() : m_bEnabled(false), m_cacheDir() {}
+
+CapsCacheVPL::~CapsCacheVPL() {}
+
+#if defined(_WIN32) || defined(_WIN64)
+
+// not supported on Windows
+mfxStatus CapsCacheVPL::Init() {
+    return MFX_ERR_UNSUPPORTED;
+}
+
+mfxStatus CapsCacheVPL::Init(const std::string & /*cacheDir*/) {
+    return MFX_ERR_UNSUPPORTED;
+}
+
+CachedLibCaps *CapsCacheVPL::Load(const STRING_TYPE & /*libNameFull*/) {
+    return nullptr;
+}
+
+mfxStatus CapsCacheVPL::Store(const STRING_TYPE & /*libNameFull*/,
+                              mfxU32 /*exportMask*/,
+                              const std::vector<CachedImplCaps> & /*implCaps*/) {
+    return MFX_ERR_UNSUPPORTED;
+}
+
+std::string CapsCacheVPL::GetCacheFileName(const STRING_TYPE & /*libNameFull*/) {
+    return "";
+}
+
+#else
+
+static bool GetFileKey(const std::string &libNameFull, CapsCacheHeader *header) {
+    struct stat st = {};
+    if (stat(libNameFull.c_str(), &st) != 0)
+        return false;
+
+    header->dev       = (mfxU64)st.st_dev;
+    header->ino       = (mfxU64)st.st_ino;
+    header->size      = (mfxU64)st.st_size;
+    header->mtimeSec  = (mfxU64)st.st_mtim.tv_sec;
+    header->mtimeNsec = (mfxU64)st.st_mtim.tv_nsec;
+
+    return true;
+}
+
+static void InitHeader(CapsCacheHeader *header) {
+    memset(header, 0, sizeof(CapsCacheHeader));
+
+    header->magic         = CAPS_CACHE_MAGIC;
+    header->formatVersion = CAPS_CACHE_FORMAT_VERSION;
+    header->apiVersion    = MFX_VERSION;
+    header->ptrSize       = sizeof(void *);
+    header->numDesc       = CAPS_CACHE_NUM_DESC;
+    strncpy(header->dispatcherVersion,
+            DISPATCHER_VERSION_STR,
+            sizeof(header->dispatcherVersion) - 1);
+}
+
+mfxStatus CapsCacheVPL::Init() {
+    m_bEnabled = false;
+
+    if (!IsEnvOn("ONEVPL_CAPS_CACHE"))
+        return MFX_ERR_UNSUPPORTED;
+
+    // per XDG base directory spec, fall back to $HOME/.cache
+    std::string cacheHome;
+    if (!GetEnvVar("XDG_CACHE_HOME", cacheHome) || cacheHome[0] != '/') {
+        if (!GetEnvVar("HOME", cacheHome) || cacheHome[0] != '/')
+            return MFX_ERR_UNSUPPORTED;
+
+        cacheHome += "/.cache";
+        mkdir(cacheHome.c_str(), 0700);
+    }
+
+    return Init(cacheHome + "/vpl");
+}
+
+// enable cache in the given directory, which is created if needed
+mfxStatus CapsCacheVPL::Init(const std::string &cacheDir) {
+    m_bEnabled = false;
+
+    m_cacheDir = cacheDir;
+    mkdir(m_cacheDir.c_str(), 0700);
+
+    struct stat st = {};
+    if (stat(m_cacheDir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+        return MFX_ERR_UNSUPPORTED;
+
+    m_bEnabled = true;
+
+    return MFX_ERR_NONE;
+}
+
+// one file per library, name is based on a hash of the full path
+// (full path is also stored in the file and checked on load)
+std::string CapsCacheVPL::GetCacheFileName(const STRING_TYPE &libNameFull) {
+    // 64-bit FNV-1a
+    mfxU64 hash = 0xcbf29ce484222325ULL;
+    for (char c : libNameFull) {
+        hash ^= (mfxU8)c;
+        hash *= 0x100000001b3ULL;
+    }
+
+    char hashStr[32] = "";
+    snprintf(hashStr, sizeof(hashStr), "%016llx", (unsigned long long)hash);
+
+    return m_cacheDir + "/caps-" + hashStr + ".bin";
+}
+
+CachedLibCaps *CapsCacheVPL::Load(const STRING_TYPE &libNameFull) {
+    if (!m_bEnabled)
+        return nullptr;
+
+    CapsCacheHeader key;
+    InitHeader(&key);
+    if (!GetFileKey(libNameFull, &key))
+        return nullptr;
+
+    std::ifstream cacheFile(GetCacheFileName(libNameFull), std::ios::binary | std::ios::ate);
+    if (!cacheFile.is_open())
+        return nullptr;
+
+    std::streamoff fileSize = cacheFile.tellg();
+    if (fileSize < (std::streamoff)sizeof(CapsCacheHeader))
+        return nullptr;
+
+    std::unique_ptr<CachedLibCaps> libCaps(new (std::nothrow) CachedLibCaps);
+    if (!libCaps)
+        return nullptr;
+
+    // single allocation for the whole file, descriptors are restored in place
+    try {
+        libCaps->buf.resize(AlignSize((size_t)fileSize) / sizeof(mfxU64));
+    }
+    catch (...) {
+        return nullptr;
+    }
+
+    mfxU8 *base = reinterpret_cast<mfxU8 *>(libCaps->buf.data());
+    size_t size = (size_t)fileSize;
+
+    cacheFile.seekg(0);
+    if (!cacheFile.read(reinterpret_cast<char *>(base), fileSize))
+        return nullptr;
+
+    // entry is stale if anything in the key changed
+    CapsCacheHeader header;
+    memcpy(&header, base, sizeof(CapsCacheHeader));
+    if (header.magic != key.magic || header.formatVersion != key.formatVersion ||
+        header.apiVersion != key.apiVersion || header.ptrSize != key.ptrSize ||
+        header.numDesc != key.numDesc ||
+        memcmp(header.dispatcherVersion, key.dispatcherVersion, sizeof(key.dispatcherVersion)) ||
+        header.dev != key.dev || header.ino != key.ino || header.size != key.size ||
+        header.mtimeSec != key.mtimeSec || header.mtimeNsec != key.mtimeNsec ||
+        header.numImpls == 0) {
+        return nullptr;
+    }
+
+    size_t off = sizeof(CapsCacheHeader);
+    if (header.pathLen != libNameFull.size() || header.pathLen > size - off ||
+        memcmp(base + off, libNameFull.c_str(), header.pathLen))
+        return nullptr;
+    off += AlignSize(header.pathLen);
+
+    libCaps->exportMask = header.exportMask;
+
+    for (mfxU32 i = 0; i < header.numImpls; i++) {
+        mfxU64 blobSize[CAPS_CACHE_NUM_DESC] = {};
+        if (off > size || size - off < sizeof(blobSize))
+            return nullptr;
+        memcpy(blobSize, base + off, sizeof(blobSize));
+        off += sizeof(blobSize);
+
+        CachedImplCaps implCaps = {};
+        for (mfxU32 j = 0; j < CAPS_CACHE_NUM_DESC; j++) {
+            if (blobSize[j] == 0)
+                continue;
+
+            if (off > size || blobSize[j] > size - off)
+                return nullptr;
+
+            CapsBlob blob(base + off, (size_t)blobSize[j]);
+            if (!ProcessDesc(blob, j, nullptr))
+                return nullptr;
+
+            *GetDescHandle(implCaps, j) = base + off;
+            off += AlignSize((size_t)blobSize[j]);
+        }
+
+        // description is required for each implementation
+        if (!implCaps.implDesc)
+            return nullptr;
+
+        libCaps->implCaps.push_back(implCaps);
+    }
+
+    return libCaps.release();
+}
+
+mfxStatus CapsCacheVPL::Store(const STRING_TYPE &libNameFull,
+                              mfxU32 exportMask,
+                              const std::vector<CachedImplCaps> &implCaps) {
+    if (!m_bEnabled)
+        return MFX_ERR_UNSUPPORTED;
+
+    if (implCaps.empty())
+        return MFX_ERR_UNSUPPORTED;
+
+    CapsCacheHeader header;
+    InitHeader(&header);
+    if (!GetFileKey(libNameFull, &header))
+        return MFX_ERR_UNSUPPORTED;
+
+    header.pathLen    = (mfxU32)libNameFull.size();
+    header.exportMask = exportMask;
+    header.numImpls   = (mfxU32)implCaps.size();
+
+    std::vector<mfxU8> fileBuf;
+    try {
+        fileBuf.insert(fileBuf.end(), (mfxU8 *)&header, (mfxU8 *)&header + sizeof(header));
+        fileBuf.insert(fileBuf.end(), libNameFull.begin(), libNameFull.end());
+        fileBuf.resize(AlignSize(fileBuf.size()), 0);
+
+        for (auto caps : implCaps) {
+            mfxU64 blobSize[CAPS_CACHE_NUM_DESC] = {};
+            CapsBlob blob[CAPS_CACHE_NUM_DESC];
+
+            for (mfxU32 j = 0; j < CAPS_CACHE_NUM_DESC; j++) {
+                mfxHDL src = *GetDescHandle(caps, j);
+                if (!src)
+                    continue;
+
+                // implementation description is required, others are optional
+                if (!ProcessDesc(blob[j], j, src)) {
+                    if (j == 0)
+                        return MFX_ERR_UNSUPPORTED;
+                    continue;
+                }
+
+                blobSize[j] = blob[j].GetBuf().size();
+            }
+
+            fileBuf.insert(fileBuf.end(), (mfxU8 *)blobSize, (mfxU8 *)blobSize + sizeof(blobSize));
+            for (mfxU32 j = 0; j < CAPS_CACHE_NUM_DESC; j++) {
+                if (blobSize[j])
+                    fileBuf.insert(fileBuf.end(), blob[j].GetBuf().begin(), blob[j].GetBuf().end());
+            }
+        }
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    // write to temporary file and rename, so readers never see a partial entry
+    std::string fileName = GetCacheFileName(libNameFull);
+    std::string tmpName  = fileName + "." + std::to_string(getpid()) + ".tmp";
+
+    std::ofstream cacheFile(tmpName, std::ios::binary | std::ios::trunc);
+    if (!cacheFile.is_open())
+        return MFX_ERR_UNSUPPORTED;
+
+    cacheFile.write(reinterpret_cast<const char *>(fileBuf.data()), fileBuf.size());
+    cacheFile.close();
+
+    if (cacheFile.fail() || rename(tmpName.c_str(), fileName.c_str()) != 0) {
+        remove(tmpName.c_str());
+        return MFX_ERR_UNSUPPORTED;
+    }
+
+    return MFX_ERR_NONE;
+}
+
+#endif
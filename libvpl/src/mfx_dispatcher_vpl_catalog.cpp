@@ -0,0 +1,124 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include <mutex>
+
+#include "src/mfx_dispatcher_vpl.h"
+
+// Intel® VPL shared runtime catalog (enabled with ONEVPL_SHARED_CATALOG=ON)
+//
+// The first loader which needs the list of implementations runs the full
+//   search, load, and caps query as usual, then publishes the resulting
+//   LibInfo/ImplInfo lists (including library handles and caps descriptors)
+//   as a process-wide catalog.
+// Later loaders attach to the catalog instead of repeating the search.
+//   Each loader keeps its own copy of every ImplInfo, so filter state,
+//   valid index, and session parameters are not shared.
+// The catalog is built without any loader's filters, so that caps do not
+//   depend on which loader created it.
+// The catalog is immutable once published, and is released (libraries
+//   unloaded) when the last attached loader is unloaded.
+
+static std::mutex g_catalogMutex;
+static CatalogVPL *g_catalog = nullptr;
+
+mfxStatus LoaderCtxVPL::InitSharedCatalog() {
+    if (!IsEnvOn("ONEVPL_SHARED_CATALOG"))
+        return MFX_ERR_UNSUPPORTED;
+
+    m_bSharedCatalog = true;
+
+    return MFX_ERR_NONE;
+}
+
+// attach to process-wide catalog, creating it if this is the first loader
+mfxStatus LoaderCtxVPL::AttachCatalog() {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    // other loaders wait here while the catalog is being built, so the
+    //   search and query only run once
+    std::lock_guard<std::mutex> lock(g_catalogMutex);
+
+    if (!g_catalog) {
+        CatalogVPL *catalog = new (std::nothrow) CatalogVPL;
+        if (!catalog)
+            return MFX_ERR_MEMORY_ALLOC;
+
+        mfxStatus sts = FullLoadAndQuery();
+        if (sts != MFX_ERR_NONE) {
+            delete catalog;
+            return sts;
+        }
+
+        // catalog takes ownership of libraries and caps descriptors
+        catalog->libInfoList.swap(m_libInfoList);
+        catalog->implInfoList.swap(m_implInfoList);
+        catalog->bPriorityPathEnabled = m_bPriorityPathEnabled;
+
+        g_catalog = catalog;
+
+        DISP_LOG_MESSAGE(&m_dispLog, "message:  shared catalog created");
+    }
+    else {
+        DISP_LOG_MESSAGE(&m_dispLog, "message:  shared catalog attached");
+    }
+
+    // make a private copy of each implementation for this loader
+    for (auto catalogImplInfo : g_catalog->implInfoList) {
+        ImplInfo *implInfo = new (std::nothrow) ImplInfo(*catalogImplInfo);
+        if (!implInfo) {
+            for (auto implInfoCopy : m_implInfoList)
+                delete implInfoCopy;
+            m_implInfoList.clear();
+
+            return MFX_ERR_MEMORY_ALLOC;
+        }
+
+        m_implInfoList.push_back(implInfo);
+    }
+
+    g_catalog->refCount++;
+    m_catalog = g_catalog;
+
+    m_bPriorityPathEnabled  = m_catalog->bPriorityPathEnabled;
+    m_bNeedFullQuery        = false;
+    m_bNeedUpdateValidImpls = true;
+
+    return MFX_ERR_NONE;
+}
+
+// detach from process-wide catalog, releasing it if this is the last loader
+mfxStatus LoaderCtxVPL::DetachCatalog() {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    if (!m_catalog)
+        return MFX_ERR_NONE;
+
+    // private copies do not own any caps descriptors
+    for (auto implInfo : m_implInfoList)
+        delete implInfo;
+    m_implInfoList.clear();
+
+    std::lock_guard<std::mutex> lock(g_catalogMutex);
+
+    m_catalog->refCount--;
+    if (m_catalog->refCount == 0) {
+        for (auto implInfo : m_catalog->implInfoList)
+            UnloadSingleImplementation(implInfo);
+
+        for (auto libInfo : m_catalog->libInfoList)
+            UnloadSingleLibrary(libInfo);
+
+        delete m_catalog;
+        g_catalog = nullptr;
+
+        DISP_LOG_MESSAGE(&m_dispLog, "message:  shared catalog released");
+    }
+
+    m_catalog = nullptr;
+
+    return MFX_ERR_NONE;
+}
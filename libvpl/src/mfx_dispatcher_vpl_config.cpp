@@ -7,15 +7,23 @@
 #include "src/mfx_dispatcher_vpl.h"
 
 #include <assert.h>
+#include <string.h>
 
+#include <atomic>
 #include <regex>
 
+// config IDs are never reused, see ConfigResultVPL
+static std::atomic<mfxU64> g_nextConfigId(1);
+
 // implementation of config context (mfxConfig)
 // each loader instance can have one or more configs
 //   associated with it - used for filtering implementations
 //   based on what they support (codec types, etc.)
 ConfigCtxVPL::ConfigCtxVPL()
         : m_propVar(),
+          m_altList(),
+          m_altGeneration(0),
+          m_filterOps(),
           m_propRange32U(),
           m_implName(),
           m_implLicense(),
@@ -25,6 +33,12 @@ ConfigCtxVPL::ConfigCtxVPL()
           m_extDevLUID8U(),
           m_extDevNameStr(),
           m_extBuf() {
+    m_configId = g_nextConfigId++;
+
+    // memoized results start with generation 0, so all groups are checked the first time
+    for (mfxU32 group = 0; group < NUM_PROP_GROUPS; group++)
+        m_groupGeneration[group] = 1;
+
     // initially set Type = unset (invalid)
     // if valid property string and value are passed in,
     //   this will be updated
@@ -36,10 +50,14 @@ ConfigCtxVPL::ConfigCtxVPL()
     }
 
     m_parentLoader = nullptr;
+    m_parentConfig = nullptr;
     return;
 }
 
 ConfigCtxVPL::~ConfigCtxVPL() {
+    for (ConfigCtxVPL *altConfig : m_altList)
+        delete altConfig;
+
     return;
 }
 
@@ -48,180 +66,316 @@ struct PropVariant {
     mfxVariantType Type;
 };
 
+// leave table formatting alone
+// clang-format off
+
+// all filter properties: index (PropIdx) and variant type
+// PropIdx and PropIdxTab are both generated from this list, so they cannot be misaligned
+#define FILTER_PROP_LIST(PROP)                                     \
+    /* settable config properties for mfxImplDescription */        \
+    PROP(ePropMain_Impl,                     MFX_VARIANT_TYPE_U32) \
+    PROP(ePropMain_AccelerationMode,         MFX_VARIANT_TYPE_U32) \
+    PROP(ePropMain_ApiVersion,               MFX_VARIANT_TYPE_U32) \
+    PROP(ePropMain_ApiVersion_Major,         MFX_VARIANT_TYPE_U16) \
+    PROP(ePropMain_ApiVersion_Minor,         MFX_VARIANT_TYPE_U16) \
+    PROP(ePropMain_ImplName,                 MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropMain_License,                  MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropMain_Keywords,                 MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropMain_VendorID,                 MFX_VARIANT_TYPE_U32) \
+    PROP(ePropMain_VendorImplID,             MFX_VARIANT_TYPE_U32) \
+    PROP(ePropMain_PoolAllocationPolicy,     MFX_VARIANT_TYPE_U32) \
+                                                                   \
+    /* settable config properties for mfxDeviceDescription */      \
+    PROP(ePropDevice_DeviceID,               MFX_VARIANT_TYPE_U16) \
+    PROP(ePropDevice_DeviceIDStr,            MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropDevice_MediaAdapterType,       MFX_VARIANT_TYPE_U16) \
+                                                                   \
+    /* settable config properties for mfxDecoderDescription */     \
+    PROP(ePropDec_CodecID,                   MFX_VARIANT_TYPE_U32) \
+    PROP(ePropDec_MaxcodecLevel,             MFX_VARIANT_TYPE_U16) \
+    PROP(ePropDec_Profile,                   MFX_VARIANT_TYPE_U32) \
+    PROP(ePropDec_MemHandleType,             MFX_VARIANT_TYPE_U32) \
+    PROP(ePropDec_Width,                     MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropDec_Height,                    MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropDec_ColorFormats,              MFX_VARIANT_TYPE_U32) \
+                                                                   \
+    /* settable config properties for mfxEncoderDescription */     \
+    PROP(ePropEnc_CodecID,                   MFX_VARIANT_TYPE_U32) \
+    PROP(ePropEnc_MaxcodecLevel,             MFX_VARIANT_TYPE_U16) \
+    PROP(ePropEnc_BiDirectionalPrediction,   MFX_VARIANT_TYPE_U16) \
+    PROP(ePropEnc_ReportedStats,             MFX_VARIANT_TYPE_U16) \
+    PROP(ePropEnc_Profile,                   MFX_VARIANT_TYPE_U32) \
+    PROP(ePropEnc_MemHandleType,             MFX_VARIANT_TYPE_U32) \
+    PROP(ePropEnc_Width,                     MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropEnc_Height,                    MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropEnc_ColorFormats,              MFX_VARIANT_TYPE_U32) \
+                                                                   \
+    /* settable config properties for mfxVPPDescription */         \
+    PROP(ePropVPP_FilterFourCC,              MFX_VARIANT_TYPE_U32) \
+    PROP(ePropVPP_MaxDelayInFrames,          MFX_VARIANT_TYPE_U16) \
+    PROP(ePropVPP_MemHandleType,             MFX_VARIANT_TYPE_U32) \
+    PROP(ePropVPP_Width,                     MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropVPP_Height,                    MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropVPP_InFormat,                  MFX_VARIANT_TYPE_U32) \
+    PROP(ePropVPP_OutFormat,                 MFX_VARIANT_TYPE_U32) \
+                                                                   \
+    /* settable config properties for mfxExtendedDeviceId */       \
+    PROP(ePropExtDev_VendorID,               MFX_VARIANT_TYPE_U16) \
+    PROP(ePropExtDev_DeviceID,               MFX_VARIANT_TYPE_U16) \
+    PROP(ePropExtDev_PCIDomain,              MFX_VARIANT_TYPE_U32) \
+    PROP(ePropExtDev_PCIBus,                 MFX_VARIANT_TYPE_U32) \
+    PROP(ePropExtDev_PCIDevice,              MFX_VARIANT_TYPE_U32) \
+    PROP(ePropExtDev_PCIFunction,            MFX_VARIANT_TYPE_U32) \
+    PROP(ePropExtDev_DeviceLUID,             MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropExtDev_LUIDDeviceNodeMask,     MFX_VARIANT_TYPE_U32) \
+    PROP(ePropExtDev_DRMRenderNodeNum,       MFX_VARIANT_TYPE_U32) \
+    PROP(ePropExtDev_DRMPrimaryNodeNum,      MFX_VARIANT_TYPE_U32) \
+    PROP(ePropExtDev_RevisionID,             MFX_VARIANT_TYPE_U16) \
+    PROP(ePropExtDev_DeviceName,             MFX_VARIANT_TYPE_PTR) \
+                                                                   \
+    /* settable config properties for mfxSurfaceTypesSupported */  \
+    PROP(ePropSurface_SurfaceType,           MFX_VARIANT_TYPE_U32) \
+    PROP(ePropSurface_SurfaceComponent,      MFX_VARIANT_TYPE_U32) \
+    PROP(ePropSurface_SurfaceFlags,          MFX_VARIANT_TYPE_U32) \
+                                                                   \
+    /* special properties not part of description struct */        \
+    PROP(ePropSpecial_HandleType,            MFX_VARIANT_TYPE_U32) \
+    PROP(ePropSpecial_Handle,                MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropSpecial_NumThread,             MFX_VARIANT_TYPE_U32) \
+    PROP(ePropSpecial_DeviceCopy,            MFX_VARIANT_TYPE_U16) \
+    PROP(ePropSpecial_ExtBuffer,             MFX_VARIANT_TYPE_PTR) \
+    PROP(ePropSpecial_DXGIAdapterIndex,      MFX_VARIANT_TYPE_U32) \
+    PROP(ePropSpecial_SessionProfile,        MFX_VARIANT_TYPE_U16) \
+                                                                   \
+    /* functions which must report as implemented */               \
+    PROP(ePropFunc_FunctionName,             MFX_VARIANT_TYPE_PTR)
+
+// property names accepted by MFXSetConfigFilterProperty(), with the index and the public ID
+//   used by MFXSetConfigFilterPropertyById()
+// ALIAS entries are other spellings of the same property, and have no ID of their own
+#define PROP_NAME_DEC "mfxImplDescription.mfxDecoderDescription.decoder."
+#define PROP_NAME_ENC "mfxImplDescription.mfxEncoderDescription.encoder."
+#define PROP_NAME_VPP "mfxImplDescription.mfxVPPDescription.filter."
+#define PROP_NAME_DEV "mfxImplDescription.mfxDeviceDescription."
+
+#define FILTER_PROP_NAMES(NAME, ALIAS)                                                    \
+    NAME("mfxImplDescription.Impl",                     ePropMain_Impl,                   \
+         MFX_FILTER_PROP_IMPL)                                                            \
+    NAME("mfxImplDescription.AccelerationMode",         ePropMain_AccelerationMode,       \
+         MFX_FILTER_PROP_ACCELERATION_MODE)                                               \
+    NAME("mfxImplDescription.ApiVersion.Version",       ePropMain_ApiVersion,             \
+         MFX_FILTER_PROP_API_VERSION)                                                     \
+    NAME("mfxImplDescription.ApiVersion.Major",         ePropMain_ApiVersion_Major,       \
+         MFX_FILTER_PROP_API_VERSION_MAJOR)                                               \
+    NAME("mfxImplDescription.ApiVersion.Minor",         ePropMain_ApiVersion_Minor,       \
+         MFX_FILTER_PROP_API_VERSION_MINOR)                                               \
+    NAME("mfxImplDescription.ImplName",                 ePropMain_ImplName,               \
+         MFX_FILTER_PROP_IMPL_NAME)                                                       \
+    NAME("mfxImplDescription.License",                  ePropMain_License,                \
+         MFX_FILTER_PROP_LICENSE)                                                         \
+    NAME("mfxImplDescription.Keywords",                 ePropMain_Keywords,               \
+         MFX_FILTER_PROP_KEYWORDS)                                                        \
+    NAME("mfxImplDescription.VendorID",                 ePropMain_VendorID,               \
+         MFX_FILTER_PROP_VENDOR_ID)                                                       \
+    NAME("mfxImplDescription.VendorImplID",             ePropMain_VendorImplID,           \
+         MFX_FILTER_PROP_VENDOR_IMPL_ID)                                                  \
+    NAME("mfxImplDescription.mfxSurfacePoolMode",       ePropMain_PoolAllocationPolicy,   \
+         MFX_FILTER_PROP_SURFACE_POOL_MODE)                                               \
+                                                                                          \
+    /* DeviceID may also be passed as a string, see ValidateAndSetProp() */               \
+    NAME(PROP_NAME_DEV "device.DeviceID",               ePropDevice_DeviceID,             \
+         MFX_FILTER_PROP_DEVICE_ID)                                                       \
+    NAME(PROP_NAME_DEV "device.MediaAdapterType",       ePropDevice_MediaAdapterType,     \
+         MFX_FILTER_PROP_MEDIA_ADAPTER_TYPE)                                              \
+    /* old version of table in spec did not have "device" */                              \
+    ALIAS(PROP_NAME_DEV "DeviceID",                     ePropDevice_DeviceID)             \
+    ALIAS(PROP_NAME_DEV "MediaAdapterType",             ePropDevice_MediaAdapterType)     \
+                                                                                          \
+    NAME(PROP_NAME_DEC "CodecID",                       ePropDec_CodecID,                 \
+         MFX_FILTER_PROP_DEC_CODEC_ID)                                                    \
+    NAME(PROP_NAME_DEC "MaxcodecLevel",                 ePropDec_MaxcodecLevel,           \
+         MFX_FILTER_PROP_DEC_MAX_CODEC_LEVEL)                                             \
+    NAME(PROP_NAME_DEC "decprofile.Profile",            ePropDec_Profile,                 \
+         MFX_FILTER_PROP_DEC_PROFILE)                                                     \
+    NAME(PROP_NAME_DEC "decprofile.decmemdesc.MemHandleType", ePropDec_MemHandleType,     \
+         MFX_FILTER_PROP_DEC_MEM_HANDLE_TYPE)                                             \
+    NAME(PROP_NAME_DEC "decprofile.decmemdesc.Width",   ePropDec_Width,                   \
+         MFX_FILTER_PROP_DEC_WIDTH)                                                       \
+    NAME(PROP_NAME_DEC "decprofile.decmemdesc.Height",  ePropDec_Height,                  \
+         MFX_FILTER_PROP_DEC_HEIGHT)                                                      \
+    NAME(PROP_NAME_DEC "decprofile.decmemdesc.ColorFormats", ePropDec_ColorFormats,       \
+         MFX_FILTER_PROP_DEC_COLOR_FORMATS)                                               \
+    ALIAS(PROP_NAME_DEC "decprofile.decmemdesc.ColorFormat", ePropDec_ColorFormats)       \
+                                                                                          \
+    NAME(PROP_NAME_ENC "CodecID",                       ePropEnc_CodecID,                 \
+         MFX_FILTER_PROP_ENC_CODEC_ID)                                                    \
+    NAME(PROP_NAME_ENC "MaxcodecLevel",                 ePropEnc_MaxcodecLevel,           \
+         MFX_FILTER_PROP_ENC_MAX_CODEC_LEVEL)                                             \
+    NAME(PROP_NAME_ENC "BiDirectionalPrediction",       ePropEnc_BiDirectionalPrediction, \
+         MFX_FILTER_PROP_ENC_BIDIRECTIONAL_PREDICTION)                                    \
+    NAME(PROP_NAME_ENC "encprofile.Profile",            ePropEnc_Profile,                 \
+         MFX_FILTER_PROP_ENC_PROFILE)                                                     \
+    NAME(PROP_NAME_ENC "encprofile.encmemdesc.MemHandleType", ePropEnc_MemHandleType,     \
+         MFX_FILTER_PROP_ENC_MEM_HANDLE_TYPE)                                             \
+    NAME(PROP_NAME_ENC "encprofile.encmemdesc.Width",   ePropEnc_Width,                   \
+         MFX_FILTER_PROP_ENC_WIDTH)                                                       \
+    NAME(PROP_NAME_ENC "encprofile.encmemdesc.Height",  ePropEnc_Height,                  \
+         MFX_FILTER_PROP_ENC_HEIGHT)                                                      \
+    NAME(PROP_NAME_ENC "encprofile.encmemdesc.ColorFormats", ePropEnc_ColorFormats,       \
+         MFX_FILTER_PROP_ENC_COLOR_FORMATS)                                               \
+    ALIAS(PROP_NAME_ENC "encprofile.encmemdesc.ColorFormat", ePropEnc_ColorFormats)       \
+                                                                                          \
+    NAME(PROP_NAME_VPP "FilterFourCC",                  ePropVPP_FilterFourCC,            \
+         MFX_FILTER_PROP_VPP_FILTER_FOURCC)                                               \
+    NAME(PROP_NAME_VPP "MaxDelayInFrames",              ePropVPP_MaxDelayInFrames,        \
+         MFX_FILTER_PROP_VPP_MAX_DELAY_IN_FRAMES)                                         \
+    NAME(PROP_NAME_VPP "memdesc.MemHandleType",         ePropVPP_MemHandleType,           \
+         MFX_FILTER_PROP_VPP_MEM_HANDLE_TYPE)                                             \
+    NAME(PROP_NAME_VPP "memdesc.Width",                 ePropVPP_Width,                   \
+         MFX_FILTER_PROP_VPP_WIDTH)                                                       \
+    NAME(PROP_NAME_VPP "memdesc.Height",                ePropVPP_Height,                  \
+         MFX_FILTER_PROP_VPP_HEIGHT)                                                      \
+    NAME(PROP_NAME_VPP "memdesc.format.InFormat",       ePropVPP_InFormat,                \
+         MFX_FILTER_PROP_VPP_IN_FORMAT)                                                   \
+    NAME(PROP_NAME_VPP "memdesc.format.OutFormat",      ePropVPP_OutFormat,               \
+         MFX_FILTER_PROP_VPP_OUT_FORMAT)                                                  \
+    ALIAS(PROP_NAME_VPP "memdesc.format.OutFormats",    ePropVPP_OutFormat)               \
+                                                                                          \
+    NAME("mfxExtendedDeviceId.VendorID",                ePropExtDev_VendorID,             \
+         MFX_FILTER_PROP_EXTDEV_VENDOR_ID)                                                \
+    NAME("mfxExtendedDeviceId.DeviceID",                ePropExtDev_DeviceID,             \
+         MFX_FILTER_PROP_EXTDEV_DEVICE_ID)                                                \
+    NAME("mfxExtendedDeviceId.PCIDomain",               ePropExtDev_PCIDomain,            \
+         MFX_FILTER_PROP_EXTDEV_PCI_DOMAIN)                                               \
+    NAME("mfxExtendedDeviceId.PCIBus",                  ePropExtDev_PCIBus,               \
+         MFX_FILTER_PROP_EXTDEV_PCI_BUS)                                                  \
+    NAME("mfxExtendedDeviceId.PCIDevice",               ePropExtDev_PCIDevice,            \
+         MFX_FILTER_PROP_EXTDEV_PCI_DEVICE)                                               \
+    NAME("mfxExtendedDeviceId.PCIFunction",             ePropExtDev_PCIFunction,          \
+         MFX_FILTER_PROP_EXTDEV_PCI_FUNCTION)                                             \
+    NAME("mfxExtendedDeviceId.DeviceLUID",              ePropExtDev_DeviceLUID,           \
+         MFX_FILTER_PROP_EXTDEV_DEVICE_LUID)                                              \
+    NAME("mfxExtendedDeviceId.LUIDDeviceNodeMask",      ePropExtDev_LUIDDeviceNodeMask,   \
+         MFX_FILTER_PROP_EXTDEV_LUID_DEVICE_NODE_MASK)                                    \
+    NAME("mfxExtendedDeviceId.DRMRenderNodeNum",        ePropExtDev_DRMRenderNodeNum,     \
+         MFX_FILTER_PROP_EXTDEV_DRM_RENDER_NODE_NUM)                                      \
+    NAME("mfxExtendedDeviceId.DRMPrimaryNodeNum",       ePropExtDev_DRMPrimaryNodeNum,    \
+         MFX_FILTER_PROP_EXTDEV_DRM_PRIMARY_NODE_NUM)                                     \
+    NAME("mfxExtendedDeviceId.RevisionID",              ePropExtDev_RevisionID,           \
+         MFX_FILTER_PROP_EXTDEV_REVISION_ID)                                              \
+    NAME("mfxExtendedDeviceId.DeviceName",              ePropExtDev_DeviceName,           \
+         MFX_FILTER_PROP_EXTDEV_DEVICE_NAME)                                              \
+                                                                                          \
+    NAME("mfxHandleType",                               ePropSpecial_HandleType,          \
+         MFX_FILTER_PROP_HANDLE_TYPE)                                                     \
+    NAME("mfxHDL",                                      ePropSpecial_Handle,              \
+         MFX_FILTER_PROP_HANDLE)                                                          \
+    NAME("NumThread",                                   ePropSpecial_NumThread,           \
+         MFX_FILTER_PROP_NUM_THREAD)                                                      \
+    NAME("ExtBuffer",                                   ePropSpecial_ExtBuffer,           \
+         MFX_FILTER_PROP_EXT_BUFFER)                                                      \
+                                                                                          \
+    NAME("mfxImplementedFunctions.FunctionsName",       ePropFunc_FunctionName,           \
+         MFX_FILTER_PROP_FUNCTION_NAME)
+
+// only available with the experimental API
+#define FILTER_PROP_NAMES_EXPERIMENTAL(NAME, ALIAS)                                 \
+    NAME(PROP_NAME_ENC "ReportedStats",                 ePropEnc_ReportedStats,     \
+         MFX_FILTER_PROP_ENC_REPORTED_STATS)                                        \
+    NAME("mfxSurfaceTypesSupported.surftype.SurfaceType", ePropSurface_SurfaceType, \
+         MFX_FILTER_PROP_SURFACE_TYPE)                                              \
+    NAME("mfxSurfaceTypesSupported.surftype.surfcomp.SurfaceComponent",             \
+         ePropSurface_SurfaceComponent,                                             \
+         MFX_FILTER_PROP_SURFACE_COMPONENT)                                         \
+    NAME("mfxSurfaceTypesSupported.surftype.surfcomp.SurfaceFlags",                 \
+         ePropSurface_SurfaceFlags,                                                 \
+         MFX_FILTER_PROP_SURFACE_FLAGS)                                             \
+    NAME("DeviceCopy",                                  ePropSpecial_DeviceCopy,    \
+         MFX_FILTER_PROP_DEVICE_COPY)                                               \
+    NAME("SessionProfile",                              ePropSpecial_SessionProfile, \
+         MFX_FILTER_PROP_SESSION_PROFILE)
+
+// this property is only valid on Windows
+#define FILTER_PROP_NAMES_WINDOWS(NAME, ALIAS)                                         \
+    NAME("DXGIAdapterIndex",                            ePropSpecial_DXGIAdapterIndex, \
+         MFX_FILTER_PROP_DXGI_ADAPTER_INDEX)
+
+// end table formatting
+// clang-format on
+
 enum PropIdx {
-    // settable config properties for mfxImplDescription
-    ePropMain_Impl = 0,
-    ePropMain_AccelerationMode,
-    ePropMain_ApiVersion,
-    ePropMain_ApiVersion_Major,
-    ePropMain_ApiVersion_Minor,
-    ePropMain_ImplName,
-    ePropMain_License,
-    ePropMain_Keywords,
-    ePropMain_VendorID,
-    ePropMain_VendorImplID,
-    ePropMain_PoolAllocationPolicy,
-
-    // settable config properties for mfxDeviceDescription
-    ePropDevice_DeviceID,
-    ePropDevice_DeviceIDStr,
-    ePropDevice_MediaAdapterType,
-
-    // settable config properties for mfxDecoderDescription
-    ePropDec_CodecID,
-    ePropDec_MaxcodecLevel,
-    ePropDec_Profile,
-    ePropDec_MemHandleType,
-    ePropDec_Width,
-    ePropDec_Height,
-    ePropDec_ColorFormats,
-
-    // settable config properties for mfxEncoderDescription
-    ePropEnc_CodecID,
-    ePropEnc_MaxcodecLevel,
-    ePropEnc_BiDirectionalPrediction,
-    ePropEnc_ReportedStats,
-    ePropEnc_Profile,
-    ePropEnc_MemHandleType,
-    ePropEnc_Width,
-    ePropEnc_Height,
-    ePropEnc_ColorFormats,
-
-    // settable config properties for mfxVPPDescription
-    ePropVPP_FilterFourCC,
-    ePropVPP_MaxDelayInFrames,
-    ePropVPP_MemHandleType,
-    ePropVPP_Width,
-    ePropVPP_Height,
-    ePropVPP_InFormat,
-    ePropVPP_OutFormat,
-
-    // settable config properties for mfxExtendedDeviceId
-    ePropExtDev_VendorID,
-    ePropExtDev_DeviceID,
-    ePropExtDev_PCIDomain,
-    ePropExtDev_PCIBus,
-    ePropExtDev_PCIDevice,
-    ePropExtDev_PCIFunction,
-    ePropExtDev_DeviceLUID,
-    ePropExtDev_LUIDDeviceNodeMask,
-    ePropExtDev_DRMRenderNodeNum,
-    ePropExtDev_DRMPrimaryNodeNum,
-    ePropExtDev_RevisionID,
-    ePropExtDev_DeviceName,
-
-    // settable config properties for mfxSurfaceTypesSupported
-    ePropSurface_SurfaceType,
-    ePropSurface_SurfaceComponent,
-    ePropSurface_SurfaceFlags,
-
-    // special properties not part of description struct
-    ePropSpecial_HandleType,
-    ePropSpecial_Handle,
-    ePropSpecial_NumThread,
-    ePropSpecial_DeviceCopy,
-    ePropSpecial_ExtBuffer,
-    ePropSpecial_DXGIAdapterIndex,
-
-    // functions which must report as implemented
-    ePropFunc_FunctionName,
+#define PROP_IDX(idx, type) idx,
+    FILTER_PROP_LIST(PROP_IDX)
+#undef PROP_IDX
 
     // number of entries (always last)
     eProp_TotalProps
 };
 
-// leave table formatting alone
-// clang-format off
-
-// order must align exactly with PropIdx list
-// to avoid mismatches, this should be automated (e.g. pre-processor step)
 static const PropVariant PropIdxTab[] = {
-    { "ePropMain_Impl",                     MFX_VARIANT_TYPE_U32 },
-    { "ePropMain_AccelerationMode",         MFX_VARIANT_TYPE_U32 },
-    { "ePropMain_ApiVersion",               MFX_VARIANT_TYPE_U32 },
-    { "ePropMain_ApiVersion_Major",         MFX_VARIANT_TYPE_U16 },
-    { "ePropMain_ApiVersion_Minor",         MFX_VARIANT_TYPE_U16 },
-    { "ePropMain_ImplName",                 MFX_VARIANT_TYPE_PTR },
-    { "ePropMain_License",                  MFX_VARIANT_TYPE_PTR },
-    { "ePropMain_Keywords",                 MFX_VARIANT_TYPE_PTR },
-    { "ePropMain_VendorID",                 MFX_VARIANT_TYPE_U32 },
-    { "ePropMain_VendorImplID",             MFX_VARIANT_TYPE_U32 },
-    { "ePropMain_PoolAllocationPolicy",     MFX_VARIANT_TYPE_U32 },
-
-    { "ePropDevice_DeviceID",               MFX_VARIANT_TYPE_U16 },
-    { "ePropDevice_DeviceIDStr",            MFX_VARIANT_TYPE_PTR },
-    { "ePropDevice_MediaAdapterType",       MFX_VARIANT_TYPE_U16 },
-
-    { "ePropDec_CodecID",                   MFX_VARIANT_TYPE_U32 },
-    { "ePropDec_MaxcodecLevel",             MFX_VARIANT_TYPE_U16 },
-    { "ePropDec_Profile",                   MFX_VARIANT_TYPE_U32 },
-    { "ePropDec_MemHandleType",             MFX_VARIANT_TYPE_U32 },
-    { "ePropDec_Width",                     MFX_VARIANT_TYPE_PTR },
-    { "ePropDec_Height",                    MFX_VARIANT_TYPE_PTR },
-    { "ePropDec_ColorFormats",              MFX_VARIANT_TYPE_U32 },
-
-    { "ePropEnc_CodecID",                   MFX_VARIANT_TYPE_U32 },
-    { "ePropEnc_MaxcodecLevel",             MFX_VARIANT_TYPE_U16 },
-    { "ePropEnc_BiDirectionalPrediction",   MFX_VARIANT_TYPE_U16 },
-    { "ePropEnc_ReportedStats",             MFX_VARIANT_TYPE_U16 },
-    { "ePropEnc_Profile",                   MFX_VARIANT_TYPE_U32 },
-    { "ePropEnc_MemHandleType",             MFX_VARIANT_TYPE_U32 },
-    { "ePropEnc_Width",                     MFX_VARIANT_TYPE_PTR },
-    { "ePropEnc_Height",                    MFX_VARIANT_TYPE_PTR },
-    { "ePropEnc_ColorFormats",              MFX_VARIANT_TYPE_U32 },
-
-    { "ePropVPP_FilterFourCC",              MFX_VARIANT_TYPE_U32 },
-    { "ePropVPP_MaxDelayInFrames",          MFX_VARIANT_TYPE_U16 },
-    { "ePropVPP_MemHandleType",             MFX_VARIANT_TYPE_U32 },
-    { "ePropVPP_Width",                     MFX_VARIANT_TYPE_PTR },
-    { "ePropVPP_Height",                    MFX_VARIANT_TYPE_PTR },
-    { "ePropVPP_InFormat",                  MFX_VARIANT_TYPE_U32 },
-    { "ePropVPP_OutFormat",                 MFX_VARIANT_TYPE_U32 },
-
-    { "ePropExtDev_VendorID",               MFX_VARIANT_TYPE_U16 },
-    { "ePropExtDev_DeviceID",               MFX_VARIANT_TYPE_U16 },
-    { "ePropExtDev_PCIDomain",              MFX_VARIANT_TYPE_U32 },
-    { "ePropExtDev_PCIBus",                 MFX_VARIANT_TYPE_U32 },
-    { "ePropExtDev_PCIDevice",              MFX_VARIANT_TYPE_U32 },
-    { "ePropExtDev_PCIFunction",            MFX_VARIANT_TYPE_U32 },
-    { "ePropExtDev_DeviceLUID",             MFX_VARIANT_TYPE_PTR },
-    { "ePropExtDev_LUIDDeviceNodeMask",     MFX_VARIANT_TYPE_U32 },
-    { "ePropExtDev_DRMRenderNodeNum",       MFX_VARIANT_TYPE_U32 },
-    { "ePropExtDev_DRMPrimaryNodeNum",      MFX_VARIANT_TYPE_U32 },
-    { "ePropExtDev_RevisionID",             MFX_VARIANT_TYPE_U16 },
-    { "ePropExtDev_DeviceName",             MFX_VARIANT_TYPE_PTR },
-
-    { "ePropSurface_SurfaceType",           MFX_VARIANT_TYPE_U32 },
-    { "ePropSurface_SurfaceComponent",      MFX_VARIANT_TYPE_U32 },
-    { "ePropSurface_SurfaceFlags",          MFX_VARIANT_TYPE_U32 },
-
-    { "ePropSpecial_HandleType",            MFX_VARIANT_TYPE_U32 },
-    { "ePropSpecial_Handle",                MFX_VARIANT_TYPE_PTR },
-    { "ePropSpecial_NumThread",             MFX_VARIANT_TYPE_U32 },
-    { "ePropSpecial_DeviceCopy",            MFX_VARIANT_TYPE_U16 },
-    { "ePropSpecial_ExtBuffer",             MFX_VARIANT_TYPE_PTR },
-    { "ePropSpecial_DXGIAdapterIndex",      MFX_VARIANT_TYPE_U32 },
-
-    { "ePropFunc_FunctionName",             MFX_VARIANT_TYPE_PTR },
+#define PROP_TAB(idx, type) { #idx, type },
+    FILTER_PROP_LIST(PROP_TAB)
+#undef PROP_TAB
 };
 
-// end table formatting
-// clang-format on
-
-// sanity check - property table and indexes must have same number of entries
-static_assert((sizeof(PropIdxTab) / sizeof(PropVariant)) == eProp_TotalProps,
-              "PropIdx and PropIdxTab are misaligned");
-
 static_assert(NUM_TOTAL_FILTER_PROPS == eProp_TotalProps,
               "NUM_TOTAL_FILTER_PROPS and eProp_TotalProps are misaligned");
 
+static mfxU32 GetPropGroup(mfxU32 idx) {
+    if (idx <= ePropDevice_MediaAdapterType)
+        return PROP_GROUP_GENERAL;
+    else if (idx <= ePropDec_ColorFormats)
+        return PROP_GROUP_DEC;
+    else if (idx <= ePropEnc_ColorFormats)
+        return PROP_GROUP_ENC;
+    else if (idx <= ePropVPP_OutFormat)
+        return PROP_GROUP_VPP;
+    else if (idx <= ePropExtDev_DeviceName)
+        return PROP_GROUP_EXTDEV;
+    else if (idx <= ePropSurface_SurfaceFlags)
+        return PROP_GROUP_SURFACE;
+    else if (idx == ePropFunc_FunctionName)
+        return PROP_GROUP_FUNCTION;
+
+    return PROP_GROUP_SPECIAL;
+}
+
+static bool IsApiVersionProp(mfxI32 idx) {
+    return (idx == ePropMain_ApiVersion || idx == ePropMain_ApiVersion_Major ||
+            idx == ePropMain_ApiVersion_Minor);
+}
+
+void ConfigCtxVPL::InvalidateGroup(mfxU32 group) {
+    m_groupGeneration[group]++;
+
+    if (m_parentConfig)
+        m_parentConfig->m_altGeneration++;
+}
+
 mfxStatus ConfigCtxVPL::ValidateAndSetProp(mfxI32 idx, mfxVariant value) {
     if (idx < 0 || idx >= eProp_TotalProps)
         return MFX_ERR_NOT_FOUND;
 
+    // deviceID may be passed as U16 (default) or string (since API 2.4)
+    // for compatibility, both are supported (value.Type distinguishes between them)
+    if (idx == ePropDevice_DeviceID && value.Type == MFX_VARIANT_TYPE_PTR)
+        idx = ePropDevice_DeviceIDStr;
+
     if (value.Type != PropIdxTab[idx].Type)
         return MFX_ERR_UNSUPPORTED;
 
+    // alternatives only select implementations, the session is created with the
+    //   properties of the parent config
+    if (m_parentConfig && (GetPropGroup(idx) == PROP_GROUP_SPECIAL ||
+                           idx == ePropMain_AccelerationMode || IsApiVersionProp(idx)))
+        return MFX_ERR_UNSUPPORTED;
+
+    // invalidate memoized results for this group
+    InvalidateGroup(GetPropGroup(idx));
+
+    // replaces a comparison set with SetFilterPropertyOp()
+    m_filterOps.erase(idx);
+
     m_propVar[idx].Version.Version = MFX_VARIANT_VERSION;
     m_propVar[idx].Type            = value.Type;
 
@@ -315,389 +469,287 @@ mfxStatus ConfigCtxVPL::ValidateAndSetProp(mfxI32 idx, mfxVariant value) {
     return MFX_ERR_NONE;
 }
 
-mfxStatus ConfigCtxVPL::SetFilterPropertyDec(std::list<std::string> &propParsedString,
-                                             mfxVariant value) {
-    std::string nextProp;
+// FNV-1a hash of the first len characters of a property name
+// evaluated at compile time for the names in FILTER_PROP_NAMES
+static constexpr mfxU32 PropNameHash(const char *name, size_t len, mfxU32 hash = 2166136261u) {
+    return len ? PropNameHash(name + 1, len - 1, (hash ^ (mfxU8)(*name)) * 16777619u) : hash;
+}
 
-    nextProp = GetNextProp(propParsedString);
+// return index of the property with this exact name, or -1 if the name is unknown
+// hashes of all names are case labels, so a collision between two names fails to compile
+static mfxI32 FindPropIdx(const char *name, size_t len) {
+#define PROP_NAME_CASE(str, idx, id)                           \
+    case PropNameHash(str, sizeof(str) - 1):                   \
+        if (len == sizeof(str) - 1 && !memcmp(name, str, len)) \
+            return idx;                                        \
+        break;
+#define PROP_ALIAS_CASE(str, idx) PROP_NAME_CASE(str, idx, 0)
+
+    switch (PropNameHash(name, len)) {
+        FILTER_PROP_NAMES(PROP_NAME_CASE, PROP_ALIAS_CASE)
+#ifdef ONEVPL_EXPERIMENTAL
+        FILTER_PROP_NAMES_EXPERIMENTAL(PROP_NAME_CASE, PROP_ALIAS_CASE)
+#endif
+#if defined(_WIN32) || defined(_WIN64)
+        FILTER_PROP_NAMES_WINDOWS(PROP_NAME_CASE, PROP_ALIAS_CASE)
+#endif
+        default:
+            break;
+    }
 
-    // no settable top-level members
-    if (nextProp != "decoder")
-        return MFX_ERR_NOT_FOUND;
+#undef PROP_NAME_CASE
+#undef PROP_ALIAS_CASE
 
-    // parse 'decoder'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "CodecID") {
-        return ValidateAndSetProp(ePropDec_CodecID, value);
-    }
-    else if (nextProp == "MaxcodecLevel") {
-        return ValidateAndSetProp(ePropDec_MaxcodecLevel, value);
-    }
-    else if (nextProp != "decprofile") {
-        return MFX_ERR_NOT_FOUND;
-    }
+    return -1;
+}
 
-    // parse 'decprofile'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "Profile") {
-        return ValidateAndSetProp(ePropDec_Profile, value);
-    }
-    else if (nextProp != "decmemdesc") {
-        return MFX_ERR_NOT_FOUND;
-    }
+#ifdef ONEVPL_EXPERIMENTAL
+// return index of the property with this public ID, or -1 if the ID is unknown
+static mfxI32 FindPropIdxById(mfxU32 propId) {
+    #define PROP_ID_CASE(str, idx, id) \
+        case id:                       \
+            return idx;
+    #define PROP_ALIAS_NONE(str, idx)
+
+    switch (propId) {
+        FILTER_PROP_NAMES(PROP_ID_CASE, PROP_ALIAS_NONE)
+        FILTER_PROP_NAMES_EXPERIMENTAL(PROP_ID_CASE, PROP_ALIAS_NONE)
+    #if defined(_WIN32) || defined(_WIN64)
+        FILTER_PROP_NAMES_WINDOWS(PROP_ID_CASE, PROP_ALIAS_NONE)
+    #endif
+        default:
+            break;
+    }
+
+    #undef PROP_ID_CASE
+    #undef PROP_ALIAS_NONE
+
+    return -1;
+}
+#endif
 
-    // parse 'decmemdesc'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "MemHandleType") {
-        return ValidateAndSetProp(ePropDec_MemHandleType, value);
-    }
-    else if (nextProp == "Width") {
-        return ValidateAndSetProp(ePropDec_Width, value);
-    }
-    else if (nextProp == "Height") {
-        return ValidateAndSetProp(ePropDec_Height, value);
-    }
-    else if (nextProp == "ColorFormat" || nextProp == "ColorFormats") {
-        return ValidateAndSetProp(ePropDec_ColorFormats, value);
+// return index of the property with this name, or -1 if the name is unknown
+static mfxI32 FindPropIdxByName(const char *propName) {
+    size_t len = strlen(propName);
+
+    // names followed by extra '.'-separated parts (e.g. "NumThread.x") have always been
+    //   accepted, so drop parts from the end until a known name is found
+    while (len > 0) {
+        mfxI32 idx = FindPropIdx(propName, len);
+        if (idx >= 0)
+            return idx;
+
+        while (len > 0 && propName[len - 1] != '.')
+            len--;
+        if (len > 0)
+            len--;
     }
 
-    // end of mfxDecoderDescription options
-    return MFX_ERR_NOT_FOUND;
+    return -1;
 }
 
-mfxStatus ConfigCtxVPL::SetFilterPropertyEnc(std::list<std::string> &propParsedString,
-                                             mfxVariant value) {
-    std::string nextProp;
-
-    nextProp = GetNextProp(propParsedString);
+// return codes (from spec):
+//   MFX_ERR_NOT_FOUND - name contains unknown parameter name
+//   MFX_ERR_UNSUPPORTED - value data type != parameter with provided name
+mfxStatus ConfigCtxVPL::SetFilterProperty(const mfxU8 *name, mfxVariant value) {
+    if (!name)
+        return MFX_ERR_NULL_PTR;
 
-    // no settable top-level members
-    if (nextProp != "encoder")
+    mfxI32 idx = FindPropIdxByName((const char *)name);
+    if (idx < 0)
         return MFX_ERR_NOT_FOUND;
 
-    // parse 'encoder'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "CodecID") {
-        return ValidateAndSetProp(ePropEnc_CodecID, value);
-    }
-    else if (nextProp == "MaxcodecLevel") {
-        return ValidateAndSetProp(ePropEnc_MaxcodecLevel, value);
-    }
-    else if (nextProp == "BiDirectionalPrediction") {
-        return ValidateAndSetProp(ePropEnc_BiDirectionalPrediction, value);
-    }
+    return ValidateAndSetProp(idx, value);
+}
+
 #ifdef ONEVPL_EXPERIMENTAL
-    else if (nextProp == "ReportedStats") {
-        return ValidateAndSetProp(ePropEnc_ReportedStats, value);
-    }
+// same as SetFilterProperty(), with the property given by public ID instead of name
+mfxStatus ConfigCtxVPL::SetFilterPropertyById(mfxU32 id, mfxVariant value) {
+    return ValidateAndSetProp(FindPropIdxById(id), value);
+}
 #endif
-    else if (nextProp != "encprofile") {
-        return MFX_ERR_NOT_FOUND;
-    }
 
-    // parse 'encprofile'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "Profile") {
-        return ValidateAndSetProp(ePropEnc_Profile, value);
-    }
-    else if (nextProp != "encmemdesc") {
-        return MFX_ERR_NOT_FOUND;
-    }
+#ifdef ONEVPL_EXPERIMENTAL
+// set all properties on a scratch config first, so that nothing is changed
+//   in this config unless every property is valid
+// propSts (optional) receives the status of each property
+mfxStatus ConfigCtxVPL::SetFilterProperties(const mfxConfigFilterProperty *props,
+                                            mfxU32 numProps,
+                                            mfxStatus *propSts) {
+    if (!props)
+        return MFX_ERR_NULL_PTR;
 
-    // parse 'encmemdesc'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "MemHandleType") {
-        return ValidateAndSetProp(ePropEnc_MemHandleType, value);
-    }
-    else if (nextProp == "Width") {
-        return ValidateAndSetProp(ePropEnc_Width, value);
-    }
-    else if (nextProp == "Height") {
-        return ValidateAndSetProp(ePropEnc_Height, value);
-    }
-    else if (nextProp == "ColorFormat" || nextProp == "ColorFormats") {
-        return ValidateAndSetProp(ePropEnc_ColorFormats, value);
-    }
+    std::unique_ptr<ConfigCtxVPL> scratchCtx(new (std::nothrow) ConfigCtxVPL);
+    if (!scratchCtx)
+        return MFX_ERR_MEMORY_ALLOC;
 
-    // end of mfxEncoderDescription options
-    return MFX_ERR_NOT_FOUND;
-}
+    // same properties are rejected as in this config
+    scratchCtx->m_parentConfig = m_parentConfig;
 
-mfxStatus ConfigCtxVPL::SetFilterPropertyVPP(std::list<std::string> &propParsedString,
-                                             mfxVariant value) {
-    std::string nextProp;
+    mfxStatus sts = MFX_ERR_NONE;
+    for (mfxU32 i = 0; i < numProps; i++) {
+        mfxStatus propStatus = scratchCtx->SetFilterProperty(props[i].Name, props[i].Value);
+        if (propSts)
+            propSts[i] = propStatus;
 
-    nextProp = GetNextProp(propParsedString);
+        if (propStatus != MFX_ERR_NONE && sts == MFX_ERR_NONE)
+            sts = propStatus;
+    }
 
-    // no settable top-level members
-    if (nextProp != "filter")
-        return MFX_ERR_NOT_FOUND;
+    if (sts != MFX_ERR_NONE)
+        return sts;
 
-    // parse 'filter'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "FilterFourCC") {
-        return ValidateAndSetProp(ePropVPP_FilterFourCC, value);
-    }
-    else if (nextProp == "MaxDelayInFrames") {
-        return ValidateAndSetProp(ePropVPP_MaxDelayInFrames, value);
-    }
-    else if (nextProp != "memdesc") {
-        return MFX_ERR_NOT_FOUND;
+    // properties were validated above, so these are not expected to fail
+    for (mfxU32 i = 0; i < numProps; i++) {
+        sts = SetFilterProperty(props[i].Name, props[i].Value);
+        if (sts != MFX_ERR_NONE)
+            return sts;
     }
 
-    // parse 'memdesc'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "MemHandleType") {
-        return ValidateAndSetProp(ePropVPP_MemHandleType, value);
-    }
-    else if (nextProp == "Width") {
-        return ValidateAndSetProp(ePropVPP_Width, value);
-    }
-    else if (nextProp == "Height") {
-        return ValidateAndSetProp(ePropVPP_Height, value);
-    }
-    else if (nextProp != "format") {
-        return MFX_ERR_NOT_FOUND;
-    }
+    return MFX_ERR_NONE;
+}
 
-    // parse 'format'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "InFormat") {
-        return ValidateAndSetProp(ePropVPP_InFormat, value);
-    }
-    else if (nextProp == "OutFormat" || nextProp == "OutFormats") {
-        return ValidateAndSetProp(ePropVPP_OutFormat, value);
+// properties which may be set with a comparison
+// bitmasks and API version are not compared for equality, and AccelerationMode is passed
+//   to the runtime, so these keep the single value of SetFilterProperty()
+static bool IsFilterOpSupported(mfxI32 idx) {
+    switch (idx) {
+        case ePropMain_AccelerationMode:
+        case ePropMain_ApiVersion:
+        case ePropMain_ApiVersion_Major:
+        case ePropMain_ApiVersion_Minor:
+        case ePropEnc_ReportedStats:
+        case ePropSurface_SurfaceFlags:
+            return false;
+        default:
+            break;
     }
 
-    // end of mfxVPPDescription options
-    return MFX_ERR_NOT_FOUND;
-}
+    if (GetPropGroup(idx) == PROP_GROUP_SPECIAL)
+        return false;
 
-mfxStatus ConfigCtxVPL::SetFilterPropertySurface(std::list<std::string> &propParsedString,
-                                                 mfxVariant value) {
-    std::string nextProp;
+    return (PropIdxTab[idx].Type == MFX_VARIANT_TYPE_U16 ||
+            PropIdxTab[idx].Type == MFX_VARIANT_TYPE_U32);
+}
 
-    nextProp = GetNextProp(propParsedString);
+// return codes are the same as SetFilterProperty()
+// MFX_ERR_UNSUPPORTED is also returned if the property cannot be compared with op,
+//   or if the number of values does not match op
+mfxStatus ConfigCtxVPL::SetFilterPropertyOp(const mfxU8 *name,
+                                            mfxU32 op,
+                                            const mfxVariant *values,
+                                            mfxU32 numValues) {
+    if (!name || !values)
+        return MFX_ERR_NULL_PTR;
 
-    // no settable top-level members
-    if (nextProp != "surftype")
+    mfxI32 idx = FindPropIdxByName((const char *)name);
+    if (idx < 0)
         return MFX_ERR_NOT_FOUND;
 
-    // parse 'surftype'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "SurfaceType") {
-        return ValidateAndSetProp(ePropSurface_SurfaceType, value);
-    }
-    else if (nextProp != "surfcomp") {
-        return MFX_ERR_NOT_FOUND;
-    }
+    if (op == MFX_FILTER_OP_EQUAL && numValues == 1)
+        return ValidateAndSetProp(idx, values[0]);
 
-    // parse 'surfcomp'
-    nextProp = GetNextProp(propParsedString);
-    if (nextProp == "SurfaceComponent") {
-        return ValidateAndSetProp(ePropSurface_SurfaceComponent, value);
-    }
-    else if (nextProp == "SurfaceFlags") {
-        return ValidateAndSetProp(ePropSurface_SurfaceFlags, value);
-    }
+    if (!IsFilterOpSupported(idx))
+        return MFX_ERR_UNSUPPORTED;
 
-    // end of mfxSurfaceTypesSupported options
-    return MFX_ERR_NOT_FOUND;
-}
+    bool bNumValuesValid = false;
+    switch (op) {
+        case MFX_FILTER_OP_NOT_EQUAL:
+            bNumValuesValid = (numValues == 1);
+            break;
+        case MFX_FILTER_OP_RANGE:
+            bNumValuesValid = (numValues == 2);
+            break;
+        case MFX_FILTER_OP_IN_SET:
+        case MFX_FILTER_OP_NOT_IN_SET:
+            bNumValuesValid = (numValues >= 1);
+            break;
+        default:
+            break;
+    }
+
+    if (!bNumValuesValid)
+        return MFX_ERR_UNSUPPORTED;
 
-// return codes (from spec):
-//   MFX_ERR_NOT_FOUND - name contains unknown parameter name
-//   MFX_ERR_UNSUPPORTED - value data type != parameter with provided name
-mfxStatus ConfigCtxVPL::SetFilterProperty(const mfxU8 *name, mfxVariant value) {
-    if (!name)
-        return MFX_ERR_NULL_PTR;
+    mfxVariantType propType = PropIdxTab[idx].Type;
 
-    std::list<std::string> propParsedString;
+    FilterOpVPL filterOp;
+    filterOp.op = op;
 
-    // parse property string into individual properties,
-    //   separated by '.'
-    std::stringstream prop((char *)name);
-    std::string s;
-    propParsedString.clear();
-    while (getline(prop, s, '.')) {
-        propParsedString.push_back(s);
-    }
+    try {
+        for (mfxU32 i = 0; i < numValues; i++) {
+            if (values[i].Type != propType)
+                return MFX_ERR_UNSUPPORTED;
 
-    // get first property descriptor
-    std::string nextProp = GetNextProp(propParsedString);
+            filterOp.values.push_back(propType == MFX_VARIANT_TYPE_U16 ? values[i].Data.U16
+                                                                       : values[i].Data.U32);
+        }
 
-    // check for special-case properties, not part of mfxImplDescription
-    if (nextProp == "mfxHandleType") {
-        return ValidateAndSetProp(ePropSpecial_HandleType, value);
-    }
-    else if (nextProp == "mfxHDL") {
-        return ValidateAndSetProp(ePropSpecial_Handle, value);
-    }
-    else if (nextProp == "NumThread") {
-        return ValidateAndSetProp(ePropSpecial_NumThread, value);
-    }
-#ifdef ONEVPL_EXPERIMENTAL
-    else if (nextProp == "DeviceCopy") {
-        return ValidateAndSetProp(ePropSpecial_DeviceCopy, value);
-    }
-#endif
-    else if (nextProp == "ExtBuffer") {
-        return ValidateAndSetProp(ePropSpecial_ExtBuffer, value);
+        if (op == MFX_FILTER_OP_RANGE && filterOp.values[0] > filterOp.values[1])
+            return MFX_ERR_UNSUPPORTED;
+
+        m_filterOps[idx] = std::move(filterOp);
     }
-    else if (nextProp == "DXGIAdapterIndex") {
-#if defined(_WIN32) || defined(_WIN64)
-        // this property is only valid on Windows
-        return ValidateAndSetProp(ePropSpecial_DXGIAdapterIndex, value);
-#else
-        return MFX_ERR_NOT_FOUND;
-#endif
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
     }
 
-    // to require that a specific function is implemented, use the property name
-    //   "mfxImplementedFunctions.FunctionsName"
-    if (nextProp == "mfxImplementedFunctions") {
-        nextProp = GetNextProp(propParsedString);
-        if (nextProp == "FunctionsName") {
-            return ValidateAndSetProp(ePropFunc_FunctionName, value);
-        }
-        return MFX_ERR_NOT_FOUND;
-    }
+    // invalidate memoized results for this group
+    InvalidateGroup(GetPropGroup(idx));
 
-    // extended device ID properties must begin with mfxExtendedDeviceId
-    if (nextProp == "mfxExtendedDeviceId") {
-        nextProp = GetNextProp(propParsedString);
-        if (nextProp == "VendorID") {
-            return ValidateAndSetProp(ePropExtDev_VendorID, value);
-        }
-        else if (nextProp == "DeviceID") {
-            return ValidateAndSetProp(ePropExtDev_DeviceID, value);
-        }
-        else if (nextProp == "PCIDomain") {
-            return ValidateAndSetProp(ePropExtDev_PCIDomain, value);
-        }
-        else if (nextProp == "PCIBus") {
-            return ValidateAndSetProp(ePropExtDev_PCIBus, value);
-        }
-        else if (nextProp == "PCIDevice") {
-            return ValidateAndSetProp(ePropExtDev_PCIDevice, value);
-        }
-        else if (nextProp == "PCIFunction") {
-            return ValidateAndSetProp(ePropExtDev_PCIFunction, value);
-        }
-        else if (nextProp == "DeviceLUID") {
-            return ValidateAndSetProp(ePropExtDev_DeviceLUID, value);
-        }
-        else if (nextProp == "LUIDDeviceNodeMask") {
-            return ValidateAndSetProp(ePropExtDev_LUIDDeviceNodeMask, value);
-        }
-        else if (nextProp == "DRMRenderNodeNum") {
-            return ValidateAndSetProp(ePropExtDev_DRMRenderNodeNum, value);
-        }
-        else if (nextProp == "DRMPrimaryNodeNum") {
-            return ValidateAndSetProp(ePropExtDev_DRMPrimaryNodeNum, value);
-        }
-        else if (nextProp == "RevisionID") {
-            return ValidateAndSetProp(ePropExtDev_RevisionID, value);
-        }
-        else if (nextProp == "DeviceName") {
-            return ValidateAndSetProp(ePropExtDev_DeviceName, value);
-        }
-        return MFX_ERR_NOT_FOUND;
-    }
+    m_propVar[idx].Version.Version = MFX_VARIANT_VERSION;
+    m_propVar[idx].Type            = VARIANT_TYPE_FILTER_OP;
+    m_propVar[idx].Data.Ptr        = &(m_filterOps[idx]);
 
-#ifdef ONEVPL_EXPERIMENTAL
-    // property is a member of mfxSurfaceTypesSupported
-    if (nextProp == "mfxSurfaceTypesSupported") {
-        return SetFilterPropertySurface(propParsedString, value);
-    }
-#endif
+    return MFX_ERR_NONE;
+}
 
-    // standard properties must begin with "mfxImplDescription"
-    if (nextProp != "mfxImplDescription") {
-        return MFX_ERR_NOT_FOUND;
-    }
+ConfigCtxVPL *ConfigCtxVPL::AddAlternative() {
+    // alternatives are not nested
+    if (m_parentConfig)
+        return nullptr;
 
-    // get next property descriptor
-    nextProp = GetNextProp(propParsedString);
+    std::unique_ptr<ConfigCtxVPL> altCtx(new (std::nothrow) ConfigCtxVPL);
+    if (!altCtx)
+        return nullptr;
 
-    // property is a top-level member of mfxImplDescription
-    if (nextProp == "Impl") {
-        return ValidateAndSetProp(ePropMain_Impl, value);
-    }
-    else if (nextProp == "AccelerationMode") {
-        return ValidateAndSetProp(ePropMain_AccelerationMode, value);
-    }
-    else if (nextProp == "mfxSurfacePoolMode") {
-        return ValidateAndSetProp(ePropMain_PoolAllocationPolicy, value);
-    }
-    else if (nextProp == "ApiVersion") {
-        // ApiVersion may be passed as single U32 (Version) or two U16's (Major, Minor)
-        nextProp = GetNextProp(propParsedString);
-        if (nextProp == "Version")
-            return ValidateAndSetProp(ePropMain_ApiVersion, value);
-        else if (nextProp == "Major")
-            return ValidateAndSetProp(ePropMain_ApiVersion_Major, value);
-        else if (nextProp == "Minor")
-            return ValidateAndSetProp(ePropMain_ApiVersion_Minor, value);
-        else
-            return MFX_ERR_NOT_FOUND;
-    }
-    else if (nextProp == "VendorID") {
-        return ValidateAndSetProp(ePropMain_VendorID, value);
-    }
-    else if (nextProp == "ImplName") {
-        return ValidateAndSetProp(ePropMain_ImplName, value);
-    }
-    else if (nextProp == "License") {
-        return ValidateAndSetProp(ePropMain_License, value);
-    }
-    else if (nextProp == "Keywords") {
-        return ValidateAndSetProp(ePropMain_Keywords, value);
+    altCtx->m_parentLoader = m_parentLoader;
+    altCtx->m_parentConfig = this;
+
+    try {
+        m_altList.push_back(altCtx.get());
     }
-    else if (nextProp == "VendorImplID") {
-        return ValidateAndSetProp(ePropMain_VendorImplID, value);
+    catch (...) {
+        return nullptr;
     }
 
-    // property is a member of mfxDeviceDescription
-    if (nextProp == "mfxDeviceDescription") {
-        nextProp = GetNextProp(propParsedString);
-        // old version of table in spec had extra "device", just skip if present
-        if (nextProp == "device")
-            nextProp = GetNextProp(propParsedString);
-
-        // special case - deviceID may be passed as U16 (default) or string (since API 2.4)
-        // for compatibility, both are supported (value.Type distinguishes between them)
-        if (nextProp == "DeviceID") {
-            if (value.Type == MFX_VARIANT_TYPE_PTR)
-                return ValidateAndSetProp(ePropDevice_DeviceIDStr, value);
-            else
-                return ValidateAndSetProp(ePropDevice_DeviceID, value);
-        }
+    // an alternative with no properties matches every implementation
+    m_altGeneration++;
 
-        if (nextProp == "MediaAdapterType") {
-            return ValidateAndSetProp(ePropDevice_MediaAdapterType, value);
-        }
+    return altCtx.release();
+}
 
-        return MFX_ERR_NOT_FOUND;
-    }
+// configResults are the memoized results of one implementation
+// returns MFX_ERR_NOT_FOUND if the implementation was not matched with the current alternatives
+mfxStatus ConfigCtxVPL::GetMatchedAlternative(const std::vector<ConfigResultVPL> &configResults,
+                                              mfxU32 *alternative) const {
+    if (m_altList.empty())
+        return MFX_ERR_NOT_INITIALIZED;
 
-    // property is a member of mfxDecoderDescription
-    if (nextProp == "mfxDecoderDescription") {
-        return SetFilterPropertyDec(propParsedString, value);
-    }
+    for (const ConfigResultVPL &result : configResults) {
+        if (result.configId != m_configId)
+            continue;
 
-    // property is a member of mfxEncoderDescription
-    if (nextProp == "mfxEncoderDescription") {
-        return SetFilterPropertyEnc(propParsedString, value);
-    }
+        if (result.altGeneration != m_altGeneration || result.altIdx < 0)
+            break;
 
-    // property is a member of mfxVPPDescription
-    if (nextProp == "mfxVPPDescription") {
-        return SetFilterPropertyVPP(propParsedString, value);
+        *alternative = (mfxU32)result.altIdx;
+        return MFX_ERR_NONE;
     }
 
     return MFX_ERR_NOT_FOUND;
 }
+#endif
 
 #define CHECK_IDX(idxA, idxB, numB) \
     if ((idxB) == (numB)) {         \
@@ -707,7 +759,7 @@ mfxStatus ConfigCtxVPL::SetFilterProperty(const mfxU8 *name, mfxVariant value) {
     }
 
 mfxStatus ConfigCtxVPL::GetFlatDescriptionsDec(const mfxImplDescription *libImplDesc,
-                                               std::list<DecConfig> &decConfigList) {
+                                               std::vector<DecConfig> &decConfigList) {
     mfxU32 codecIdx   = 0;
     mfxU32 profileIdx = 0;
     mfxU32 memIdx     = 0;
@@ -749,7 +801,7 @@ mfxStatus ConfigCtxVPL::GetFlatDescriptionsDec(const mfxImplDescription *libImpl
 }
 
 mfxStatus ConfigCtxVPL::GetFlatDescriptionsEnc(const mfxImplDescription *libImplDesc,
-                                               std::list<EncConfig> &encConfigList) {
+                                               std::vector<EncConfig> &encConfigList) {
     mfxU32 codecIdx   = 0;
     mfxU32 profileIdx = 0;
     mfxU32 memIdx     = 0;
@@ -811,7 +863,7 @@ mfxStatus ConfigCtxVPL::GetFlatDescriptionsEnc(const mfxImplDescription *libImpl
 }
 
 mfxStatus ConfigCtxVPL::GetFlatDescriptionsVPP(const mfxImplDescription *libImplDesc,
-                                               std::list<VPPConfig> &vppConfigList) {
+                                               std::vector<VPPConfig> &vppConfigList) {
     mfxU32 filterIdx = 0;
     mfxU32 memIdx    = 0;
     mfxU32 inFmtIdx  = 0;
@@ -854,7 +906,7 @@ mfxStatus ConfigCtxVPL::GetFlatDescriptionsVPP(const mfxImplDescription *libImpl
 
 #ifdef ONEVPL_EXPERIMENTAL
 mfxStatus ConfigCtxVPL::GetFlatDescriptionsSurface(const mfxSurfaceTypesSupported *libSurfaceTypes,
-                                                   std::list<SurfaceConfig> &surfaceConfigList) {
+                                                   std::vector<SurfaceConfig> &surfaceConfigList) {
     if (!libSurfaceTypes) {
         surfaceConfigList.clear();
         return MFX_ERR_INVALID_VIDEO_PARAM;
@@ -890,13 +942,201 @@ mfxStatus ConfigCtxVPL::GetFlatDescriptionsSurface(const mfxSurfaceTypesSupporte
 }
 #endif
 
-#define CHECK_PROP(idx, type, val)                             \
-    if ((cfgPropsAll[(idx)].Type != MFX_VARIANT_TYPE_UNSET) && \
-        (cfgPropsAll[(idx)].Data.type != val))                 \
+// bit for memory type in CapsIndexGroup::memTypeMask
+static mfxU32 GetMemTypeBit(mfxU32 memType) {
+    return 1u << std::min(memType, 31u);
+}
+
+// bit for index of color format in CapsIndexGroup::formatMask
+static mfxU64 GetFormatBit(mfxU32 formatIdx) {
+    return (mfxU64)1 << std::min(formatIdx, 63u);
+}
+
+// bit for color format in CapsIndexGroup::formatMask, adding format to the index if new
+static mfxU64 AddFormat(std::vector<mfxU32> &formats, mfxU32 format) {
+    auto f = std::find(formats.begin(), formats.end(), format);
+    if (f == formats.end())
+        f = formats.insert(formats.end(), format);
+
+    return GetFormatBit((mfxU32)(f - formats.begin()));
+}
+
+static mfxU32 GetGroupID(const DecConfig &dc) {
+    return dc.CodecID;
+}
+
+static mfxU32 GetGroupID(const EncConfig &ec) {
+    return ec.CodecID;
+}
+
+static mfxU32 GetGroupID(const VPPConfig &vc) {
+    return vc.FilterFourCC;
+}
+
+static mfxU64 AddFormats(std::vector<mfxU32> &formats, const DecConfig &dc) {
+    return AddFormat(formats, dc.ColorFormat);
+}
+
+static mfxU64 AddFormats(std::vector<mfxU32> &formats, const EncConfig &ec) {
+    return AddFormat(formats, ec.ColorFormat);
+}
+
+static mfxU64 AddFormats(std::vector<mfxU32> &formats, const VPPConfig &vc) {
+    return AddFormat(formats, vc.InFormat) | AddFormat(formats, vc.OutFormat);
+}
+
+// sort flat descriptions by CodecID or FilterFourCC and record the range of each one
+// sort is stable so descriptions keep the order reported by the runtime
+template <typename T>
+static void BuildCapsIndexGroups(std::vector<T> &configList,
+                                 std::vector<mfxU32> &formats,
+                                 std::vector<CapsIndexGroup> &groups) {
+    std::stable_sort(configList.begin(), configList.end(), [](const T &c1, const T &c2) {
+        return GetGroupID(c1) < GetGroupID(c2);
+    });
+
+    for (mfxU32 i = 0; i < (mfxU32)configList.size(); i++) {
+        const T &c = configList[i];
+
+        if (groups.empty() || groups.back().id != GetGroupID(c)) {
+            CapsIndexGroup group = {};
+            group.id             = GetGroupID(c);
+            group.first          = i;
+            groups.push_back(group);
+        }
+
+        CapsIndexGroup &group = groups.back();
+        group.count++;
+        group.memTypeMask |= GetMemTypeBit(c.MemHandleType);
+        group.formatMask |= AddFormats(formats, c);
+    }
+}
+
+static void SplitString(const mfxChar *implString, std::vector<std::string> &tokens) {
+    std::string s;
+
+    // parse implString string into tokens, separated by ','
+    std::stringstream implSS((char *)implString);
+    while (getline(implSS, s, ',')) {
+        tokens.push_back(s);
+    }
+}
+
+mfxStatus ConfigCtxVPL::BuildCapsIndex(const mfxImplDescription *libImplDesc,
+#ifdef ONEVPL_EXPERIMENTAL
+                                       const mfxSurfaceTypesSupported *libImplSurfTypes,
+#endif
+                                       CapsIndexVPL &capsIndex) {
+    if (!libImplDesc)
+        return MFX_ERR_NULL_PTR;
+
+    try {
+        // generate "flat" descriptions of each combination
+        //   (e.g. multiple profiles from the same codec)
+        GetFlatDescriptionsDec(libImplDesc, capsIndex.dec);
+        GetFlatDescriptionsEnc(libImplDesc, capsIndex.enc);
+        GetFlatDescriptionsVPP(libImplDesc, capsIndex.vpp);
+
+#ifdef ONEVPL_EXPERIMENTAL
+        GetFlatDescriptionsSurface(libImplSurfTypes, capsIndex.surface);
+#endif
+
+        BuildCapsIndexGroups(capsIndex.dec, capsIndex.formats, capsIndex.decGroups);
+        BuildCapsIndexGroups(capsIndex.enc, capsIndex.formats, capsIndex.encGroups);
+        BuildCapsIndexGroups(capsIndex.vpp, capsIndex.formats, capsIndex.vppGroups);
+
+        SplitString(libImplDesc->License, capsIndex.licenseTokens);
+        SplitString(libImplDesc->Keywords, capsIndex.keywordTokens);
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    return MFX_ERR_NONE;
+}
+
+// returns true if val passes the comparison of a property set with SetFilterPropertyOp()
+static bool FilterOpMatches(const mfxVariant &prop, mfxU32 val) {
+#ifdef ONEVPL_EXPERIMENTAL
+    const FilterOpVPL *filterOp        = (const FilterOpVPL *)(prop.Data.Ptr);
+    const std::vector<mfxU32> &values = filterOp->values;
+
+    switch (filterOp->op) {
+        case MFX_FILTER_OP_NOT_EQUAL:
+            return (val != values[0]);
+        case MFX_FILTER_OP_RANGE:
+            return (val >= values[0] && val <= values[1]);
+        case MFX_FILTER_OP_IN_SET:
+            return (std::find(values.begin(), values.end(), val) != values.end());
+        case MFX_FILTER_OP_NOT_IN_SET:
+            return (std::find(values.begin(), values.end(), val) == values.end());
+        default:
+            break;
+    }
+#endif
+
+    return false;
+}
+
+// returns true if val matches a U16 or U32 property which is set
+static bool PropValueMatches(const mfxVariant &prop, mfxU32 val) {
+    if (prop.Type == VARIANT_TYPE_FILTER_OP)
+        return FilterOpMatches(prop, val);
+    else if (prop.Type == MFX_VARIANT_TYPE_U16)
+        return (prop.Data.U16 == val);
+
+    return (prop.Data.U32 == val);
+}
+
+// add bit for requested color format (if set) to formatMask
+// returns false if no description in the index uses this format
+static bool GetRequestedFormatMask(const mfxVariant cfgPropsAll[],
+                                   mfxU32 idx,
+                                   const CapsIndexVPL &capsIndex,
+                                   mfxU64 &formatMask) {
+    // formats compared with SetFilterPropertyOp() are only checked per description
+    if (cfgPropsAll[idx].Type == MFX_VARIANT_TYPE_UNSET ||
+        cfgPropsAll[idx].Type == VARIANT_TYPE_FILTER_OP)
+        return true;
+
+    const std::vector<mfxU32> &formats = capsIndex.formats;
+
+    auto f = std::find(formats.begin(), formats.end(), cfgPropsAll[idx].Data.U32);
+    if (f == formats.end())
+        return false;
+
+    formatMask |= GetFormatBit((mfxU32)(f - formats.begin()));
+
+    return true;
+}
+
+// returns false if no description in this group can match the requested properties
+static bool GroupMayMatch(const mfxVariant cfgPropsAll[],
+                          const CapsIndexGroup &group,
+                          mfxU32 idxID,
+                          mfxU32 idxMemType,
+                          mfxU64 formatMask) {
+    if (cfgPropsAll[idxID].Type != MFX_VARIANT_TYPE_UNSET &&
+        !PropValueMatches(cfgPropsAll[idxID], group.id))
+        return false;
+
+    if (cfgPropsAll[idxMemType].Type == MFX_VARIANT_TYPE_U32 &&
+        !(group.memTypeMask & GetMemTypeBit(cfgPropsAll[idxMemType].Data.U32)))
+        return false;
+
+    return ((group.formatMask & formatMask) == formatMask);
+}
+
+#define CHECK_PROP(idx, type, val)                                     \
+    if ((cfgPropsAll[(idx)].Type != MFX_VARIANT_TYPE_UNSET) &&         \
+        (cfgPropsAll[(idx)].Type == VARIANT_TYPE_FILTER_OP             \
+             ? !FilterOpMatches(cfgPropsAll[(idx)], (mfxU32)(val))     \
+             : cfgPropsAll[(idx)].Data.type != val))                   \
         isCompatible = false;
 
 mfxStatus ConfigCtxVPL::CheckPropsGeneral(const mfxVariant cfgPropsAll[],
-                                          const mfxImplDescription *libImplDesc) {
+                                          const mfxImplDescription *libImplDesc,
+                                          const CapsIndexVPL &capsIndex) {
     bool isCompatible = true;
 
     // check if this implementation includes
@@ -935,11 +1175,14 @@ mfxStatus ConfigCtxVPL::CheckPropsGeneral(const mfxVariant cfgPropsAll[],
         // check all supported policies if list is filled out
         // if structure is not present (old version) numPolicies will be 0, so skipped
         if (isCompatible == true && numPolicies > 0) {
-            mfxPoolAllocationPolicy policyRequested =
-                (mfxPoolAllocationPolicy)(cfgPropsAll[ePropMain_PoolAllocationPolicy].Data.U32);
-            auto *policyTab = libImplDesc->PoolPolicies.Policy;
-
-            auto *m = std::find(policyTab, policyTab + numPolicies, policyRequested);
+            const mfxVariant &policyRequested = cfgPropsAll[ePropMain_PoolAllocationPolicy];
+            auto *policyTab                   = libImplDesc->PoolPolicies.Policy;
+
+            auto *m = std::find_if(policyTab,
+                                   policyTab + numPolicies,
+                                   [&policyRequested](mfxPoolAllocationPolicy policy) {
+                                       return PropValueMatches(policyRequested, policy);
+                                   });
             if (m == policyTab + numPolicies)
                 isCompatible = false;
         }
@@ -950,23 +1193,22 @@ mfxStatus ConfigCtxVPL::CheckPropsGeneral(const mfxVariant cfgPropsAll[],
 
     // check string: ImplName (string match)
     if (cfgPropsAll[ePropMain_ImplName].Type != MFX_VARIANT_TYPE_UNSET) {
-        std::string filtName = *(std::string *)(cfgPropsAll[ePropMain_ImplName].Data.Ptr);
-        std::string implName = libImplDesc->ImplName;
-        if (filtName != implName)
+        const std::string &filtName = *(std::string *)(cfgPropsAll[ePropMain_ImplName].Data.Ptr);
+        if (filtName != libImplDesc->ImplName)
             isCompatible = false;
     }
 
     // check string: License (tokenized)
     if (cfgPropsAll[ePropMain_License].Type != MFX_VARIANT_TYPE_UNSET) {
-        std::string license = *(std::string *)(cfgPropsAll[ePropMain_License].Data.Ptr);
-        if (CheckPropString(libImplDesc->License, license) != MFX_ERR_NONE)
+        const std::string &license = *(std::string *)(cfgPropsAll[ePropMain_License].Data.Ptr);
+        if (CheckPropString(capsIndex.licenseTokens, license) != MFX_ERR_NONE)
             isCompatible = false;
     }
 
     // check string: Keywords (tokenized)
     if (cfgPropsAll[ePropMain_Keywords].Type != MFX_VARIANT_TYPE_UNSET) {
-        std::string keywords = *(std::string *)(cfgPropsAll[ePropMain_Keywords].Data.Ptr);
-        if (CheckPropString(libImplDesc->Keywords, keywords) != MFX_ERR_NONE)
+        const std::string &keywords = *(std::string *)(cfgPropsAll[ePropMain_Keywords].Data.Ptr);
+        if (CheckPropString(capsIndex.keywordTokens, keywords) != MFX_ERR_NONE)
             isCompatible = false;
     }
 
@@ -981,16 +1223,15 @@ mfxStatus ConfigCtxVPL::CheckPropsGeneral(const mfxVariant cfgPropsAll[],
             return MFX_ERR_UNSUPPORTED;
         }
 
-        unsigned int filtDeviceID = (unsigned int)(cfgPropsAll[ePropDevice_DeviceID].Data.U16);
-        if (implDeviceID != filtDeviceID)
+        if (!PropValueMatches(cfgPropsAll[ePropDevice_DeviceID], implDeviceID))
             isCompatible = false;
     }
 
     if (cfgPropsAll[ePropDevice_DeviceIDStr].Type != MFX_VARIANT_TYPE_UNSET) {
         // since API 2.4 - pass DeviceID as string (do string match)
-        std::string filtDeviceID = *(std::string *)(cfgPropsAll[ePropDevice_DeviceIDStr].Data.Ptr);
-        std::string implDeviceID = libImplDesc->Dev.DeviceID;
-        if (filtDeviceID != implDeviceID)
+        const std::string &filtDeviceID =
+            *(std::string *)(cfgPropsAll[ePropDevice_DeviceIDStr].Data.Ptr);
+        if (filtDeviceID != libImplDesc->Dev.DeviceID)
             isCompatible = false;
     }
 
@@ -1012,144 +1253,175 @@ mfxStatus ConfigCtxVPL::CheckPropsGeneral(const mfxVariant cfgPropsAll[],
 }
 
 mfxStatus ConfigCtxVPL::CheckPropsDec(const mfxVariant cfgPropsAll[],
-                                      std::list<DecConfig> decConfigList) {
-    auto it = decConfigList.begin();
-    while (it != decConfigList.end()) {
-        DecConfig dc      = (DecConfig)(*it);
-        bool isCompatible = true;
+                                      const CapsIndexVPL &capsIndex) {
+    mfxU64 formatMask = 0;
+    if (!GetRequestedFormatMask(cfgPropsAll, ePropDec_ColorFormats, capsIndex, formatMask))
+        return MFX_ERR_UNSUPPORTED;
 
-        // check if this decode description includes
-        //   all of the required decoder properties
-        CHECK_PROP(ePropDec_CodecID, U32, dc.CodecID);
-        CHECK_PROP(ePropDec_MaxcodecLevel, U16, dc.MaxcodecLevel);
-        CHECK_PROP(ePropDec_Profile, U32, dc.Profile);
-        CHECK_PROP(ePropDec_MemHandleType, U32, dc.MemHandleType);
-        CHECK_PROP(ePropDec_ColorFormats, U32, dc.ColorFormat);
-
-        // special handling for properties passed via pointer
-        if (cfgPropsAll[ePropDec_Width].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxRange32U width = {};
-            if (cfgPropsAll[ePropDec_Width].Data.Ptr)
-                width = *((mfxRange32U *)(cfgPropsAll[ePropDec_Width].Data.Ptr));
-
-            if ((width.Max > dc.Width.Max) || (width.Min < dc.Width.Min) ||
-                (width.Step < dc.Width.Step))
-                isCompatible = false;
-        }
+    for (const CapsIndexGroup &group : capsIndex.decGroups) {
+        if (!GroupMayMatch(cfgPropsAll,
+                           group,
+                           ePropDec_CodecID,
+                           ePropDec_MemHandleType,
+                           formatMask))
+            continue;
+
+        for (mfxU32 i = group.first; i < group.first + group.count; i++) {
+            const DecConfig &dc = capsIndex.dec[i];
+            bool isCompatible   = true;
+
+            // check if this decode description includes
+            //   all of the required decoder properties
+            CHECK_PROP(ePropDec_CodecID, U32, dc.CodecID);
+            CHECK_PROP(ePropDec_MaxcodecLevel, U16, dc.MaxcodecLevel);
+            CHECK_PROP(ePropDec_Profile, U32, dc.Profile);
+            CHECK_PROP(ePropDec_MemHandleType, U32, dc.MemHandleType);
+            CHECK_PROP(ePropDec_ColorFormats, U32, dc.ColorFormat);
+
+            // special handling for properties passed via pointer
+            if (cfgPropsAll[ePropDec_Width].Type != MFX_VARIANT_TYPE_UNSET) {
+                mfxRange32U width = {};
+                if (cfgPropsAll[ePropDec_Width].Data.Ptr)
+                    width = *((mfxRange32U *)(cfgPropsAll[ePropDec_Width].Data.Ptr));
+
+                if ((width.Max > dc.Width.Max) || (width.Min < dc.Width.Min) ||
+                    (width.Step < dc.Width.Step))
+                    isCompatible = false;
+            }
 
-        if (cfgPropsAll[ePropDec_Height].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxRange32U height = {};
-            if (cfgPropsAll[ePropDec_Height].Data.Ptr)
-                height = *((mfxRange32U *)(cfgPropsAll[ePropDec_Height].Data.Ptr));
+            if (cfgPropsAll[ePropDec_Height].Type != MFX_VARIANT_TYPE_UNSET) {
+                mfxRange32U height = {};
+                if (cfgPropsAll[ePropDec_Height].Data.Ptr)
+                    height = *((mfxRange32U *)(cfgPropsAll[ePropDec_Height].Data.Ptr));
 
-            if ((height.Max > dc.Height.Max) || (height.Min < dc.Height.Min) ||
-                (height.Step < dc.Height.Step))
-                isCompatible = false;
-        }
-
-        if (isCompatible == true)
-            return MFX_ERR_NONE;
+                if ((height.Max > dc.Height.Max) || (height.Min < dc.Height.Min) ||
+                    (height.Step < dc.Height.Step))
+                    isCompatible = false;
+            }
 
-        it++;
+            if (isCompatible == true)
+                return MFX_ERR_NONE;
+        }
     }
 
     return MFX_ERR_UNSUPPORTED;
 }
 
 mfxStatus ConfigCtxVPL::CheckPropsEnc(const mfxVariant cfgPropsAll[],
-                                      std::list<EncConfig> encConfigList) {
-    auto it = encConfigList.begin();
-    while (it != encConfigList.end()) {
-        EncConfig ec      = (EncConfig)(*it);
-        bool isCompatible = true;
-
-        // check if this encode description includes
-        //   all of the required encoder properties
-        CHECK_PROP(ePropEnc_CodecID, U32, ec.CodecID);
-        CHECK_PROP(ePropEnc_MaxcodecLevel, U16, ec.MaxcodecLevel);
-        CHECK_PROP(ePropEnc_BiDirectionalPrediction, U16, ec.BiDirectionalPrediction);
-        CHECK_PROP(ePropEnc_Profile, U32, ec.Profile);
-        CHECK_PROP(ePropEnc_MemHandleType, U32, ec.MemHandleType);
-        CHECK_PROP(ePropEnc_ColorFormats, U32, ec.ColorFormat);
-
-        // special handling for properties passed via pointer
-        if (cfgPropsAll[ePropEnc_Width].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxRange32U width = {};
-            if (cfgPropsAll[ePropEnc_Width].Data.Ptr)
-                width = *((mfxRange32U *)(cfgPropsAll[ePropEnc_Width].Data.Ptr));
-
-            if ((width.Max > ec.Width.Max) || (width.Min < ec.Width.Min) ||
-                (width.Step < ec.Width.Step))
-                isCompatible = false;
-        }
+                                      const CapsIndexVPL &capsIndex) {
+    mfxU64 formatMask = 0;
+    if (!GetRequestedFormatMask(cfgPropsAll, ePropEnc_ColorFormats, capsIndex, formatMask))
+        return MFX_ERR_UNSUPPORTED;
 
-        if (cfgPropsAll[ePropEnc_Height].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxRange32U height = {};
-            if (cfgPropsAll[ePropEnc_Height].Data.Ptr)
-                height = *((mfxRange32U *)(cfgPropsAll[ePropEnc_Height].Data.Ptr));
+    for (const CapsIndexGroup &group : capsIndex.encGroups) {
+        if (!GroupMayMatch(cfgPropsAll,
+                           group,
+                           ePropEnc_CodecID,
+                           ePropEnc_MemHandleType,
+                           formatMask))
+            continue;
+
+        for (mfxU32 i = group.first; i < group.first + group.count; i++) {
+            const EncConfig &ec = capsIndex.enc[i];
+            bool isCompatible   = true;
+
+            // check if this encode description includes
+            //   all of the required encoder properties
+            CHECK_PROP(ePropEnc_CodecID, U32, ec.CodecID);
+            CHECK_PROP(ePropEnc_MaxcodecLevel, U16, ec.MaxcodecLevel);
+            CHECK_PROP(ePropEnc_BiDirectionalPrediction, U16, ec.BiDirectionalPrediction);
+            CHECK_PROP(ePropEnc_Profile, U32, ec.Profile);
+            CHECK_PROP(ePropEnc_MemHandleType, U32, ec.MemHandleType);
+            CHECK_PROP(ePropEnc_ColorFormats, U32, ec.ColorFormat);
+
+            // special handling for properties passed via pointer
+            if (cfgPropsAll[ePropEnc_Width].Type != MFX_VARIANT_TYPE_UNSET) {
+                mfxRange32U width = {};
+                if (cfgPropsAll[ePropEnc_Width].Data.Ptr)
+                    width = *((mfxRange32U *)(cfgPropsAll[ePropEnc_Width].Data.Ptr));
+
+                if ((width.Max > ec.Width.Max) || (width.Min < ec.Width.Min) ||
+                    (width.Step < ec.Width.Step))
+                    isCompatible = false;
+            }
 
-            if ((height.Max > ec.Height.Max) || (height.Min < ec.Height.Min) ||
-                (height.Step < ec.Height.Step))
-                isCompatible = false;
-        }
+            if (cfgPropsAll[ePropEnc_Height].Type != MFX_VARIANT_TYPE_UNSET) {
+                mfxRange32U height = {};
+                if (cfgPropsAll[ePropEnc_Height].Data.Ptr)
+                    height = *((mfxRange32U *)(cfgPropsAll[ePropEnc_Height].Data.Ptr));
 
-        if (cfgPropsAll[ePropEnc_ReportedStats].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxU16 requestedStats = cfgPropsAll[ePropEnc_ReportedStats].Data.U16;
+                if ((height.Max > ec.Height.Max) || (height.Min < ec.Height.Min) ||
+                    (height.Step < ec.Height.Step))
+                    isCompatible = false;
+            }
 
-            // ReportedStats is a logical OR of one or more flags: MFX_ENCODESTATS_LEVEL_xxx
-            if ((requestedStats & ec.ReportedStats) != requestedStats)
-                isCompatible = false;
-        }
+            if (cfgPropsAll[ePropEnc_ReportedStats].Type != MFX_VARIANT_TYPE_UNSET) {
+                mfxU16 requestedStats = cfgPropsAll[ePropEnc_ReportedStats].Data.U16;
 
-        if (isCompatible == true)
-            return MFX_ERR_NONE;
+                // ReportedStats is a logical OR of one or more flags: MFX_ENCODESTATS_LEVEL_xxx
+                if ((requestedStats & ec.ReportedStats) != requestedStats)
+                    isCompatible = false;
+            }
 
-        it++;
+            if (isCompatible == true)
+                return MFX_ERR_NONE;
+        }
     }
 
     return MFX_ERR_UNSUPPORTED;
 }
 
 mfxStatus ConfigCtxVPL::CheckPropsVPP(const mfxVariant cfgPropsAll[],
-                                      std::list<VPPConfig> vppConfigList) {
-    auto it = vppConfigList.begin();
-    while (it != vppConfigList.end()) {
-        VPPConfig vc      = (VPPConfig)(*it);
-        bool isCompatible = true;
-
-        // check if this filter description includes
-        //   all of the required VPP properties
-        CHECK_PROP(ePropVPP_FilterFourCC, U32, vc.FilterFourCC);
-        CHECK_PROP(ePropVPP_MaxDelayInFrames, U16, vc.MaxDelayInFrames);
-        CHECK_PROP(ePropVPP_MemHandleType, U32, vc.MemHandleType);
-        CHECK_PROP(ePropVPP_InFormat, U32, vc.InFormat);
-        CHECK_PROP(ePropVPP_OutFormat, U32, vc.OutFormat);
-
-        // special handling for properties passed via pointer
-        if (cfgPropsAll[ePropVPP_Width].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxRange32U width = {};
-            if (cfgPropsAll[ePropVPP_Width].Data.Ptr)
-                width = *((mfxRange32U *)(cfgPropsAll[ePropVPP_Width].Data.Ptr));
-
-            if ((width.Max > vc.Width.Max) || (width.Min < vc.Width.Min) ||
-                (width.Step < vc.Width.Step))
-                isCompatible = false;
-        }
+                                      const CapsIndexVPL &capsIndex) {
+    mfxU64 formatMask = 0;
+    if (!GetRequestedFormatMask(cfgPropsAll, ePropVPP_InFormat, capsIndex, formatMask) ||
+        !GetRequestedFormatMask(cfgPropsAll, ePropVPP_OutFormat, capsIndex, formatMask))
+        return MFX_ERR_UNSUPPORTED;
 
-        if (cfgPropsAll[ePropVPP_Height].Type != MFX_VARIANT_TYPE_UNSET) {
-            mfxRange32U height = {};
-            if (cfgPropsAll[ePropVPP_Height].Data.Ptr)
-                height = *((mfxRange32U *)(cfgPropsAll[ePropVPP_Height].Data.Ptr));
+    for (const CapsIndexGroup &group : capsIndex.vppGroups) {
+        if (!GroupMayMatch(cfgPropsAll,
+                           group,
+                           ePropVPP_FilterFourCC,
+                           ePropVPP_MemHandleType,
+                           formatMask))
+            continue;
+
+        for (mfxU32 i = group.first; i < group.first + group.count; i++) {
+            const VPPConfig &vc = capsIndex.vpp[i];
+            bool isCompatible   = true;
+
+            // check if this filter description includes
+            //   all of the required VPP properties
+            CHECK_PROP(ePropVPP_FilterFourCC, U32, vc.FilterFourCC);
+            CHECK_PROP(ePropVPP_MaxDelayInFrames, U16, vc.MaxDelayInFrames);
+            CHECK_PROP(ePropVPP_MemHandleType, U32, vc.MemHandleType);
+            CHECK_PROP(ePropVPP_InFormat, U32, vc.InFormat);
+            CHECK_PROP(ePropVPP_OutFormat, U32, vc.OutFormat);
+
+            // special handling for properties passed via pointer
+            if (cfgPropsAll[ePropVPP_Width].Type != MFX_VARIANT_TYPE_UNSET) {
+                mfxRange32U width = {};
+                if (cfgPropsAll[ePropVPP_Width].Data.Ptr)
+                    width = *((mfxRange32U *)(cfgPropsAll[ePropVPP_Width].Data.Ptr));
+
+                if ((width.Max > vc.Width.Max) || (width.Min < vc.Width.Min) ||
+                    (width.Step < vc.Width.Step))
+                    isCompatible = false;
+            }
 
-            if ((height.Max > vc.Height.Max) || (height.Min < vc.Height.Min) ||
-                (height.Step < vc.Height.Step))
-                isCompatible = false;
-        }
+            if (cfgPropsAll[ePropVPP_Height].Type != MFX_VARIANT_TYPE_UNSET) {
+                mfxRange32U height = {};
+                if (cfgPropsAll[ePropVPP_Height].Data.Ptr)
+                    height = *((mfxRange32U *)(cfgPropsAll[ePropVPP_Height].Data.Ptr));
 
-        if (isCompatible == true)
-            return MFX_ERR_NONE;
+                if ((height.Max > vc.Height.Max) || (height.Min < vc.Height.Min) ||
+                    (height.Step < vc.Height.Step))
+                    isCompatible = false;
+            }
 
-        it++;
+            if (isCompatible == true)
+                return MFX_ERR_NONE;
+        }
     }
 
     return MFX_ERR_UNSUPPORTED;
@@ -1218,9 +1490,9 @@ mfxStatus ConfigCtxVPL::CheckPropsExtDevID(const mfxVariant cfgPropsAll[],
 
     // check string: DeviceName (string match)
     if (cfgPropsAll[ePropExtDev_DeviceName].Type != MFX_VARIANT_TYPE_UNSET) {
-        std::string filtName = *(std::string *)(cfgPropsAll[ePropExtDev_DeviceName].Data.Ptr);
-        std::string implName = libImplExtDevID->DeviceName;
-        if (filtName != implName)
+        const std::string &filtName =
+            *(std::string *)(cfgPropsAll[ePropExtDev_DeviceName].Data.Ptr);
+        if (filtName != libImplExtDevID->DeviceName)
             isCompatible = false;
     }
 
@@ -1232,10 +1504,8 @@ mfxStatus ConfigCtxVPL::CheckPropsExtDevID(const mfxVariant cfgPropsAll[],
 
 #ifdef ONEVPL_EXPERIMENTAL
 mfxStatus ConfigCtxVPL::CheckPropsSurface(const mfxVariant cfgPropsAll[],
-                                          std::list<SurfaceConfig> surfaceConfigList) {
-    auto it = surfaceConfigList.begin();
-    while (it != surfaceConfigList.end()) {
-        SurfaceConfig sc  = (SurfaceConfig)(*it);
+                                          const CapsIndexVPL &capsIndex) {
+    for (const SurfaceConfig &sc : capsIndex.surface) {
         bool isCompatible = true;
 
         // check if this filter description includes
@@ -1252,78 +1522,188 @@ mfxStatus ConfigCtxVPL::CheckPropsSurface(const mfxVariant cfgPropsAll[],
 
         if (isCompatible == true)
             return MFX_ERR_NONE;
-
-        it++;
     }
 
     return MFX_ERR_UNSUPPORTED;
 }
 #endif
 
-// implString = string from implDesc - one or more comma-separated tokens
+// implTokens = tokens of string from implDesc, split when the caps index was built
 // filtString = string user is looking for - one or more comma-separated tokens
-// we parse filtString into tokens, then check if all of them are present in implString
-mfxStatus ConfigCtxVPL::CheckPropString(const mfxChar *implString, const std::string filtString) {
-    std::list<std::string> tokenString;
-    std::string s;
-
-    // parse implString string into tokens, separated by ','
-    std::stringstream implSS((char *)implString);
-    while (getline(implSS, s, ',')) {
-        tokenString.push_back(s);
-    }
-
+// we parse filtString into tokens, then check if all of them are present in implTokens
+mfxStatus ConfigCtxVPL::CheckPropString(const std::vector<std::string> &implTokens,
+                                        const std::string &filtString) {
     // parse filtString string into tokens, separated by ','
-    // check that each token is present in implString, otherwise return error
-    std::stringstream filtSS(filtString);
-    while (getline(filtSS, s, ',')) {
-        if (std::find(tokenString.begin(), tokenString.end(), s) == tokenString.end())
+    // check that each token is present in implTokens, otherwise return error
+    size_t start = 0;
+    while (start < filtString.size()) {
+        size_t end = filtString.find(',', start);
+        if (end == std::string::npos)
+            end = filtString.size();
+
+        bool bFound = false;
+        for (const std::string &token : implTokens) {
+            if (filtString.compare(start, end - start, token) == 0) {
+                bFound = true;
+                break;
+            }
+        }
+
+        if (!bFound)
             return MFX_ERR_UNSUPPORTED;
+
+        start = end + 1;
     }
 
     return MFX_ERR_NONE;
 }
 
+// copy properties of a single config object
+// required function name is not copied, it is checked with m_implFunctionName
+static void GetConfigProps(const mfxVariant propVar[], mfxVariant cfgPropsAll[]) {
+    for (mfxU32 idx = 0; idx < eProp_TotalProps; idx++) {
+        cfgPropsAll[idx].Type = MFX_VARIANT_TYPE_UNSET;
+
+        // ignore unset properties
+        if (propVar[idx].Type == MFX_VARIANT_TYPE_UNSET || idx == ePropFunc_FunctionName)
+            continue;
+
+        cfgPropsAll[idx].Type = propVar[idx].Type;
+        cfgPropsAll[idx].Data = propVar[idx].Data;
+    }
+}
+
+mfxU32 ConfigCtxVPL::CheckPropGroups(mfxU32 groupMask,
+                                     const mfxImplDescription *libImplDesc,
+                                     const mfxImplementedFunctions *libImplFuncs,
+                                     const mfxExtendedDeviceId *libImplExtDevID,
+#ifdef ONEVPL_EXPERIMENTAL
+                                     const mfxSurfaceTypesSupported *libImplSurfTypes,
+#endif
+                                     const CapsIndexVPL &capsIndex,
+                                     LibType libType) const {
+    mfxVariant cfgPropsAll[eProp_TotalProps];
+    GetConfigProps(m_propVar, cfgPropsAll);
+
+    // groups with at least one property set
+    mfxU32 requestedMask = 0;
+    for (mfxU32 idx = 0; idx < eProp_TotalProps; idx++) {
+        if (m_propVar[idx].Type != MFX_VARIANT_TYPE_UNSET)
+            requestedMask |= (1u << GetPropGroup(idx));
+    }
+
+    mfxU32 failMask = 0;
+
+    if (groupMask & (1u << PROP_GROUP_GENERAL)) {
+        if (CheckPropsGeneral(cfgPropsAll, libImplDesc, capsIndex))
+            failMask |= (1u << PROP_GROUP_GENERAL);
+    }
+
+    mfxU32 checkMask = groupMask & requestedMask;
+
+    if (checkMask & (1u << PROP_GROUP_EXTDEV)) {
+        // fail if extDevID is not available (null) or if prop is not supported
+        if (!libImplExtDevID || CheckPropsExtDevID(cfgPropsAll, libImplExtDevID))
+            failMask |= (1u << PROP_GROUP_EXTDEV);
+    }
+
+    if (checkMask & (1u << PROP_GROUP_SURFACE)) {
+#ifdef ONEVPL_EXPERIMENTAL
+        if (!libImplSurfTypes || CheckPropsSurface(cfgPropsAll, capsIndex))
+            failMask |= (1u << PROP_GROUP_SURFACE);
+#else
+        failMask |= (1u << PROP_GROUP_SURFACE);
+#endif
+    }
+
+    // MSDK RT compatibility mode (1.x) does not provide Dec/Enc/VPP caps
+    // ignore these filters if set (do not use them to _exclude_ the library)
+    if (libType != LibTypeMSDK) {
+        if ((checkMask & (1u << PROP_GROUP_DEC)) && CheckPropsDec(cfgPropsAll, capsIndex))
+            failMask |= (1u << PROP_GROUP_DEC);
+
+        if ((checkMask & (1u << PROP_GROUP_ENC)) && CheckPropsEnc(cfgPropsAll, capsIndex))
+            failMask |= (1u << PROP_GROUP_ENC);
+
+        if ((checkMask & (1u << PROP_GROUP_VPP)) && CheckPropsVPP(cfgPropsAll, capsIndex))
+            failMask |= (1u << PROP_GROUP_VPP);
+    }
+
+    // check whether required function is implemented
+    if (checkMask & (1u << PROP_GROUP_FUNCTION)) {
+        bool bFound = false;
+
+        // library may not provide list of implemented functions
+        if (libImplFuncs) {
+            for (mfxU32 fnIdx = 0; fnIdx < libImplFuncs->NumFunctions; fnIdx++) {
+                if (m_implFunctionName == libImplFuncs->FunctionsName[fnIdx]) {
+                    bFound = true;
+                    break;
+                }
+            }
+        }
+
+        if (!bFound)
+            failMask |= (1u << PROP_GROUP_FUNCTION);
+    }
+
+    return failMask;
+}
+
+// find memoized result for config object, adding a new one if not found
+// returns nullptr if results are not memoized
+static ConfigResultVPL *GetConfigResult(std::vector<ConfigResultVPL> *configResults,
+                                        mfxU64 configId) {
+    if (!configResults)
+        return nullptr;
+
+    for (ConfigResultVPL &result : *configResults) {
+        if (result.configId == configId)
+            return &result;
+    }
+
+    ConfigResultVPL result = {};
+    result.configId        = configId;
+
+    try {
+        configResults->push_back(result);
+    }
+    catch (...) {
+        return nullptr;
+    }
+
+    return &configResults->back();
+}
+
 mfxStatus ConfigCtxVPL::ValidateConfig(const mfxImplDescription *libImplDesc,
                                        const mfxImplementedFunctions *libImplFuncs,
                                        const mfxExtendedDeviceId *libImplExtDevID,
 #ifdef ONEVPL_EXPERIMENTAL
                                        const mfxSurfaceTypesSupported *libImplSurfTypes,
 #endif
-                                       std::list<ConfigCtxVPL *> configCtxList,
+                                       const CapsIndexVPL *capsIndex,
+                                       const std::list<ConfigCtxVPL *> &configCtxList,
                                        LibType libType,
-                                       SpecialConfig *specialConfig) {
-    mfxU32 idx;
-    bool decRequested    = false;
-    bool encRequested    = false;
-    bool vppRequested    = false;
-    bool extDevRequested = false;
-
-    bool surfaceRequested = false;
-
+                                       SpecialConfig *specialConfig,
+                                       std::vector<ConfigResultVPL> *configResults) {
     bool bImplValid = true;
 
     if (!libImplDesc)
         return MFX_ERR_NULL_PTR;
 
-    std::list<DecConfig> decConfigList;
-    std::list<EncConfig> encConfigList;
-    std::list<VPPConfig> vppConfigList;
-    std::list<SurfaceConfig> surfaceConfigList;
-
-    // generate "flat" descriptions of each combination
-    //   (e.g. multiple profiles from the same codec)
-    GetFlatDescriptionsDec(libImplDesc, decConfigList);
-    GetFlatDescriptionsEnc(libImplDesc, encConfigList);
-    GetFlatDescriptionsVPP(libImplDesc, vppConfigList);
-
+    // index is normally built once when caps are queried
+    CapsIndexVPL localCapsIndex;
+    if (!capsIndex) {
+        mfxStatus sts = BuildCapsIndex(libImplDesc,
 #ifdef ONEVPL_EXPERIMENTAL
-    GetFlatDescriptionsSurface(libImplSurfTypes, surfaceConfigList);
+                                       libImplSurfTypes,
 #endif
+                                       localCapsIndex);
+        if (sts != MFX_ERR_NONE)
+            return sts;
 
-    // list of functions required to be implemented
-    std::list<std::string> implFunctionList;
-    implFunctionList.clear();
+        capsIndex = &localCapsIndex;
+    }
 
     // check requested API version
     mfxVersion reqVersion = {};
@@ -1335,78 +1715,80 @@ mfxStatus ConfigCtxVPL::ValidateConfig(const mfxImplDescription *libImplDesc,
     specialConfig->ExtBuffers.clear();
 
     // iterate through all filters and populate cfgPropsAll
-    auto it = configCtxList.begin();
-
-    while (it != configCtxList.end()) {
-        ConfigCtxVPL *config = (*it);
-        it++;
-
-        // initially all properties are unset
-        mfxVariant cfgPropsAll[eProp_TotalProps] = {};
-        for (idx = 0; idx < eProp_TotalProps; idx++) {
-            cfgPropsAll[idx].Type = MFX_VARIANT_TYPE_UNSET;
-        }
-
-        for (idx = 0; idx < eProp_TotalProps; idx++) {
-            // ignore unset properties
-            if (config->m_propVar[idx].Type == MFX_VARIANT_TYPE_UNSET)
-                continue;
-
-            // if property is required function, add to list which will be checked below
-            if (idx == ePropFunc_FunctionName) {
-                implFunctionList.push_back(config->m_implFunctionName);
-                continue;
-            }
-
-            cfgPropsAll[idx].Type = config->m_propVar[idx].Type;
-            cfgPropsAll[idx].Data = config->m_propVar[idx].Data;
-
-            if (idx >= ePropDec_CodecID && idx <= ePropDec_ColorFormats)
-                decRequested = true;
-            else if (idx >= ePropEnc_CodecID && idx <= ePropEnc_ColorFormats)
-                encRequested = true;
-            else if (idx >= ePropVPP_FilterFourCC && idx <= ePropVPP_OutFormat)
-                vppRequested = true;
-            else if (idx >= ePropExtDev_VendorID && idx <= ePropExtDev_DeviceName)
-                extDevRequested = true;
-            else if (idx >= ePropSurface_SurfaceType && idx <= ePropSurface_SurfaceFlags)
-                surfaceRequested = true;
-        }
+    for (const ConfigCtxVPL *config : configCtxList) {
+        mfxVariant cfgPropsAll[eProp_TotalProps];
+        GetConfigProps(config->m_propVar, cfgPropsAll);
 
         // if already marked invalid, no need to check props again
         // however we still need to iterate over all of the config objects
         //   to get any non-filtering properties (returned in SpecialConfig)
         if (bImplValid == true) {
-            if (CheckPropsGeneral(cfgPropsAll, libImplDesc))
-                bImplValid = false;
+            ConfigResultVPL *result = GetConfigResult(configResults, config->m_configId);
 
-            if (extDevRequested) {
-                // fail if extDevID is not available (null) or if prop is not supported
-                if (!libImplExtDevID || CheckPropsExtDevID(cfgPropsAll, libImplExtDevID))
-                    bImplValid = false;
+            // only check groups which changed since the last call (all groups if not memoized)
+            mfxU32 staleMask = 0;
+            for (mfxU32 group = 0; group < NUM_PROP_GROUPS; group++) {
+                if (!result || result->groupGeneration[group] != config->m_groupGeneration[group])
+                    staleMask |= (1u << group);
             }
+
+            mfxU32 failMask = config->CheckPropGroups(staleMask,
+                                                      libImplDesc,
+                                                      libImplFuncs,
+                                                      libImplExtDevID,
 #ifdef ONEVPL_EXPERIMENTAL
-            if (surfaceRequested) {
-                if (!libImplSurfTypes || CheckPropsSurface(cfgPropsAll, surfaceConfigList))
-                    bImplValid = false;
-            }
-#else
-            if (surfaceRequested)
-                bImplValid = false;
+                                                      libImplSurfTypes,
 #endif
+                                                      *capsIndex,
+                                                      libType);
 
-            // MSDK RT compatibility mode (1.x) does not provide Dec/Enc/VPP caps
-            // ignore these filters if set (do not use them to _exclude_ the library)
-            if (libType != LibTypeMSDK) {
-                if (decRequested && CheckPropsDec(cfgPropsAll, decConfigList))
-                    bImplValid = false;
+            if (result) {
+                result->failMask = (result->failMask & ~staleMask) | failMask;
+                std::copy(config->m_groupGeneration,
+                          config->m_groupGeneration + NUM_PROP_GROUPS,
+                          result->groupGeneration);
 
-                if (encRequested && CheckPropsEnc(cfgPropsAll, encConfigList))
-                    bImplValid = false;
+                failMask = result->failMask;
+            }
+
+            // all properties of the config match, so at least one alternative must also match
+            if (!failMask && !config->m_altList.empty()) {
+                mfxI32 altIdx = -1;
+
+                if (result && result->altGeneration == config->m_altGeneration) {
+                    altIdx = result->altIdx;
+                }
+                else {
+                    mfxI32 idx = 0;
+                    for (const ConfigCtxVPL *altConfig : config->m_altList) {
+                        // alternatives are not memoized, so all groups are checked
+                        if (!altConfig->CheckPropGroups((1u << NUM_PROP_GROUPS) - 1,
+                                                        libImplDesc,
+                                                        libImplFuncs,
+                                                        libImplExtDevID,
+#ifdef ONEVPL_EXPERIMENTAL
+                                                        libImplSurfTypes,
+#endif
+                                                        *capsIndex,
+                                                        libType)) {
+                            altIdx = idx;
+                            break;
+                        }
+                        idx++;
+                    }
+
+                    if (result) {
+                        result->altGeneration = config->m_altGeneration;
+                        result->altIdx        = altIdx;
+                    }
+                }
 
-                if (vppRequested && CheckPropsVPP(cfgPropsAll, vppConfigList))
+                if (altIdx < 0)
                     bImplValid = false;
             }
+
+            if (failMask)
+                bImplValid = false;
         }
 
         // update any special (including non-filtering) properties, for use by caller
@@ -1438,6 +1820,11 @@ mfxStatus ConfigCtxVPL::ValidateConfig(const mfxImplDescription *libImplDesc,
             specialConfig->bIsSet_dxgiAdapterIdx = true;
         }
 
+        if (cfgPropsAll[ePropSpecial_SessionProfile].Type != MFX_VARIANT_TYPE_UNSET) {
+            specialConfig->SessionProfile = cfgPropsAll[ePropSpecial_SessionProfile].Data.U16;
+            specialConfig->bIsSet_SessionProfile = true;
+        }
+
         if (cfgPropsAll[ePropMain_AccelerationMode].Type != MFX_VARIANT_TYPE_UNSET) {
             specialConfig->accelerationMode =
                 (mfxAccelerationMode)cfgPropsAll[ePropMain_AccelerationMode].Data.U32;
@@ -1482,29 +1869,6 @@ mfxStatus ConfigCtxVPL::ValidateConfig(const mfxImplDescription *libImplDesc,
     if (bImplValid == false)
         return MFX_ERR_UNSUPPORTED;
 
-    // check whether required functions are implemented
-    if (!implFunctionList.empty()) {
-        if (!libImplFuncs) {
-            // library did not provide list of implemented functions
-            return MFX_ERR_UNSUPPORTED;
-        }
-
-        auto fn = implFunctionList.begin();
-        while (fn != implFunctionList.end()) {
-            std::string fnName = (*fn++);
-            mfxU32 fnIdx;
-
-            // search for fnName in list of implemented functions
-            for (fnIdx = 0; fnIdx < libImplFuncs->NumFunctions; fnIdx++) {
-                if (fnName == libImplFuncs->FunctionsName[fnIdx])
-                    break;
-            }
-
-            if (fnIdx == libImplFuncs->NumFunctions)
-                return MFX_ERR_UNSUPPORTED;
-        }
-    }
-
     return MFX_ERR_NONE;
 }
 
@@ -1533,6 +1897,10 @@ bool ConfigCtxVPL::CheckLowLatencyConfig(std::list<ConfigCtxVPL *> configCtxList
         ConfigCtxVPL *config = (*it);
         it++;
 
+        // alternatives require caps of all implementations
+        if (!config->m_altList.empty())
+            bLowLatency = false;
+
         for (idx = 0; idx < eProp_TotalProps; idx++) {
             // ignore unset properties
             if (config->m_propVar[idx].Type == MFX_VARIANT_TYPE_UNSET)
@@ -1626,6 +1994,14 @@ bool ConfigCtxVPL::CheckLowLatencyConfig(std::list<ConfigCtxVPL *> configCtxList
                 }
                 break;
 
+            case ePropSpecial_SessionProfile:
+                if (cfgPropsAll[ePropSpecial_SessionProfile].Type != MFX_VARIANT_TYPE_UNSET) {
+                    specialConfig->SessionProfile =
+                        cfgPropsAll[ePropSpecial_SessionProfile].Data.U16;
+                    specialConfig->bIsSet_SessionProfile = true;
+                }
+                break;
+
             case ePropSpecial_ExtBuffer:
                 // extBufs were already pushed into the overall list, above
                 break;
@@ -1650,6 +2026,39 @@ bool ConfigCtxVPL::CheckLowLatencyConfig(std::list<ConfigCtxVPL *> configCtxList
     return bLowLatency;
 }
 
+// encoder requested by the filters, used to rank implementations by throughput
+// returns false unless the encoder CodecID is set to a single value
+// width and height are the maximum of the requested ranges, or 0 if not set
+bool ConfigCtxVPL::GetRequestedEncoder(const std::list<ConfigCtxVPL *> &configCtxList,
+                                       mfxU32 &codecID,
+                                       mfxU32 &width,
+                                       mfxU32 &height) {
+    bool bCodecSet = false;
+
+    width  = 0;
+    height = 0;
+
+    // as with low latency mode, the most recent value of each property is used
+    for (const ConfigCtxVPL *config : configCtxList) {
+        const mfxVariant *propVar = config->m_propVar;
+
+        if (propVar[ePropEnc_CodecID].Type == MFX_VARIANT_TYPE_U32) {
+            codecID   = propVar[ePropEnc_CodecID].Data.U32;
+            bCodecSet = true;
+        }
+
+        if (propVar[ePropEnc_Width].Type != MFX_VARIANT_TYPE_UNSET &&
+            propVar[ePropEnc_Width].Data.Ptr)
+            width = ((mfxRange32U *)(propVar[ePropEnc_Width].Data.Ptr))->Max;
+
+        if (propVar[ePropEnc_Height].Type != MFX_VARIANT_TYPE_UNSET &&
+            propVar[ePropEnc_Height].Data.Ptr)
+            height = ((mfxRange32U *)(propVar[ePropEnc_Height].Data.Ptr))->Max;
+    }
+
+    return bCodecSet;
+}
+
 bool ConfigCtxVPL::ParseDeviceIDx86(mfxChar *cDeviceID, mfxU32 &deviceID, mfxU32 &adapterIdx) {
     std::string strDevID(cDeviceID);
     std::regex reDevIDAll("[0-9a-fA-F]+/[0-9]+");
@@ -0,0 +1,364 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include "src/mfx_dispatcher_vpl.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+    #include <elf.h>
+    #include <fcntl.h>
+    #include <link.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+
+// Intel® VPL dispatcher check of runtime exports (ONEVPL_EXPORT_CHECK)
+//
+// The library file is mapped read-only, and the dynamic section is used to
+//   locate the dynamic symbol table, string table, and hash table, the same way
+//   as the dynamic linker does. Section headers are not used, since they may be
+//   stripped. Symbols are looked up with the GNU hash table (DT_GNU_HASH) if present,
+//   otherwise with the SysV hash table (DT_HASH).
+// Only libraries which could be loaded into this process (same ELF class and byte
+//   order) are parsed. All offsets read from the file are checked against its size,
+//   and anything unexpected makes Open() fail, so the library is loaded as before.
+
+ElfExportsVPL::ElfExportsVPL()
+        : m_data(nullptr),
+          m_size(0),
+          m_dynSym(nullptr),
+          m_dynStr(nullptr),
+          m_dynStrSize(0),
+          m_gnuHash(nullptr),
+          m_sysvHash(nullptr) {}
+
+ElfExportsVPL::~ElfExportsVPL() {
+    Close();
+}
+
+    #if __SIZEOF_POINTER__ == 8
+        #define ELF_CLASS_NATIVE ELFCLASS64
+    #else
+        #define ELF_CLASS_NATIVE ELFCLASS32
+    #endif
+
+    #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        #define ELF_DATA_NATIVE ELFDATA2LSB
+    #else
+        #define ELF_DATA_NATIVE ELFDATA2MSB
+    #endif
+
+    // st_info and st_other fields are decoded the same way in both ELF classes
+    #define ELF_ST_BIND_VPL(info)      ELF32_ST_BIND(info)
+    #define ELF_ST_TYPE_VPL(info)      ELF32_ST_TYPE(info)
+    #define ELF_ST_VISIBILITY_VPL(oth) ELF32_ST_VISIBILITY(oth)
+
+    // number of bits in each word of the GNU hash bloom filter
+    #define ELF_BLOOM_BITS (sizeof(ElfW(Addr)) * 8)
+
+static mfxU32 GnuHash(const char *name) {
+    mfxU32 h = 5381;
+    for (const unsigned char *c = (const unsigned char *)name; *c; c++)
+        h = (h << 5) + h + *c;
+
+    return h;
+}
+
+static mfxU32 SysvHash(const char *name) {
+    mfxU32 h = 0;
+    for (const unsigned char *c = (const unsigned char *)name; *c; c++) {
+        h = (h << 4) + *c;
+
+        mfxU32 g = h & 0xf0000000;
+        if (g)
+            h ^= g >> 24;
+        h &= ~g;
+    }
+
+    return h;
+}
+
+mfxStatus ElfExportsVPL::Open(const STRING_TYPE &libNameFull) {
+    Close();
+
+    int fd = open(libNameFull.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return MFX_ERR_NOT_FOUND;
+
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < (off_t)sizeof(ElfW(Ehdr))) {
+        close(fd);
+        return MFX_ERR_UNSUPPORTED;
+    }
+
+    void *data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        return MFX_ERR_UNSUPPORTED;
+
+    m_data = (const mfxU8 *)data;
+    m_size = (size_t)st.st_size;
+
+    mfxStatus sts = ParseDynamic();
+    if (sts != MFX_ERR_NONE)
+        Close();
+
+    return sts;
+}
+
+void ElfExportsVPL::Close() {
+    if (m_data)
+        munmap((void *)m_data, m_size);
+
+    m_data       = nullptr;
+    m_size       = 0;
+    m_dynSym     = nullptr;
+    m_dynStr     = nullptr;
+    m_dynStrSize = 0;
+    m_gnuHash    = nullptr;
+    m_sysvHash   = nullptr;
+}
+
+bool ElfExportsVPL::IsInFile(const void *ptr, size_t size) {
+    const mfxU8 *p = (const mfxU8 *)ptr;
+
+    return (p >= m_data && p <= m_data + m_size && size <= (size_t)(m_data + m_size - p));
+}
+
+// locate the tables used for symbol lookup from the dynamic section
+mfxStatus ElfExportsVPL::ParseDynamic() {
+    const ElfW(Ehdr) *ehdr = (const ElfW(Ehdr) *)m_data;
+
+    if (memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0 ||
+        ehdr->e_ident[EI_CLASS] != ELF_CLASS_NATIVE || ehdr->e_ident[EI_DATA] != ELF_DATA_NATIVE ||
+        ehdr->e_type != ET_DYN || ehdr->e_phentsize != sizeof(ElfW(Phdr)))
+        return MFX_ERR_UNSUPPORTED;
+
+    const ElfW(Phdr) *phdr = (const ElfW(Phdr) *)(m_data + ehdr->e_phoff);
+    if (ehdr->e_phoff > m_size || ehdr->e_phoff % alignof(ElfW(Phdr)) ||
+        !IsInFile(phdr, (size_t)ehdr->e_phnum * sizeof(ElfW(Phdr))))
+        return MFX_ERR_UNSUPPORTED;
+
+    // addresses in the dynamic section are translated to file offsets with
+    //   the loadable segments
+    auto addrToPtr = [&](ElfW(Addr) addr) -> const mfxU8 * {
+        for (mfxU32 i = 0; i < ehdr->e_phnum; i++) {
+            if (phdr[i].p_type != PT_LOAD)
+                continue;
+
+            if (addr >= phdr[i].p_vaddr && addr - phdr[i].p_vaddr < phdr[i].p_filesz) {
+                ElfW(Off) offset = phdr[i].p_offset + (addr - phdr[i].p_vaddr);
+                return (offset < m_size ? m_data + offset : nullptr);
+            }
+        }
+        return nullptr;
+    };
+
+    const ElfW(Dyn) *dyn = nullptr;
+    size_t numDyn        = 0;
+    for (mfxU32 i = 0; i < ehdr->e_phnum; i++) {
+        if (phdr[i].p_type == PT_DYNAMIC) {
+            dyn    = (const ElfW(Dyn) *)(m_data + phdr[i].p_offset);
+            numDyn = phdr[i].p_filesz / sizeof(ElfW(Dyn));
+            if (phdr[i].p_offset > m_size || phdr[i].p_offset % alignof(ElfW(Dyn)) ||
+                !IsInFile(dyn, numDyn * sizeof(ElfW(Dyn))))
+                return MFX_ERR_UNSUPPORTED;
+            break;
+        }
+    }
+
+    if (!dyn)
+        return MFX_ERR_UNSUPPORTED;
+
+    ElfW(Addr) symTabAddr = 0, strTabAddr = 0, gnuHashAddr = 0, sysvHashAddr = 0;
+    size_t strTabSize = 0, symEntSize = sizeof(ElfW(Sym));
+
+    for (size_t i = 0; i < numDyn && dyn[i].d_tag != DT_NULL; i++) {
+        switch (dyn[i].d_tag) {
+            case DT_SYMTAB:
+                symTabAddr = dyn[i].d_un.d_ptr;
+                break;
+            case DT_STRTAB:
+                strTabAddr = dyn[i].d_un.d_ptr;
+                break;
+            case DT_STRSZ:
+                strTabSize = (size_t)dyn[i].d_un.d_val;
+                break;
+            case DT_SYMENT:
+                symEntSize = (size_t)dyn[i].d_un.d_val;
+                break;
+            case DT_GNU_HASH:
+                gnuHashAddr = dyn[i].d_un.d_ptr;
+                break;
+            case DT_HASH:
+                sysvHashAddr = dyn[i].d_un.d_ptr;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (symEntSize != sizeof(ElfW(Sym)))
+        return MFX_ERR_UNSUPPORTED;
+
+    m_dynSym     = addrToPtr(symTabAddr);
+    m_dynStr     = (const char *)addrToPtr(strTabAddr);
+    m_dynStrSize = strTabSize;
+    if (gnuHashAddr)
+        m_gnuHash = (const mfxU32 *)addrToPtr(gnuHashAddr);
+    if (sysvHashAddr)
+        m_sysvHash = (const mfxU32 *)addrToPtr(sysvHashAddr);
+
+    if (!m_dynSym || (size_t)m_dynSym % alignof(ElfW(Sym)))
+        return MFX_ERR_UNSUPPORTED;
+
+    if (!m_dynStr || !IsInFile(m_dynStr, m_dynStrSize))
+        return MFX_ERR_UNSUPPORTED;
+
+    // the GNU hash table contains an array of words of the native size
+    if ((size_t)m_gnuHash % alignof(ElfW(Addr)))
+        m_gnuHash = nullptr;
+    if ((size_t)m_sysvHash % alignof(mfxU32))
+        m_sysvHash = nullptr;
+
+    // without a hash table the number of symbols is not known
+    if (!m_gnuHash && !m_sysvHash)
+        return MFX_ERR_UNSUPPORTED;
+
+    return MFX_ERR_NONE;
+}
+
+const void *ElfExportsVPL::GetSymbol(mfxU32 idx) {
+    const ElfW(Sym) *sym = (const ElfW(Sym) *)m_dynSym + idx;
+
+    return (IsInFile(sym, sizeof(ElfW(Sym))) ? sym : nullptr);
+}
+
+bool ElfExportsVPL::IsSymbolName(const void *sym, const char *name) {
+    size_t nameOffset = ((const ElfW(Sym) *)sym)->st_name;
+    size_t nameLen    = strlen(name);
+
+    if (nameOffset >= m_dynStrSize || nameLen >= m_dynStrSize - nameOffset)
+        return false;
+
+    // compare including the terminating null
+    return (memcmp(m_dynStr + nameOffset, name, nameLen + 1) == 0);
+}
+
+const void *ElfExportsVPL::FindSymbolGnuHash(const char *name) {
+    // header: nbuckets, symoffset, bloom size, bloom shift
+    if (!IsInFile(m_gnuHash, 4 * sizeof(mfxU32)))
+        return nullptr;
+
+    mfxU32 numBuckets = m_gnuHash[0];
+    mfxU32 symOffset  = m_gnuHash[1];
+    mfxU32 bloomSize  = m_gnuHash[2];
+    mfxU32 bloomShift = m_gnuHash[3];
+
+    const ElfW(Addr) *bloom = (const ElfW(Addr) *)(m_gnuHash + 4);
+    const mfxU32 *buckets   = (const mfxU32 *)(bloom + bloomSize);
+    const mfxU32 *chain     = buckets + numBuckets;
+
+    if (numBuckets == 0 || bloomSize == 0 || !IsInFile(bloom, bloomSize * sizeof(ElfW(Addr))) ||
+        !IsInFile(buckets, numBuckets * sizeof(mfxU32)))
+        return nullptr;
+
+    mfxU32 h1 = GnuHash(name);
+
+    // bloom filter rejects most names which are not defined
+    ElfW(Addr) word = bloom[(h1 / ELF_BLOOM_BITS) % bloomSize];
+    ElfW(Addr) mask = ((ElfW(Addr))1 << (h1 % ELF_BLOOM_BITS)) |
+                      ((ElfW(Addr))1 << ((h1 >> bloomShift) % ELF_BLOOM_BITS));
+    if ((word & mask) != mask)
+        return nullptr;
+
+    mfxU32 symIdx = buckets[h1 % numBuckets];
+    if (symIdx < symOffset)
+        return nullptr;
+
+    // names in one bucket are in consecutive symbols, the last one has bit 0 set
+    //   in its chain entry
+    for (;; symIdx++) {
+        const mfxU32 *h2 = chain + (symIdx - symOffset);
+        if (symIdx < symOffset || !IsInFile(h2, sizeof(mfxU32)))
+            return nullptr;
+
+        if ((h1 | 1) == (*h2 | 1)) {
+            const void *sym = GetSymbol(symIdx);
+            if (!sym)
+                return nullptr;
+
+            if (IsSymbolName(sym, name))
+                return sym;
+        }
+
+        if (*h2 & 1)
+            break;
+    }
+
+    return nullptr;
+}
+
+const void *ElfExportsVPL::FindSymbolSysvHash(const char *name) {
+    // header: nbucket, nchain
+    if (!IsInFile(m_sysvHash, 2 * sizeof(mfxU32)))
+        return nullptr;
+
+    mfxU32 numBuckets = m_sysvHash[0];
+    mfxU32 numChain   = m_sysvHash[1];
+
+    const mfxU32 *buckets = m_sysvHash + 2;
+    const mfxU32 *chain   = buckets + numBuckets;
+
+    if (numBuckets == 0 || !IsInFile(buckets, ((size_t)numBuckets + numChain) * sizeof(mfxU32)))
+        return nullptr;
+
+    // at most numChain steps, in case the chain has a loop
+    mfxU32 symIdx = buckets[SysvHash(name) % numBuckets];
+    for (mfxU32 i = 0; i < numChain && symIdx != STN_UNDEF && symIdx < numChain; i++) {
+        const void *sym = GetSymbol(symIdx);
+        if (!sym)
+            return nullptr;
+
+        if (IsSymbolName(sym, name))
+            return sym;
+
+        symIdx = chain[symIdx];
+    }
+
+    return nullptr;
+}
+
+const void *ElfExportsVPL::FindSymbol(const char *name) {
+    if (m_gnuHash)
+        return FindSymbolGnuHash(name);
+
+    return FindSymbolSysvHash(name);
+}
+
+bool ElfExportsVPL::HasFunction(const char *name) {
+    if (!m_data)
+        return false;
+
+    const ElfW(Sym) *sym = (const ElfW(Sym) *)FindSymbol(name);
+    if (!sym || sym->st_shndx == SHN_UNDEF)
+        return false;
+
+    // dlsym() only returns global symbols with default or protected visibility
+    mfxU32 bind       = ELF_ST_BIND_VPL(sym->st_info);
+    mfxU32 type       = ELF_ST_TYPE_VPL(sym->st_info);
+    mfxU32 visibility = ELF_ST_VISIBILITY_VPL(sym->st_other);
+
+    if (bind != STB_GLOBAL && bind != STB_WEAK && bind != STB_GNU_UNIQUE)
+        return false;
+
+    if (type != STT_FUNC && type != STT_GNU_IFUNC)
+        return false;
+
+    return (visibility == STV_DEFAULT || visibility == STV_PROTECTED);
+}
+
+#endif
@@ -0,0 +1,281 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include <string.h>
+
+#include "src/mfx_dispatcher_vpl.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+
+// Intel® VPL flat caps descriptor (MFX_IMPLCAPS_FLAT)
+//
+// Layout: mfxImplCapsFlat, followed by the Dec, Enc, and VPP tables of
+//   mfxCapsFlatEntry, each at an 8-byte aligned offset from the start of the block.
+//   There are no pointers, so the block may be copied or mapped at any address.
+// Entries are taken from the caps index (one per codec/profile/memory/format combination)
+//   and sorted by key fields, so MFXFindCapsFlatEntry() finds the entries which match
+//   a query with a binary search.
+
+// Dec and Enc: ID, Profile, MemHandleType, Format
+// VPP: ID, MemHandleType, Format, OutFormat
+// Profile is 0 in VPP entries and OutFormat in Dec and Enc entries, so they are not part of the
+//   key, otherwise a query which sets them would stop the binary search at ID
+#define NUM_KEY_FIELDS 4
+
+static void GetKey(const mfxCapsFlatEntry &e, bool bVPP, mfxU32 key[NUM_KEY_FIELDS]) {
+    key[0] = e.ID;
+    if (bVPP) {
+        key[1] = e.MemHandleType;
+        key[2] = e.Format;
+        key[3] = e.OutFormat;
+    }
+    else {
+        key[1] = e.Profile;
+        key[2] = e.MemHandleType;
+        key[3] = e.Format;
+    }
+}
+
+// compare the first numFields key fields
+static bool KeyLess(const mfxCapsFlatEntry &e1,
+                    const mfxCapsFlatEntry &e2,
+                    bool bVPP,
+                    mfxU32 numFields) {
+    mfxU32 key1[NUM_KEY_FIELDS], key2[NUM_KEY_FIELDS];
+    GetKey(e1, bVPP, key1);
+    GetKey(e2, bVPP, key2);
+
+    for (mfxU32 i = 0; i < numFields; i++) {
+        if (key1[i] != key2[i])
+            return (key1[i] < key2[i]);
+    }
+
+    return false;
+}
+
+static mfxCapsFlatEntry MakeEntry(const DecConfig &c) {
+    mfxCapsFlatEntry e = {};
+    e.ID               = c.CodecID;
+    e.Profile          = c.Profile;
+    e.MemHandleType    = c.MemHandleType;
+    e.Format           = c.ColorFormat;
+    e.Width            = c.Width;
+    e.Height           = c.Height;
+    e.MaxcodecLevel    = c.MaxcodecLevel;
+    return e;
+}
+
+static mfxCapsFlatEntry MakeEntry(const EncConfig &c) {
+    mfxCapsFlatEntry e        = {};
+    e.ID                      = c.CodecID;
+    e.Profile                 = c.Profile;
+    e.MemHandleType           = c.MemHandleType;
+    e.Format                  = c.ColorFormat;
+    e.Width                   = c.Width;
+    e.Height                  = c.Height;
+    e.MaxcodecLevel           = c.MaxcodecLevel;
+    e.BiDirectionalPrediction = c.BiDirectionalPrediction;
+    e.ReportedStats           = c.ReportedStats;
+    return e;
+}
+
+static mfxCapsFlatEntry MakeEntry(const VPPConfig &c) {
+    mfxCapsFlatEntry e = {};
+    e.ID               = c.FilterFourCC;
+    e.MemHandleType    = c.MemHandleType;
+    e.Format           = c.InFormat;
+    e.OutFormat        = c.OutFormat;
+    e.Width            = c.Width;
+    e.Height           = c.Height;
+    e.MaxDelayInFrames = c.MaxDelayInFrames;
+    return e;
+}
+
+template <typename T>
+static void MakeTable(const std::vector<T> &configList,
+                      bool bVPP,
+                      std::vector<mfxCapsFlatEntry> &entries) {
+    for (const auto &c : configList)
+        entries.push_back(MakeEntry(c));
+
+    std::stable_sort(entries.begin(),
+                     entries.end(),
+                     [bVPP](const mfxCapsFlatEntry &e1, const mfxCapsFlatEntry &e2) {
+                         return KeyLess(e1, e2, bVPP, NUM_KEY_FIELDS);
+                     });
+}
+
+static size_t AlignOffset(size_t offset) {
+    return (offset + 7) & ~(size_t)7;
+}
+
+static size_t CopyTable(mfxU8 *base,
+                        size_t offset,
+                        const std::vector<mfxCapsFlatEntry> &entries,
+                        mfxCapsFlatTable &table) {
+    table.Offset     = (mfxU32)offset;
+    table.NumEntries = (mfxU32)entries.size();
+
+    if (!entries.empty())
+        memcpy(base + offset, entries.data(), entries.size() * sizeof(mfxCapsFlatEntry));
+
+    return AlignOffset(offset + entries.size() * sizeof(mfxCapsFlatEntry));
+}
+
+static void BuildFlatCaps(const mfxImplDescription *implDesc, const CapsIndexVPL &capsIndex) {
+    std::vector<mfxCapsFlatEntry> dec, enc, vpp;
+
+    // not allocated (see AllocFlatCaps)
+    if (capsIndex.flatCapsBuf.empty())
+        return;
+
+    // one entry per config, so the tables fit in the block
+    size_t size = capsIndex.flatCapsBuf.size() * sizeof(mfxU64);
+    try {
+        MakeTable(capsIndex.dec, false, dec);
+        MakeTable(capsIndex.enc, false, enc);
+        MakeTable(capsIndex.vpp, true, vpp);
+    }
+    catch (...) {
+        return;
+    }
+
+    mfxU8 *base           = (mfxU8 *)capsIndex.flatCapsBuf.data();
+    mfxImplCapsFlat *caps = (mfxImplCapsFlat *)base;
+
+    caps->Version.Version  = MFX_IMPLCAPSFLAT_VERSION;
+    caps->Size             = (mfxU32)size;
+    caps->Impl             = implDesc->Impl;
+    caps->AccelerationMode = implDesc->AccelerationMode;
+    caps->ApiVersion       = implDesc->ApiVersion;
+    caps->VendorID         = implDesc->VendorID;
+    caps->VendorImplID     = implDesc->VendorImplID;
+
+    // same length as in mfxImplDescription
+    memcpy(caps->ImplName, implDesc->ImplName, sizeof(caps->ImplName));
+    memcpy(caps->DeviceID, implDesc->Dev.DeviceID, sizeof(caps->DeviceID));
+    caps->ImplName[sizeof(caps->ImplName) - 1] = 0;
+    caps->DeviceID[sizeof(caps->DeviceID) - 1] = 0;
+
+    size_t offset = AlignOffset(sizeof(mfxImplCapsFlat));
+    offset        = CopyTable(base, offset, dec, caps->Dec);
+    offset        = CopyTable(base, offset, enc, caps->Enc);
+    offset        = CopyTable(base, offset, vpp, caps->VPP);
+
+    capsIndex.flatCaps.store(caps);
+}
+
+// allocate flat caps descriptor when the caps index is built, so that the handle can be
+//   mapped back to its implementation by RebuildImplIndex() before the descriptor is built
+// descriptor is not supported if allocation fails
+void LoaderCtxVPL::AllocFlatCaps(CapsIndexVPL &capsIndex) {
+    size_t size = AlignOffset(sizeof(mfxImplCapsFlat));
+    size += AlignOffset(capsIndex.dec.size() * sizeof(mfxCapsFlatEntry));
+    size += AlignOffset(capsIndex.enc.size() * sizeof(mfxCapsFlatEntry));
+    size += AlignOffset(capsIndex.vpp.size() * sizeof(mfxCapsFlatEntry));
+    if (size > 0xFFFFFFFF)
+        return;
+
+    try {
+        // mfxU64 elements keep the block 8-byte aligned
+        capsIndex.flatCapsBuf.resize(size / sizeof(mfxU64), 0);
+    }
+    catch (...) {
+        capsIndex.flatCapsBuf.clear();
+    }
+}
+
+// return flat caps descriptor, building it on first call
+// may be called concurrently (loader locked in shared mode), copies of ImplInfo share the index
+mfxImplCapsFlat *LoaderCtxVPL::GetFlatCaps(ImplInfo *implInfo) {
+    const CapsIndexVPL *capsIndex = implInfo->capsIndex.get();
+    mfxImplDescription *implDesc  = (mfxImplDescription *)(implInfo->implDesc);
+
+    if (!capsIndex || !implDesc)
+        return nullptr;
+
+    std::call_once(capsIndex->flatCapsOnce, [&]() {
+        BuildFlatCaps(implDesc, *capsIndex);
+    });
+
+    return capsIndex->flatCaps.load();
+}
+
+mfxStatus MFXFindCapsFlatEntry(const mfxImplCapsFlat *caps,
+                               const mfxCapsFlatTable *table,
+                               const mfxCapsFlatEntry *query,
+                               const mfxCapsFlatEntry **entry) {
+    if (!caps || !table || !query || !entry)
+        return MFX_ERR_NULL_PTR;
+
+    *entry = nullptr;
+
+    if (caps->Version.Major != 1)
+        return MFX_ERR_UNSUPPORTED;
+
+    if (table != &caps->Dec && table != &caps->Enc && table != &caps->VPP)
+        return MFX_ERR_UNSUPPORTED;
+
+    if ((mfxU64)table->Offset + (mfxU64)table->NumEntries * sizeof(mfxCapsFlatEntry) >
+        caps->Size)
+        return MFX_ERR_UNSUPPORTED;
+
+    const mfxCapsFlatEntry *first =
+        (const mfxCapsFlatEntry *)((const mfxU8 *)caps + table->Offset);
+    const mfxCapsFlatEntry *last = first + table->NumEntries;
+
+    // binary search on the leading key fields which are set in the query,
+    //   other fields are checked for each entry in the range
+    bool bVPP = (table == &caps->VPP);
+
+    mfxU32 queryKey[NUM_KEY_FIELDS];
+    GetKey(*query, bVPP, queryKey);
+
+    mfxU32 numFields = 1;
+    while (numFields < NUM_KEY_FIELDS && queryKey[numFields] != 0)
+        numFields++;
+
+    auto range = std::equal_range(first,
+                                  last,
+                                  *query,
+                                  [bVPP, numFields](const mfxCapsFlatEntry &e1,
+                                                    const mfxCapsFlatEntry &e2) {
+                                      return KeyLess(e1, e2, bVPP, numFields);
+                                  });
+
+    for (const mfxCapsFlatEntry *e = range.first; e != range.second; e++) {
+        mfxU32 key[NUM_KEY_FIELDS];
+        GetKey(*e, bVPP, key);
+
+        bool bMatch = true;
+        for (mfxU32 i = numFields; i < NUM_KEY_FIELDS; i++) {
+            if (queryKey[i] != 0 && queryKey[i] != key[i])
+                bMatch = false;
+        }
+
+        // field which is not part of the key for this table
+        if (bVPP ? (query->Profile && query->Profile != e->Profile)
+                 : (query->OutFormat && query->OutFormat != e->OutFormat))
+            bMatch = false;
+
+        if (query->Width.Max &&
+            (query->Width.Max < e->Width.Min || query->Width.Max > e->Width.Max))
+            bMatch = false;
+
+        if (query->Height.Max &&
+            (query->Height.Max < e->Height.Min || query->Height.Max > e->Height.Max))
+            bMatch = false;
+
+        if (bMatch) {
+            *entry = e;
+            return MFX_ERR_NONE;
+        }
+    }
+
+    return MFX_ERR_NOT_FOUND;
+}
+
+#endif // ONEVPL_EXPERIMENTAL
@@ -0,0 +1,166 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include "src/mfx_dispatcher_vpl.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+    #if defined _M_IX86
+        // Windows x86
+        #define LIB_ONEVPL_GPU L"libmfx32-gen."
+    #else
+        // Windows x64
+        #define LIB_ONEVPL_GPU L"libmfx64-gen."
+    #endif
+#elif defined(__linux__)
+    // Linux x64
+    #define LIB_ONEVPL_GPU "libmfx-gen.so."
+#endif
+
+// Intel® VPL lazy enumeration (enabled with ONEVPL_LAZY_ENUM=ON)
+//
+// Candidate libraries are ordered by the parts of the priority rules which
+//   are known before loading them, then loaded and queried one at a time
+//   until the requested implementation index passes all filters.
+// Remaining candidates are only loaded if the application asks for
+//   an implementation index beyond what has been resolved.
+//
+// Static ordering (stable, so search order is kept within each rank):
+//   1) ONEVPL_PRIORITY_PATH libraries (not sorted by other rules)
+//   2) known Intel® VPL GPU runtime (HW over SW)
+//   3) other 2.x libraries
+//   4) legacy MSDK libraries - probed as a single batch so that only
+//        the highest API version is kept, as in CheckValidLibraries()
+// then by search path priority within each rank.
+//
+// The static order only approximates PrioritizeImplList(), which is applied
+//   again each time more candidates are loaded. So implementation indices may
+//   differ from full enumeration, and an index which was already returned may
+//   refer to a different implementation after a higher index is requested.
+
+enum LazyRank {
+    LazyRankPriorityPath = 0,
+    LazyRankGPU          = 1,
+    LazyRankOther        = 2,
+    LazyRankMSDK         = 3,
+};
+
+static mfxU32 GetLazyRank(const LibInfo *libInfo, bool bPriorityPathEnabled) {
+    if (bPriorityPathEnabled && libInfo->libPriority == LIB_PRIORITY_SPECIAL)
+        return LazyRankPriorityPath;
+
+    if (libInfo->libPriority >= LIB_PRIORITY_LEGACY_DRIVERSTORE ||
+        libInfo->libNameFull.find(MSDK_LIB_NAME) != std::string::npos)
+        return LazyRankMSDK;
+
+    if (libInfo->libNameFull.find(LIB_ONEVPL_GPU) != std::string::npos)
+        return LazyRankGPU;
+
+    return LazyRankOther;
+}
+
+mfxStatus LoaderCtxVPL::InitLazyEnum() {
+    if (!IsEnvOn("ONEVPL_LAZY_ENUM"))
+        return MFX_ERR_UNSUPPORTED;
+
+    m_bLazyEnum = true;
+
+    return MFX_ERR_NONE;
+}
+
+// number of implementations which currently pass all filters
+mfxU32 LoaderCtxVPL::GetNumValidImpls() {
+    return (mfxU32)m_validImplList.size();
+}
+
+// load and query candidate libraries in static priority order until
+//   implementation idx passes all filters, or there are no more candidates
+mfxStatus LoaderCtxVPL::LazyLoadAndQuery(mfxU32 idx) {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    mfxStatus sts = MFX_ERR_NONE;
+
+    // disable low latency mode
+    m_bLowLatency = false;
+
+    if (!m_bLazyListBuilt) {
+        // search directories for candidate implementations based on search order in spec
+        sts = BuildListOfCandidateLibs();
+        if (MFX_ERR_NONE != sts)
+            return sts;
+
+        m_lazyLibList.splice(m_lazyLibList.end(), m_libInfoList);
+
+        bool bPriorityPathEnabled = m_bPriorityPathEnabled;
+        m_lazyLibList.sort([bPriorityPathEnabled](const LibInfo *lib1, const LibInfo *lib2) {
+            mfxU32 rank1 = GetLazyRank(lib1, bPriorityPathEnabled);
+            mfxU32 rank2 = GetLazyRank(lib2, bPriorityPathEnabled);
+
+            if (rank1 != rank2)
+                return (rank1 < rank2);
+
+            // ONEVPL_PRIORITY_PATH libs keep search order
+            if (rank1 == LazyRankPriorityPath)
+                return false;
+
+            return (lib1->libPriority < lib2->libPriority);
+        });
+
+        m_bLazyListBuilt = true;
+    }
+
+    // apply any filters which were changed since the last call
+    if (m_bNeedUpdateValidImpls)
+        UpdateValidImplList();
+
+    while (GetNumValidImpls() <= idx && !m_lazyLibList.empty()) {
+        // move libraries which were already resolved out of the way, so that
+        //   CheckValidLibraries() and QueryLibraryCaps() only see the next batch
+        std::list<LibInfo *> resolvedLibList;
+        resolvedLibList.swap(m_libInfoList);
+
+        bool bMSDKBatch =
+            (GetLazyRank(m_lazyLibList.front(), m_bPriorityPathEnabled) == LazyRankMSDK);
+        if (bMSDKBatch)
+            m_libInfoList.swap(m_lazyLibList);
+        else
+            m_libInfoList.splice(m_libInfoList.end(), m_lazyLibList, m_lazyLibList.begin());
+
+        DISP_LOG_MESSAGE(&m_dispLog,
+                         "message:  lazy enumeration -- probing %d of %d remaining libraries",
+                         (int)m_libInfoList.size(),
+                         (int)(m_libInfoList.size() + m_lazyLibList.size()));
+
+        // prune libraries which are not actually implementations, then query caps
+        // QueryLibraryCaps() appends to m_implInfoList
+        if (CheckValidLibraries() > 0)
+            QueryLibraryCaps();
+
+        resolvedLibList.splice(resolvedLibList.end(), m_libInfoList);
+        m_libInfoList.swap(resolvedLibList);
+
+        // validate newly added implementations vs. filters and update priority order
+        UpdateValidImplList();
+    }
+
+    // all candidates were loaded - equivalent to FullLoadAndQuery()
+    if (m_lazyLibList.empty())
+        m_bNeedFullQuery = false;
+
+    m_bNeedUpdateValidImpls = false;
+
+    return m_implInfoList.empty() ? MFX_ERR_UNSUPPORTED : MFX_ERR_NONE;
+}
+
+// free candidate libraries which were never loaded
+mfxStatus LoaderCtxVPL::UnloadLazyLibraries() {
+    for (auto libInfo : m_lazyLibList)
+        UnloadSingleLibrary(libInfo);
+
+    m_lazyLibList.clear();
+    m_bLazyListBuilt = false;
+
+    return MFX_ERR_NONE;
+}
@@ -5,6 +5,8 @@
   ############################################################################*/
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "src/mfx_dispatcher_vpl.h"
 
@@ -41,6 +43,28 @@ static const VPLFunctionDesc MSDKCompatFunctions[NumMSDKFunctions] = {
 // end table formatting
 // clang-format on
 
+bool GetEnvVar(const char *name, std::string &value) {
+#if defined(_WIN32) || defined(_WIN64)
+    char envVar[MAX_VPL_SEARCH_PATH] = "";
+    DWORD err = GetEnvironmentVariableA(name, envVar, MAX_VPL_SEARCH_PATH);
+    if (err == 0 || err >= MAX_VPL_SEARCH_PATH)
+        return false; // environment variable not defined or string too long
+#else
+    const char *envVar = std::getenv(name);
+    if (!envVar)
+        return false; // environment variable not defined
+#endif
+
+    value = envVar;
+
+    return true;
+}
+
+bool IsEnvOn(const char *name) {
+    std::string value;
+    return GetEnvVar(name, value) && value == "ON";
+}
+
 // implementation of loader context (mfxLoader)
 // each loader instance will build a list of valid runtimes and allow
 // application to create sessions with them
@@ -48,12 +72,26 @@ LoaderCtxVPL::LoaderCtxVPL()
         : m_libInfoList(),
           m_implInfoList(),
           m_configCtxList(),
+          m_validImplList(),
+          m_implHandleMap(),
           m_gpuAdapterInfo(),
           m_specialConfig(),
           m_implIdxNext(0),
           m_bKeepCapsUntilUnload(true),
           m_envVar(),
-          m_dispLog() {
+          m_dispLog(),
+          m_capsCache(),
+          m_startupTiming(),
+          m_maxProbeThreads(1),
+          m_lazyLibList(),
+          m_bLazyListBuilt(false),
+          m_catalog(nullptr),
+          m_sessionPoolList(),
+          m_manifestList(),
+          m_warmUpThread(),
+          m_warmUpSts(MFX_ERR_NONE),
+          m_rankFileScores(),
+          m_bRankFileLoaded(false) {
     // allow loader to distinguish between property value of 0
     //   and property not set
     m_specialConfig.bIsSet_deviceHandleType = false;
@@ -63,6 +101,7 @@ LoaderCtxVPL::LoaderCtxVPL()
     m_specialConfig.bIsSet_dxgiAdapterIdx   = false;
     m_specialConfig.bIsSet_NumThread        = false;
     m_specialConfig.bIsSet_DeviceCopy       = false;
+    m_specialConfig.bIsSet_SessionProfile   = false;
     m_specialConfig.bIsSet_ExtBuffer        = false;
 
     // initial state
@@ -71,6 +110,14 @@ LoaderCtxVPL::LoaderCtxVPL()
     m_bNeedFullQuery        = true;
     m_bNeedLowLatencyQuery  = true;
     m_bPriorityPathEnabled  = false;
+    m_bLazyEnum             = false;
+    m_bSharedCatalog        = false;
+    m_bSessionFastPath      = true;
+    m_bSessionProfile       = false;
+    m_bExportCheck          = true;
+    m_bManifest             = false;
+    m_bWarmUp               = false;
+    m_bRankThroughput       = false;
 
     return;
 }
@@ -83,6 +130,20 @@ mfxStatus LoaderCtxVPL::FullLoadAndQuery() {
     // disable low latency mode
     m_bLowLatency = false;
 
+    mfxStatus sts = SearchAndQueryLibs();
+    if (MFX_ERR_NONE != sts)
+        return sts;
+
+    m_bNeedFullQuery        = false;
+    m_bNeedUpdateValidImpls = true;
+
+    return MFX_ERR_NONE;
+}
+
+// search, load, and query all candidate libraries
+// does not change the loader state flags, so it may run on the warm-up thread
+//   while filters are set
+mfxStatus LoaderCtxVPL::SearchAndQueryLibs() {
     // search directories for candidate implementations based on search order in
     // spec
     mfxStatus sts = BuildListOfCandidateLibs();
@@ -101,9 +162,6 @@ mfxStatus LoaderCtxVPL::FullLoadAndQuery() {
     if (MFX_ERR_NONE != sts)
         return MFX_ERR_NOT_FOUND;
 
-    m_bNeedFullQuery        = false;
-    m_bNeedUpdateValidImpls = true;
-
     return MFX_ERR_NONE;
 }
 
@@ -444,6 +502,7 @@ mfxU32 LoaderCtxVPL::GetSearchPathsInstallDir(std::list<STRING_TYPE> &searchDirs
 //   according to the rules in the spec
 mfxStatus LoaderCtxVPL::BuildListOfCandidateLibs() {
     DISP_LOG_FUNCTION(&m_dispLog);
+    STARTUP_PHASE_TIMER(&m_startupTiming, LOADER_PHASE_SEARCH);
 
     mfxStatus sts = MFX_ERR_NONE;
 
@@ -451,6 +510,10 @@ mfxStatus LoaderCtxVPL::BuildListOfCandidateLibs() {
     std::list<STRING_TYPE> searchDirList;
     std::list<STRING_TYPE>::iterator it;
 
+    // manifest lists all candidate runtimes, so no directories are searched
+    if (m_bManifest)
+        return AddManifestLibs();
+
     // special case: ONEVPL_PRIORITY_PATH may be used to specify user-defined path
     //   and bypass priority sorting (API >= 2.6)
     searchDirList.clear();
@@ -593,81 +656,185 @@ mfxStatus LoaderCtxVPL::BuildListOfCandidateLibs() {
     return sts;
 }
 
+// run fn(i) for each i in [0, count) on up to maxThreads threads (including the caller)
+// each index is processed exactly once, so fn may store results per index without locking
+template <typename Fn>
+static void RunParallel(mfxU32 count, mfxU32 maxThreads, Fn fn) {
+    std::atomic<mfxU32> nextIdx(0);
+    auto worker = [&]() {
+        mfxU32 idx;
+        while ((idx = nextIdx++) < count)
+            fn(idx);
+    };
+
+    std::vector<std::thread> threads;
+    mfxU32 numThreads = std::min(count, maxThreads);
+    for (mfxU32 i = 1; i < numThreads; i++) {
+        try {
+            threads.emplace_back(worker);
+        }
+        catch (...) {
+            // unable to create thread - remaining work is done by existing threads
+            break;
+        }
+    }
+
+    worker();
+
+    for (auto &t : threads)
+        t.join();
+}
+
+// load a single library and check which type of runtime it is
+// may be called concurrently for different libraries, so only libInfo is modified
+void LoaderCtxVPL::ProbeSingleLibrary(LibInfo *libInfo) {
+    // if caps for this library are in the persistent cache, do not load it
+    //   until the application creates a session
+    if (m_capsCache.IsEnabled() && libInfo->libPriority < LIB_PRIORITY_LEGACY_DRIVERSTORE) {
+        libInfo->cachedCaps = m_capsCache.Load(libInfo->libNameFull);
+        if (libInfo->cachedCaps) {
+            libInfo->libType = LibTypeVPL;
+            return;
+        }
+    }
+
+    mfxU64 startNs = (m_startupTiming.IsEnabled() ? StartupTimingVPL::GetTimeNs() : 0);
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    // do not load libraries which are known not to be runtimes
+    if (m_bExportCheck && !CheckLibraryExports(libInfo)) {
+        libInfo->bMissingExports = true;
+        return;
+    }
+#endif
+
+    // load DLL
+    mfxStatus sts = LoadSingleLibrary(libInfo);
+
+    // load video functions: pointers to exposed functions
+    // not all function pointers may be filled in (depends on API version)
+    if (sts == MFX_ERR_NONE && libInfo->hModuleVPL)
+        LoadAPIExports(libInfo, LibTypeVPL);
+
+    if (m_startupTiming.IsEnabled())
+        libInfo->loadTimeNs = StartupTimingVPL::GetTimeNs() - startNs;
+
+    // all runtime libraries with API >= 2.0 must export MFXInitialize()
+    // validation of additional functions vs. API version takes place
+    //   during UpdateValidImplList() since the minimum API version requested
+    //   by application is not known yet (use SetConfigFilterProperty)
+    if (libInfo->vplFuncTable[IdxMFXInitialize] &&
+        libInfo->libPriority < LIB_PRIORITY_LEGACY_DRIVERSTORE) {
+        libInfo->libType = LibTypeVPL;
+        return;
+    }
+
+    // not a valid 2.x runtime - check for 1.x API (legacy caps query)
+    mfxU32 numFunctions = 0;
+    if (sts == MFX_ERR_NONE && libInfo->hModuleVPL) {
+        if (libInfo->libNameFull.find(MSDK_LIB_NAME) != std::string::npos) {
+            // legacy runtime must be named libmfxhw64 (or 32)
+            // MSDK must export all of the required functions
+            numFunctions = LoadAPIExports(libInfo, LibTypeMSDK);
+        }
+    }
+
+    // check if all of the required MSDK functions were found
+    //   and this is valid library (can create session, query version)
+    if (numFunctions == NumMSDKFunctions) {
+        sts = LoaderCtxMSDK::QueryAPIVersion(libInfo->libNameFull, &(libInfo->msdkVersion));
+        if (sts == MFX_ERR_NONE)
+            libInfo->libType = LibTypeMSDK;
+    }
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+// check exported functions of a candidate library without loading it
+// returns false only if the library could be parsed and does not export the functions
+//   required for either a 2.x or a legacy runtime, see ProbeSingleLibrary()
+bool LoaderCtxVPL::CheckLibraryExports(LibInfo *libInfo) {
+    ElfExportsVPL elfExports;
+    if (elfExports.Open(libInfo->libNameFull) != MFX_ERR_NONE)
+        return true;
+
+    if (elfExports.HasFunction(FunctionDesc2[IdxMFXInitialize].pName) &&
+        libInfo->libPriority < LIB_PRIORITY_LEGACY_DRIVERSTORE)
+        return true;
+
+    if (libInfo->libNameFull.find(MSDK_LIB_NAME) == std::string::npos)
+        return false;
+
+    for (mfxU32 i = 0; i < NumMSDKFunctions; i += 1) {
+        if (!elfExports.HasFunction(MSDKCompatFunctions[i].pName))
+            return false;
+    }
+
+    return true;
+}
+#endif
+
 // return number of valid libraries found
 mfxU32 LoaderCtxVPL::CheckValidLibraries() {
     DISP_LOG_FUNCTION(&m_dispLog);
+    STARTUP_PHASE_TIMER(&m_startupTiming, LOADER_PHASE_LOAD);
 
     LibInfo *msdkLibBest   = nullptr;
     LibInfo *msdkLibBestDS = nullptr;
 
-    // load all libraries
+    // load and probe all libraries, in parallel if enabled
+    std::vector<LibInfo *> libInfoVec(m_libInfoList.begin(), m_libInfoList.end());
+    RunParallel((mfxU32)libInfoVec.size(), m_maxProbeThreads, [&](mfxU32 idx) {
+        ProbeSingleLibrary(libInfoVec[idx]);
+    });
+
+    // merge results in original search order
     std::list<LibInfo *>::iterator it = m_libInfoList.begin();
     while (it != m_libInfoList.end()) {
         LibInfo *libInfo = (*it);
-        mfxStatus sts    = MFX_ERR_NONE;
-
-        // load DLL
-        sts = LoadSingleLibrary(libInfo);
-
-        // load video functions: pointers to exposed functions
-        // not all function pointers may be filled in (depends on API version)
-        if (sts == MFX_ERR_NONE && libInfo->hModuleVPL)
-            LoadAPIExports(libInfo, LibTypeVPL);
-
-        // all runtime libraries with API >= 2.0 must export MFXInitialize()
-        // validation of additional functions vs. API version takes place
-        //   during UpdateValidImplList() since the minimum API version requested
-        //   by application is not known yet (use SetConfigFilterProperty)
-        if (libInfo->vplFuncTable[IdxMFXInitialize] &&
-            libInfo->libPriority < LIB_PRIORITY_LEGACY_DRIVERSTORE) {
-            libInfo->libType = LibTypeVPL;
+
+        if (libInfo->cachedCaps) {
+            DISP_LOG_MESSAGE(&m_dispLog,
+                             "message:  caps cache hit -- %s",
+                             libInfo->libNameFull.c_str());
+        }
+
+        if (libInfo->bMissingExports) {
+            DISP_LOG_MESSAGE(&m_dispLog,
+                             "message:  required exports not found, not loaded -- %s",
+                             libInfo->libNameFull.c_str());
+        }
+
+        if (libInfo->libType == LibTypeVPL) {
             it++;
             continue;
         }
 
-        // not a valid 2.x runtime - check for 1.x API (legacy caps query)
-        mfxU32 numFunctions = 0;
-        if (sts == MFX_ERR_NONE && libInfo->hModuleVPL) {
-            if (libInfo->libNameFull.find(MSDK_LIB_NAME) != std::string::npos) {
-                // legacy runtime must be named libmfxhw64 (or 32)
-                // MSDK must export all of the required functions
-                numFunctions = LoadAPIExports(libInfo, LibTypeMSDK);
+        if (libInfo->libType == LibTypeMSDK) {
+            if (msdkLibBest == nullptr ||
+                (libInfo->msdkVersion.Version > msdkLibBest->msdkVersion.Version)) {
+                msdkLibBest = libInfo;
             }
-        }
 
-        // check if all of the required MSDK functions were found
-        //   and this is valid library (can create session, query version)
-        if (numFunctions == NumMSDKFunctions) {
-            sts = LoaderCtxMSDK::QueryAPIVersion(libInfo->libNameFull, &(libInfo->msdkVersion));
-
-            if (sts == MFX_ERR_NONE) {
-                libInfo->libType = LibTypeMSDK;
-                if (msdkLibBest == nullptr ||
-                    (libInfo->msdkVersion.Version > msdkLibBest->msdkVersion.Version)) {
-                    msdkLibBest = libInfo;
-                }
-
-                if (libInfo->libPriority == LIB_PRIORITY_LEGACY_DRIVERSTORE) {
-                    if (msdkLibBestDS == nullptr ||
-                        (libInfo->msdkVersion.Version > msdkLibBestDS->msdkVersion.Version)) {
-                        msdkLibBestDS = libInfo;
-                    }
+            if (libInfo->libPriority == LIB_PRIORITY_LEGACY_DRIVERSTORE) {
+                if (msdkLibBestDS == nullptr ||
+                    (libInfo->msdkVersion.Version > msdkLibBestDS->msdkVersion.Version)) {
+                    msdkLibBestDS = libInfo;
                 }
+            }
 
 #if defined(_WIN32) || defined(_WIN64)
-                // workaround for double-init issue in old versions of MSDK runtime
-                //   (allow DLL to be fully unloaded after each call to MFXClose)
-                // apply to MSDK with API version <= 1.27
-                if (libInfo->hModuleVPL && (libInfo->msdkVersion.Major == 1) &&
-                    (libInfo->msdkVersion.Minor <= 27)) {
-                    MFX::mfx_dll_free(libInfo->hModuleVPL);
-                    libInfo->hModuleVPL = nullptr;
-                }
+            // workaround for double-init issue in old versions of MSDK runtime
+            //   (allow DLL to be fully unloaded after each call to MFXClose)
+            // apply to MSDK with API version <= 1.27
+            if (libInfo->hModuleVPL && (libInfo->msdkVersion.Major == 1) &&
+                (libInfo->msdkVersion.Minor <= 27)) {
+                MFX::mfx_dll_free(libInfo->hModuleVPL);
+                libInfo->hModuleVPL = nullptr;
+            }
 #endif
 
-                it++;
-                continue;
-            }
+            it++;
+            continue;
         }
 
         // required functions missing from DLL, or DLL failed to load
@@ -738,6 +905,15 @@ mfxStatus LoaderCtxVPL::UnloadSingleLibrary(LibInfo *libInfo) {
             dlclose(libInfo->hModuleVPL);
 #endif
         }
+
+        // descriptors restored from caps cache are owned by the dispatcher
+        if (libInfo->cachedCaps)
+            delete libInfo->cachedCaps;
+
+        // sessions created with the fast path keep their own reference to the library
+        if (libInfo->hFuncTable)
+            MFXReleaseFuncTable(libInfo->hFuncTable);
+
         delete libInfo;
         return MFX_ERR_NONE;
     }
@@ -751,6 +927,20 @@ mfxStatus LoaderCtxVPL::UnloadSingleLibrary(LibInfo *libInfo) {
 mfxStatus LoaderCtxVPL::UnloadAllLibraries() {
     DISP_LOG_FUNCTION(&m_dispLog);
 
+    // pooled sessions must be closed before their libraries are unloaded
+    DestroySessionPools();
+
+    // asynchronous requests keep their sessions, but workers must be done with the libraries
+    FinishSessionRequests();
+
+    // index refers to implementations which are about to be freed
+    m_validImplList.clear();
+    m_implHandleMap.clear();
+
+    // libraries are owned by the shared catalog
+    if (m_catalog)
+        return DetachCatalog();
+
     std::list<ImplInfo *>::iterator it2 = m_implInfoList.begin();
     while (it2 != m_implInfoList.end()) {
         ImplInfo *implInfo = (*it2);
@@ -776,6 +966,9 @@ mfxStatus LoaderCtxVPL::UnloadAllLibraries() {
     m_libInfoList.clear();
     m_implIdxNext = 0;
 
+    // free any candidates which were not loaded in lazy enumeration mode
+    UnloadLazyLibraries();
+
     return MFX_ERR_NONE;
 }
 
@@ -790,7 +983,8 @@ mfxStatus LoaderCtxVPL::UnloadSingleImplementation(ImplInfo *implInfo) {
         //   was never called by the application
         // this is a valid scenario, e.g. app did not call MFXEnumImplementations()
         //   and just used the first available implementation provided by dispatcher
-        if (libInfo->libType == LibTypeVPL) {
+        // nothing to release if caps were restored from the caps cache
+        if (libInfo->libType == LibTypeVPL && !libInfo->cachedCaps) {
             if (implInfo->implDesc) {
                 // MFX_IMPLCAPS_IMPLDESCSTRUCTURE;
                 (*(mfxStatus(MFX_CDECL *)(mfxHDL))pFunc)(implInfo->implDesc);
@@ -855,11 +1049,25 @@ mfxU32 LoaderCtxVPL::LoadAPIExports(LibInfo *libInfo, LibType libType) {
     return numFunctions;
 }
 
+// return bitmask of exported functions, bit N is set if FunctionDesc2[N] was found
+mfxU32 LoaderCtxVPL::GetAPIExportMask(LibInfo *libInfo) {
+    if (libInfo->cachedCaps)
+        return libInfo->cachedCaps->exportMask;
+
+    mfxU32 exportMask = 0;
+    for (mfxU32 i = 0; i < NumVPLFunctions; i += 1) {
+        if (libInfo->vplFuncTable[i])
+            exportMask |= (1 << i);
+    }
+
+    return exportMask;
+}
+
 // check that all functions for this API version are available in library
-mfxStatus LoaderCtxVPL::ValidateAPIExports(VPLFunctionPtr *vplFuncTable,
-                                           mfxVersion reportedVersion) {
+mfxStatus LoaderCtxVPL::ValidateAPIExports(mfxU32 exportMask, mfxVersion reportedVersion) {
     for (mfxU32 i = 0; i < NumVPLFunctions; i += 1) {
-        if (!vplFuncTable[i] && (FunctionDesc2[i].apiVersion.Version <= reportedVersion.Version))
+        if (!(exportMask & (1 << i)) &&
+            (FunctionDesc2[i].apiVersion.Version <= reportedVersion.Version))
             return MFX_ERR_UNSUPPORTED;
     }
 
@@ -913,79 +1121,153 @@ bool LoaderCtxVPL::IsValidX86GPU(ImplInfo *implInfo, mfxU32 &deviceID, mfxU32 &a
     return false;
 }
 
+// call MFXQueryImplsDescription() for each caps format used by the dispatcher
+// may be called concurrently for different libraries, so only capsQuery is modified
+mfxStatus LoaderCtxVPL::QueryLibraryImplsVPL(LibInfo *libInfo, LibCapsQuery *capsQuery) {
+    VPLFunctionPtr pFunc = libInfo->vplFuncTable[IdxMFXQueryImplsDescription];
+
+    capsQuery->bQueried = true;
+
+    mfxU64 startNs = (m_startupTiming.IsEnabled() ? StartupTimingVPL::GetTimeNs() : 0);
+
+    // handle to implDesc structure, null in low-latency mode (no query)
+    if (m_bLowLatency == false) {
+        // call MFXQueryImplsDescription() for this implementation
+        // return handle to description in requested format
+        capsQuery->hImpl = (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
+                               pFunc)(MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &capsQuery->numImpls);
+
+        // validate description pointer for each implementation
+        if (!capsQuery->hImpl) {
+            capsQuery->sts = MFX_ERR_UNSUPPORTED;
+            return capsQuery->sts;
+        }
+
+        for (mfxU32 i = 0; i < capsQuery->numImpls; i++) {
+            if (!capsQuery->hImpl[i]) {
+                capsQuery->sts = MFX_ERR_UNSUPPORTED;
+                return capsQuery->sts;
+            }
+        }
+
+        capsQuery->hImplExtDeviceID =
+            (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
+                 pFunc)(MFX_IMPLCAPS_DEVICE_ID_EXTENDED, &capsQuery->numImplsExtDeviceID);
+
+#ifdef ONEVPL_EXPERIMENTAL
+        capsQuery->hImplSurfTypes =
+            (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
+                 pFunc)(MFX_IMPLCAPS_SURFACE_TYPES, &capsQuery->numImplsSurfTypes);
+#endif
+    }
+
+    // query for list of implemented functions
+    // prior to API 2.2, this will return null since the format was not defined yet
+    //   so we need to check whether the returned handle is valid before attempting to use it
+    capsQuery->hImplFuncs =
+        (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
+             pFunc)(MFX_IMPLCAPS_IMPLEMENTEDFUNCTIONS, &capsQuery->numImplsFuncs);
+
+    if (m_startupTiming.IsEnabled())
+        libInfo->queryTimeNs = StartupTimingVPL::GetTimeNs() - startNs;
+
+    capsQuery->sts = MFX_ERR_NONE;
+    return capsQuery->sts;
+}
+
 // query capabilities of all valid libraries
 //   and add to list for future calls to EnumImplementations()
 //   as well as filtering by functionality
 // assume MFX_IMPLCAPS_IMPLDESCSTRUCTURE is the only format supported
 mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
     DISP_LOG_FUNCTION(&m_dispLog);
+    STARTUP_PHASE_TIMER(&m_startupTiming, LOADER_PHASE_QUERY_CAPS);
 
     mfxStatus sts = MFX_ERR_NONE;
 
+    // query caps of all loaded 2.x runtimes in parallel
+    // results are merged below in the original search order, so the
+    //   implementation list is the same regardless of number of threads
+    std::vector<LibInfo *> libInfoVec(m_libInfoList.begin(), m_libInfoList.end());
+    std::vector<LibCapsQuery> capsQueryVec(libInfoVec.size());
+    if (m_maxProbeThreads > 1 && m_bLowLatency == false) {
+        RunParallel((mfxU32)libInfoVec.size(), m_maxProbeThreads, [&](mfxU32 idx) {
+            LibInfo *libInfo = libInfoVec[idx];
+            if (libInfo->libType == LibTypeVPL && !libInfo->cachedCaps)
+                QueryLibraryImplsVPL(libInfo, &capsQueryVec[idx]);
+        });
+    }
+
+    size_t libIdx                     = 0;
     std::list<LibInfo *>::iterator it = m_libInfoList.begin();
     while (it != m_libInfoList.end()) {
         LibInfo *libInfo = (*it);
 
-        if (libInfo->libType == LibTypeVPL) {
-            VPLFunctionPtr pFunc = libInfo->vplFuncTable[IdxMFXQueryImplsDescription];
-
-            // handle to implDesc structure, null in low-latency mode (no query)
-            mfxHDL *hImpl   = nullptr;
-            mfxU32 numImpls = 0;
+        if (libInfo->libType == LibTypeVPL && libInfo->cachedCaps) {
+            // save user-friendly path for MFX_IMPLCAPS_IMPLPATH query (API >= 2.4)
+            UpdateImplPath(libInfo);
 
-            mfxHDL *hImplExtDeviceID   = nullptr;
-            mfxU32 numImplsExtDeviceID = 0;
+            // descriptors restored from caps cache, library is not loaded
+            std::vector<CachedImplCaps> &implCaps = libInfo->cachedCaps->implCaps;
+            for (mfxU32 i = 0; i < (mfxU32)implCaps.size(); i++) {
+                ImplInfo *implInfo = new (std::nothrow) ImplInfo;
+                if (!implInfo)
+                    return MFX_ERR_MEMORY_ALLOC;
 
+                implInfo->libInfo         = libInfo;
+                implInfo->implDesc        = implCaps[i].implDesc;
+                implInfo->implFuncs       = implCaps[i].implFuncs;
+                implInfo->implExtDeviceID = implCaps[i].implExtDeviceID;
 #ifdef ONEVPL_EXPERIMENTAL
-            mfxHDL *hImplSurfTypes   = nullptr;
-            mfxU32 numImplsSurfTypes = 0;
+                implInfo->implSurfTypes = implCaps[i].implSurfTypes;
 #endif
 
-            if (m_bLowLatency == false) {
-                // call MFXQueryImplsDescription() for this implementation
-                // return handle to description in requested format
-                hImpl = (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
-                             pFunc)(MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &numImpls);
+                memset(&(implInfo->vplParam), 0, sizeof(mfxInitializationParam));
 
-                // validate description pointer for each implementation
-                bool b_isValidDesc = true;
-                if (!hImpl) {
-                    b_isValidDesc = false;
-                }
-                else {
-                    for (mfxU32 i = 0; i < numImpls; i++) {
-                        if (!hImpl[i]) {
-                            b_isValidDesc = false;
-                            break;
-                        }
-                    }
-                }
+                mfxImplDescription *implDesc = (mfxImplDescription *)(implInfo->implDesc);
+                implInfo->vplParam.AccelerationMode = implDesc->AccelerationMode;
+                implInfo->version                   = implDesc->ApiVersion;
+                implInfo->libImplIdx                = i;
 
-                if (!b_isValidDesc) {
-                    // the required function is implemented incorrectly
-                    // remove this library from the list of valid libraries
-                    UnloadSingleLibrary(libInfo);
-                    it = m_libInfoList.erase(it);
+                if (ValidateAPIExports(GetAPIExportMask(libInfo), implInfo->version)) {
+                    UnloadSingleImplementation(implInfo);
                     continue;
                 }
 
-                hImplExtDeviceID =
-                    (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
-                         pFunc)(MFX_IMPLCAPS_DEVICE_ID_EXTENDED, &numImplsExtDeviceID);
+                implInfo->validImplIdx = m_implIdxNext++;
+                m_implInfoList.push_back(implInfo);
+            }
+        }
+        else if (libInfo->libType == LibTypeVPL) {
+            // use results of parallel query if available, otherwise query now
+            LibCapsQuery capsQuery;
+            if (libIdx < capsQueryVec.size() && capsQueryVec[libIdx].bQueried)
+                capsQuery = capsQueryVec[libIdx];
+            else
+                QueryLibraryImplsVPL(libInfo, &capsQuery);
+
+            if (capsQuery.sts != MFX_ERR_NONE) {
+                // the required function is implemented incorrectly
+                // remove this library from the list of valid libraries
+                UnloadSingleLibrary(libInfo);
+                it = m_libInfoList.erase(it);
+                libIdx++;
+                continue;
+            }
+
+            mfxHDL *hImpl   = capsQuery.hImpl;
+            mfxU32 numImpls = capsQuery.numImpls;
+
+            mfxHDL *hImplExtDeviceID   = capsQuery.hImplExtDeviceID;
+            mfxU32 numImplsExtDeviceID = capsQuery.numImplsExtDeviceID;
 
 #ifdef ONEVPL_EXPERIMENTAL
-                hImplSurfTypes = (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
-                                      pFunc)(MFX_IMPLCAPS_SURFACE_TYPES, &numImplsSurfTypes);
+            mfxHDL *hImplSurfTypes   = capsQuery.hImplSurfTypes;
+            mfxU32 numImplsSurfTypes = capsQuery.numImplsSurfTypes;
 #endif
-            }
 
-            // query for list of implemented functions
-            // prior to API 2.2, this will return null since the format was not defined yet
-            //   so we need to check whether the returned handle is valid before attempting to use it
-            mfxHDL *hImplFuncs   = nullptr;
-            mfxU32 numImplsFuncs = 0;
-            hImplFuncs           = (*(mfxHDL * (MFX_CDECL *)(mfxImplCapsDeliveryFormat, mfxU32 *))
-                              pFunc)(MFX_IMPLCAPS_IMPLEMENTEDFUNCTIONS, &numImplsFuncs);
+            mfxHDL *hImplFuncs   = capsQuery.hImplFuncs;
+            mfxU32 numImplsFuncs = capsQuery.numImplsFuncs;
 
             // only report single impl, but application may still attempt to create session using
             //    any of VendorImplID via the DXGIAdapterIndex filter property
@@ -995,6 +1277,14 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
             // save user-friendly path for MFX_IMPLCAPS_IMPLPATH query (API >= 2.4)
             UpdateImplPath(libInfo);
 
+            if (m_startupTiming.IsEnabled()) {
+                DISP_LOG_MESSAGE(&m_dispLog,
+                                 "message:  startup timing -- %s (load %llu us, query %llu us)",
+                                 libInfo->implCapsPath,
+                                 (unsigned long long)(libInfo->loadTimeNs / 1000),
+                                 (unsigned long long)(libInfo->queryTimeNs / 1000));
+            }
+
             for (mfxU32 i = 0; i < numImpls; i++) {
                 ImplInfo *implInfo = new (std::nothrow) ImplInfo;
                 if (!implInfo)
@@ -1054,7 +1344,7 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
                 implInfo->libImplIdx = i;
 
                 // validate that library exports all required functions for the reported API version
-                if (ValidateAPIExports(libInfo->vplFuncTable, implInfo->version)) {
+                if (ValidateAPIExports(GetAPIExportMask(libInfo), implInfo->version)) {
                     UnloadSingleImplementation(implInfo);
                     continue;
                 }
@@ -1069,6 +1359,31 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
                 // add implementation to overall list
                 m_implInfoList.push_back(implInfo);
             }
+
+            // save full query results so the next process can skip loading this library
+            if (m_capsCache.IsEnabled() && m_bLowLatency == false) {
+                std::vector<CachedImplCaps> implCaps(numImpls);
+                for (mfxU32 i = 0; i < numImpls; i++) {
+                    implCaps[i].implDesc = hImpl[i];
+                    implCaps[i].implFuncs =
+                        (hImplFuncs && i < numImplsFuncs) ? hImplFuncs[i] : nullptr;
+                    implCaps[i].implExtDeviceID =
+                        (hImplExtDeviceID && i < numImplsExtDeviceID) ? hImplExtDeviceID[i]
+                                                                      : nullptr;
+#ifdef ONEVPL_EXPERIMENTAL
+                    implCaps[i].implSurfTypes =
+                        (hImplSurfTypes && i < numImplsSurfTypes) ? hImplSurfTypes[i] : nullptr;
+#endif
+                }
+
+                if (m_capsCache.Store(libInfo->libNameFull,
+                                      GetAPIExportMask(libInfo),
+                                      implCaps) == MFX_ERR_NONE) {
+                    DISP_LOG_MESSAGE(&m_dispLog,
+                                     "message:  caps cache updated -- %s",
+                                     libInfo->libNameFull.c_str());
+                }
+            }
         }
         else if (libInfo->libType == LibTypeMSDK) {
             // save user-friendly path for MFX_IMPLCAPS_IMPLPATH query (API >= 2.4)
@@ -1097,8 +1412,11 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
                 LoaderCtxMSDK *msdkCtx = &(libInfo->msdkCtx[i]);
                 if (m_bLowLatency == false) {
                     // perf. optimization: if app requested bIsSet_accelerationMode other than D3D9, don't test whether MSDK supports D3D9
+                    // shared catalog is used by other loaders, so caps must not depend on filters
+                    // warm-up runs while filters are set, so they are not read either
                     bool bSkipD3D9Check = false;
-                    if (m_specialConfig.bIsSet_accelerationMode &&
+                    if (!m_bSharedCatalog && !m_bWarmUp &&
+                        m_specialConfig.bIsSet_accelerationMode &&
                         m_specialConfig.accelerationMode != MFX_ACCEL_MODE_VIA_D3D9) {
                         bSkipD3D9Check = true;
                     }
@@ -1198,14 +1516,19 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
                 // error loading MSDK library in compatibility mode - remove from list
                 UnloadSingleLibrary(libInfo);
                 it = m_libInfoList.erase(it);
+                libIdx++;
                 continue;
             }
         }
         it++;
+        libIdx++;
     }
 
     if (m_bLowLatency == false && !m_implInfoList.empty()) {
-        bool bD3D9Requested = (m_specialConfig.bIsSet_accelerationMode &&
+        // shared catalog and warm-up are built without application filters,
+        //   so D3D9 request is ignored
+        bool bD3D9Requested = (!m_bSharedCatalog && !m_bWarmUp &&
+                               m_specialConfig.bIsSet_accelerationMode &&
                                m_specialConfig.accelerationMode == MFX_ACCEL_MODE_VIA_D3D9);
 
         std::list<ImplInfo *>::iterator it2 = m_implInfoList.begin();
@@ -1245,13 +1568,17 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
                                 implDesc->Impl == MFX_IMPL_TYPE_HARDWARE && bMatchingDeviceID);
                     });
 
-                if (vplIdx != m_implInfoList.end() && bD3D9Requested == false)
-                    implInfo->validImplIdx = -1;
+                if (vplIdx != m_implInfoList.end() && bD3D9Requested == false) {
+                    implInfo->validImplIdx      = -1;
+                    implInfo->bExcludedByQuery = true;
+                }
 
                 // avoid loading Intel® VPL RT via compatibility entrypoint
                 if (msdkImplDesc && msdkImplDesc->ApiVersion.Major == 1 &&
-                    msdkImplDesc->ApiVersion.Minor == 255)
-                    implInfo->validImplIdx = -1;
+                    msdkImplDesc->ApiVersion.Minor == 255) {
+                    implInfo->validImplIdx      = -1;
+                    implInfo->bExcludedByQuery = true;
+                }
             }
 
             if (implInfo->libInfo->libType == LibTypeVPL && !implInfo->implDesc) {
@@ -1272,7 +1599,8 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
 
                 // perf. optimization: if app requested bIsSet_accelerationMode other than D3D9, don't test whether MSDK supports D3D9
                 bool bSkipD3D9Check = false;
-                if (m_specialConfig.bIsSet_accelerationMode &&
+                if (!m_bSharedCatalog && !m_bWarmUp &&
+                    m_specialConfig.bIsSet_accelerationMode &&
                     m_specialConfig.accelerationMode != MFX_ACCEL_MODE_VIA_D3D9) {
                     bSkipD3D9Check = true;
                 }
@@ -1291,56 +1619,187 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
                 implInfo->implFuncs = implFuncs;
             }
 
+            // runtime reports a lower API version than required by its manifest entry
+            mfxImplDescription *implDesc = (mfxImplDescription *)(implInfo->implDesc);
+            if (implDesc &&
+                implDesc->ApiVersion.Version < implInfo->libInfo->minApiVersion.Version) {
+                DISP_LOG_MESSAGE(&m_dispLog,
+                                 "message:  excluded by manifest -- API version %d.%d",
+                                 implDesc->ApiVersion.Major,
+                                 implDesc->ApiVersion.Minor);
+                implInfo->validImplIdx     = -1;
+                implInfo->bExcludedByQuery = true;
+            }
+
             it2++;
         }
 
         // sort valid implementations according to priority rules in spec
         PrioritizeImplList();
+
+        // caps do not change after this, so they are indexed once for all later filtering
+        for (auto implInfo : m_implInfoList)
+            IndexImplCaps(implInfo);
+    }
+    else {
+        // implementations are not prioritized in low latency mode
+        RebuildImplIndex();
     }
 
     return m_implInfoList.empty() ? MFX_ERR_UNSUPPORTED : MFX_ERR_NONE;
 }
 
+// build caps index used by UpdateValidImplList(), if not already built
+// copies of ImplInfo (e.g. from shared catalog) share the same index
+mfxStatus LoaderCtxVPL::IndexImplCaps(ImplInfo *implInfo) {
+    if (implInfo->capsIndex || !implInfo->implDesc)
+        return MFX_ERR_NONE;
+
+    std::shared_ptr<CapsIndexVPL> capsIndex;
+    try {
+        capsIndex = std::make_shared<CapsIndexVPL>();
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    mfxStatus sts =
+        ConfigCtxVPL::BuildCapsIndex((mfxImplDescription *)implInfo->implDesc,
+#ifdef ONEVPL_EXPERIMENTAL
+                                     (mfxSurfaceTypesSupported *)implInfo->implSurfTypes,
+#endif
+                                     *capsIndex);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+#ifdef ONEVPL_EXPERIMENTAL
+    AllocFlatCaps(*capsIndex);
+#endif
+
+    implInfo->capsIndex = capsIndex;
+
+    return MFX_ERR_NONE;
+}
+
+// caps formats with handles owned by ImplInfo or LibInfo, see RebuildImplIndex()
+// flat caps are built on first use by GetImplHandle(), so they are indexed separately
+static const mfxImplCapsDeliveryFormat implHandleFormats[] = {
+    MFX_IMPLCAPS_IMPLDESCSTRUCTURE, MFX_IMPLCAPS_IMPLEMENTEDFUNCTIONS,
+    MFX_IMPLCAPS_IMPLPATH,          MFX_IMPLCAPS_DEVICE_ID_EXTENDED,
+#ifdef ONEVPL_EXPERIMENTAL
+    MFX_IMPLCAPS_SURFACE_TYPES,
+#endif
+};
+
+// return handle to caps of implInfo in the requested format, or nullptr if not supported
+mfxHDL LoaderCtxVPL::GetImplHandle(ImplInfo *implInfo, mfxImplCapsDeliveryFormat format) {
+    if (format == MFX_IMPLCAPS_IMPLDESCSTRUCTURE)
+        return implInfo->implDesc;
+    else if (format == MFX_IMPLCAPS_IMPLEMENTEDFUNCTIONS)
+        return implInfo->implFuncs;
+    else if (format == MFX_IMPLCAPS_IMPLPATH)
+        return implInfo->libInfo->implCapsPath;
+    else if (format == MFX_IMPLCAPS_DEVICE_ID_EXTENDED)
+        return implInfo->implExtDeviceID;
+#ifdef ONEVPL_EXPERIMENTAL
+    else if (format == MFX_IMPLCAPS_SURFACE_TYPES)
+        return implInfo->implSurfTypes;
+    else if (format == MFX_IMPLCAPS_FLAT)
+        return GetFlatCaps(implInfo);
+#endif
+
+    return nullptr;
+}
+
+// rebuild array of valid implementations (indexed by validImplIdx) and
+//   map of caps handles back to their implementation
+// must be called whenever validImplIdx changes, with the loader locked in exclusive mode
+void LoaderCtxVPL::RebuildImplIndex() {
+    m_validImplList.clear();
+    m_implHandleMap.clear();
+
+    for (auto implInfo : m_implInfoList) {
+        if (implInfo->validImplIdx >= 0) {
+            mfxU32 idx = (mfxU32)implInfo->validImplIdx;
+            if (idx >= m_validImplList.size())
+                m_validImplList.resize(idx + 1, nullptr);
+
+            // keep the first implementation in list order, as a linear search would
+            if (!m_validImplList[idx])
+                m_validImplList[idx] = implInfo;
+        }
+
+        // handles of all implementations can be released, valid or not
+        for (auto format : implHandleFormats) {
+            mfxHDL hdl = GetImplHandle(implInfo, format);
+            if (hdl)
+                m_implHandleMap.emplace(hdl, ImplHandleVPL{ implInfo, format });
+        }
+
+#ifdef ONEVPL_EXPERIMENTAL
+        // flat caps may not be built yet, but their block is allocated with the caps index
+        if (implInfo->capsIndex && !implInfo->capsIndex->flatCapsBuf.empty()) {
+            m_implHandleMap.emplace(implInfo->capsIndex->flatCapsBuf.data(),
+                                    ImplHandleVPL{ implInfo, MFX_IMPLCAPS_FLAT });
+        }
+#endif
+    }
+}
+
 // query implementation i
 mfxStatus LoaderCtxVPL::QueryImpl(mfxU32 idx, mfxImplCapsDeliveryFormat format, mfxHDL *idesc) {
     DISP_LOG_FUNCTION(&m_dispLog);
 
     *idesc = nullptr;
 
-    std::list<ImplInfo *>::iterator it = m_implInfoList.begin();
-    while (it != m_implInfoList.end()) {
-        ImplInfo *implInfo = (*it);
-        if (implInfo->validImplIdx == (mfxI32)idx) {
-            if (format == MFX_IMPLCAPS_IMPLDESCSTRUCTURE) {
-                *idesc = implInfo->implDesc;
-            }
-            else if (format == MFX_IMPLCAPS_IMPLEMENTEDFUNCTIONS) {
-                *idesc = implInfo->implFuncs;
-            }
-            else if (format == MFX_IMPLCAPS_IMPLPATH) {
-                *idesc = implInfo->libInfo->implCapsPath;
-            }
-            else if (format == MFX_IMPLCAPS_DEVICE_ID_EXTENDED) {
-                *idesc = implInfo->implExtDeviceID;
-            }
+    // invalid idx
+    if (idx >= m_validImplList.size() || !m_validImplList[idx])
+        return MFX_ERR_NOT_FOUND;
+
+    *idesc = GetImplHandle(m_validImplList[idx], format);
+
+    // implementation found, but requested query format is not supported
+    if (*idesc == nullptr)
+        return MFX_ERR_UNSUPPORTED;
+
+    return MFX_ERR_NONE;
+}
+
 #ifdef ONEVPL_EXPERIMENTAL
-            else if (format == MFX_IMPLCAPS_SURFACE_TYPES) {
-                *idesc = implInfo->implSurfTypes;
-            }
-#endif
+// query all valid implementations, in index order
+mfxStatus LoaderCtxVPL::QueryAllImpls(mfxImplCapsDeliveryFormat format,
+                                      mfxHDL *idescs,
+                                      mfxU32 *numImpls) {
+    DISP_LOG_FUNCTION(&m_dispLog);
 
-            // implementation found, but requested query format is not supported
-            if (*idesc == nullptr)
-                return MFX_ERR_UNSUPPORTED;
+    mfxU32 numValidImpls = (mfxU32)m_validImplList.size();
+    if (numValidImpls == 0)
+        return MFX_ERR_NOT_FOUND;
 
-            return MFX_ERR_NONE;
-        }
-        it++;
+    // only return the number of implementations
+    if (idescs == nullptr) {
+        *numImpls = numValidImpls;
+        return MFX_ERR_NONE;
     }
 
-    // invalid idx
-    return MFX_ERR_NOT_FOUND;
+    if (*numImpls < numValidImpls) {
+        *numImpls = numValidImpls;
+        return MFX_ERR_NOT_ENOUGH_BUFFER;
+    }
+
+    for (mfxU32 idx = 0; idx < numValidImpls; idx++) {
+        ImplInfo *implInfo = m_validImplList[idx];
+
+        idescs[idx] = (implInfo ? GetImplHandle(implInfo, format) : nullptr);
+        if (idescs[idx] == nullptr)
+            return MFX_ERR_UNSUPPORTED;
+    }
+
+    *numImpls = numValidImpls;
+
+    return MFX_ERR_NONE;
 }
+#endif
 
 mfxStatus LoaderCtxVPL::ReleaseImpl(mfxHDL idesc) {
     DISP_LOG_FUNCTION(&m_dispLog);
@@ -1350,42 +1809,14 @@ mfxStatus LoaderCtxVPL::ReleaseImpl(mfxHDL idesc) {
     if (idesc == nullptr)
         return MFX_ERR_NULL_PTR;
 
-    // all we get from the application is a handle to the descriptor,
-    //   not the implementation associated with it, so we search
-    //   through the full list until we find a match
-    std::list<ImplInfo *>::iterator it = m_implInfoList.begin();
-    while (it != m_implInfoList.end()) {
-        ImplInfo *implInfo                   = (*it);
-        mfxImplCapsDeliveryFormat capsFormat = (mfxImplCapsDeliveryFormat)0; // unknown format
-
-        // in low latency mode implDesc will be empty
-        if (implInfo->implDesc == nullptr)
-            continue;
-
-        // determine type of descriptor so we know which handle to
-        //   invalidate in the Loader context
-        if (implInfo->implDesc == idesc) {
-            capsFormat = MFX_IMPLCAPS_IMPLDESCSTRUCTURE;
-        }
-        else if (implInfo->implFuncs == idesc) {
-            capsFormat = MFX_IMPLCAPS_IMPLEMENTEDFUNCTIONS;
-        }
-        else if (implInfo->libInfo->implCapsPath == idesc) {
-            capsFormat = MFX_IMPLCAPS_IMPLPATH;
-        }
-        else if (implInfo->implExtDeviceID == idesc) {
-            capsFormat = MFX_IMPLCAPS_DEVICE_ID_EXTENDED;
-        }
-#ifdef ONEVPL_EXPERIMENTAL
-        else if (implInfo->implSurfTypes == idesc) {
-            capsFormat = MFX_IMPLCAPS_SURFACE_TYPES;
-        }
-#endif
-        else {
-            // no match - try next implementation
-            it++;
-            continue;
-        }
+    // all we get from the application is a handle to the descriptor, so look up
+    //   the implementation and type of descriptor it was returned for
+    // the handle is checked again, since the descriptor may have been released already
+    auto it = m_implHandleMap.find(idesc);
+    if (it != m_implHandleMap.end() &&
+        GetImplHandle(it->second.implInfo, it->second.format) == idesc) {
+        ImplInfo *implInfo                   = it->second.implInfo;
+        mfxImplCapsDeliveryFormat capsFormat = it->second.format;
 
         // if true, do not actually call ReleaseImplDescription() until
         //   MFXUnload() --> UnloadAllLibraries()
@@ -1394,8 +1825,15 @@ mfxStatus LoaderCtxVPL::ReleaseImpl(mfxHDL idesc) {
         if (m_bKeepCapsUntilUnload)
             return MFX_ERR_NONE;
 
+#ifdef ONEVPL_EXPERIMENTAL
+        // flat caps are built by the dispatcher, freed with the caps index
+        if (capsFormat == MFX_IMPLCAPS_FLAT)
+            return MFX_ERR_NONE;
+#endif
+
         // LibTypeMSDK does not require calling a release function
-        if (implInfo->libInfo->libType == LibTypeVPL) {
+        // descriptors restored from caps cache are released in UnloadSingleLibrary()
+        if (implInfo->libInfo->libType == LibTypeVPL && !implInfo->libInfo->cachedCaps) {
             // call MFXReleaseImplDescription() for this implementation
             VPLFunctionPtr pFunc = implInfo->libInfo->vplFuncTable[IdxMFXReleaseImplDescription];
 
@@ -1419,6 +1857,10 @@ mfxStatus LoaderCtxVPL::ReleaseImpl(mfxHDL idesc) {
 #endif
 
             // nothing to do if (capsFormat == MFX_IMPLCAPS_IMPLPATH) since no new memory was allocated
+
+            // memoized results were checked against the released descriptor
+            if (capsFormat != MFX_IMPLCAPS_IMPLPATH)
+                implInfo->configResults.clear();
         }
 
         return sts;
@@ -1429,15 +1871,24 @@ mfxStatus LoaderCtxVPL::ReleaseImpl(mfxHDL idesc) {
 }
 
 mfxStatus LoaderCtxVPL::UpdateLowLatency() {
+    // all libraries are loaded by the warm-up thread, low latency mode is not used
+    if (m_bWarmUp)
+        return MFX_ERR_NONE;
+
     m_bLowLatency = false;
 
     m_bLowLatency = ConfigCtxVPL::CheckLowLatencyConfig(m_configCtxList, &m_specialConfig);
 
+    // low latency mode searches fixed locations instead of the manifest
+    if (m_bManifest)
+        m_bLowLatency = false;
+
     return MFX_ERR_NONE;
 }
 
 mfxStatus LoaderCtxVPL::UpdateValidImplList(void) {
     DISP_LOG_FUNCTION(&m_dispLog);
+    STARTUP_PHASE_TIMER(&m_startupTiming, LOADER_PHASE_VALIDATE_CONFIG);
 
     mfxStatus sts = MFX_ERR_NONE;
 
@@ -1449,12 +1900,16 @@ mfxStatus LoaderCtxVPL::UpdateValidImplList(void) {
     while (it != m_implInfoList.end()) {
         ImplInfo *implInfo = (*it);
 
-        // already invalidated by previous filter
-        if (implInfo->validImplIdx == -1) {
+        // implementations rejected by earlier filters are checked again, since the
+        //   filter may have changed - only properties which changed are re-checked
+        if (implInfo->bExcludedByQuery) {
             it++;
             continue;
         }
 
+        // index caps if this was not done when they were queried
+        IndexImplCaps(implInfo);
+
         // compare caps from this library vs. config filters
         sts = ConfigCtxVPL::ValidateConfig((mfxImplDescription *)implInfo->implDesc,
                                            (mfxImplementedFunctions *)implInfo->implFuncs,
@@ -1462,9 +1917,11 @@ mfxStatus LoaderCtxVPL::UpdateValidImplList(void) {
 #ifdef ONEVPL_EXPERIMENTAL
                                            (mfxSurfaceTypesSupported *)implInfo->implSurfTypes,
 #endif
+                                           implInfo->capsIndex.get(),
                                            m_configCtxList,
                                            implInfo->libInfo->libType,
-                                           &m_specialConfig);
+                                           &m_specialConfig,
+                                           &implInfo->configResults);
 
         // check special filter properties which are not part of mfxImplDescription
         if (m_specialConfig.bIsSet_dxgiAdapterIdx &&
@@ -1488,6 +1945,10 @@ mfxStatus LoaderCtxVPL::UpdateValidImplList(void) {
     // re-sort valid implementations according to priority rules in spec
     PrioritizeImplList();
 
+    // then by measured throughput, if enabled
+    if (m_bRankThroughput)
+        RankImplList();
+
     m_bNeedUpdateValidImpls = false;
 
     return MFX_ERR_NONE;
@@ -1502,6 +1963,7 @@ mfxStatus LoaderCtxVPL::UpdateValidImplList(void) {
 //  4) Search path priority: lower values = higher priority
 mfxStatus LoaderCtxVPL::PrioritizeImplList(void) {
     DISP_LOG_FUNCTION(&m_dispLog);
+    STARTUP_PHASE_TIMER(&m_startupTiming, LOADER_PHASE_PRIORITIZE);
 
     // API 2.6 introduced special search location ONEVPL_PRIORITY_PATH
     // Libs here always have highest priority = LIB_PRIORITY_SPECIAL
@@ -1563,8 +2025,14 @@ mfxStatus LoaderCtxVPL::PrioritizeImplList(void) {
         m_implInfoList.splice(m_implInfoList.begin(), implInfoListPriority);
     }
 
-    // final pass - update index to match new priority order
-    // validImplIdx will be the index associated with MFXEnumImplememntations()
+    RenumberValidImpls();
+
+    return MFX_ERR_NONE;
+}
+
+// final pass after sorting - update index to match new priority order
+// validImplIdx will be the index associated with MFXEnumImplememntations()
+void LoaderCtxVPL::RenumberValidImpls() {
     mfxI32 validImplIdx                = 0;
     std::list<ImplInfo *>::iterator it = m_implInfoList.begin();
     while (it != m_implInfoList.end()) {
@@ -1576,125 +2044,192 @@ mfxStatus LoaderCtxVPL::PrioritizeImplList(void) {
         it++;
     }
 
-    return MFX_ERR_NONE;
+    RebuildImplIndex();
 }
 
 mfxStatus LoaderCtxVPL::CreateSession(mfxU32 idx, mfxSession *session) {
     DISP_LOG_FUNCTION(&m_dispLog);
 
-    mfxStatus sts = MFX_ERR_NONE;
+    SessionParamsVPL params;
+
+    mfxStatus sts = GetSessionParams(idx, params);
+    if (sts != MFX_ERR_NONE)
+        return sts;
 
+    return CreateSessionFromParams(params, session);
+}
+
+// resolve parameters for creating a session with implementation idx
+//   from the current filters and special config properties
+mfxStatus LoaderCtxVPL::GetSessionParams(mfxU32 idx, SessionParamsVPL &params) {
     // find library with given implementation index
     // list of valid implementations (and associated indices) is updated
     //   every time a filter property is added/modified
-    std::list<ImplInfo *>::iterator it = m_implInfoList.begin();
-    while (it != m_implInfoList.end()) {
-        ImplInfo *implInfo = (*it);
+    if (idx >= m_validImplList.size() || !m_validImplList[idx])
+        return MFX_ERR_NOT_FOUND;
 
-        if (implInfo->validImplIdx == (mfxI32)idx) {
-            LibInfo *libInfo = implInfo->libInfo;
-            mfxU16 deviceID  = 0;
+    ImplInfo *implInfo = m_validImplList[idx];
+    LibInfo *libInfo   = implInfo->libInfo;
 
-            // pass VendorImplID for this implementation (disambiguate if one
-            //   library contains multiple implementations)
-            // NOTE: implDesc may be null in low latency mode (RT query not called)
-            //   so this value will not be available
-            mfxImplDescription *implDesc = (mfxImplDescription *)(implInfo->implDesc);
-            if (implDesc) {
-                implInfo->vplParam.VendorImplID = implDesc->VendorImplID;
-            }
+    // implInfo is not modified, since other threads may be reading it
+    mfxInitializationParam &vplParam = params.vplParam;
+    vplParam                         = implInfo->vplParam;
+
+    // pass VendorImplID for this implementation (disambiguate if one
+    //   library contains multiple implementations)
+    // NOTE: implDesc may be null in low latency mode (RT query not called)
+    //   so this value will not be available
+    mfxImplDescription *implDesc = (mfxImplDescription *)(implInfo->implDesc);
+    if (implDesc) {
+        vplParam.VendorImplID = implDesc->VendorImplID;
+    }
 
-            // set any special parameters passed in via SetConfigProperty
-            // if application did not specify accelerationMode, use default
-            if (m_specialConfig.bIsSet_accelerationMode)
-                implInfo->vplParam.AccelerationMode = m_specialConfig.accelerationMode;
+    // set any special parameters passed in via SetConfigProperty
+    // if application did not specify accelerationMode, use default
+    if (m_specialConfig.bIsSet_accelerationMode)
+        vplParam.AccelerationMode = m_specialConfig.accelerationMode;
 
 #ifdef ONEVPL_EXPERIMENTAL
-            if (m_specialConfig.bIsSet_DeviceCopy)
-                implInfo->vplParam.DeviceCopy = m_specialConfig.DeviceCopy;
+    if (m_specialConfig.bIsSet_DeviceCopy)
+        vplParam.DeviceCopy = m_specialConfig.DeviceCopy;
 #endif
 
-            // in low latency mode there was no implementation filtering, so check here
-            //   for minimum API version
-            if (m_bLowLatency && m_specialConfig.bIsSet_ApiVersion) {
-                if (implInfo->version.Version < m_specialConfig.ApiVersion.Version)
-                    return MFX_ERR_NOT_FOUND;
-            }
-
-            mfxIMPL msdkImpl = 0;
-            if (libInfo->libType == LibTypeMSDK) {
-                if (implInfo->vplParam.AccelerationMode == MFX_ACCEL_MODE_VIA_D3D9)
-                    msdkImpl = libInfo->msdkCtx[implInfo->msdkImplIdx].m_msdkAdapterD3D9;
-                else
-                    msdkImpl = libInfo->msdkCtx[implInfo->msdkImplIdx].m_msdkAdapter;
-            }
+    // in low latency mode there was no implementation filtering, so check here
+    //   for minimum API version
+    if (m_bLowLatency && m_specialConfig.bIsSet_ApiVersion) {
+        if (implInfo->version.Version < m_specialConfig.ApiVersion.Version)
+            return MFX_ERR_NOT_FOUND;
+    }
 
-            // in low latency mode implDesc is not available, but application may set adapter number via DXGIAdapterIndex filter
-            if (m_bLowLatency) {
-                if (m_specialConfig.bIsSet_dxgiAdapterIdx && libInfo->libType == LibTypeVPL) {
-                    implInfo->vplParam.VendorImplID = m_specialConfig.dxgiAdapterIdx;
-                }
-                else if (m_specialConfig.bIsSet_dxgiAdapterIdx && libInfo->libType == LibTypeMSDK) {
-                    if (m_specialConfig.dxgiAdapterIdx >= MAX_NUM_IMPL_MSDK)
-                        return MFX_ERR_NOT_FOUND; // MSDK adapter index out of range
-                    msdkImpl = msdkImplTab[m_specialConfig.dxgiAdapterIdx];
-                }
-            }
+    mfxIMPL msdkImpl = 0;
+    if (libInfo->libType == LibTypeMSDK) {
+        if (vplParam.AccelerationMode == MFX_ACCEL_MODE_VIA_D3D9)
+            msdkImpl = libInfo->msdkCtx[implInfo->msdkImplIdx].m_msdkAdapterD3D9;
+        else
+            msdkImpl = libInfo->msdkCtx[implInfo->msdkImplIdx].m_msdkAdapter;
+    }
 
-            // add any extension buffers set via special filter properties
-            std::vector<mfxExtBuffer *> extBufs;
+    // in low latency mode implDesc is not available, but application may set adapter number via DXGIAdapterIndex filter
+    if (m_bLowLatency) {
+        if (m_specialConfig.bIsSet_dxgiAdapterIdx && libInfo->libType == LibTypeVPL) {
+            vplParam.VendorImplID = m_specialConfig.dxgiAdapterIdx;
+        }
+        else if (m_specialConfig.bIsSet_dxgiAdapterIdx && libInfo->libType == LibTypeMSDK) {
+            if (m_specialConfig.dxgiAdapterIdx >= MAX_NUM_IMPL_MSDK)
+                return MFX_ERR_NOT_FOUND; // MSDK adapter index out of range
+            msdkImpl = msdkImplTab[m_specialConfig.dxgiAdapterIdx];
+        }
+    }
 
-            // pass NumThread via mfxExtThreadsParam
-            mfxExtThreadsParam extThreadsParam = {};
-            if (m_specialConfig.bIsSet_NumThread) {
-                DISP_LOG_MESSAGE(&m_dispLog,
-                                 "message:  extBuf enabled -- NumThread (%d)",
-                                 m_specialConfig.NumThread);
+    params.libInfo  = libInfo;
+    params.version  = implInfo->version;
+    params.msdkImpl = msdkImpl;
 
-                extThreadsParam.Header.BufferId = MFX_EXTBUFF_THREADS_PARAM;
-                extThreadsParam.Header.BufferSz = sizeof(mfxExtThreadsParam);
-                extThreadsParam.NumThread       = m_specialConfig.NumThread;
+    // fast path: reuse function table which was resolved for this library
+    //   by a previous call, without loading the library again
+    params.bFastPath = (m_bSessionFastPath && libInfo->libType == LibTypeVPL && !m_bLowLatency);
 
-                extBufs.push_back((mfxExtBuffer *)&extThreadsParam);
-            }
+    // record call statistics in the dispatcher (ONEVPL_SESSION_PROFILE or filter property)
+    params.bProfile = (m_bSessionProfile || (m_specialConfig.bIsSet_SessionProfile &&
+                                             m_specialConfig.SessionProfile));
 
-            // add extBufs provided via mfxConfig filter property "ExtBuffer"
-            if (m_specialConfig.bIsSet_ExtBuffer) {
-                for (auto extBuf : m_specialConfig.ExtBuffers) {
-                    extBufs.push_back((mfxExtBuffer *)extBuf);
-                }
-            }
+    // pass NumThread via mfxExtThreadsParam
+    if (m_specialConfig.bIsSet_NumThread) {
+        DISP_LOG_MESSAGE(&m_dispLog,
+                         "message:  extBuf enabled -- NumThread (%d)",
+                         m_specialConfig.NumThread);
 
-            // attach vector of extBufs to mfxInitializationParam
-            implInfo->vplParam.NumExtParam = static_cast<mfxU16>(extBufs.size());
-            implInfo->vplParam.ExtParam =
-                (implInfo->vplParam.NumExtParam ? extBufs.data() : nullptr);
-
-            // initialize this library via MFXInitialize or else fail
-            //   (specify full path to library)
-            sts = MFXInitEx2(implInfo->version,
-                             implInfo->vplParam,
-                             msdkImpl,
-                             session,
-                             &deviceID,
-                             (CHAR_TYPE *)libInfo->libNameFull.c_str());
-
-            // optionally call MFXSetHandle() if present via SetConfigProperty
-            if (sts == MFX_ERR_NONE && m_specialConfig.bIsSet_deviceHandleType &&
-                m_specialConfig.bIsSet_deviceHandle && m_specialConfig.deviceHandleType &&
-                m_specialConfig.deviceHandle) {
-                sts = MFXVideoCORE_SetHandle(*session,
-                                             m_specialConfig.deviceHandleType,
-                                             m_specialConfig.deviceHandle);
-            }
+        params.extThreadsParam.Header.BufferId = MFX_EXTBUFF_THREADS_PARAM;
+        params.extThreadsParam.Header.BufferSz = sizeof(mfxExtThreadsParam);
+        params.extThreadsParam.NumThread       = m_specialConfig.NumThread;
+        params.bSetThreadsParam                = true;
+    }
 
-            return sts;
+    // add extBufs provided via mfxConfig filter property "ExtBuffer"
+    // copies are kept, since config objects may be destroyed or changed later
+    if (m_specialConfig.bIsSet_ExtBuffer) {
+        for (auto extBuf : m_specialConfig.ExtBuffers) {
+            mfxU8 *extBufStart = (mfxU8 *)extBuf;
+            params.extBufData.emplace_back(extBufStart, extBufStart + extBuf->BufferSz);
         }
-        it++;
     }
 
-    // invalid idx
-    return MFX_ERR_NOT_FOUND;
+    // optionally call MFXSetHandle() if present via SetConfigProperty
+    if (m_specialConfig.bIsSet_deviceHandleType && m_specialConfig.bIsSet_deviceHandle &&
+        m_specialConfig.deviceHandleType && m_specialConfig.deviceHandle) {
+        params.deviceHandleType = m_specialConfig.deviceHandleType;
+        params.deviceHandle     = m_specialConfig.deviceHandle;
+    }
+
+    return MFX_ERR_NONE;
+}
+
+// create session with parameters from GetSessionParams()
+mfxStatus LoaderCtxVPL::CreateSessionFromParams(const SessionParamsVPL &params,
+                                                mfxSession *session) {
+    mfxStatus sts   = MFX_ERR_NONE;
+    mfxU16 deviceID = 0;
+
+    LibInfo *libInfo                           = params.libInfo;
+    mfxInitializationParam vplParam            = params.vplParam;
+    std::vector<std::vector<mfxU8>> extBufData = params.extBufData;
+
+    // add any extension buffers set via special filter properties
+    // runtime gets its own copy, as it is allowed to write to them
+    std::vector<mfxExtBuffer *> extBufs;
+    mfxExtThreadsParam extThreadsParam = params.extThreadsParam;
+    if (params.bSetThreadsParam)
+        extBufs.push_back((mfxExtBuffer *)&extThreadsParam);
+
+    for (auto &extBuf : extBufData)
+        extBufs.push_back((mfxExtBuffer *)extBuf.data());
+
+    // attach vector of extBufs to mfxInitializationParam
+    vplParam.NumExtParam = static_cast<mfxU16>(extBufs.size());
+    vplParam.ExtParam    = (vplParam.NumExtParam ? extBufs.data() : nullptr);
+
+    STARTUP_PHASE_TIMER(&m_startupTiming, LOADER_PHASE_CREATE_SESSION);
+    mfxU64 startNs = (m_startupTiming.IsEnabled() ? StartupTimingVPL::GetTimeNs() : 0);
+
+    mfxHDL funcTable = nullptr;
+    if (params.bFastPath)
+        funcTable = GetFuncTable(libInfo, params.version);
+
+    sts = MFX_ERR_UNSUPPORTED;
+    if (funcTable) {
+        sts = MFXInitFromFuncTable(params.version, vplParam, funcTable, session);
+        if (sts == MFX_ERR_NONE)
+            DISP_LOG_MESSAGE(&m_dispLog, "message:  session created with fast path");
+    }
+
+    // initialize this library via MFXInitialize or else fail
+    //   (specify full path to library)
+    if (sts != MFX_ERR_NONE) {
+        sts = MFXInitEx2(params.version,
+                         vplParam,
+                         params.msdkImpl,
+                         session,
+                         &deviceID,
+                         (CHAR_TYPE *)libInfo->libNameFull.c_str());
+    }
+
+    if (sts == MFX_ERR_NONE && params.deviceHandle)
+        sts = MFXVideoCORE_SetHandle(*session, params.deviceHandleType, params.deviceHandle);
+
+    // functions called from now on are profiled
+    if (sts == MFX_ERR_NONE && params.bProfile) {
+        mfxStatus profileSts = MFXEnableSessionProfile(*session);
+        DISP_LOG_MESSAGE(&m_dispLog,
+                         "message:  session profile %s",
+                         (profileSts == MFX_ERR_NONE) ? "enabled" : "not available");
+    }
+
+    if (m_startupTiming.IsEnabled() && sts == MFX_ERR_NONE) {
+        libInfo->sessionTimeNs += StartupTimingVPL::GetTimeNs() - startNs;
+        libInfo->numSessions++;
+    }
+
+    return sts;
 }
 
 ConfigCtxVPL *LoaderCtxVPL::AddConfigFilter() {
@@ -1733,46 +2268,164 @@ mfxStatus LoaderCtxVPL::FreeConfigFilters() {
     return MFX_ERR_NONE;
 }
 
-mfxStatus LoaderCtxVPL::InitDispatcherLog() {
-    std::string strLogEnabled, strLogFile;
+// return function table for session creation fast path, resolving it on first use
+// returns null if the fast path is not available for this library
+mfxHDL LoaderCtxVPL::GetFuncTable(LibInfo *libInfo, mfxVersion version) {
+    // all 2.x runtimes export the 2.0 functions, version of each session is checked later
+    mfxVersion tableVersion = MAKE_MFX_VERSION(2, 0);
+    if (version.Major < 2)
+        return nullptr;
 
-#if defined(_WIN32) || defined(_WIN64)
-    DWORD err;
+    std::call_once(libInfo->funcTableOnce, [&]() {
+        MFXCreateFuncTable(tableVersion,
+                           (CHAR_TYPE *)libInfo->libNameFull.c_str(),
+                           &libInfo->hFuncTable);
+    });
 
-    char logEnabled[MAX_VPL_SEARCH_PATH] = "";
-    err = GetEnvironmentVariableA("ONEVPL_DISPATCHER_LOG", logEnabled, MAX_VPL_SEARCH_PATH);
-    if (err == 0 || err >= MAX_VPL_SEARCH_PATH)
-        return MFX_ERR_UNSUPPORTED; // environment variable not defined or string too long
+    return libInfo->hFuncTable;
+}
+
+// set whether sessions may be created with the loader's function table
+// ONEVPL_SESSION_FAST_PATH=OFF always loads the runtime again for each session
+mfxStatus LoaderCtxVPL::InitSessionFastPath() {
+    std::string strFastPath;
+    if (!GetEnvVar("ONEVPL_SESSION_FAST_PATH", strFastPath))
+        return MFX_ERR_NONE;
+
+    if (strFastPath == "OFF")
+        m_bSessionFastPath = false;
+
+    return MFX_ERR_NONE;
+}
+
+// set whether exports of candidate runtimes are checked before loading them
+// ONEVPL_EXPORT_CHECK=OFF loads every candidate to check its exports
+mfxStatus LoaderCtxVPL::InitExportCheck() {
+    std::string strExportCheck;
+    if (!GetEnvVar("ONEVPL_EXPORT_CHECK", strExportCheck))
+        return MFX_ERR_NONE;
+
+    if (strExportCheck == "OFF")
+        m_bExportCheck = false;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus LoaderCtxVPL::InitSessionProfile() {
+    if (IsEnvOn("ONEVPL_SESSION_PROFILE"))
+        m_bSessionProfile = true;
+
+    return MFX_ERR_NONE;
+}
+
+// destroy all config filters so the loader can be reused with a new set of filters
+// loaded libraries and caps are kept
+mfxStatus LoaderCtxVPL::ResetConfigFilters() {
+    DISP_LOG_FUNCTION(&m_dispLog);
 
-    strLogEnabled = logEnabled;
+    FreeConfigFilters();
+    m_configCtxList.clear();
+
+    m_specialConfig.bIsSet_deviceHandleType = false;
+    m_specialConfig.bIsSet_deviceHandle     = false;
+    m_specialConfig.bIsSet_accelerationMode = false;
+    m_specialConfig.bIsSet_ApiVersion       = false;
+    m_specialConfig.bIsSet_dxgiAdapterIdx   = false;
+    m_specialConfig.bIsSet_NumThread        = false;
+    m_specialConfig.bIsSet_DeviceCopy       = false;
+    m_specialConfig.bIsSet_SessionProfile   = false;
+    m_specialConfig.bIsSet_ExtBuffer        = false;
+    m_specialConfig.ExtBuffers.clear();
 
-    char logFile[MAX_VPL_SEARCH_PATH] = "";
-    err = GetEnvironmentVariableA("ONEVPL_DISPATCHER_LOG_FILE", logFile, MAX_VPL_SEARCH_PATH);
-    if (err == 0 || err >= MAX_VPL_SEARCH_PATH) {
-        // nothing to do - strLogFile is an empty string
+    // libraries loaded in low latency mode were not fully queried
+    if (m_bLowLatency && !m_bNeedLowLatencyQuery) {
+        UnloadAllLibraries();
+        m_bNeedLowLatencyQuery = true;
     }
-    else {
-        strLogFile = logFile;
+    m_bLowLatency = false;
+
+    // all implementations are reconsidered with the next set of filters
+    std::list<ImplInfo *>::iterator it = m_implInfoList.begin();
+    while (it != m_implInfoList.end()) {
+        ImplInfo *implInfo     = (*it);
+        implInfo->validImplIdx = (implInfo->bExcludedByQuery ? -1 : 0);
+        implInfo->configResults.clear();
+        it++;
     }
 
-#else
-    const char *logEnabled = std::getenv("ONEVPL_DISPATCHER_LOG");
-    if (!logEnabled)
-        return MFX_ERR_UNSUPPORTED;
+    // indices are assigned again by UpdateValidImplList()
+    m_validImplList.clear();
+
+    m_bNeedUpdateValidImpls = true;
 
-    strLogEnabled = logEnabled;
+    return MFX_ERR_NONE;
+}
 
-    const char *logFile = std::getenv("ONEVPL_DISPATCHER_LOG_FILE");
-    if (logFile)
-        strLogFile = logFile;
+#ifdef ONEVPL_EXPERIMENTAL
+// return the alternative of config which matched valid implementation idx
+// valid implementation list must be up to date
+mfxStatus LoaderCtxVPL::QueryConfigAlternative(mfxU32 idx,
+                                               ConfigCtxVPL *config,
+                                               mfxU32 *alternative) {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    // alternatives are not in the list, so they are also rejected here
+    auto it = std::find(m_configCtxList.begin(), m_configCtxList.end(), config);
+    if (it == m_configCtxList.end())
+        return MFX_ERR_INVALID_HANDLE;
+
+    if (idx >= m_validImplList.size() || !m_validImplList[idx])
+        return MFX_ERR_NOT_FOUND;
+
+    return config->GetMatchedAlternative(m_validImplList[idx]->configResults, alternative);
+}
 #endif
 
-    if (strLogEnabled != "ON")
+mfxStatus LoaderCtxVPL::InitDispatcherLog() {
+    std::string strLogEnabled, strLogFile;
+    if (!GetEnvVar("ONEVPL_DISPATCHER_LOG", strLogEnabled))
+        return MFX_ERR_UNSUPPORTED;
+
+    // strLogFile stays empty if not defined
+    GetEnvVar("ONEVPL_DISPATCHER_LOG_FILE", strLogFile);
+
+    // TRACE keeps binary records in memory and writes them at unload
+    DispatcherLogOutputVPL output = DISP_LOG_OUTPUT_TEXT;
+    if (strLogEnabled == "TRACE")
+        output = DISP_LOG_OUTPUT_TRACE;
+    else if (strLogEnabled == "TRACE_JSON")
+        output = DISP_LOG_OUTPUT_TRACE_JSON;
+    else if (strLogEnabled != "ON")
         return MFX_ERR_UNSUPPORTED;
 
     // currently logLevel is either 0 or non-zero
     // additional levels will be added with future API updates
-    return m_dispLog.Init(1, strLogFile);
+    return m_dispLog.Init(1, strLogFile, output);
+}
+
+mfxStatus LoaderCtxVPL::InitCapsCache() {
+    return m_capsCache.Init();
+}
+
+// set max number of threads used to probe candidate runtimes
+// ONEVPL_PROBE_THREADS=1 restores serial probing
+mfxStatus LoaderCtxVPL::InitProbeThreads() {
+    mfxU32 numThreads = std::thread::hardware_concurrency();
+    if (numThreads == 0)
+        numThreads = 1;
+    m_maxProbeThreads = std::min(numThreads, (mfxU32)MAX_NUM_PROBE_THREADS);
+
+    std::string strProbeThreads;
+    if (!GetEnvVar("ONEVPL_PROBE_THREADS", strProbeThreads))
+        return MFX_ERR_NONE;
+
+    int val = std::atoi(strProbeThreads.c_str());
+    if (val < 1)
+        return MFX_ERR_UNSUPPORTED;
+
+    m_maxProbeThreads = (mfxU32)val;
+
+    return MFX_ERR_NONE;
 }
 
 // public function to return logger object
@@ -6,21 +6,49 @@
 
 #include "src/mfx_dispatcher_vpl_log.h"
 
-DispatcherLogVPL::DispatcherLogVPL() : m_logLevel(0), m_logFileName(), m_logFile(nullptr) {}
+#include <algorithm>
+
+// records per thread (power of two), 256 KB
+#define TRACE_RING_SIZE 2048
+
+static std::atomic<mfxU64> g_nextTraceId(1);
+
+TraceRingVPL::TraceRingVPL(mfxU32 threadIdx, std::thread::id threadId)
+        : m_records(TRACE_RING_SIZE),
+          m_writeIdx(0),
+          m_threadIdx(threadIdx),
+          m_threadId(threadId) {}
+
+DispatcherLogVPL::DispatcherLogVPL()
+        : m_logLevel(0),
+          m_logFileName(),
+          m_logFile(nullptr),
+          m_output(DISP_LOG_OUTPUT_TEXT),
+          m_traceId(g_nextTraceId++),
+          m_traceStart(),
+          m_traceMutex(),
+          m_traceRings() {}
 
 DispatcherLogVPL::~DispatcherLogVPL() {
+    if (m_output != DISP_LOG_OUTPUT_TEXT && m_logFile)
+        WriteTrace();
+
     if (!m_logFileName.empty() && m_logFile)
         fclose(m_logFile);
     m_logFile = nullptr;
 }
 
-mfxStatus DispatcherLogVPL::Init(mfxU32 logLevel, const std::string &logFileName) {
+mfxStatus DispatcherLogVPL::Init(mfxU32 logLevel,
+                                 const std::string &logFileName,
+                                 DispatcherLogOutputVPL output) {
     // avoid leaking file handle if Init is accidentally called more than once
     if (m_logFile)
         return MFX_ERR_UNSUPPORTED;
 
     m_logLevel    = logLevel;
     m_logFileName = logFileName;
+    m_output      = output;
+    m_traceStart  = std::chrono::steady_clock::now();
 
     // append to file if it already exists, otherwise create a new one
     // m_logFile will be closed in dtor
@@ -52,6 +80,28 @@ mfxStatus DispatcherLogVPL::LogMessage(const char *msg, ...) {
     if (!m_logLevel || !m_logFile)
         return MFX_ERR_NONE;
 
+    if (m_output != DISP_LOG_OUTPUT_TEXT) {
+        TraceRingVPL *ring = GetTraceRing();
+        if (!ring)
+            return MFX_ERR_NONE;
+
+        TraceRecordVPL *rec = ring->NextRecord();
+        rec->timeNs         = (mfxU64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - m_traceStart)
+                          .count();
+        rec->fnName = nullptr;
+        rec->event  = TRACE_EVENT_MESSAGE;
+
+        va_list args;
+        va_start(args, msg);
+        vsnprintf(rec->msg, sizeof(rec->msg), msg, args);
+        va_end(args);
+
+        ring->Commit();
+
+        return MFX_ERR_NONE;
+    }
+
     va_list args;
     va_start(args, msg);
     vfprintf(m_logFile, msg, args);
@@ -61,3 +111,175 @@ mfxStatus DispatcherLogVPL::LogMessage(const char *msg, ...) {
 
     return MFX_ERR_NONE;
 }
+
+void DispatcherLogVPL::LogFunction(const char *fnName, mfxU32 event) {
+    if (!m_logLevel || !m_logFile)
+        return;
+
+    if (m_output == DISP_LOG_OUTPUT_TEXT) {
+        LogMessage("function: %s (%s)",
+                   fnName,
+                   (event == TRACE_EVENT_FN_ENTER) ? "enter" : "return");
+        return;
+    }
+
+    TraceRingVPL *ring = GetTraceRing();
+    if (!ring)
+        return;
+
+    TraceRecordVPL *rec = ring->NextRecord();
+    rec->timeNs         = (mfxU64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - m_traceStart)
+                      .count();
+    rec->fnName = fnName;
+    rec->event  = event;
+
+    ring->Commit();
+}
+
+// return ring buffer of the calling thread, creating it on first use
+// the ring used last is cached per thread, so the lock is only taken when a thread
+//   logs to a loader for the first time (or alternates between loaders)
+TraceRingVPL *DispatcherLogVPL::GetTraceRing() {
+    thread_local mfxU64 cachedTraceId     = 0;
+    thread_local TraceRingVPL *cachedRing = nullptr;
+
+    if (cachedTraceId == m_traceId)
+        return cachedRing;
+
+    std::lock_guard<std::mutex> lock(m_traceMutex);
+
+    std::thread::id threadId = std::this_thread::get_id();
+
+    TraceRingVPL *ring = nullptr;
+    for (auto &r : m_traceRings) {
+        if (r->m_threadId == threadId) {
+            ring = r.get();
+            break;
+        }
+    }
+
+    if (!ring) {
+        try {
+            m_traceRings.emplace_back(new TraceRingVPL((mfxU32)m_traceRings.size(), threadId));
+        }
+        catch (...) {
+            return nullptr;
+        }
+        ring = m_traceRings.back().get();
+    }
+
+    cachedTraceId = m_traceId;
+    cachedRing    = ring;
+
+    return ring;
+}
+
+// write string with JSON escapes
+static void WriteJsonString(FILE *f, const char *str) {
+    fputc('"', f);
+    for (const char *c = str; *c; c++) {
+        if (*c == '"' || *c == '\\')
+            fprintf(f, "\\%c", *c);
+        else if ((unsigned char)*c < 0x20)
+            fprintf(f, "\\u%04x", (unsigned char)*c);
+        else
+            fputc(*c, f);
+    }
+    fputc('"', f);
+}
+
+struct TraceEntryVPL {
+    const TraceRecordVPL *rec;
+    mfxU32 threadIdx;
+};
+
+// merge records from all threads in time order and write them to the log
+// called when the loader is unloaded, after all threads are done logging
+void DispatcherLogVPL::WriteTrace() {
+    std::vector<TraceEntryVPL> entries;
+    mfxU64 numDropped = 0;
+
+    bool bJson = (m_output == DISP_LOG_OUTPUT_TRACE_JSON);
+
+    std::lock_guard<std::mutex> lock(m_traceMutex);
+
+    try {
+        for (auto &ring : m_traceRings) {
+            mfxU64 writeIdx   = ring->m_writeIdx.load(std::memory_order_acquire);
+            mfxU64 numRecords = std::min(writeIdx, (mfxU64)ring->m_records.size());
+
+            // oldest records were overwritten
+            if (writeIdx > numRecords && !bJson) {
+                fprintf(m_logFile,
+                        "message:  trace -- thread %u dropped %llu records\n",
+                        ring->m_threadIdx,
+                        (unsigned long long)(writeIdx - numRecords));
+            }
+            numDropped += writeIdx - numRecords;
+
+            for (mfxU64 i = writeIdx - numRecords; i < writeIdx; i++) {
+                const TraceRecordVPL *rec = &ring->m_records[i & (ring->m_records.size() - 1)];
+                entries.push_back({ rec, ring->m_threadIdx });
+            }
+        }
+    }
+    catch (...) {
+        return;
+    }
+
+    std::stable_sort(entries.begin(),
+                     entries.end(),
+                     [](const TraceEntryVPL &e1, const TraceEntryVPL &e2) {
+                         return (e1.rec->timeNs < e2.rec->timeNs);
+                     });
+
+    if (bJson)
+        fprintf(m_logFile, "{\"traceEvents\":[\n");
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        const TraceRecordVPL *rec = entries[i].rec;
+
+        unsigned long long timeUs = (unsigned long long)(rec->timeNs / 1000);
+        unsigned int timeFrac     = (unsigned int)(rec->timeNs % 1000);
+
+        if (!bJson) {
+            fprintf(m_logFile,
+                    "[%llu.%03u us] [thread %u] ",
+                    timeUs,
+                    timeFrac,
+                    entries[i].threadIdx);
+            if (rec->event == TRACE_EVENT_MESSAGE)
+                fprintf(m_logFile, "%s\n", rec->msg);
+            else
+                fprintf(m_logFile,
+                        "function: %s (%s)\n",
+                        rec->fnName,
+                        (rec->event == TRACE_EVENT_FN_ENTER) ? "enter" : "return");
+            continue;
+        }
+
+        // function enter/exit are duration events, messages are thread-scoped instant events
+        fprintf(m_logFile, "{\"name\":");
+        if (rec->event == TRACE_EVENT_MESSAGE) {
+            fprintf(m_logFile, "\"message\",\"ph\":\"i\",\"s\":\"t\",\"args\":{\"msg\":");
+            WriteJsonString(m_logFile, rec->msg);
+            fprintf(m_logFile, "}");
+        }
+        else {
+            WriteJsonString(m_logFile, rec->fnName);
+            fprintf(m_logFile, ",\"ph\":\"%s\"", (rec->event == TRACE_EVENT_FN_ENTER) ? "B" : "E");
+        }
+        fprintf(m_logFile,
+                ",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%u}%s\n",
+                timeUs,
+                timeFrac,
+                entries[i].threadIdx,
+                (i + 1 < entries.size()) ? "," : "");
+    }
+
+    if (bJson)
+        fprintf(m_logFile, "],\"otherData\":{\"dropped\":%llu}}\n", (unsigned long long)numDropped);
+
+    fflush(m_logFile);
+}
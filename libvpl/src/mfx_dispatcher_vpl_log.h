@@ -14,12 +14,26 @@
  * By default, Intel VPL dispatcher prints all log messages to the console.
  * To redirect log output to the desired file, set the ONEVPL_DISPATCHER_LOG_FILE environmental 
  *   variable with the file name of the log file.
+ *
+ * ONEVPL_DISPATCHER_LOG=TRACE keeps log records in a per-thread binary ring buffer instead,
+ *   and writes them to the log when the loader is unloaded. Function enter/exit records are
+ *   not formatted, and threads do not take any lock. ONEVPL_DISPATCHER_LOG=TRACE_JSON writes
+ *   the records in Chrome trace event format (chrome://tracing, Perfetto).
+ *
+ * Log sites above ONEVPL_DISPATCHER_LOG_MAX_LEVEL are removed at compile time
+ *   (CMake DISPATCHER_LOG_MAX_LEVEL): 0 = none, 1 = messages, 2 = messages and functions.
  */
 
 #include <stdarg.h>
 #include <stdio.h>
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "vpl/mfxdispatcher.h"
 #include "vpl/mfxvideo.h"
@@ -32,19 +46,82 @@
     #endif
 #endif
 
+#ifndef ONEVPL_DISPATCHER_LOG_MAX_LEVEL
+    #define ONEVPL_DISPATCHER_LOG_MAX_LEVEL 2
+#endif
+
+enum DispatcherLogOutputVPL {
+    DISP_LOG_OUTPUT_TEXT = 0, // formatted immediately
+    DISP_LOG_OUTPUT_TRACE, // binary records, written as text at unload
+    DISP_LOG_OUTPUT_TRACE_JSON, // binary records, written as Chrome trace events at unload
+};
+
+enum TraceEventVPL {
+    TRACE_EVENT_FN_ENTER = 0,
+    TRACE_EVENT_FN_RETURN,
+    TRACE_EVENT_MESSAGE,
+};
+
+#define TRACE_MSG_LEN 104
+
+// fixed-size trace record
+// function records only keep a pointer to the (static) function name, messages are
+//   formatted into the record since string arguments may not outlive the call
+struct TraceRecordVPL {
+    mfxU64 timeNs;
+    const char *fnName;
+    mfxU32 event;
+    mfxU32 reserved;
+    char msg[TRACE_MSG_LEN];
+};
+
+// ring buffer of trace records written by one thread
+// only the owning thread writes, so no lock is needed; oldest records are overwritten
+//   when full and the ring is read after the loader is done
+class TraceRingVPL {
+public:
+    TraceRingVPL(mfxU32 threadIdx, std::thread::id threadId);
+
+    TraceRecordVPL *NextRecord() {
+        return &m_records[m_writeIdx.load(std::memory_order_relaxed) & (m_records.size() - 1)];
+    }
+
+    void Commit() {
+        m_writeIdx.store(m_writeIdx.load(std::memory_order_relaxed) + 1,
+                         std::memory_order_release);
+    }
+
+    std::vector<TraceRecordVPL> m_records; // power of two
+    std::atomic<mfxU64> m_writeIdx;
+    mfxU32 m_threadIdx;
+    std::thread::id m_threadId;
+};
+
 class DispatcherLogVPL {
 public:
     DispatcherLogVPL();
     ~DispatcherLogVPL();
 
-    mfxStatus Init(mfxU32 logLevel, const std::string &logFileName);
+    mfxStatus Init(mfxU32 logLevel,
+                   const std::string &logFileName,
+                   DispatcherLogOutputVPL output = DISP_LOG_OUTPUT_TEXT);
     mfxStatus LogMessage(const char *msdk, ...);
+    void LogFunction(const char *fnName, mfxU32 event);
 
     mfxU32 m_logLevel;
 
 private:
+    TraceRingVPL *GetTraceRing();
+    void WriteTrace();
+
     std::string m_logFileName;
     FILE *m_logFile;
+
+    DispatcherLogOutputVPL m_output;
+    mfxU64 m_traceId; // unique per log, identifies the cached per-thread ring
+    std::chrono::steady_clock::time_point m_traceStart;
+    std::mutex m_traceMutex; // protects the list of rings (not the rings)
+    std::vector<std::unique_ptr<TraceRingVPL>> m_traceRings;
 };
 
 class DispatcherLogVPLFunction {
@@ -52,30 +129,45 @@ public:
     DispatcherLogVPLFunction(DispatcherLogVPL *dispLog, const char *fnName)
             : m_dispLog(),
               m_fnName() {
-        m_dispLog = dispLog;
-
-        if (m_dispLog && m_dispLog->m_logLevel) {
-            m_fnName = fnName;
-            m_dispLog->LogMessage("function: %s (enter)", m_fnName.c_str());
+        if (dispLog && dispLog->m_logLevel) {
+            m_dispLog = dispLog;
+            m_fnName  = fnName;
+            m_dispLog->LogFunction(m_fnName, TRACE_EVENT_FN_ENTER);
         }
     }
 
     ~DispatcherLogVPLFunction() {
-        if (m_dispLog && m_dispLog->m_logLevel)
-            m_dispLog->LogMessage("function: %s (return)", m_fnName.c_str());
+        if (m_dispLog)
+            m_dispLog->LogFunction(m_fnName, TRACE_EVENT_FN_RETURN);
     }
 
 private:
     DispatcherLogVPL *m_dispLog;
-    std::string m_fnName;
+    const char *m_fnName; // __FUNC_NAME__ is a static string
 };
 
-#define DISP_LOG_FUNCTION(dispLog) DispatcherLogVPLFunction _dispLogFn(dispLog, __FUNC_NAME__);
-#define DISP_LOG_MESSAGE(dispLog, ...)          \
-    {                                           \
-        if (dispLog) {                          \
-            (dispLog)->LogMessage(__VA_ARGS__); \
-        }                                       \
-    }
+#if ONEVPL_DISPATCHER_LOG_MAX_LEVEL >= 2
+    #define DISP_LOG_FUNCTION(dispLog) \
+        DispatcherLogVPLFunction _dispLogFn(dispLog, __FUNC_NAME__);
+#else
+    #define DISP_LOG_FUNCTION(dispLog) (void)(dispLog);
+#endif
+
+#if ONEVPL_DISPATCHER_LOG_MAX_LEVEL >= 1
+    #define DISP_LOG_MESSAGE(dispLog, ...)          \
+        {                                           \
+            if (dispLog) {                          \
+                (dispLog)->LogMessage(__VA_ARGS__); \
+            }                                       \
+        }
+#else
+    // arguments are still compiled (and count as used), but the call is removed
+    #define DISP_LOG_MESSAGE(dispLog, ...)          \
+        {                                           \
+            if (false) {                            \
+                (dispLog)->LogMessage(__VA_ARGS__); \
+            }                                       \
+        }
+#endif
 
 #endif // LIBVPL_SRC_MFX_DISPATCHER_VPL_LOG_H_
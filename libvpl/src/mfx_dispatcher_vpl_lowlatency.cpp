@@ -61,19 +61,29 @@ LibInfo *LoaderCtxVPL::AddSingleLibrary(STRING_TYPE libPath, LibType libType) {
     if (!pProc)
         return nullptr;
 #else
-    // try to open library
-    void *hLib = dlopen(libPath.c_str(), RTLD_LOCAL | RTLD_NOW);
-    if (!hLib)
-        return nullptr;
+    const char *reqFunc = (libType == LibTypeVPL ? reqFuncVPL : reqFuncMSDK);
+
+    // check for required entrypoint function without loading the library, if possible
+    // the library is loaded once it is used to create a session
+    ElfExportsVPL elfExports;
+    if (m_bExportCheck && elfExports.Open(libPath) == MFX_ERR_NONE) {
+        if (!elfExports.HasFunction(reqFunc))
+            return nullptr;
+    }
+    else {
+        // try to open library
+        void *hLib = dlopen(libPath.c_str(), RTLD_LOCAL | RTLD_NOW);
+        if (!hLib)
+            return nullptr;
 
-    // check for required entrypoint function
-    const char *reqFunc  = (libType == LibTypeVPL ? reqFuncVPL : reqFuncMSDK);
-    VPLFunctionPtr pProc = (VPLFunctionPtr)dlsym(hLib, reqFunc);
-    dlclose(hLib);
+        // check for required entrypoint function
+        VPLFunctionPtr pProc = (VPLFunctionPtr)dlsym(hLib, reqFunc);
+        dlclose(hLib);
 
-    // entrypoint function missing - invalid library
-    if (!pProc)
-        return nullptr;
+        // entrypoint function missing - invalid library
+        if (!pProc)
+            return nullptr;
+    }
 #endif
 
     // create new LibInfo and add to list
@@ -245,6 +255,7 @@ mfxStatus LoaderCtxVPL::LoadLibsFromMultipleDirs(LibType libType) {
 
 mfxStatus LoaderCtxVPL::LoadLibsLowLatency() {
     DISP_LOG_FUNCTION(&m_dispLog);
+    STARTUP_PHASE_TIMER(&m_startupTiming, LOADER_PHASE_LOAD);
 
 #if defined(_WIN32) || defined(_WIN64)
     mfxStatus sts = MFX_ERR_NONE;
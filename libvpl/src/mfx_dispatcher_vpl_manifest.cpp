@@ -0,0 +1,232 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include <fstream>
+
+#include "src/mfx_dispatcher_vpl.h"
+
+// Intel® VPL dispatcher manifest
+//
+// The manifest is a text file with the full list of candidate runtimes.
+//   If it is present, no directories are searched and only the listed
+//   runtimes are loaded.
+// Location: ONEVPL_MANIFEST environment variable, otherwise /etc/vpl/manifest
+//   on Linux (ONEVPL_MANIFEST=OFF ignores the default file)
+//
+// One entry per line, '#' starts a comment:
+//   <priority> [api=<major>.<minor>] <full path to runtime>
+//   caps <directory>
+//
+// priority has the same meaning as the search location of a runtime in the spec:
+//   special - like ONEVPL_PRIORITY_PATH, listed before all others in manifest order
+//   1-9999  - lower value has higher priority
+//   legacy  - 1.x runtime (libmfxhw64)
+// api - minimum API version, implementations reporting a lower version are excluded
+// caps - enable the persistent caps cache (Linux) in this directory, so caps
+//   may be stored once when the system image is built
+
+#define MANIFEST_DEFAULT_PATH "/etc/vpl/manifest"
+
+// return next token separated by spaces or tabs, and advance pos past it
+static std::string NextToken(const std::string &line, size_t &pos) {
+    size_t start = line.find_first_not_of(" \t\r", pos);
+    if (start == std::string::npos) {
+        pos = line.size();
+        return "";
+    }
+
+    size_t end = line.find_first_of(" \t\r", start);
+    if (end == std::string::npos)
+        end = line.size();
+
+    pos = end;
+    return line.substr(start, end - start);
+}
+
+// return rest of line without leading and trailing whitespace (paths may contain spaces)
+static std::string RestOfLine(const std::string &line, size_t pos) {
+    size_t start = line.find_first_not_of(" \t\r", pos);
+    if (start == std::string::npos)
+        return "";
+
+    size_t end = line.find_last_not_of(" \t\r");
+    return line.substr(start, end - start + 1);
+}
+
+static bool ParsePriority(const std::string &token, mfxU32 &priority) {
+    if (token == "special") {
+        priority = LIB_PRIORITY_SPECIAL;
+        return true;
+    }
+
+    if (token == "legacy") {
+        priority = LIB_PRIORITY_LEGACY;
+        return true;
+    }
+
+    if (token.empty() || token.size() > 4 ||
+        token.find_first_not_of("0123456789") != std::string::npos)
+        return false;
+
+    priority = (mfxU32)std::atoi(token.c_str());
+
+    return (priority >= LIB_PRIORITY_01 && priority <= LIB_PRIORITY_9999);
+}
+
+static bool ParseApiVersion(const std::string &token, mfxVersion &version) {
+    unsigned int major = 0, minor = 0;
+    char extra         = 0;
+
+    if (sscanf(token.c_str(), "%u.%u%c", &major, &minor, &extra) != 2)
+        return false;
+
+    if (major > 0xFFFF || minor > 0xFFFF)
+        return false;
+
+    version.Major = (mfxU16)major;
+    version.Minor = (mfxU16)minor;
+
+    return true;
+}
+
+static STRING_TYPE ToLibPath(const std::string &path) {
+#if defined(_WIN32) || defined(_WIN64)
+    int len = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    if (len <= 0)
+        return STRING_TYPE();
+
+    std::vector<wchar_t> libPath(len);
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, libPath.data(), len);
+
+    return STRING_TYPE(libPath.data());
+#else
+    return path;
+#endif
+}
+
+mfxStatus LoaderCtxVPL::InitManifest() {
+    std::string strManifest;
+    if (!GetEnvVar("ONEVPL_MANIFEST", strManifest)) {
+#if defined(_WIN32) || defined(_WIN64)
+        return MFX_ERR_UNSUPPORTED; // no default location on Windows
+#else
+        strManifest = MANIFEST_DEFAULT_PATH;
+#endif
+    }
+
+    if (strManifest.empty() || strManifest == "OFF")
+        return MFX_ERR_UNSUPPORTED;
+
+    std::ifstream manifestFile(strManifest);
+    if (!manifestFile.is_open())
+        return MFX_ERR_UNSUPPORTED;
+
+    std::string line;
+    mfxU32 lineNum = 0;
+    while (std::getline(manifestFile, line)) {
+        lineNum++;
+
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+
+        size_t pos        = 0;
+        std::string token = NextToken(line, pos);
+        if (token.empty())
+            continue;
+
+        if (token == "caps") {
+            std::string cacheDir = RestOfLine(line, pos);
+            if (cacheDir.empty() || m_capsCache.Init(cacheDir) != MFX_ERR_NONE) {
+                DISP_LOG_MESSAGE(&m_dispLog,
+                                 "message:  manifest line %d -- caps cache not enabled",
+                                 lineNum);
+            }
+            continue;
+        }
+
+        ManifestEntryVPL entry;
+        if (!ParsePriority(token, entry.libPriority)) {
+            DISP_LOG_MESSAGE(&m_dispLog, "message:  manifest line %d -- invalid priority", lineNum);
+            continue;
+        }
+
+        size_t apiPos = pos;
+        token         = NextToken(line, apiPos);
+        if (token.compare(0, 4, "api=") == 0) {
+            if (!ParseApiVersion(token.substr(4), entry.minApiVersion)) {
+                DISP_LOG_MESSAGE(&m_dispLog,
+                                 "message:  manifest line %d -- invalid API version",
+                                 lineNum);
+                continue;
+            }
+            pos = apiPos;
+        }
+
+        entry.libNameFull = ToLibPath(RestOfLine(line, pos));
+        if (entry.libNameFull.empty()) {
+            DISP_LOG_MESSAGE(&m_dispLog, "message:  manifest line %d -- missing path", lineNum);
+            continue;
+        }
+
+        m_manifestList.push_back(entry);
+    }
+
+    // a manifest without runtimes is ignored, rather than hiding all of them
+    if (m_manifestList.empty()) {
+        DISP_LOG_MESSAGE(&m_dispLog,
+                         "message:  manifest %s has no runtimes -- ignored",
+                         strManifest.c_str());
+        return MFX_ERR_UNSUPPORTED;
+    }
+
+    DISP_LOG_MESSAGE(&m_dispLog,
+                     "message:  using manifest %s -- %d runtimes",
+                     strManifest.c_str(),
+                     (int)m_manifestList.size());
+
+    m_bManifest = true;
+
+    return MFX_ERR_NONE;
+}
+
+// add runtimes listed in the manifest to the list of candidate libraries
+// paths are used as given (no directory search or path resolution)
+mfxStatus LoaderCtxVPL::AddManifestLibs() {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+#if defined(_WIN32) || defined(_WIN64)
+    // retrieve list of DX11 graphics adapters (lightweight)
+    m_gpuAdapterInfo.clear();
+    if (!MFX::DXGI1Device::GetAdapterList(m_gpuAdapterInfo))
+        m_gpuAdapterInfo.clear();
+#endif
+
+    for (const auto &entry : m_manifestList) {
+        // skip duplicates
+        auto libFound =
+            std::find_if(m_libInfoList.begin(), m_libInfoList.end(), [&](LibInfo *li) {
+                return (li->libNameFull == entry.libNameFull);
+            });
+        if (libFound != m_libInfoList.end())
+            continue;
+
+        LibInfo *libInfo = new (std::nothrow) LibInfo;
+        if (!libInfo)
+            return MFX_ERR_MEMORY_ALLOC;
+
+        libInfo->libNameFull   = entry.libNameFull;
+        libInfo->libPriority   = entry.libPriority;
+        libInfo->minApiVersion = entry.minApiVersion;
+
+        m_libInfoList.push_back(libInfo);
+
+        if (entry.libPriority == LIB_PRIORITY_SPECIAL)
+            m_bPriorityPathEnabled = true;
+    }
+
+    return MFX_ERR_NONE;
+}
@@ -0,0 +1,198 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include "src/mfx_dispatcher_vpl.h"
+
+// Intel® VPL session pools (experimental MFXCreateSessionPool/MFXAcquireSession)
+//
+// Session parameters for the implementation are resolved once, when the pool
+//   is created, using the same filters and special config properties
+//   (device handle, NumThread, ExtBuffer) as MFXCreateSession().
+// A worker thread per pool creates sessions until the pool is full, then
+//   waits until a session is taken and creates a new one. If session creation
+//   fails, the worker stops and is started again by the next call to
+//   MFXCreateSessionPool() for the implementation.
+// If the pool is empty, the session is created by the calling thread, so
+//   acquiring a session is never slower than MFXCreateSession().
+// Pools are found by implementation, not by index, so that an index always
+//   refers to the same implementation as MFXEnumImplementations() after the
+//   filters are changed or reset.
+
+// pool for valid implementation idx, or nullptr if none was created
+SessionPoolVPL *LoaderCtxVPL::FindSessionPool(mfxU32 idx) {
+    if (idx >= m_validImplList.size() || !m_validImplList[idx])
+        return nullptr;
+
+    for (auto pool : m_sessionPoolList) {
+        if (pool->implInfo == m_validImplList[idx])
+            return pool;
+    }
+
+    return nullptr;
+}
+
+mfxStatus LoaderCtxVPL::CreateSessionPool(mfxU32 idx, mfxU32 poolSize) {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    // only change the size of an existing pool, session parameters are kept
+    SessionPoolVPL *existingPool = FindSessionPool(idx);
+    if (existingPool)
+        return ResizeSessionPool(existingPool, poolSize);
+
+    std::unique_ptr<SessionPoolVPL> pool;
+    try {
+        pool.reset(new SessionPoolVPL{});
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    mfxStatus sts = GetSessionParams(idx, pool->params);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    pool->implInfo = m_validImplList[idx];
+    pool->poolSize = poolSize;
+
+    try {
+        pool->worker = std::thread(&LoaderCtxVPL::RefillSessionPool, this, pool.get());
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    DISP_LOG_MESSAGE(&m_dispLog,
+                     "message:  session pool created -- implementation %d, size %d",
+                     idx,
+                     poolSize);
+
+    m_sessionPoolList.push_back(pool.release());
+
+    return MFX_ERR_NONE;
+}
+
+// change the size of a pool, and restart its worker if it stopped after an error
+// loader must be locked in exclusive mode, so the pool is not used by other calls
+mfxStatus LoaderCtxVPL::ResizeSessionPool(SessionPoolVPL *pool, mfxU32 poolSize) {
+    std::unique_lock<std::mutex> lock(pool->poolMutex);
+
+    pool->poolSize = poolSize;
+    pool->poolCond.notify_all();
+
+    if (pool->workerSts == MFX_ERR_NONE)
+        return MFX_ERR_NONE;
+
+    // worker has returned, join it without the lock
+    lock.unlock();
+    if (pool->worker.joinable())
+        pool->worker.join();
+
+    DISP_LOG_MESSAGE(&m_dispLog,
+                     "message:  session pool worker restarted -- implementation %d, sts %d",
+                     pool->implInfo->validImplIdx,
+                     pool->workerSts);
+
+    pool->workerSts = MFX_ERR_NONE;
+
+    try {
+        pool->worker = std::thread(&LoaderCtxVPL::RefillSessionPool, this, pool);
+    }
+    catch (...) {
+        // try again on the next resize
+        pool->workerSts = MFX_ERR_MEMORY_ALLOC;
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    return MFX_ERR_NONE;
+}
+
+// take a session from the pool for implementation idx
+// returns MFX_ERR_NOT_INITIALIZED if there is no pool for this implementation
+mfxStatus LoaderCtxVPL::AcquirePooledSession(mfxU32 idx, mfxSession *session) {
+    if (idx >= m_validImplList.size() || !m_validImplList[idx])
+        return MFX_ERR_NOT_FOUND;
+
+    SessionPoolVPL *pool = FindSessionPool(idx);
+    if (!pool)
+        return MFX_ERR_NOT_INITIALIZED;
+
+    {
+        std::lock_guard<std::mutex> lock(pool->poolMutex);
+        if (!pool->sessions.empty()) {
+            *session = pool->sessions.front();
+            pool->sessions.pop_front();
+
+            // wake up worker to create a replacement
+            pool->poolCond.notify_all();
+
+            DISP_LOG_MESSAGE(&m_dispLog, "message:  session taken from pool");
+
+            return MFX_ERR_NONE;
+        }
+    }
+
+    // pool is empty (or the worker failed), create session with the same parameters
+    DISP_LOG_MESSAGE(&m_dispLog, "message:  session pool empty");
+
+    return CreateSessionFromParams(pool->params, session);
+}
+
+// worker thread - keep the pool full until it is destroyed
+void LoaderCtxVPL::RefillSessionPool(SessionPoolVPL *pool) {
+    std::unique_lock<std::mutex> lock(pool->poolMutex);
+
+    while (!pool->bStop) {
+        if (pool->sessions.size() >= pool->poolSize) {
+            pool->poolCond.wait(lock);
+            continue;
+        }
+
+        // do not hold the lock while the runtime is initialized
+        lock.unlock();
+
+        mfxSession session = nullptr;
+        mfxStatus sts      = CreateSessionFromParams(pool->params, &session);
+
+        lock.lock();
+
+        // stop refilling, later sessions are created by AcquirePooledSession()
+        if (sts != MFX_ERR_NONE) {
+            pool->workerSts = sts;
+            break;
+        }
+
+        pool->sessions.push_back(session);
+    }
+}
+
+// stop all workers and close sessions which were not taken
+mfxStatus LoaderCtxVPL::DestroySessionPools() {
+    for (auto pool : m_sessionPoolList) {
+        {
+            std::lock_guard<std::mutex> lock(pool->poolMutex);
+            pool->bStop = true;
+            pool->poolCond.notify_all();
+        }
+
+        if (pool->worker.joinable())
+            pool->worker.join();
+
+        for (auto session : pool->sessions)
+            MFXClose(session);
+
+        if (pool->workerSts != MFX_ERR_NONE) {
+            DISP_LOG_MESSAGE(&m_dispLog,
+                             "message:  session pool worker failed -- implementation %d, sts %d",
+                             pool->implInfo->validImplIdx,
+                             pool->workerSts);
+        }
+
+        delete pool;
+    }
+    m_sessionPoolList.clear();
+
+    return MFX_ERR_NONE;
+}
@@ -0,0 +1,466 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "src/mfx_dispatcher_vpl.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+#endif
+
+// Intel® VPL throughput ranking (ONEVPL_RANK_POLICY=THROUGHPUT)
+//
+// When the filters request a single encoder codec, each valid implementation encodes
+//   a few frames of synthetic content at the requested resolution class, and the valid
+//   list is sorted by the measured time per frame. The order from PrioritizeImplList()
+//   breaks ties, and implementations which fail the benchmark are sorted last.
+// Libraries in ONEVPL_PRIORITY_PATH stay in front, as with the spec order.
+// Scores are kept by each implementation until the loader is unloaded. With the caps
+//   cache enabled (Linux), successful scores are also stored in the cache directory, keyed
+//   by the library file and device, so each benchmark runs once per installed runtime.
+//   A benchmark which failed is run again by the next loader.
+
+// number of frames encoded by the benchmark, after initialization
+#define RANK_BENCH_FRAMES 8
+
+// limits for runtimes which stop making progress
+#define RANK_SYNC_WAIT_MS 10000
+#define RANK_MAX_CALLS    1000
+
+#define RANK_SCORE_FAILED ((mfxU64)-1)
+
+#define RANK_FILE_NAME   "rank.txt"
+#define RANK_FILE_HEADER "# vpl rank scores v2"
+
+// benchmark resolution classes, the requested size is rounded up to the first which fits
+struct RankResolution {
+    mfxU16 width;
+    mfxU16 height;
+};
+
+static const RankResolution rankResolutions[] = {
+    { 1280, 720 },
+    { 1920, 1080 },
+    { 3840, 2160 },
+    { 7680, 4320 },
+};
+
+#define RANK_NUM_RESOLUTIONS (sizeof(rankResolutions) / sizeof(rankResolutions[0]))
+#define RANK_RES_DEFAULT     1 // 1080p if no size is requested
+
+#define RANK_ALIGN16(value) (((value) + 15) & ~15)
+
+static mfxU32 GetResolutionClass(mfxU32 width, mfxU32 height) {
+    if (!width && !height)
+        return RANK_RES_DEFAULT;
+
+    for (mfxU32 idx = 0; idx < RANK_NUM_RESOLUTIONS; idx++) {
+        if (width <= rankResolutions[idx].width && height <= rankResolutions[idx].height)
+            return idx;
+    }
+
+    return RANK_NUM_RESOLUTIONS - 1;
+}
+
+static mfxU64 GetRankScore(const ImplInfo *implInfo, mfxU64 scoreKey) {
+    auto it = implInfo->rankScores.find(scoreKey);
+    if (it == implInfo->rankScores.end())
+        return RANK_SCORE_FAILED;
+
+    return it->second;
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+
+// scores are not persisted on Windows
+static bool GetRankFileKey(const ImplInfo * /*implInfo*/,
+                           mfxU32 /*codecID*/,
+                           mfxU32 /*resClass*/,
+                           std::string & /*key*/) {
+    return false;
+}
+
+static void LoadRankFile(const std::string & /*fileName*/,
+                         std::unordered_map<std::string, mfxU64> & /*scores*/) {
+    return;
+}
+
+static mfxStatus StoreRankFile(const std::string & /*fileName*/,
+                               const std::unordered_map<std::string, mfxU64> & /*scores*/) {
+    return MFX_ERR_UNSUPPORTED;
+}
+
+#else
+
+// benchmark, device, and library file, the score is reused only if all of them match
+static bool GetRankFileKey(const ImplInfo *implInfo,
+                           mfxU32 codecID,
+                           mfxU32 resClass,
+                           std::string &key) {
+    const std::string &libNameFull = implInfo->libInfo->libNameFull;
+
+    struct stat st = {};
+    if (stat(libNameFull.c_str(), &st) != 0)
+        return false;
+
+    mfxImplDescription *implDesc = (mfxImplDescription *)(implInfo->implDesc);
+
+    char keyBuf[256 + sizeof(implDesc->Dev.DeviceID)];
+    snprintf(keyBuf,
+             sizeof(keyBuf),
+             "%u %.*s %08x %u %llu %llu %llu %llu %llu ",
+             implDesc->VendorImplID,
+             (int)sizeof(implDesc->Dev.DeviceID),
+             implDesc->Dev.DeviceID,
+             codecID,
+             resClass,
+             (unsigned long long)st.st_dev,
+             (unsigned long long)st.st_ino,
+             (unsigned long long)st.st_size,
+             (unsigned long long)st.st_mtim.tv_sec,
+             (unsigned long long)st.st_mtim.tv_nsec);
+
+    key = keyBuf + libNameFull;
+
+    return true;
+}
+
+// one score per line, followed by its key
+// lines which cannot be parsed are ignored
+static void LoadRankFile(const std::string &fileName,
+                         std::unordered_map<std::string, mfxU64> &scores) {
+    std::ifstream rankFile(fileName);
+    if (!rankFile.is_open())
+        return;
+
+    std::string line;
+    if (!std::getline(rankFile, line) || line != RANK_FILE_HEADER)
+        return;
+
+    while (std::getline(rankFile, line)) {
+        size_t pos = line.find(' ');
+        if (pos == std::string::npos || pos == 0)
+            continue;
+
+        std::istringstream scoreStr(line.substr(0, pos));
+        unsigned long long score = 0;
+        if (!(scoreStr >> score))
+            continue;
+
+        scores[line.substr(pos + 1)] = (mfxU64)score;
+    }
+}
+
+static mfxStatus StoreRankFile(const std::string &fileName,
+                               const std::unordered_map<std::string, mfxU64> &scores) {
+    // write to temporary file and rename, as with caps cache entries
+    std::string tmpName = fileName + "." + std::to_string(getpid()) + ".tmp";
+
+    std::ofstream rankFile(tmpName, std::ios::trunc);
+    if (!rankFile.is_open())
+        return MFX_ERR_UNSUPPORTED;
+
+    rankFile << RANK_FILE_HEADER << "\n";
+    for (auto &score : scores)
+        rankFile << (unsigned long long)score.second << " " << score.first << "\n";
+    rankFile.close();
+
+    if (rankFile.fail() || rename(tmpName.c_str(), fileName.c_str()) != 0) {
+        remove(tmpName.c_str());
+        return MFX_ERR_UNSUPPORTED;
+    }
+
+    return MFX_ERR_NONE;
+}
+
+#endif
+
+// encode RANK_BENCH_FRAMES frames of a gradient from system memory
+// returns the time of MFXVideoENCODE_Init() and the average time per encoded frame
+static mfxStatus EncodeBenchFrames(mfxSession session,
+                                   mfxU32 codecID,
+                                   mfxU32 width,
+                                   mfxU32 height,
+                                   mfxU64 &initNs,
+                                   mfxU64 &frameNs) {
+    mfxVideoParam par               = {};
+    par.mfx.CodecId                 = codecID;
+    par.mfx.TargetUsage             = MFX_TARGETUSAGE_BEST_SPEED;
+    par.mfx.RateControlMethod       = MFX_RATECONTROL_CQP;
+    par.mfx.QPI                     = 26;
+    par.mfx.QPP                     = 26;
+    par.mfx.QPB                     = 26;
+    par.mfx.GopRefDist              = 1;
+    par.mfx.FrameInfo.FourCC        = MFX_FOURCC_NV12;
+    par.mfx.FrameInfo.ChromaFormat  = MFX_CHROMAFORMAT_YUV420;
+    par.mfx.FrameInfo.PicStruct     = MFX_PICSTRUCT_PROGRESSIVE;
+    par.mfx.FrameInfo.FrameRateExtN = 30;
+    par.mfx.FrameInfo.FrameRateExtD = 1;
+    par.mfx.FrameInfo.Width         = (mfxU16)RANK_ALIGN16(width);
+    par.mfx.FrameInfo.Height        = (mfxU16)RANK_ALIGN16(height);
+    par.mfx.FrameInfo.CropW         = (mfxU16)width;
+    par.mfx.FrameInfo.CropH         = (mfxU16)height;
+    par.IOPattern                   = MFX_IOPATTERN_IN_SYSTEM_MEMORY;
+    par.AsyncDepth                  = 1;
+
+    mfxU64 startNs = StartupTimingVPL::GetTimeNs();
+    mfxStatus sts  = MFXVideoENCODE_Init(session, &par);
+    initNs         = StartupTimingVPL::GetTimeNs() - startNs;
+
+    // warnings (e.g. partial acceleration) are fine for ranking
+    if (sts < MFX_ERR_NONE)
+        return sts;
+
+    mfxU32 pitch     = par.mfx.FrameInfo.Width;
+    mfxU32 lumaSize  = pitch * par.mfx.FrameInfo.Height;
+    mfxU32 frameSize = lumaSize * 3 / 2;
+
+    // the encoder may require a larger buffer than one raw frame
+    mfxU32 bufferSize    = frameSize;
+    mfxVideoParam outPar = {};
+    if (MFXVideoENCODE_GetVideoParam(session, &outPar) == MFX_ERR_NONE) {
+        mfxU32 multiplier = std::max<mfxU32>(outPar.mfx.BRCParamMultiplier, 1);
+        bufferSize = std::max<mfxU32>(bufferSize, outPar.mfx.BufferSizeInKB * 1000 * multiplier);
+    }
+
+    std::vector<mfxU8> frameData, bsData;
+    try {
+        frameData.resize(frameSize);
+        bsData.resize(bufferSize);
+    }
+    catch (...) {
+        MFXVideoENCODE_Close(session);
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    // horizontal gradient in Y, neutral chroma
+    for (mfxU32 y = 0; y < par.mfx.FrameInfo.Height; y++) {
+        for (mfxU32 x = 0; x < pitch; x++)
+            frameData[y * pitch + x] = (mfxU8)((x + y) & 0xff);
+    }
+    std::fill(frameData.begin() + lumaSize, frameData.end(), (mfxU8)128);
+
+    mfxFrameSurface1 surface = {};
+    surface.Info             = par.mfx.FrameInfo;
+    surface.Data.Y           = frameData.data();
+    surface.Data.UV          = frameData.data() + lumaSize;
+    surface.Data.Pitch       = (mfxU16)pitch;
+
+    mfxBitstream bs = {};
+    bs.Data         = bsData.data();
+    bs.MaxLength    = bufferSize;
+
+    mfxU32 numSubmitted = 0;
+    mfxU32 numEncoded   = 0;
+
+    startNs = StartupTimingVPL::GetTimeNs();
+    for (mfxU32 call = 0; numEncoded < RANK_BENCH_FRAMES && call < RANK_MAX_CALLS; call++) {
+        // null surface drains frames buffered by the encoder
+        mfxFrameSurface1 *pSurface = (numSubmitted < RANK_BENCH_FRAMES) ? &surface : nullptr;
+        if (pSurface) {
+            surface.Data.FrameOrder = numSubmitted;
+            surface.Data.Y[0]       = (mfxU8)numSubmitted;
+        }
+
+        mfxSyncPoint syncp = nullptr;
+        bs.DataOffset      = 0;
+        bs.DataLength      = 0;
+
+        sts = MFXVideoENCODE_EncodeFrameAsync(session, nullptr, pSurface, &bs, &syncp);
+        if (sts == MFX_WRN_DEVICE_BUSY) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        if (pSurface)
+            numSubmitted++;
+
+        // frame was buffered, more input needed before output
+        if (sts == MFX_ERR_MORE_DATA && pSurface)
+            continue;
+
+        // stop on errors, or once all buffered frames were drained
+        if (sts < MFX_ERR_NONE)
+            break;
+
+        if (syncp) {
+            sts = MFXVideoCORE_SyncOperation(session, syncp, RANK_SYNC_WAIT_MS);
+            if (sts < MFX_ERR_NONE)
+                break;
+
+            numEncoded++;
+        }
+    }
+    frameNs = StartupTimingVPL::GetTimeNs() - startNs;
+
+    MFXVideoENCODE_Close(session);
+
+    if (numEncoded == 0)
+        return (sts < MFX_ERR_NONE) ? sts : MFX_ERR_ABORTED;
+
+    frameNs /= numEncoded;
+
+    return MFX_ERR_NONE;
+}
+
+// called from MFXLoad()
+mfxStatus LoaderCtxVPL::InitRankPolicy() {
+    std::string strRankPolicy;
+    if (!GetEnvVar("ONEVPL_RANK_POLICY", strRankPolicy) || strRankPolicy != "THROUGHPUT")
+        return MFX_ERR_UNSUPPORTED;
+
+    // lazy enumeration returns the first implementation which matches, without a full list
+    if (m_bLazyEnum) {
+        DISP_LOG_MESSAGE(&m_dispLog, "message:  throughput ranking not used with lazy enum");
+        return MFX_ERR_UNSUPPORTED;
+    }
+
+    m_bRankThroughput = true;
+
+    DISP_LOG_MESSAGE(&m_dispLog, "message:  throughput ranking enabled");
+
+    return MFX_ERR_NONE;
+}
+
+// create a session with valid implementation implInfo and run the encode benchmark
+// returns time per frame in ns, or RANK_SCORE_FAILED
+mfxU64 LoaderCtxVPL::RunRankBenchmark(ImplInfo *implInfo,
+                                      mfxU32 codecID,
+                                      mfxU32 width,
+                                      mfxU32 height) {
+    SessionParamsVPL params;
+    mfxSession session = nullptr;
+
+    mfxStatus sts = GetSessionParams((mfxU32)implInfo->validImplIdx, params);
+    if (sts == MFX_ERR_NONE)
+        sts = CreateSessionFromParams(params, &session);
+
+    if (sts != MFX_ERR_NONE) {
+        DISP_LOG_MESSAGE(&m_dispLog,
+                         "message:  rank implementation %d -- session failed, sts %d",
+                         implInfo->validImplIdx,
+                         sts);
+        return RANK_SCORE_FAILED;
+    }
+
+    mfxU64 initNs  = 0;
+    mfxU64 frameNs = 0;
+
+    sts = EncodeBenchFrames(session, codecID, width, height, initNs, frameNs);
+
+    MFXClose(session);
+
+    DISP_LOG_MESSAGE(&m_dispLog,
+                     "message:  rank implementation %d codec 0x%08x %dx%d -- sts %d, "
+                     "init %llu ns, %llu ns/frame",
+                     implInfo->validImplIdx,
+                     codecID,
+                     width,
+                     height,
+                     sts,
+                     (unsigned long long)initNs,
+                     (unsigned long long)frameNs);
+
+    if (sts != MFX_ERR_NONE)
+        return RANK_SCORE_FAILED;
+
+    return frameNs;
+}
+
+// sort valid implementations by measured time per frame of the requested encoder
+// called after PrioritizeImplList(), so the spec order is the tie-breaker
+// loader must be locked in exclusive mode
+mfxStatus LoaderCtxVPL::RankImplList() {
+    DISP_LOG_FUNCTION(&m_dispLog);
+
+    mfxU32 codecID = 0, width = 0, height = 0;
+    if (!ConfigCtxVPL::GetRequestedEncoder(m_configCtxList, codecID, width, height)) {
+        DISP_LOG_MESSAGE(&m_dispLog, "message:  no encoder requested, spec order is used");
+        return MFX_ERR_NONE;
+    }
+
+    mfxU32 resClass = GetResolutionClass(width, height);
+    mfxU64 scoreKey = ((mfxU64)codecID << 32) | resClass;
+
+    const RankResolution &res = rankResolutions[resClass];
+
+    bool bPersist = m_capsCache.IsEnabled();
+    std::string fileName;
+    bool bFileChanged = false;
+
+    try {
+        if (bPersist) {
+            fileName = m_capsCache.GetCacheDir() + "/" + RANK_FILE_NAME;
+            if (!m_bRankFileLoaded) {
+                LoadRankFile(fileName, m_rankFileScores);
+                m_bRankFileLoaded = true;
+            }
+        }
+
+        for (ImplInfo *implInfo : m_implInfoList) {
+            if (implInfo->validImplIdx < 0 || !implInfo->implDesc)
+                continue;
+
+            if (implInfo->rankScores.count(scoreKey))
+                continue;
+
+            std::string fileKey;
+            bool bFileKey = bPersist && GetRankFileKey(implInfo, codecID, resClass, fileKey);
+
+            mfxU64 score = RANK_SCORE_FAILED;
+            auto it      = bFileKey ? m_rankFileScores.find(fileKey) : m_rankFileScores.end();
+            if (it != m_rankFileScores.end()) {
+                score = it->second;
+            }
+            else {
+                score = RunRankBenchmark(implInfo, codecID, res.width, res.height);
+
+                // failure may be temporary (e.g. device busy), so it is not stored
+                if (bFileKey && score != RANK_SCORE_FAILED) {
+                    m_rankFileScores[fileKey] = score;
+                    bFileChanged              = true;
+                }
+            }
+
+            implInfo->rankScores[scoreKey] = score;
+        }
+    }
+    catch (...) {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    if (bFileChanged)
+        StoreRankFile(fileName, m_rankFileScores);
+
+    // stable sort, invalid implementations have no score and move to the end
+    bool bPriorityPathEnabled = m_bPriorityPathEnabled;
+    m_implInfoList.sort([bPriorityPathEnabled, scoreKey](const ImplInfo *impl1,
+                                                         const ImplInfo *impl2) {
+        bool bSpecial1 = bPriorityPathEnabled &&
+                         impl1->libInfo->libPriority == LIB_PRIORITY_SPECIAL;
+        bool bSpecial2 = bPriorityPathEnabled &&
+                         impl2->libInfo->libPriority == LIB_PRIORITY_SPECIAL;
+
+        // ONEVPL_PRIORITY_PATH libs stay first, in their current order
+        if (bSpecial1 || bSpecial2)
+            return (bSpecial1 && !bSpecial2);
+
+        return (GetRankScore(impl1, scoreKey) < GetRankScore(impl2, scoreKey));
+    });
+
+    RenumberValidImpls();
+
+    return MFX_ERR_NONE;
+}
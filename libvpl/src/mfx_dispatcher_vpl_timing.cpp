@@ -0,0 +1,95 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include "src/mfx_dispatcher_vpl.h"
+
+// Intel® VPL dispatcher startup timing
+//
+// Enabled with ONEVPL_STARTUP_TIMING=ON, or when the dispatcher log is enabled.
+// Each phase (search, load, caps query, filter matching, priority sort, session
+//   creation) adds its time to a per-loader total, and load/query/session times are
+//   also kept per library. With the log enabled, each phase is printed as it ends.
+// When disabled, each phase only checks the enabled flag.
+
+#ifdef ONEVPL_EXPERIMENTAL
+static_assert(NUM_LOADER_PHASES == MFX_LOADER_NUM_PHASES, "phase list must match mfxLoaderPhase");
+#endif
+
+static const char *phaseNames[NUM_LOADER_PHASES] = {
+    "search", "load", "query caps", "validate config", "prioritize", "create session",
+};
+
+StartupTimingVPL::StartupTimingVPL() : m_bEnabled(false), m_dispLog(nullptr) {
+    for (mfxU32 i = 0; i < NUM_LOADER_PHASES; i++) {
+        m_timeNs[i].store(0);
+        m_count[i].store(0);
+    }
+}
+
+mfxStatus StartupTimingVPL::Init(DispatcherLogVPL *dispLog) {
+    bool bTiming = IsEnvOn("ONEVPL_STARTUP_TIMING");
+
+    // timings are always printed with the dispatcher log
+    if (dispLog && dispLog->m_logLevel)
+        m_dispLog = dispLog;
+
+    if (!bTiming && !m_dispLog)
+        return MFX_ERR_UNSUPPORTED;
+
+    m_bEnabled = true;
+
+    return MFX_ERR_NONE;
+}
+
+void StartupTimingVPL::AddPhase(mfxU32 phase, mfxU64 timeNs) {
+    m_timeNs[phase] += timeNs;
+    m_count[phase]++;
+
+    DISP_LOG_MESSAGE(m_dispLog,
+                     "message:  startup timing -- %s (%llu us)",
+                     phaseNames[phase],
+                     (unsigned long long)(timeNs / 1000));
+}
+
+mfxStatus LoaderCtxVPL::InitStartupTiming() {
+    return m_startupTiming.Init(&m_dispLog);
+}
+
+#ifdef ONEVPL_EXPERIMENTAL
+mfxStatus LoaderCtxVPL::GetLoaderTimings(mfxLoaderTimings *timings) {
+    if (!m_startupTiming.IsEnabled())
+        return MFX_ERR_UNSUPPORTED;
+
+    *timings                 = {};
+    timings->Version.Version = MFX_LOADERTIMINGS_VERSION;
+
+    for (mfxU32 i = 0; i < NUM_LOADER_PHASES; i++) {
+        timings->TimeNs[i] = m_startupTiming.GetPhaseTime(i);
+        timings->Count[i]  = m_startupTiming.GetPhaseCount(i);
+    }
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus LoaderCtxVPL::GetImplTimings(mfxU32 idx, mfxImplTimings *timings) {
+    if (!m_startupTiming.IsEnabled())
+        return MFX_ERR_UNSUPPORTED;
+
+    if (idx >= m_validImplList.size() || !m_validImplList[idx])
+        return MFX_ERR_NOT_FOUND;
+
+    LibInfo *libInfo = m_validImplList[idx]->libInfo;
+
+    *timings                 = {};
+    timings->Version.Version = MFX_IMPLTIMINGS_VERSION;
+    timings->NumSessions     = libInfo->numSessions.load();
+    timings->LoadTimeNs      = libInfo->loadTimeNs;
+    timings->QueryTimeNs     = libInfo->queryTimeNs;
+    timings->SessionTimeNs   = libInfo->sessionTimeNs.load();
+
+    return MFX_ERR_NONE;
+}
+#endif
@@ -0,0 +1,69 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include "src/mfx_dispatcher_vpl.h"
+
+// Intel® VPL loader warm-up (ONEVPL_WARMUP=ON)
+//
+// MFXLoad() starts a thread which searches, loads, and queries all candidate
+//   runtimes, so that the application can overlap discovery with its own startup.
+// The thread only touches the library and implementation lists, which are not
+//   used by MFXCreateConfig() or MFXSetConfigFilterProperty(), so filters may be
+//   set while it runs. Low latency mode is disabled, and filters are not used
+//   to skip caps queries, as with the shared catalog.
+// The first call which needs the implementation list waits for the thread in
+//   FinishWarmUp(), then applies the filters as usual.
+
+// called from MFXLoad() after all other settings are read
+mfxStatus LoaderCtxVPL::InitWarmUp() {
+    if (!IsEnvOn("ONEVPL_WARMUP"))
+        return MFX_ERR_UNSUPPORTED;
+
+    // lazy enumeration and shared catalog have their own load order
+    if (m_bLazyEnum || m_bSharedCatalog) {
+        DISP_LOG_MESSAGE(&m_dispLog, "message:  warm-up not used with lazy enum or shared catalog");
+        return MFX_ERR_UNSUPPORTED;
+    }
+
+    m_bWarmUp = true;
+
+    try {
+        m_warmUpThread = std::thread(&LoaderCtxVPL::RunWarmUp, this);
+    }
+    catch (...) {
+        // libraries are loaded by the first call as usual
+        m_bWarmUp = false;
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    DISP_LOG_MESSAGE(&m_dispLog, "message:  warm-up started");
+
+    return MFX_ERR_NONE;
+}
+
+// warm-up thread
+void LoaderCtxVPL::RunWarmUp() {
+    m_warmUpSts = SearchAndQueryLibs();
+}
+
+// wait for the warm-up thread, if it is running, and mark the libraries as loaded
+// loader must be locked in exclusive mode
+mfxStatus LoaderCtxVPL::FinishWarmUp() {
+    if (!m_warmUpThread.joinable())
+        return MFX_ERR_NONE;
+
+    m_warmUpThread.join();
+
+    DISP_LOG_MESSAGE(&m_dispLog, "message:  warm-up finished -- sts %d", m_warmUpSts);
+
+    // if nothing was found, the next call searches again as without warm-up
+    if (m_warmUpSts == MFX_ERR_NONE) {
+        m_bNeedFullQuery        = false;
+        m_bNeedUpdateValidImpls = true;
+    }
+
+    return m_warmUpSts;
+}
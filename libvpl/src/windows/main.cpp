@@ -591,6 +591,31 @@ mfxStatus MFXInitEx2(mfxVersion version,
     return pHandle->loadStatus;
 }
 
+// session creation from a pre-resolved function table is not implemented on Windows
+// callers fall back to MFXInitEx2()
+mfxStatus MFXCreateFuncTable(mfxVersion /*version*/, wchar_t * /*dllName*/, mfxHDL *funcTable) {
+    if (funcTable)
+        *funcTable = nullptr;
+
+    return MFX_ERR_UNSUPPORTED;
+}
+
+mfxStatus MFXReleaseFuncTable(mfxHDL /*funcTable*/) {
+    return MFX_ERR_UNSUPPORTED;
+}
+
+mfxStatus MFXInitFromFuncTable(mfxVersion /*version*/,
+                               mfxInitializationParam /*vplParam*/,
+                               mfxHDL /*funcTable*/,
+                               mfxSession * /*session*/) {
+    return MFX_ERR_UNSUPPORTED;
+}
+
+// session profiling is not implemented on Windows
+mfxStatus MFXEnableSessionProfile(mfxSession /*session*/) {
+    return MFX_ERR_UNSUPPORTED;
+}
+
 mfxStatus MFXClose(mfxSession session) {
     MFX::MFXAutomaticCriticalSection guard(&dispGuard);
 
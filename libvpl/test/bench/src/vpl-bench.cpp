@@ -0,0 +1,633 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+// Intel® VPL dispatcher microbenchmarks
+//
+// Each benchmark runs against N copies of the stub runtime (libvpl/test/runtimes/stub),
+//   installed in a temporary directory which is the only entry in ONEVPL_SEARCH_PATH.
+// Caps size is scaled with the synthetic caps of the stub runtime (VPL_STUB_SYNTH), with
+//   the same number of decoders, encoders, and VPP filters.
+// Results are printed as JSON (field names follow Google Benchmark output, real_time is
+//   the mean wall time) or CSV, one entry per benchmark and runtime count.
+
+#if defined(_WIN32) || defined(_WIN64)
+    #include <Windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "vpl/mfx.h"
+
+// ImplName reported by the stub runtime
+#define STUB_IMPL_NAME "Stub Implementation"
+
+// number of calls timed together for each passthrough sample
+#define NUM_PASSTHROUGH_CALLS 1000
+
+struct BenchResult {
+    std::string name;
+    mfxU32 numRuntimes;
+    mfxU32 numCaps;
+    std::vector<double> samplesNs;
+};
+
+struct BenchParams {
+    mfxU32 numRuntimes;
+    mfxU32 numIterations;
+};
+
+static double GetTimeNs() {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static void SetEnv(const char *name, const char *value) {
+#if defined(_WIN32) || defined(_WIN64)
+    SetEnvironmentVariableA(name, value);
+#else
+    if (value)
+        setenv(name, value, 1);
+    else
+        unsetenv(name);
+#endif
+}
+
+// temporary directory for runtime copies, unique per process
+static std::string MakeRuntimeDir() {
+#if defined(_WIN32) || defined(_WIN64)
+    char tempPath[MAX_PATH] = "";
+    if (!GetTempPathA(MAX_PATH, tempPath))
+        return "";
+
+    std::string dir = std::string(tempPath) + "vpl-bench-" + std::to_string(GetCurrentProcessId());
+    if (!CreateDirectoryA(dir.c_str(), nullptr))
+        return "";
+
+    return dir;
+#else
+    const char *tempPath = std::getenv("TMPDIR");
+    std::string dirTemplate =
+        std::string((tempPath && *tempPath) ? tempPath : "/tmp") + "/vpl-bench-XXXXXX";
+
+    std::vector<char> dir(dirTemplate.begin(), dirTemplate.end());
+    dir.push_back(0);
+    if (!mkdtemp(dir.data()))
+        return "";
+
+    return dir.data();
+#endif
+}
+
+static void RemoveRuntimeDir(const std::string &dir) {
+#if defined(_WIN32) || defined(_WIN64)
+    RemoveDirectoryA(dir.c_str());
+#else
+    rmdir(dir.c_str());
+#endif
+}
+
+static bool CopyRuntime(const std::string &src, const std::string &dst) {
+    std::ifstream in(src, std::ios::binary);
+    std::ofstream out(dst, std::ios::binary | std::ios::trunc);
+    if (!in.is_open() || !out.is_open())
+        return false;
+
+    out << in.rdbuf();
+
+    return out.good();
+}
+
+// install numRuntimes copies of the stub runtime (names must begin with "libvpl")
+// copies are separate files, so each one is loaded and queried separately
+static bool InstallRuntimes(const std::string &stubPath,
+                            const std::string &dir,
+                            mfxU32 numRuntimes,
+                            std::vector<std::string> &runtimePaths) {
+    size_t nameStart = stubPath.find_last_of("/\\");
+    nameStart        = (nameStart == std::string::npos) ? 0 : nameStart + 1;
+
+    size_t extStart = stubPath.find('.', nameStart);
+    std::string ext = (extStart == std::string::npos) ? "" : stubPath.substr(extStart);
+
+    for (mfxU32 i = 0; i < numRuntimes; i++) {
+        char name[32] = "";
+        snprintf(name, sizeof(name), "libvplbench%03u", i);
+
+        std::string runtimePath = dir + "/" + name + ext;
+        if (!CopyRuntime(stubPath, runtimePath))
+            return false;
+
+        runtimePaths.push_back(runtimePath);
+    }
+
+    return true;
+}
+
+static void RemoveRuntimes(std::vector<std::string> &runtimePaths) {
+    for (const auto &runtimePath : runtimePaths)
+        std::remove(runtimePath.c_str());
+    runtimePaths.clear();
+}
+
+static mfxStatus SetFilterU32(mfxConfig config, const char *name, mfxU32 value) {
+    mfxVariant var      = {};
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_U32;
+    var.Data.U32        = value;
+
+    return MFXSetConfigFilterProperty(config, (const mfxU8 *)name, var);
+}
+
+// loader which only enumerates the stub runtimes, enumerated before timing starts
+static mfxLoader LoadStub() {
+    mfxLoader loader = MFXLoad();
+    if (!loader)
+        return nullptr;
+
+    mfxVariant var      = {};
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_PTR;
+    var.Data.Ptr        = (mfxHDL)STUB_IMPL_NAME;
+
+    mfxConfig config = MFXCreateConfig(loader);
+    if (!config ||
+        MFXSetConfigFilterProperty(config, (const mfxU8 *)"mfxImplDescription.ImplName", var) !=
+            MFX_ERR_NONE) {
+        MFXUnload(loader);
+        return nullptr;
+    }
+
+    mfxHDL implDesc = nullptr;
+    if (MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &implDesc) !=
+        MFX_ERR_NONE) {
+        MFXUnload(loader);
+        return nullptr;
+    }
+    MFXDispReleaseImplDescription(loader, implDesc);
+
+    return loader;
+}
+
+// MFXLoad() only
+static bool BenchLoad(const BenchParams &params, BenchResult &result) {
+    for (mfxU32 i = 0; i < params.numIterations; i++) {
+        double startNs   = GetTimeNs();
+        mfxLoader loader = MFXLoad();
+        result.samplesNs.push_back(GetTimeNs() - startNs);
+
+        if (!loader)
+            return false;
+        MFXUnload(loader);
+    }
+
+    return true;
+}
+
+// MFXLoad() and description of all implementations (search, load, and caps query)
+static bool BenchEnumImplementations(const BenchParams &params, BenchResult &result) {
+    for (mfxU32 i = 0; i < params.numIterations; i++) {
+        double startNs   = GetTimeNs();
+        mfxLoader loader = MFXLoad();
+        if (!loader)
+            return false;
+
+        mfxU32 numImpls = 0;
+        mfxHDL implDesc = nullptr;
+        while (MFXEnumImplementations(loader,
+                                      numImpls,
+                                      MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                      &implDesc) == MFX_ERR_NONE) {
+            MFXDispReleaseImplDescription(loader, implDesc);
+            numImpls++;
+        }
+        result.samplesNs.push_back(GetTimeNs() - startNs);
+
+        MFXUnload(loader);
+
+        if (numImpls < params.numRuntimes)
+            return false;
+    }
+
+    return true;
+}
+
+// update of one filter property and the next enumeration, which checks all implementations
+static bool BenchFilterUpdate(const BenchParams &params, BenchResult &result) {
+    mfxLoader loader = LoadStub();
+    if (!loader)
+        return false;
+
+    // cycle through the encoders of the stub runtime
+    std::vector<mfxU32> codecs;
+    mfxImplDescription *implDesc = nullptr;
+    if (MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc) ==
+        MFX_ERR_NONE) {
+        for (mfxU32 i = 0; i < implDesc->Enc.NumCodecs; i++)
+            codecs.push_back(implDesc->Enc.Codecs[i].CodecID);
+        MFXDispReleaseImplDescription(loader, implDesc);
+    }
+
+    const char *name = "mfxImplDescription.mfxEncoderDescription.encoder.CodecID";
+    mfxConfig config = MFXCreateConfig(loader);
+    bool bOk         = (config != nullptr && !codecs.empty());
+
+    for (mfxU32 i = 0; bOk && i < params.numIterations; i++) {
+        mfxHDL implDesc = nullptr;
+
+        double startNs = GetTimeNs();
+        mfxStatus sts  = SetFilterU32(config, name, codecs[i % codecs.size()]);
+        if (sts == MFX_ERR_NONE)
+            sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &implDesc);
+        result.samplesNs.push_back(GetTimeNs() - startNs);
+
+        bOk = (sts == MFX_ERR_NONE);
+
+        if (implDesc)
+            MFXDispReleaseImplDescription(loader, implDesc);
+    }
+
+    MFXUnload(loader);
+
+    return bOk;
+}
+
+// MFXCreateSession() with an enumerated loader
+static bool BenchCreateSession(const BenchParams &params, BenchResult &result) {
+    mfxLoader loader = LoadStub();
+    if (!loader)
+        return false;
+
+    bool bOk = true;
+    for (mfxU32 i = 0; bOk && i < params.numIterations; i++) {
+        mfxSession session = nullptr;
+
+        double startNs = GetTimeNs();
+        bOk            = (MFXCreateSession(loader, 0, &session) == MFX_ERR_NONE);
+        result.samplesNs.push_back(GetTimeNs() - startNs);
+
+        if (session)
+            MFXClose(session);
+    }
+
+    MFXUnload(loader);
+
+    return bOk;
+}
+
+// MFXCloneSession()
+static bool BenchCloneSession(const BenchParams &params, BenchResult &result) {
+    mfxLoader loader = LoadStub();
+    if (!loader)
+        return false;
+
+    mfxSession session = nullptr;
+    bool bOk           = (MFXCreateSession(loader, 0, &session) == MFX_ERR_NONE);
+
+    for (mfxU32 i = 0; bOk && i < params.numIterations; i++) {
+        mfxSession clone = nullptr;
+
+        double startNs = GetTimeNs();
+        bOk            = (MFXCloneSession(session, &clone) == MFX_ERR_NONE);
+        result.samplesNs.push_back(GetTimeNs() - startNs);
+
+        if (clone)
+            MFXClose(clone);
+    }
+
+    if (session)
+        MFXClose(session);
+    MFXUnload(loader);
+
+    return bOk;
+}
+
+// per-call cost of a passthrough function (stub runtime returns immediately)
+static bool BenchPassthrough(const BenchParams &params, BenchResult &result) {
+    mfxLoader loader = LoadStub();
+    if (!loader)
+        return false;
+
+    mfxSession session = nullptr;
+    bool bOk           = (MFXCreateSession(loader, 0, &session) == MFX_ERR_NONE);
+
+    for (mfxU32 i = 0; bOk && i < params.numIterations; i++) {
+        mfxIMPL impl = {};
+
+        double startNs = GetTimeNs();
+        for (mfxU32 j = 0; j < NUM_PASSTHROUGH_CALLS; j++)
+            bOk &= (MFXQueryIMPL(session, &impl) == MFX_ERR_NONE);
+        result.samplesNs.push_back((GetTimeNs() - startNs) / NUM_PASSTHROUGH_CALLS);
+    }
+
+    if (session)
+        MFXClose(session);
+    MFXUnload(loader);
+
+    return bOk;
+}
+
+struct BenchFunc {
+    const char *name;
+    bool (*func)(const BenchParams &params, BenchResult &result);
+};
+
+static const BenchFunc benchFuncs[] = {
+    { "MFXLoad", BenchLoad },
+    { "EnumImplementations", BenchEnumImplementations },
+    { "FilterUpdate", BenchFilterUpdate },
+    { "MFXCreateSession", BenchCreateSession },
+    { "MFXCloneSession", BenchCloneSession },
+    { "MFXQueryIMPL", BenchPassthrough },
+};
+
+struct BenchStats {
+    double mean;
+    double min;
+    double median;
+    double p90;
+    double max;
+};
+
+static BenchStats GetStats(std::vector<double> samplesNs) {
+    BenchStats stats = {};
+    if (samplesNs.empty())
+        return stats;
+
+    std::sort(samplesNs.begin(), samplesNs.end());
+
+    double total = 0;
+    for (double s : samplesNs)
+        total += s;
+
+    stats.mean   = total / samplesNs.size();
+    stats.min    = samplesNs.front();
+    stats.median = samplesNs[samplesNs.size() / 2];
+    stats.p90    = samplesNs[(samplesNs.size() * 9) / 10];
+    stats.max    = samplesNs.back();
+
+    return stats;
+}
+
+static void PrintJSON(FILE *out,
+                      const std::string &label,
+                      const std::vector<BenchResult> &results) {
+    fprintf(out, "{\n");
+    fprintf(out, "  \"context\": {\n");
+    fprintf(out, "    \"executable\": \"vpl-bench\",\n");
+    fprintf(out, "    \"label\": \"%s\",\n", label.c_str());
+    fprintf(out, "    \"api_version\": \"%d.%d\"\n", MFX_VERSION_MAJOR, MFX_VERSION_MINOR);
+    fprintf(out, "  },\n");
+    fprintf(out, "  \"benchmarks\": [");
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult &r = results[i];
+        BenchStats stats     = GetStats(r.samplesNs);
+
+        fprintf(out, "%s\n    {\n", i ? "," : "");
+        fprintf(out,
+                "      \"name\": \"%s/runtimes:%u/caps:%u\",\n",
+                r.name.c_str(),
+                r.numRuntimes,
+                r.numCaps);
+        fprintf(out, "      \"run_name\": \"%s\",\n", r.name.c_str());
+        fprintf(out, "      \"runtimes\": %u,\n", r.numRuntimes);
+        fprintf(out, "      \"caps\": %u,\n", r.numCaps);
+        fprintf(out, "      \"iterations\": %u,\n", (mfxU32)r.samplesNs.size());
+        fprintf(out, "      \"real_time\": %.1f,\n", stats.mean);
+        fprintf(out, "      \"min\": %.1f,\n", stats.min);
+        fprintf(out, "      \"median\": %.1f,\n", stats.median);
+        fprintf(out, "      \"p90\": %.1f,\n", stats.p90);
+        fprintf(out, "      \"max\": %.1f,\n", stats.max);
+        fprintf(out, "      \"time_unit\": \"ns\"\n");
+        fprintf(out, "    }");
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+}
+
+static void PrintCSV(FILE *out, const std::vector<BenchResult> &results) {
+    fprintf(out, "name,runtimes,caps,iterations,mean_ns,min_ns,median_ns,p90_ns,max_ns\n");
+
+    for (const auto &r : results) {
+        BenchStats stats = GetStats(r.samplesNs);
+        fprintf(out,
+                "%s,%u,%u,%u,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+                r.name.c_str(),
+                r.numRuntimes,
+                r.numCaps,
+                (mfxU32)r.samplesNs.size(),
+                stats.mean,
+                stats.min,
+                stats.median,
+                stats.p90,
+                stats.max);
+    }
+}
+
+static void PrintUsage() {
+    printf("Usage: vpl-bench -stub <path> [options]\n");
+    printf("       -stub path ........ stub runtime library (libvpl/test/runtimes/stub)\n");
+    printf("       -runtimes list .... comma-separated numbers of installed runtimes\n");
+    printf("                           (default = 1,4,16)\n");
+    printf("       -caps list ........ comma-separated numbers of decoders, encoders, and\n");
+    printf("                           VPP filters in synthetic caps (0 = default caps)\n");
+    printf("       -synth str ........ other synthetic caps settings, e.g. profiles=4\n");
+    printf("       -iterations n ..... samples per benchmark (default = 100)\n");
+    printf("       -filter name ...... only run benchmarks whose name contains name\n");
+    printf("       -format fmt ....... json (default) or csv\n");
+    printf("       -label str ........ label to store with JSON results\n");
+    printf("       -o file ........... write results to file instead of stdout\n");
+}
+
+static bool ParseList(const char *arg,
+                      mfxU32 minValue,
+                      mfxU32 maxValue,
+                      std::vector<mfxU32> &list) {
+    list.clear();
+
+    std::string str = arg;
+    size_t pos      = 0;
+    while (pos <= str.size()) {
+        size_t end = str.find(',', pos);
+        if (end == std::string::npos)
+            end = str.size();
+
+        std::string value = str.substr(pos, end - pos);
+        mfxU32 n          = (mfxU32)atol(value.c_str());
+        if (value.empty() || n < minValue || n > maxValue)
+            return false;
+        list.push_back(n);
+
+        pos = end + 1;
+    }
+
+    return !list.empty();
+}
+
+// run all benchmarks with numRuntimes copies of the stub runtime
+static int RunBenchmarks(const std::string &stubPath,
+                         const std::string &runtimeDir,
+                         const std::string &filter,
+                         const BenchParams &params,
+                         mfxU32 numCaps,
+                         std::vector<BenchResult> &results) {
+    std::vector<std::string> runtimePaths;
+
+    if (!InstallRuntimes(stubPath, runtimeDir, params.numRuntimes, runtimePaths)) {
+        printf("Error - cannot install runtimes from %s\n", stubPath.c_str());
+        RemoveRuntimes(runtimePaths);
+        return -1;
+    }
+
+    int ret = 0;
+    for (const auto &bench : benchFuncs) {
+        if (!filter.empty() && !strstr(bench.name, filter.c_str()))
+            continue;
+
+        BenchResult result = {};
+        result.name        = bench.name;
+        result.numRuntimes = params.numRuntimes;
+        result.numCaps     = numCaps;
+
+        // one untimed pass to load libraries and fill OS caches
+        BenchParams warmupParams   = params;
+        warmupParams.numIterations = 1;
+        BenchResult warmupResult   = {};
+        bench.func(warmupParams, warmupResult);
+
+        if (!bench.func(params, result)) {
+            printf("Error - %s failed with %u runtimes\n", bench.name, params.numRuntimes);
+            ret = -1;
+            continue;
+        }
+
+        results.push_back(result);
+    }
+
+    RemoveRuntimes(runtimePaths);
+
+    return ret;
+}
+
+int main(int argc, char *argv[]) {
+    std::string stubPath, filter, outPath, label, synth;
+    std::vector<mfxU32> runtimeList = { 1, 4, 16 };
+    std::vector<mfxU32> capsList    = { 0 };
+    mfxU32 numIterations            = 100;
+    bool bCSV                       = false;
+
+    for (int i = 1; i < argc; i++) {
+        bool bHasValue = (i + 1 < argc);
+
+        if (!strcmp(argv[i], "-stub") && bHasValue) {
+            stubPath = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-runtimes") && bHasValue) {
+            if (!ParseList(argv[++i], 1, 999, runtimeList)) {
+                printf("Error - invalid runtime list\n");
+                return -1;
+            }
+        }
+        else if (!strcmp(argv[i], "-caps") && bHasValue) {
+            if (!ParseList(argv[++i], 0, 0xFFFF, capsList)) {
+                printf("Error - invalid caps list\n");
+                return -1;
+            }
+        }
+        else if (!strcmp(argv[i], "-synth") && bHasValue) {
+            synth = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-iterations") && bHasValue) {
+            numIterations = (mfxU32)atol(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "-filter") && bHasValue) {
+            filter = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-format") && bHasValue) {
+            bCSV = !strcmp(argv[++i], "csv");
+        }
+        else if (!strcmp(argv[i], "-label") && bHasValue) {
+            label = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-o") && bHasValue) {
+            outPath = argv[++i];
+        }
+        else {
+            printf("Error - invalid argument\n\n");
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    if (stubPath.empty() || numIterations == 0) {
+        PrintUsage();
+        return -1;
+    }
+
+    std::string runtimeDir = MakeRuntimeDir();
+    if (runtimeDir.empty()) {
+        printf("Error - cannot create temporary directory\n");
+        return -1;
+    }
+
+    // only the runtime copies are found (in addition to system default locations)
+    SetEnv("ONEVPL_SEARCH_PATH", runtimeDir.c_str());
+
+    std::vector<BenchResult> results;
+    int ret = 0;
+
+    for (mfxU32 numCaps : capsList) {
+        // stub runtime reads the configuration when it is loaded
+        std::string synthConfig = synth;
+        if (numCaps) {
+            std::string n = std::to_string(numCaps);
+            synthConfig += (synthConfig.empty() ? "" : ",");
+            synthConfig += "dec=" + n + ",enc=" + n + ",vpp=" + n;
+        }
+        SetEnv("VPL_STUB_SYNTH", synthConfig.empty() ? nullptr : synthConfig.c_str());
+
+        for (mfxU32 numRuntimes : runtimeList) {
+            BenchParams params   = {};
+            params.numRuntimes   = numRuntimes;
+            params.numIterations = numIterations;
+
+            if (RunBenchmarks(stubPath, runtimeDir, filter, params, numCaps, results))
+                ret = -1;
+        }
+    }
+
+    RemoveRuntimeDir(runtimeDir);
+
+    FILE *out = stdout;
+    if (!outPath.empty()) {
+        out = fopen(outPath.c_str(), "w");
+        if (!out) {
+            printf("Error - cannot open %s\n", outPath.c_str());
+            return -1;
+        }
+    }
+
+    if (bCSV)
+        PrintCSV(out, results);
+    else
+        PrintJSON(out, label, results);
+
+    if (out != stdout)
+        fclose(out);
+
+    return ret;
+}
@@ -14,6 +14,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <chrono>
 #include <vector>
 
 #include "vpl/mfx.h"
@@ -26,6 +27,10 @@ struct mfxDispatcherVersion {
 };
 
 static mfxStatus GetDispatcherVersion(mfxDispatcherVersion *dispatcherVersion);
+#ifdef ONEVPL_EXPERIMENTAL
+static mfxStatus TimeFilterProperties(mfxU32 numCycles);
+static void PrintLoaderTimings(mfxLoader loader);
+#endif
 
 static void SetDefaultParamsEncode(mfxVideoParam *par) {
     par->mfx.CodecId                  = MFX_CODEC_AVC;
@@ -55,6 +60,8 @@ int main(int argc, char *argv[]) {
     mfxSession session = nullptr;
     mfxStatus sts      = MFX_ERR_NONE;
     mfxU32 adapterNum  = 0;
+    mfxU32 numSessions = 0;
+    mfxU32 numFilters  = 0;
 
     bool bEnumImpls     = false;
     bool bUseFastLoad   = false;
@@ -64,6 +71,11 @@ int main(int argc, char *argv[]) {
         if (!strncmp(argv[i], "-e", 2)) {
             bEnumImpls = true;
         }
+        else if (!strncmp(argv[i], "-filters", 8)) {
+            // check before "-f"
+            i++;
+            numFilters = atol(argv[i]);
+        }
         else if (!strncmp(argv[i], "-f", 2)) {
             bUseFastLoad = true;
         }
@@ -74,6 +86,10 @@ int main(int argc, char *argv[]) {
             i++;
             adapterNum = atol(argv[i]);
         }
+        else if (!strncmp(argv[i], "-sessions", 9)) {
+            i++;
+            numSessions = atol(argv[i]);
+        }
         else {
             printf("Error - invalid argument\n\n");
             printf("Usage: vpl-timing [options]\n");
@@ -81,6 +97,10 @@ int main(int argc, char *argv[]) {
             printf("       -f ................ enable fast loading\n");
             printf("       -p ................ print paths of loaded implementation\n");
             printf("       -adapterNum n ..... use device adapter number n (default = 0)\n");
+            printf("       -sessions n ....... time n additional create/close session cycles\n");
+            printf("                           (set ONEVPL_SESSION_FAST_PATH=OFF to compare)\n");
+            printf("       -filters n ........ time n filter update cycles, one property per\n");
+            printf("                           call vs. MFXSetConfigFilterProperties()\n");
             return -1;
         }
     }
@@ -232,6 +252,50 @@ int main(int argc, char *argv[]) {
 
     VPL_LOG_TIME_END(totaltime);
 
+    if (numSessions > 0) {
+        // loader already resolved the implementation, measure steady-state session creation
+        std::chrono::high_resolution_clock::time_point startTime =
+            std::chrono::high_resolution_clock::now();
+
+        for (mfxU32 i = 0; i < numSessions; i++) {
+            mfxSession sessionN = nullptr;
+
+            sts = MFXCreateSession(loader, 0, &sessionN);
+            if (sts != MFX_ERR_NONE) {
+                printf("Error - MFXCreateSession (cycle %d) returned %d\n", i, sts);
+                MFXClose(session);
+                MFXUnload(loader);
+                return -1;
+            }
+            MFXClose(sessionN);
+        }
+
+        std::chrono::microseconds diff = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - startTime);
+        printf("vpl-timing -- %-48s = % 8.3f msec\n",
+               "MFXCreateSession + MFXClose (average)",
+               diff.count() / 1000.0f / numSessions);
+    }
+
+    if (numFilters > 0) {
+#ifdef ONEVPL_EXPERIMENTAL
+        sts = TimeFilterProperties(numFilters);
+        if (sts != MFX_ERR_NONE) {
+            printf("Error - filter timing returned %d\n", sts);
+            MFXClose(session);
+            MFXUnload(loader);
+            return -1;
+        }
+#else
+        printf("-filters ignored (requires experimental API)\n");
+#endif
+    }
+
+#ifdef ONEVPL_EXPERIMENTAL
+    // only available if the dispatcher was run with ONEVPL_STARTUP_TIMING=ON
+    PrintLoaderTimings(loader);
+#endif
+
     printf("\n");
 
     mfxVersion actualVersion = {};
@@ -268,6 +332,120 @@ int main(int argc, char *argv[]) {
     return 0;
 }
 
+#ifdef ONEVPL_EXPERIMENTAL
+// set filters matching implementation 0 on a new loader, numCycles times, and
+//   enumerate after each update so that the filters are applied
+// compares one MFXSetConfigFilterProperty() call per property with a single
+//   MFXSetConfigFilterProperties() call
+static mfxStatus TimeFilterProperties(mfxU32 numCycles) {
+    mfxLoader loader = MFXLoad();
+    if (loader == NULL)
+        return MFX_ERR_NOT_FOUND;
+
+    mfxImplDescription *idesc = nullptr;
+
+    mfxStatus sts = MFXEnumImplementations(loader,
+                                           0,
+                                           MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                           reinterpret_cast<mfxHDL *>(&idesc));
+    if (sts != MFX_ERR_NONE) {
+        MFXUnload(loader);
+        return sts;
+    }
+
+    mfxConfigFilterProperty props[5] = {};
+    for (auto &prop : props)
+        prop.Value.Version.Version = MFX_VARIANT_VERSION;
+
+    props[0].Name           = (const mfxU8 *)"mfxImplDescription.Impl";
+    props[0].Value.Type     = MFX_VARIANT_TYPE_U32;
+    props[0].Value.Data.U32 = idesc->Impl;
+    props[1].Name           = (const mfxU8 *)"mfxImplDescription.AccelerationMode";
+    props[1].Value.Type     = MFX_VARIANT_TYPE_U32;
+    props[1].Value.Data.U32 = idesc->AccelerationMode;
+    props[2].Name           = (const mfxU8 *)"mfxImplDescription.VendorID";
+    props[2].Value.Type     = MFX_VARIANT_TYPE_U32;
+    props[2].Value.Data.U32 = idesc->VendorID;
+    props[3].Name           = (const mfxU8 *)"mfxImplDescription.ApiVersion.Version";
+    props[3].Value.Type     = MFX_VARIANT_TYPE_U32;
+    props[3].Value.Data.U32 = idesc->ApiVersion.Version;
+    props[4].Name           = (const mfxU8 *)"mfxImplDescription.ImplName";
+    props[4].Value.Type     = MFX_VARIANT_TYPE_PTR;
+    props[4].Value.Data.Ptr = idesc->ImplName;
+    const mfxU32 numProps   = sizeof(props) / sizeof(props[0]);
+
+    mfxConfig config = MFXCreateConfig(loader);
+    if (config == NULL) {
+        MFXDispReleaseImplDescription(loader, idesc);
+        MFXUnload(loader);
+        return MFX_ERR_NULL_PTR;
+    }
+
+    for (int batch = 0; batch < 2 && sts == MFX_ERR_NONE; batch++) {
+        std::chrono::high_resolution_clock::time_point startTime =
+            std::chrono::high_resolution_clock::now();
+
+        for (mfxU32 i = 0; i < numCycles && sts == MFX_ERR_NONE; i++) {
+            if (batch) {
+                sts = MFXSetConfigFilterProperties(config, props, numProps, nullptr);
+            }
+            else {
+                for (mfxU32 j = 0; j < numProps && sts == MFX_ERR_NONE; j++)
+                    sts = MFXSetConfigFilterProperty(config, props[j].Name, props[j].Value);
+            }
+
+            mfxHDL hdl = nullptr;
+            if (sts == MFX_ERR_NONE)
+                sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &hdl);
+            if (sts == MFX_ERR_NONE)
+                MFXDispReleaseImplDescription(loader, hdl);
+        }
+
+        std::chrono::microseconds diff = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - startTime);
+        printf("vpl-timing -- %-48s = % 8.3f msec\n",
+               batch ? "MFXSetConfigFilterProperties + enum (average)"
+                     : "MFXSetConfigFilterProperty x5 + enum (average)",
+               diff.count() / 1000.0f / numCycles);
+    }
+
+    MFXDispReleaseImplDescription(loader, idesc);
+    MFXUnload(loader);
+
+    return sts;
+}
+#endif
+
+#ifdef ONEVPL_EXPERIMENTAL
+// print time spent by the dispatcher in each loader phase, and per implementation
+static void PrintLoaderTimings(mfxLoader loader) {
+    static const char *phaseNames[MFX_LOADER_NUM_PHASES] = {
+        "search", "load", "query caps", "validate config", "prioritize", "create session",
+    };
+
+    mfxLoaderTimings timings = {};
+    if (MFXQueryLoaderTimings(loader, &timings) != MFX_ERR_NONE)
+        return;
+
+    for (mfxU32 i = 0; i < MFX_LOADER_NUM_PHASES; i++) {
+        char logStr[64];
+        snprintf(logStr, sizeof(logStr), "phase %s (%d calls)", phaseNames[i], timings.Count[i]);
+        printf("vpl-timing -- %-48s = % 8.3f msec\n", logStr, timings.TimeNs[i] / 1000000.0f);
+    }
+
+    mfxImplTimings implTimings = {};
+    for (mfxU32 idx = 0; MFXQueryImplTimings(loader, idx, &implTimings) == MFX_ERR_NONE; idx++) {
+        printf("vpl-timing -- impl %d: load = %.3f msec, query = %.3f msec, "
+               "%d sessions = %.3f msec\n",
+               idx,
+               implTimings.LoadTimeNs / 1000000.0f,
+               implTimings.QueryTimeNs / 1000000.0f,
+               implTimings.NumSessions,
+               implTimings.SessionTimeNs / 1000000.0f);
+    }
+}
+#endif
+
 static mfxStatus GetDispatcherVersion(mfxDispatcherVersion *ver) {
 #if defined(_WIN32) || defined(_WIN64)
     std::vector<char> fileInfoBuf;
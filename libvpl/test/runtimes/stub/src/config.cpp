@@ -10,6 +10,10 @@
 #include "src/caps.h"
 #include "src/config.h"
 
+#ifndef ENABLE_STUB_1X
+    #include "src/synth.h"
+#endif
+
 // the auto-generated capabilities structs
 // only include one time in this library
 #include "src/caps_dec_none.h"
@@ -137,11 +141,19 @@ mfxStatus MFXInitialize(mfxInitializationParam par, mfxSession *session) {
     }
 #endif
 
+#ifndef ENABLE_STUB_1X
+    SynthDelay(GetSynthConfig().initDelayUs);
+
+    if (SynthInitFails())
+        return MFX_ERR_UNSUPPORTED;
+#endif
+
     _mfxSession *stubSession = new _mfxSession;
     if (!stubSession)
         return MFX_ERR_MEMORY_ALLOC;
 
-    stubSession->handleType = DEFAULT_SESSION_HANDLE_2X;
+    stubSession->handleType   = DEFAULT_SESSION_HANDLE_2X;
+    stubSession->vendorImplID = par.VendorImplID;
 
     *session = (mfxSession)stubSession;
 
@@ -450,7 +462,7 @@ static const mfxSurfaceTypesSupported *minSurfTypesSupportedArray[NUM_CPU_IMPLS]
 
 // query and release are independent of session - called during
 //   caps query and config stage using Intel® Video Processing Library (Intel® VPL) extensions
-mfxHDL *MFXQueryImplsDescription(mfxImplCapsDeliveryFormat format, mfxU32 *num_impls) {
+static mfxHDL *QueryDefaultImplsDescription(mfxImplCapsDeliveryFormat format, mfxU32 *num_impls) {
     *num_impls = NUM_CPU_IMPLS;
 
     if (format == MFX_IMPLCAPS_IMPLDESCSTRUCTURE) {
@@ -480,6 +492,19 @@ mfxHDL *MFXQueryImplsDescription(mfxImplCapsDeliveryFormat format, mfxU32 *num_i
     }
 }
 
+mfxHDL *MFXQueryImplsDescription(mfxImplCapsDeliveryFormat format, mfxU32 *num_impls) {
+#ifndef ENABLE_STUB_1X
+    // synthetic caps, see synth.cpp
+    if (GetSynthConfig().bEnabled) {
+        mfxU32 numDefault  = 0;
+        mfxHDL *defaultHdl = QueryDefaultImplsDescription(format, &numDefault);
+        return SynthQueryImplsDescription(format, num_impls, defaultHdl);
+    }
+#endif
+
+    return QueryDefaultImplsDescription(format, num_impls);
+}
+
 // walk through implDesc and delete dynamically-allocated structs
 mfxStatus MFXReleaseImplDescription(mfxHDL hdl) {
     if (!hdl)
@@ -503,6 +528,11 @@ mfxStatus MFXQueryVersion(mfxSession session, mfxVersion *pVersion) {
     pVersion->Major = MFX_VERSION_MAJOR;
     pVersion->Minor = MFX_VERSION_MINOR;
 
+#ifndef ENABLE_STUB_1X
+    if (GetSynthConfig().bApiVersion)
+        *pVersion = GetSynthConfig().apiVersion;
+#endif
+
     return MFX_ERR_NONE;
 }
 
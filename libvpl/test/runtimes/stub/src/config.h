@@ -20,8 +20,14 @@
 struct _mfxSession {
     mfxU32 handleType;
 
+    // used by the synthetic encoder (see synth.cpp)
+    mfxU32 vendorImplID;
+    bool bEncodeInit;
+
     _mfxSession() {
-        handleType = 0;
+        handleType   = 0;
+        vendorImplID = 0;
+        bEncodeInit  = false;
     }
 };
 
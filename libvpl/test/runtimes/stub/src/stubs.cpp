@@ -6,6 +6,10 @@
 
 #include "vpl/mfx.h"
 
+#ifndef ENABLE_STUB_1X
+    #include "src/synth.h"
+#endif
+
 mfxStatus MFXInit(mfxIMPL implParam, mfxVersion *ver, mfxSession *session) {
     return MFX_ERR_NOT_IMPLEMENTED;
 }
@@ -40,7 +44,11 @@ mfxStatus MFXVideoCORE_QueryPlatform(mfxSession session, mfxPlatform *platform)
 }
 
 mfxStatus MFXVideoCORE_SyncOperation(mfxSession session, mfxSyncPoint syncp, mfxU32 wait) {
+#ifndef ENABLE_STUB_1X
+    return SynthSyncOperation(session, syncp);
+#else
     return MFX_ERR_NOT_IMPLEMENTED;
+#endif
 }
 
 mfxStatus MFXVideoDECODE_DecodeHeader(mfxSession session, mfxBitstream *bs, mfxVideoParam *par) {
@@ -136,11 +144,19 @@ mfxStatus MFXVideoENCODE_QueryIOSurf(mfxSession session,
 }
 
 mfxStatus MFXVideoENCODE_Init(mfxSession session, mfxVideoParam *par) {
+#ifndef ENABLE_STUB_1X
+    return SynthEncodeInit(session, par);
+#else
     return MFX_ERR_NOT_IMPLEMENTED;
+#endif
 }
 
 mfxStatus MFXVideoENCODE_Close(mfxSession session) {
+#ifndef ENABLE_STUB_1X
+    return SynthEncodeClose(session);
+#else
     return MFX_ERR_NOT_IMPLEMENTED;
+#endif
 }
 
 mfxStatus MFXVideoENCODE_EncodeFrameAsync(mfxSession session,
@@ -148,7 +164,11 @@ mfxStatus MFXVideoENCODE_EncodeFrameAsync(mfxSession session,
                                           mfxFrameSurface1 *surface,
                                           mfxBitstream *bs,
                                           mfxSyncPoint *syncp) {
+#ifndef ENABLE_STUB_1X
+    return SynthEncodeFrameAsync(session, surface, bs, syncp);
+#else
     return MFX_ERR_NOT_IMPLEMENTED;
+#endif
 }
 
 mfxStatus MFXVideoENCODE_Reset(mfxSession session, mfxVideoParam *par) {
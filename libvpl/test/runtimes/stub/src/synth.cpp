@@ -0,0 +1,494 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+// synthetic stub runtime - caps are generated from a configuration, so dispatcher
+//   scaling (many runtimes, large caps) can be measured without GPUs
+//
+// configuration is read from a side-car file next to the library (<library path>.synth),
+//   otherwise from the VPL_STUB_SYNTH environment variable
+// format: key=value pairs separated by commas or new lines, '#' starts a comment
+//   impls=n          number of implementations (default = 1)
+//   dec=n, enc=n     number of decoders/encoders (default = stub caps)
+//   vpp=n            number of VPP filters (default = stub caps)
+//   profiles=n       profiles per codec (default = 1)
+//   formats=n        color formats per profile/filter (default = 1)
+//   query_delay_us=n delay in MFXQueryImplsDescription()
+//   init_delay_us=n  delay in MFXInitialize()
+//   init_fail=n      MFXInitialize() fails for the first n calls
+//   encode_frame_us=n[:n...]
+//                    delay per frame of a synthetic encoder, for each implementation
+//                    (the last value is used for the remaining ones)
+//   api=major.minor  reported API version (default = headers)
+//   name=str         ImplName (default = "Stub Implementation")
+// without a configuration, the stub runtime reports its default caps
+
+#if defined(_WIN32) || defined(_WIN64)
+    #include <windows.h>
+#else
+    #include <dlfcn.h>
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "src/caps.h"
+#include "src/config.h"
+#include "src/synth.h"
+
+// real IDs are used first, then synthetic FourCC codes
+static const mfxU32 codecIDs[] = {
+    MFX_CODEC_AVC,   MFX_CODEC_HEVC, MFX_CODEC_AV1, MFX_CODEC_VP9,
+    MFX_CODEC_MPEG2, MFX_CODEC_JPEG, MFX_CODEC_VP8, MFX_CODEC_VVC,
+};
+
+static const mfxU32 colorFormats[] = {
+    MFX_FOURCC_NV12, MFX_FOURCC_I420, MFX_FOURCC_P010, MFX_FOURCC_YUY2,
+    MFX_FOURCC_AYUV, MFX_FOURCC_Y210, MFX_FOURCC_Y410, MFX_FOURCC_RGB4,
+    MFX_FOURCC_BGR4, MFX_FOURCC_P016, MFX_FOURCC_Y216, MFX_FOURCC_Y416,
+};
+
+static const mfxU32 filterIDs[] = {
+    MFX_EXTBUFF_VPP_DENOISE2,       MFX_EXTBUFF_VPP_SCALING,
+    MFX_EXTBUFF_VPP_PROCAMP,        MFX_EXTBUFF_VPP_DETAIL,
+    MFX_EXTBUFF_VPP_DEINTERLACING,  MFX_EXTBUFF_VPP_FRAME_RATE_CONVERSION,
+    MFX_EXTBUFF_VPP_ROTATION,       MFX_EXTBUFF_VPP_MIRRORING,
+};
+
+#define NUM_ELEMENTS(a) (mfxU32)(sizeof(a) / sizeof((a)[0]))
+
+static mfxU32 GetID(const mfxU32 *ids, mfxU32 numIDs, char prefix, mfxU32 idx) {
+    if (idx < numIDs)
+        return ids[idx];
+
+    return MFX_MAKEFOURCC('S', prefix, (idx >> 8) & 0xFF, idx & 0xFF);
+}
+
+static std::string GetModulePath() {
+#if defined(_WIN32) || defined(_WIN64)
+    HMODULE hModule = nullptr;
+    if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                                GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                            (LPCSTR)&GetModulePath,
+                            &hModule))
+        return "";
+
+    char path[MAX_PATH] = "";
+    DWORD len           = GetModuleFileNameA(hModule, path, MAX_PATH);
+    if (len == 0 || len >= MAX_PATH)
+        return "";
+
+    return path;
+#else
+    Dl_info info = {};
+    if (!dladdr((void *)&GetModulePath, &info) || !info.dli_fname)
+        return "";
+
+    return info.dli_fname;
+#endif
+}
+
+static bool ReadConfigText(std::string &text) {
+    std::string modulePath = GetModulePath();
+    if (!modulePath.empty()) {
+        std::ifstream synthFile(modulePath + ".synth");
+        if (synthFile.is_open()) {
+            std::stringstream ss;
+            ss << synthFile.rdbuf();
+            text = ss.str();
+            return true;
+        }
+    }
+
+    const char *synthEnv = std::getenv("VPL_STUB_SYNTH");
+    if (synthEnv && *synthEnv) {
+        text = synthEnv;
+        return true;
+    }
+
+    return false;
+}
+
+static std::string Trim(const std::string &str) {
+    size_t start = str.find_first_not_of(" \t\r");
+    if (start == std::string::npos)
+        return "";
+
+    size_t end = str.find_last_not_of(" \t\r");
+    return str.substr(start, end - start + 1);
+}
+
+static void ParseConfig(const std::string &text, SynthConfig &cfg) {
+    std::string entry;
+    std::stringstream ss(text);
+
+    while (std::getline(ss, entry)) {
+        size_t comment = entry.find('#');
+        if (comment != std::string::npos)
+            entry.erase(comment);
+
+        std::stringstream entries(entry);
+        std::string kv;
+        while (std::getline(entries, kv, ',')) {
+            size_t eq = kv.find('=');
+            if (eq == std::string::npos)
+                continue;
+
+            std::string key   = Trim(kv.substr(0, eq));
+            std::string value = Trim(kv.substr(eq + 1));
+
+            mfxU32 n = (mfxU32)strtoul(value.c_str(), nullptr, 10);
+            if (key == "impls")
+                cfg.numImpls = std::max(n, 1u);
+            else if (key == "dec")
+                cfg.numDec = (mfxI32)n;
+            else if (key == "enc")
+                cfg.numEnc = (mfxI32)n;
+            else if (key == "vpp")
+                cfg.numVPP = (mfxI32)n;
+            else if (key == "profiles")
+                cfg.numProfiles = std::max(n, 1u);
+            else if (key == "formats")
+                cfg.numFormats = std::max(n, 1u);
+            else if (key == "query_delay_us")
+                cfg.queryDelayUs = n;
+            else if (key == "init_delay_us")
+                cfg.initDelayUs = n;
+            else if (key == "init_fail")
+                cfg.initFailCount = n;
+            else if (key == "encode_frame_us") {
+                std::stringstream delays(value);
+                std::string delay;
+                while (std::getline(delays, delay, ':'))
+                    cfg.encodeFrameUs.push_back((mfxU32)strtoul(delay.c_str(), nullptr, 10));
+            }
+            else if (key == "name")
+                cfg.implName = value;
+            else if (key == "api") {
+                unsigned int major = 0, minor = 0;
+                if (sscanf(value.c_str(), "%u.%u", &major, &minor) == 2) {
+                    cfg.bApiVersion      = true;
+                    cfg.apiVersion.Major = (mfxU16)major;
+                    cfg.apiVersion.Minor = (mfxU16)minor;
+                }
+            }
+        }
+    }
+}
+
+const SynthConfig &GetSynthConfig() {
+    static SynthConfig cfg;
+    static std::once_flag cfgOnce;
+
+    std::call_once(cfgOnce, []() {
+        cfg             = {};
+        cfg.numImpls    = 1;
+        cfg.numDec      = -1;
+        cfg.numEnc      = -1;
+        cfg.numVPP      = -1;
+        cfg.numProfiles = 1;
+        cfg.numFormats  = 1;
+        cfg.implName    = "Stub Implementation";
+
+        std::string text;
+        if (ReadConfigText(text)) {
+            ParseConfig(text, cfg);
+            cfg.bEnabled = true;
+        }
+    });
+
+    return cfg;
+}
+
+void SynthDelay(mfxU32 delayUs) {
+    if (delayUs)
+        std::this_thread::sleep_for(std::chrono::microseconds(delayUs));
+}
+
+bool SynthInitFails() {
+    static std::atomic<mfxU32> numCalls(0);
+
+    mfxU32 failCount = GetSynthConfig().initFailCount;
+
+    return failCount && numCalls.fetch_add(1) < failCount;
+}
+
+// generated caps, kept until the library is unloaded
+// vectors are filled once and not resized later, so pointers into them remain valid
+struct SynthCaps {
+    std::vector<mfxU32> formats;
+
+    std::vector<DecMemDesc> decMemDesc;
+    std::vector<DecProfile> decProfiles;
+    std::vector<DecCodec> decCodecs;
+
+    std::vector<EncMemDesc> encMemDesc;
+    std::vector<EncProfile> encProfiles;
+    std::vector<EncCodec> encCodecs;
+
+    std::vector<VPPFormat> vppFormats;
+    std::vector<VPPMemDesc> vppMemDesc;
+    std::vector<VPPFilter> vppFilters;
+
+    std::vector<mfxImplDescription> implDesc;
+
+    // handle arrays for each caps format
+    std::map<mfxU32, std::vector<mfxHDL>> hdlArrays;
+};
+
+static SynthCaps synthCaps;
+static std::once_flag synthCapsOnce;
+static std::mutex synthHdlMutex;
+
+static void BuildDecoders(const SynthConfig &cfg, SynthCaps &caps) {
+    mfxU32 numDec = (mfxU32)cfg.numDec;
+
+    caps.decMemDesc.resize(numDec * cfg.numProfiles);
+    caps.decProfiles.resize(numDec * cfg.numProfiles);
+    caps.decCodecs.resize(numDec);
+
+    for (mfxU32 c = 0; c < numDec; c++) {
+        for (mfxU32 p = 0; p < cfg.numProfiles; p++) {
+            mfxU32 idx = c * cfg.numProfiles + p;
+
+            DecMemDesc &memDesc     = caps.decMemDesc[idx];
+            memDesc                 = {};
+            memDesc.MemHandleType   = MFX_RESOURCE_SYSTEM_SURFACE;
+            memDesc.Width           = { DEF_RANGE_MIN, DEF_RANGE_MAX, DEF_RANGE_STEP };
+            memDesc.Height          = { DEF_RANGE_MIN, DEF_RANGE_MAX, DEF_RANGE_STEP };
+            memDesc.NumColorFormats = (mfxU16)cfg.numFormats;
+            memDesc.ColorFormats    = caps.formats.data();
+
+            DecProfile &profile = caps.decProfiles[idx];
+            profile             = {};
+            profile.Profile     = p + 1;
+            profile.NumMemTypes = 1;
+            profile.MemDesc     = &memDesc;
+        }
+
+        DecCodec &codec   = caps.decCodecs[c];
+        codec             = {};
+        codec.CodecID     = GetID(codecIDs, NUM_ELEMENTS(codecIDs), 'D', c);
+        codec.NumProfiles = (mfxU16)cfg.numProfiles;
+        codec.Profiles    = &caps.decProfiles[c * cfg.numProfiles];
+    }
+}
+
+static void BuildEncoders(const SynthConfig &cfg, SynthCaps &caps) {
+    mfxU32 numEnc = (mfxU32)cfg.numEnc;
+
+    caps.encMemDesc.resize(numEnc * cfg.numProfiles);
+    caps.encProfiles.resize(numEnc * cfg.numProfiles);
+    caps.encCodecs.resize(numEnc);
+
+    for (mfxU32 c = 0; c < numEnc; c++) {
+        for (mfxU32 p = 0; p < cfg.numProfiles; p++) {
+            mfxU32 idx = c * cfg.numProfiles + p;
+
+            EncMemDesc &memDesc     = caps.encMemDesc[idx];
+            memDesc                 = {};
+            memDesc.MemHandleType   = MFX_RESOURCE_SYSTEM_SURFACE;
+            memDesc.Width           = { DEF_RANGE_MIN, DEF_RANGE_MAX, DEF_RANGE_STEP };
+            memDesc.Height          = { DEF_RANGE_MIN, DEF_RANGE_MAX, DEF_RANGE_STEP };
+            memDesc.NumColorFormats = (mfxU16)cfg.numFormats;
+            memDesc.ColorFormats    = caps.formats.data();
+
+            EncProfile &profile = caps.encProfiles[idx];
+            profile             = {};
+            profile.Profile     = p + 1;
+            profile.NumMemTypes = 1;
+            profile.MemDesc     = &memDesc;
+        }
+
+        EncCodec &codec               = caps.encCodecs[c];
+        codec                         = {};
+        codec.CodecID                 = GetID(codecIDs, NUM_ELEMENTS(codecIDs), 'E', c);
+        codec.BiDirectionalPrediction = 1;
+        codec.NumProfiles             = (mfxU16)cfg.numProfiles;
+        codec.Profiles                = &caps.encProfiles[c * cfg.numProfiles];
+    }
+}
+
+static void BuildFilters(const SynthConfig &cfg, SynthCaps &caps) {
+    mfxU32 numVPP = (mfxU32)cfg.numVPP;
+
+    caps.vppFormats.resize(numVPP * cfg.numFormats);
+    caps.vppMemDesc.resize(numVPP);
+    caps.vppFilters.resize(numVPP);
+
+    for (mfxU32 f = 0; f < numVPP; f++) {
+        for (mfxU32 i = 0; i < cfg.numFormats; i++) {
+            VPPFormat &format = caps.vppFormats[f * cfg.numFormats + i];
+            format              = {};
+            format.InFormat     = caps.formats[i];
+            format.NumOutFormat = (mfxU16)cfg.numFormats;
+            format.OutFormats   = caps.formats.data();
+        }
+
+        VPPMemDesc &memDesc   = caps.vppMemDesc[f];
+        memDesc               = {};
+        memDesc.MemHandleType = MFX_RESOURCE_SYSTEM_SURFACE;
+        memDesc.Width         = { DEF_RANGE_MIN, DEF_RANGE_MAX, DEF_RANGE_STEP };
+        memDesc.Height        = { DEF_RANGE_MIN, DEF_RANGE_MAX, DEF_RANGE_STEP };
+        memDesc.NumInFormats  = (mfxU16)cfg.numFormats;
+        memDesc.Formats       = &caps.vppFormats[f * cfg.numFormats];
+
+        VPPFilter &filter   = caps.vppFilters[f];
+        filter              = {};
+        filter.FilterFourCC = GetID(filterIDs, NUM_ELEMENTS(filterIDs), 'V', f);
+        filter.NumMemTypes  = 1;
+        filter.MemDesc      = &memDesc;
+    }
+}
+
+static void BuildCaps(const SynthConfig &cfg, const mfxImplDescription &defaultDesc) {
+    SynthCaps &caps = synthCaps;
+
+    caps.formats.resize(cfg.numFormats);
+    for (mfxU32 i = 0; i < cfg.numFormats; i++)
+        caps.formats[i] = GetID(colorFormats, NUM_ELEMENTS(colorFormats), 'F', i);
+
+    mfxImplDescription desc = defaultDesc;
+
+    if (cfg.numDec >= 0) {
+        BuildDecoders(cfg, caps);
+        desc.Dec.NumCodecs = (mfxU16)caps.decCodecs.size();
+        desc.Dec.Codecs    = caps.decCodecs.empty() ? nullptr : caps.decCodecs.data();
+    }
+
+    if (cfg.numEnc >= 0) {
+        BuildEncoders(cfg, caps);
+        desc.Enc.NumCodecs = (mfxU16)caps.encCodecs.size();
+        desc.Enc.Codecs    = caps.encCodecs.empty() ? nullptr : caps.encCodecs.data();
+    }
+
+    if (cfg.numVPP >= 0) {
+        BuildFilters(cfg, caps);
+        desc.VPP.NumFilters = (mfxU16)caps.vppFilters.size();
+        desc.VPP.Filters    = caps.vppFilters.empty() ? nullptr : caps.vppFilters.data();
+    }
+
+    if (cfg.bApiVersion)
+        desc.ApiVersion = cfg.apiVersion;
+
+    memset(desc.ImplName, 0, sizeof(desc.ImplName));
+    strncpy(desc.ImplName, cfg.implName.c_str(), sizeof(desc.ImplName) - 1);
+
+    caps.implDesc.resize(cfg.numImpls, desc);
+    for (mfxU32 i = 0; i < cfg.numImpls; i++)
+        caps.implDesc[i].VendorImplID = i;
+}
+
+mfxHDL *SynthQueryImplsDescription(mfxImplCapsDeliveryFormat format,
+                                   mfxU32 *num_impls,
+                                   mfxHDL *defaultHdl) {
+    const SynthConfig &cfg = GetSynthConfig();
+
+    *num_impls = cfg.numImpls;
+
+    if (!defaultHdl)
+        return nullptr;
+
+    if (format == MFX_IMPLCAPS_IMPLDESCSTRUCTURE) {
+        SynthDelay(cfg.queryDelayUs);
+
+        std::call_once(synthCapsOnce, [&]() {
+            BuildCaps(cfg, *(const mfxImplDescription *)defaultHdl[0]);
+        });
+    }
+
+    std::lock_guard<std::mutex> lock(synthHdlMutex);
+
+    std::vector<mfxHDL> &hdlArray = synthCaps.hdlArrays[format];
+    if (hdlArray.empty()) {
+        for (mfxU32 i = 0; i < cfg.numImpls; i++) {
+            if (format == MFX_IMPLCAPS_IMPLDESCSTRUCTURE)
+                hdlArray.push_back(&synthCaps.implDesc[i]);
+            else
+                hdlArray.push_back(defaultHdl[0]);
+        }
+    }
+
+    return hdlArray.data();
+}
+
+// frames are "encoded" into an empty bitstream after the configured delay, and are
+//   complete when returned, so the sync point only identifies the session
+mfxStatus SynthEncodeInit(mfxSession session, mfxVideoParam *par) {
+    if (GetSynthConfig().encodeFrameUs.empty())
+        return MFX_ERR_NOT_IMPLEMENTED;
+
+    if (!session)
+        return MFX_ERR_INVALID_HANDLE;
+
+    if (!par)
+        return MFX_ERR_NULL_PTR;
+
+    ((_mfxSession *)session)->bEncodeInit = true;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus SynthEncodeClose(mfxSession session) {
+    if (GetSynthConfig().encodeFrameUs.empty())
+        return MFX_ERR_NOT_IMPLEMENTED;
+
+    if (!session)
+        return MFX_ERR_INVALID_HANDLE;
+
+    ((_mfxSession *)session)->bEncodeInit = false;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus SynthEncodeFrameAsync(mfxSession session,
+                                mfxFrameSurface1 *surface,
+                                mfxBitstream *bs,
+                                mfxSyncPoint *syncp) {
+    const SynthConfig &cfg = GetSynthConfig();
+    if (cfg.encodeFrameUs.empty())
+        return MFX_ERR_NOT_IMPLEMENTED;
+
+    if (!session)
+        return MFX_ERR_INVALID_HANDLE;
+
+    _mfxSession *stubSession = (_mfxSession *)session;
+    if (!stubSession->bEncodeInit)
+        return MFX_ERR_NOT_INITIALIZED;
+
+    // no frames are buffered
+    if (!surface)
+        return MFX_ERR_MORE_DATA;
+
+    if (!bs || !syncp)
+        return MFX_ERR_NULL_PTR;
+
+    mfxU32 implIdx = std::min(stubSession->vendorImplID, (mfxU32)cfg.encodeFrameUs.size() - 1);
+    SynthDelay(cfg.encodeFrameUs[implIdx]);
+
+    *syncp = (mfxSyncPoint)session;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus SynthSyncOperation(mfxSession session, mfxSyncPoint syncp) {
+    if (GetSynthConfig().encodeFrameUs.empty())
+        return MFX_ERR_NOT_IMPLEMENTED;
+
+    if (!session || syncp != (mfxSyncPoint)session)
+        return MFX_ERR_NULL_PTR;
+
+    return MFX_ERR_NONE;
+}
@@ -0,0 +1,63 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#ifndef LIBVPL_TEST_RUNTIMES_STUB_SRC_SYNTH_H_
+#define LIBVPL_TEST_RUNTIMES_STUB_SRC_SYNTH_H_
+
+#include <string>
+#include <vector>
+
+#include "vpl/mfx.h"
+
+// synthetic caps configuration, see synth.cpp
+// counts set to -1 keep the default stub caps
+struct SynthConfig {
+    bool bEnabled;
+
+    mfxU32 numImpls;
+    mfxI32 numDec;
+    mfxI32 numEnc;
+    mfxI32 numVPP;
+    mfxU32 numProfiles;
+    mfxU32 numFormats;
+
+    mfxU32 queryDelayUs;
+    mfxU32 initDelayUs;
+    mfxU32 initFailCount;
+
+    // delay per encoded frame for each implementation, empty if encode is not synthesized
+    std::vector<mfxU32> encodeFrameUs;
+
+    bool bApiVersion;
+    mfxVersion apiVersion;
+    std::string implName;
+};
+
+// configuration is read once, when first used after the library is loaded
+const SynthConfig &GetSynthConfig();
+
+// sleep for the configured delay (no-op if delayUs is 0)
+void SynthDelay(mfxU32 delayUs);
+
+// true for the first initFailCount calls, since the library was loaded
+bool SynthInitFails();
+
+// return handles for numImpls implementations in the requested format
+// defaultHdl is the stub's handle array for the same format (single implementation)
+mfxHDL *SynthQueryImplsDescription(mfxImplCapsDeliveryFormat format,
+                                   mfxU32 *num_impls,
+                                   mfxHDL *defaultHdl);
+
+// synthetic encoder, returns MFX_ERR_NOT_IMPLEMENTED unless encode_frame_us is set
+mfxStatus SynthEncodeInit(mfxSession session, mfxVideoParam *par);
+mfxStatus SynthEncodeClose(mfxSession session);
+mfxStatus SynthEncodeFrameAsync(mfxSession session,
+                                mfxFrameSurface1 *surface,
+                                mfxBitstream *bs,
+                                mfxSyncPoint *syncp);
+mfxStatus SynthSyncOperation(mfxSession session, mfxSyncPoint syncp);
+
+#endif // LIBVPL_TEST_RUNTIMES_STUB_SRC_SYNTH_H_
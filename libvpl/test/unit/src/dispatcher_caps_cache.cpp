@@ -0,0 +1,211 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for persistent caps cache (ONEVPL_CAPS_CACHE).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+// load stub implementation, save a copy of selected caps, and create a session
+static void LoadStubAndCreateSession(mfxImplDescription *descCopy, mfxU16 *numFunctions) {
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplDescription *implDesc = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_NE(implDesc, nullptr);
+
+    // nested arrays are not copied, only compare top-level fields and counts
+    *descCopy = *implDesc;
+
+    if (implDesc->Enc.NumCodecs > 0) {
+        EXPECT_NE(implDesc->Enc.Codecs, nullptr);
+        EXPECT_NE(implDesc->Enc.Codecs[0].Profiles, nullptr);
+    }
+
+    mfxImplementedFunctions *implFuncs = nullptr;
+    sts                                = MFXEnumImplementations(loader,
+                                     0,
+                                     MFX_IMPLCAPS_IMPLEMENTEDFUNCTIONS,
+                                     (mfxHDL *)&implFuncs);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_NE(implFuncs, nullptr);
+
+    *numFunctions = implFuncs->NumFunctions;
+    for (mfxU16 i = 0; i < implFuncs->NumFunctions; i++)
+        EXPECT_NE(implFuncs->FunctionsName[i], nullptr);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXDispReleaseImplDescription(loader, implDesc);
+    MFXDispReleaseImplDescription(loader, implFuncs);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_CapsCache, SecondLoadUsesCachedCaps) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string cacheDir;
+    EnableCapsCache(cacheDir);
+
+    // first pass - query runtime and write cache
+    mfxImplDescription desc1 = {};
+    mfxU16 numFunctions1     = 0;
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    LoadStubAndCreateSession(&desc1, &numFunctions1);
+    CheckOutputLog("caps cache updated");
+    CheckOutputLog("caps cache hit", false);
+    CleanupOutputLog();
+
+    // second pass - caps are restored from cache
+    mfxImplDescription desc2 = {};
+    mfxU16 numFunctions2     = 0;
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    LoadStubAndCreateSession(&desc2, &numFunctions2);
+    CheckOutputLog("caps cache hit");
+    CleanupOutputLog();
+
+    EXPECT_EQ(desc1.Impl, desc2.Impl);
+    EXPECT_EQ(desc1.ApiVersion.Version, desc2.ApiVersion.Version);
+    EXPECT_EQ(std::string(desc1.ImplName), std::string(desc2.ImplName));
+    EXPECT_EQ(desc1.Dec.NumCodecs, desc2.Dec.NumCodecs);
+    EXPECT_EQ(desc1.Enc.NumCodecs, desc2.Enc.NumCodecs);
+    EXPECT_EQ(desc1.VPP.NumFilters, desc2.VPP.NumFilters);
+    EXPECT_EQ(numFunctions1, numFunctions2);
+
+    DisableCapsCache(cacheDir);
+}
+
+TEST(Dispatcher_Stub_CapsCache, CorruptCacheFileIsIgnored) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string cacheDir;
+    EnableCapsCache(cacheDir);
+
+    mfxImplDescription desc = {};
+    mfxU16 numFunctions     = 0;
+    LoadStubAndCreateSession(&desc, &numFunctions);
+
+    // overwrite every cache file with garbage
+    DIR *pSearchDir = opendir(cacheDir.c_str());
+    ASSERT_NE(pSearchDir, nullptr);
+
+    struct dirent *currFile;
+    while ((currFile = readdir(pSearchDir)) != NULL) {
+        std::string fileName = currFile->d_name;
+        if (fileName == "." || fileName == "..")
+            continue;
+
+        std::ofstream cacheFile(cacheDir + PATH_SEPARATOR + fileName,
+                                std::ios::binary | std::ios::trunc);
+        cacheFile << "not a valid caps cache file";
+    }
+    closedir(pSearchDir);
+
+    // runtime is queried again and cache is rewritten
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    LoadStubAndCreateSession(&desc, &numFunctions);
+    CheckOutputLog("caps cache hit", false);
+    CheckOutputLog("caps cache updated");
+    CleanupOutputLog();
+
+    DisableCapsCache(cacheDir);
+}
+
+TEST(Dispatcher_Stub_CapsCache, DisabledByDefault) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxImplDescription desc = {};
+    mfxU16 numFunctions     = 0;
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    LoadStubAndCreateSession(&desc, &numFunctions);
+    CheckOutputLog("caps cache", false);
+    CleanupOutputLog();
+}
+
+// rank synthetic implementations by AVC encode throughput, return VendorImplID in index order
+static std::vector<mfxU32> LoadStubAndRankImpls() {
+    std::vector<mfxU32> vendorImplIDs;
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = SetConfigFilterProperty<mfxU32>(
+        loader,
+        "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+        MFX_CODEC_AVC);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplDescription *implDesc = nullptr;
+    for (mfxU32 idx = 0;
+         MFXEnumImplementations(loader, idx, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc) ==
+         MFX_ERR_NONE;
+         idx++) {
+        vendorImplIDs.push_back(implDesc->VendorImplID);
+        MFXDispReleaseImplDescription(loader, implDesc);
+    }
+
+    MFXUnload(loader);
+
+    return vendorImplIDs;
+}
+
+TEST(Dispatcher_Stub_CapsCache, RankScoresAreCached) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string cacheDir;
+    EnableCapsCache(cacheDir);
+
+    SetEnv("ONEVPL_RANK_POLICY", "THROUGHPUT");
+
+    // first pass - benchmark runs and scores are stored
+    SetEnv("VPL_STUB_SYNTH", "impls=3, encode_frame_us=4000:0:2000");
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    EXPECT_EQ(LoadStubAndRankImpls(), std::vector<mfxU32>({ 1, 2, 0 }));
+    CheckOutputLog("rank implementation");
+    CleanupOutputLog();
+
+    struct stat st = {};
+    EXPECT_EQ(stat((cacheDir + PATH_SEPARATOR + "rank.txt").c_str(), &st), 0);
+
+    // second pass - stored scores are used, although the runtime is now faster
+    SetEnv("VPL_STUB_SYNTH", "impls=3, encode_frame_us=0:4000:4000");
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    EXPECT_EQ(LoadStubAndRankImpls(), std::vector<mfxU32>({ 1, 2, 0 }));
+    CheckOutputLog("rank implementation", false);
+    CleanupOutputLog();
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+    SetEnv("ONEVPL_RANK_POLICY", nullptr);
+
+    DisableCapsCache(cacheDir);
+}
+
+#endif
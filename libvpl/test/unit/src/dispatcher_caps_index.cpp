@@ -0,0 +1,135 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for the caps index used for filter matching.
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+TEST(Dispatcher_Stub_CapsIndex, EveryEncoderDescriptionMatchesFilters) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplDescription *implDesc = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // all encoder properties are set in the same cfg object, so they must match a single
+    //   codec + profile + memory type + color format combination
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxU32 numDescriptions = 0;
+    for (mfxU32 c = 0; c < implDesc->Enc.NumCodecs; c++) {
+        const auto *encCodec = &implDesc->Enc.Codecs[c];
+        for (mfxU32 p = 0; p < encCodec->NumProfiles; p++) {
+            const auto *encProfile = &encCodec->Profiles[p];
+            for (mfxU32 m = 0; m < encProfile->NumMemTypes; m++) {
+                const auto *encMemDesc = &encProfile->MemDesc[m];
+                for (mfxU32 f = 0; f < encMemDesc->NumColorFormats; f++) {
+                    SetConfigFilterProperty<mfxU32>(
+                        loader,
+                        cfg,
+                        "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+                        encCodec->CodecID);
+                    SetConfigFilterProperty<mfxU32>(
+                        loader,
+                        cfg,
+                        "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.Profile",
+                        encProfile->Profile);
+                    SetConfigFilterProperty<mfxU32>(
+                        loader,
+                        cfg,
+                        "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc."
+                        "MemHandleType",
+                        encMemDesc->MemHandleType);
+                    SetConfigFilterProperty<mfxU32>(
+                        loader,
+                        cfg,
+                        "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc."
+                        "ColorFormats",
+                        encMemDesc->ColorFormats[f]);
+
+                    EXPECT_TRUE(IsImplAvailable(loader));
+                    numDescriptions++;
+                }
+            }
+        }
+    }
+    EXPECT_GT(numDescriptions, 0u);
+
+    // AVC baseline and I010 are both supported, but not together
+    SetConfigFilterProperty<mfxU32>(loader,
+                                    cfg,
+                                    "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+                                    MFX_CODEC_AVC);
+    SetConfigFilterProperty<mfxU32>(
+        loader,
+        cfg,
+        "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.Profile",
+        MFX_PROFILE_AVC_BASELINE);
+    SetConfigFilterProperty<mfxU32>(
+        loader,
+        cfg,
+        "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.ColorFormats",
+        MFX_FOURCC_I010);
+    EXPECT_FALSE(IsImplAvailable(loader));
+
+    // color format which is not supported by any encoder
+    SetConfigFilterProperty<mfxU32>(
+        loader,
+        cfg,
+        "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.ColorFormats",
+        MFX_FOURCC_Y416);
+    EXPECT_FALSE(IsImplAvailable(loader));
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_CapsIndex, KeywordsMatchAllTokens) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxVariant keywords;
+    keywords.Version.Version = MFX_VARIANT_VERSION;
+    keywords.Type            = MFX_VARIANT_TYPE_PTR;
+
+    keywords.Data.Ptr = (mfxHDL) "Stub,VPL";
+    sts = MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.Keywords", keywords);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_TRUE(IsImplAvailable(loader));
+
+    // trailing separator does not add an empty token
+    keywords.Data.Ptr = (mfxHDL) "Stub,";
+    sts = MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.Keywords", keywords);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_TRUE(IsImplAvailable(loader));
+
+    // partial token does not match
+    keywords.Data.Ptr = (mfxHDL) "Stu";
+    sts = MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.Keywords", keywords);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_FALSE(IsImplAvailable(loader));
+
+    MFXUnload(loader);
+}
@@ -2519,3 +2519,48 @@ TEST(Dispatcher_Common_Logger, LogDisabledReturnsNoMessages) {
 #endif
     CleanupOutputLog();
 }
+
+// create and close a stub session with the dispatcher log in trace mode (logValue)
+static void CreateSessionWithTraceLog(const char *logValue) {
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    SetEnv("ONEVPL_DISPATCHER_LOG", logValue);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_NE(session, nullptr);
+
+    sts = MFXClose(session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // trace is written when the loader is unloaded
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Common_Logger, TraceLogReturnsMessagesAtUnload) {
+    CreateSessionWithTraceLog("TRACE");
+
+    CheckOutputLog("[thread 0] function: ", true);
+    CheckOutputLog("MFXCreateSession", true);
+    CheckOutputLog("(return)", true);
+    CheckOutputLog("message:  low latency mode disabled", true);
+    CleanupOutputLog();
+}
+
+TEST(Dispatcher_Common_Logger, TraceJsonLogReturnsTraceEvents) {
+    CreateSessionWithTraceLog("TRACE_JSON");
+
+    CheckOutputLog("{\"traceEvents\":[", true);
+    CheckOutputLog("\"ph\":\"B\"", true);
+    CheckOutputLog("\"ph\":\"E\"", true);
+    CheckOutputLog("\"msg\":\"message:  low latency mode disabled\"", true);
+    CheckOutputLog("\"otherData\":{\"dropped\":0}}", true);
+    CleanupOutputLog();
+}
@@ -59,9 +59,42 @@ void CaptureOutputLog(CaptureLogType type);
 // set expectMatch to false to check that expectedString is NOT in the log
 void CheckOutputLog(const char *expectedString, bool expectMatch = true);
 
+// return whether expectedString is found in the captured log, without checking the result
+bool FindOutputLog(const char *expectedString);
+
 // delete log files, reset log type, reset cout
 void CleanupOutputLog(void);
 
+// set environment variable, or remove it if value is nullptr
+void SetEnv(const char *name, const char *value);
+
+// VendorImplID of each implementation which passes the filters, in index order
+std::vector<mfxU32> GetValidVendorImplIDs(mfxLoader loader);
+
+// returns true if at least one implementation passes all filters
+// descriptor is not released, since that would exclude the implementation from later filtering
+bool IsImplAvailable(mfxLoader loader);
+
+// return full path of the stub runtime found by the normal directory search
+std::string GetStubLibPath();
+
+// write manifest with the given lines and point ONEVPL_MANIFEST to it
+void EnableManifest(const std::vector<std::string> &lines);
+
+// delete manifest and unset ONEVPL_MANIFEST
+void DisableManifest();
+
+// return full paths of all implementations enumerated by a new loader, in enumeration order
+std::vector<std::string> GetImplPaths();
+
+#if !defined(_WIN32) && !defined(_WIN64)
+// point XDG_CACHE_HOME to a clean directory and enable caps cache
+void EnableCapsCache(std::string &cacheDir);
+
+// remove cache files and restore environment
+void DisableCapsCache(const std::string &cacheDir);
+#endif
+
 // helper functions for testing string API, C-style alloc/free to illustrate possible FFmpeg integration
 mfxStatus AllocateExtBuf(mfxVideoParam &par,
                          std::vector<mfxExtBuffer *> &extBufVector,
@@ -0,0 +1,152 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for Linux DRM device topology (src/linux/device_ids.h).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    #include <unistd.h>
+
+    #include "src/dispatcher_common.h"
+    #include "src/linux/device_ids.h"
+
+    #define FAKE_SYSFS_TEST_DIR "utestSysfs"
+
+// write one attribute of a fake render node
+static void WriteAttr(const std::string &nodeDir, const char *attr, const char *value) {
+    std::ofstream attrFile(nodeDir + "/device/" + attr);
+    attrFile << value << "\n";
+}
+
+// add renderDN to fake sysfs tree under root/class/drm
+static std::string AddRenderNode(const std::string &root,
+                                 unsigned int node,
+                                 const char *vendor,
+                                 const char *device) {
+    std::string nodeDir = root + "/class/drm/renderD" + std::to_string(node);
+    mkdir(nodeDir.c_str(), 0700);
+    mkdir((nodeDir + "/device").c_str(), 0700);
+
+    WriteAttr(nodeDir, "vendor", vendor);
+    WriteAttr(nodeDir, "device", device);
+
+    return nodeDir;
+}
+
+// recursively delete fake sysfs tree
+static void RemoveTree(const std::string &path) {
+    DIR *pSearchDir = opendir(path.c_str());
+    if (pSearchDir) {
+        struct dirent *currFile;
+        while ((currFile = readdir(pSearchDir)) != NULL) {
+            std::string fileName = currFile->d_name;
+            if (fileName != "." && fileName != "..")
+                RemoveTree(path + PATH_SEPARATOR + fileName);
+        }
+        closedir(pSearchDir);
+        rmdir(path.c_str());
+    }
+    else {
+        std::remove(path.c_str());
+    }
+}
+
+static std::string CreateFakeSysfs() {
+    char cwd[PATH_MAX] = "";
+    EXPECT_NE(getcwd(cwd, sizeof(cwd)), nullptr);
+
+    std::string root = std::string(cwd) + PATH_SEPARATOR + FAKE_SYSFS_TEST_DIR;
+    RemoveTree(root);
+
+    mkdir(root.c_str(), 0700);
+    mkdir((root + "/class").c_str(), 0700);
+    mkdir((root + "/class/drm").c_str(), 0700);
+
+    return root;
+}
+
+TEST(Dispatcher_DeviceIDs, EnumeratesRenderNodesFromSysfsRoot) {
+    std::string root = CreateFakeSysfs();
+
+    // unknown (new) Intel device with all optional attributes
+    std::string nodeDir = AddRenderNode(root, 129, "0x8086", "0xffff");
+    WriteAttr(nodeDir, "revision", "0x04");
+    WriteAttr(nodeDir, "numa_node", "1");
+    WriteAttr(nodeDir, "uevent", "DRIVER=i915\nPCI_SLOT_NAME=0000:03:00.0");
+
+    // known Intel device (EHL), no optional attributes
+    AddRenderNode(root, 128, "0x8086", "0x4500");
+
+    // non-Intel device and nodes which are not render nodes are ignored
+    AddRenderNode(root, 130, "0x1002", "0x73bf");
+    mkdir((root + "/class/drm/card0").c_str(), 0700);
+    mkdir((root + "/class/drm/renderD").c_str(), 0700);
+
+    // Intel render node with an out-of-range node number is skipped
+    std::string bigDir = root + "/class/drm/renderD99999999999999999999";
+    mkdir(bigDir.c_str(), 0700);
+    mkdir((bigDir + "/device").c_str(), 0700);
+    WriteAttr(bigDir, "vendor", "0x8086");
+    WriteAttr(bigDir, "device", "0x4500");
+
+    std::vector<Device> devices;
+    mfxStatus sts = get_devices(devices, root);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_EQ(devices.size(), 2u);
+
+    // unknown platform is sorted first
+    EXPECT_EQ(devices[0].render_node, 129u);
+    EXPECT_EQ(devices[0].vendor_id, 0x8086u);
+    EXPECT_EQ(devices[0].device_id, 0xffffu);
+    EXPECT_EQ(devices[0].platform, MFX_HW_UNKNOWN);
+    EXPECT_EQ(devices[0].revision, 0x04u);
+    EXPECT_EQ(devices[0].numa_node, 1);
+    EXPECT_EQ(devices[0].pci_bdf, "0000:03:00.0");
+
+    EXPECT_EQ(devices[1].render_node, 128u);
+    EXPECT_EQ(devices[1].device_id, 0x4500u);
+    EXPECT_EQ(devices[1].platform, MFX_HW_EHL);
+    EXPECT_EQ(devices[1].revision, 0u);
+    EXPECT_EQ(devices[1].numa_node, -1);
+    EXPECT_EQ(devices[1].pci_bdf, "");
+
+    RemoveTree(root);
+}
+
+TEST(Dispatcher_DeviceIDs, EmptySysfsRootReturnsNotFound) {
+    std::string root = CreateFakeSysfs();
+
+    std::vector<Device> devices;
+    mfxStatus sts = get_devices(devices, root);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+    EXPECT_TRUE(devices.empty());
+
+    sts = get_devices(devices, root + "/missing");
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    RemoveTree(root);
+}
+
+TEST(Dispatcher_DeviceIDs, PlatformLookupMatchesTable) {
+    for (const auto &item : listLegalDevIDs) {
+        // first entry wins if a device_id is listed more than once
+        const mfx_device_item *first = std::find_if(std::begin(listLegalDevIDs),
+                                                    std::end(listLegalDevIDs),
+                                                    [&item](const mfx_device_item &other) {
+                                                        return other.device_id == item.device_id;
+                                                    });
+        EXPECT_EQ(get_platform(item.device_id), first->platform);
+    }
+
+    EXPECT_EQ(get_platform(0), MFX_HW_UNKNOWN);
+    EXPECT_EQ(get_platform(0xffff), MFX_HW_UNKNOWN);
+}
+
+#endif
@@ -0,0 +1,459 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for the check of runtime exports from the ELF symbol table (ONEVPL_EXPORT_CHECK).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/dispatcher_common.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    #include <dlfcn.h>
+    #include <elf.h>
+    #include <link.h>
+
+    // ElfExportsVPL is built into the tests from the dispatcher sources
+    #include "src/mfx_dispatcher_vpl.h"
+
+    #define ELF_TEST_FILE "utestElf.so"
+
+// return full path of the dispatcher library, which is a shared library
+//   that does not export the functions required for a runtime
+static std::string GetDispatcherLibPath() {
+    Dl_info info = {};
+    if (!dladdr(reinterpret_cast<void *>(&MFXLoad), &info) || !info.dli_fname)
+        return "";
+
+    return info.dli_fname;
+}
+
+static std::vector<char> ReadImage(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+
+    return std::vector<char>(std::istreambuf_iterator<char>(file),
+                             std::istreambuf_iterator<char>());
+}
+
+// write image to a file and check if it exports function name
+// whatever the image contains, this must not crash
+static mfxStatus CheckImage(const std::vector<char> &image, const char *name, bool *bFound) {
+    std::ofstream file(ELF_TEST_FILE, std::ios::binary | std::ios::trunc);
+    file.write(image.data(), image.size());
+    file.close();
+
+    ElfExportsVPL elfExports;
+    mfxStatus sts = elfExports.Open(ELF_TEST_FILE);
+    *bFound       = elfExports.HasFunction(name);
+    elfExports.Close();
+
+    std::remove(ELF_TEST_FILE);
+
+    return sts;
+}
+
+static ElfW(Ehdr) * GetEhdr(std::vector<char> &image) {
+    return reinterpret_cast<ElfW(Ehdr) *>(image.data());
+}
+
+// return first program header of the given type, or nullptr if not found
+static ElfW(Phdr) * GetPhdr(std::vector<char> &image, ElfW(Word) type) {
+    ElfW(Ehdr) *ehdr = GetEhdr(image);
+    ElfW(Phdr) *phdr = reinterpret_cast<ElfW(Phdr) *>(image.data() + ehdr->e_phoff);
+
+    for (mfxU32 i = 0; i < ehdr->e_phnum; i++) {
+        if (phdr[i].p_type == type)
+            return &phdr[i];
+    }
+
+    return nullptr;
+}
+
+// return entry of the dynamic section with the given tag, or nullptr if not found
+static ElfW(Dyn) * GetDyn(std::vector<char> &image, ElfW(Sxword) tag) {
+    ElfW(Phdr) *phdr = GetPhdr(image, PT_DYNAMIC);
+    if (!phdr)
+        return nullptr;
+
+    ElfW(Dyn) *dyn = reinterpret_cast<ElfW(Dyn) *>(image.data() + phdr->p_offset);
+    for (size_t i = 0; i < phdr->p_filesz / sizeof(ElfW(Dyn)) && dyn[i].d_tag != DT_NULL; i++) {
+        if (dyn[i].d_tag == tag)
+            return &dyn[i];
+    }
+
+    return nullptr;
+}
+
+// return table at the address in the dynamic section entry with the given tag
+static mfxU32 *GetTable(std::vector<char> &image, ElfW(Sxword) tag) {
+    ElfW(Dyn) *dyn = GetDyn(image, tag);
+    if (!dyn)
+        return nullptr;
+
+    ElfW(Ehdr) *ehdr = GetEhdr(image);
+    ElfW(Phdr) *phdr = reinterpret_cast<ElfW(Phdr) *>(image.data() + ehdr->e_phoff);
+    ElfW(Addr) addr  = dyn->d_un.d_ptr;
+
+    for (mfxU32 i = 0; i < ehdr->e_phnum; i++) {
+        if (phdr[i].p_type == PT_LOAD && addr >= phdr[i].p_vaddr &&
+            addr - phdr[i].p_vaddr < phdr[i].p_filesz)
+            return reinterpret_cast<mfxU32 *>(image.data() + phdr[i].p_offset +
+                                              (addr - phdr[i].p_vaddr));
+    }
+
+    return nullptr;
+}
+
+TEST(Dispatcher_ElfExports, RuntimeExportsAreFound) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string stubPath = GetStubLibPath();
+    ASSERT_FALSE(stubPath.empty());
+
+    ElfExportsVPL elfExports;
+    ASSERT_EQ(elfExports.Open(stubPath), MFX_ERR_NONE);
+
+    EXPECT_TRUE(elfExports.HasFunction("MFXInitialize"));
+    EXPECT_TRUE(elfExports.HasFunction("MFXQueryImplsDescription"));
+    EXPECT_FALSE(elfExports.HasFunction("MFXNotAFunction"));
+    EXPECT_FALSE(elfExports.HasFunction(""));
+
+    // not mapped any more
+    elfExports.Close();
+    EXPECT_FALSE(elfExports.HasFunction("MFXInitialize"));
+}
+
+TEST(Dispatcher_ElfExports, SysvHashOnlyLibraryIsParsed) {
+    std::vector<char> image = ReadImage(ELF_TEST_SYSV_HASH_LIB);
+    ASSERT_GE(image.size(), sizeof(ElfW(Ehdr)));
+
+    // symbols are only looked up with the SysV hash table if there is no GNU hash table
+    ASSERT_NE(GetDyn(image, DT_HASH), nullptr);
+    ASSERT_EQ(GetDyn(image, DT_GNU_HASH), nullptr);
+
+    ElfExportsVPL elfExports;
+    ASSERT_EQ(elfExports.Open(ELF_TEST_SYSV_HASH_LIB), MFX_ERR_NONE);
+
+    EXPECT_TRUE(elfExports.HasFunction("ElfTestFunction"));
+    EXPECT_FALSE(elfExports.HasFunction("ElfTestHiddenFunction"));
+    EXPECT_FALSE(elfExports.HasFunction("ElfTestVariable"));
+    EXPECT_FALSE(elfExports.HasFunction("MFXInitialize"));
+}
+
+TEST(Dispatcher_ElfExports, TruncatedImageIsRejected) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string stubPath = GetStubLibPath();
+    ASSERT_FALSE(stubPath.empty());
+
+    const std::pair<std::string, const char *> libs[] = {
+        { stubPath, "MFXInitialize" },
+        { ELF_TEST_SYSV_HASH_LIB, "ElfTestFunction" },
+    };
+
+    for (const auto &lib : libs) {
+        std::vector<char> image = ReadImage(lib.first);
+        ASSERT_GE(image.size(), sizeof(ElfW(Ehdr)));
+
+        ElfW(Ehdr) *ehdr = GetEhdr(image);
+        size_t phdrEnd   = ehdr->e_phoff + ehdr->e_phnum * sizeof(ElfW(Phdr));
+
+        // the whole library is a few pages, so it is cut at every 256 bytes
+        std::vector<size_t> sizes = { 0, 1, SELFMAG, sizeof(ElfW(Ehdr)) - 1, phdrEnd - 1 };
+        for (size_t size = 256; size < image.size(); size += 256)
+            sizes.push_back(size);
+
+        for (auto size : sizes) {
+            std::vector<char> truncated(image.begin(), image.begin() + size);
+
+            bool bFound   = false;
+            mfxStatus sts = CheckImage(truncated, lib.second, &bFound);
+            if (size < phdrEnd) {
+                EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED) << lib.first << ", size " << size;
+            }
+            if (sts != MFX_ERR_NONE) {
+                EXPECT_FALSE(bFound) << lib.first << ", size " << size;
+            }
+        }
+    }
+}
+
+TEST(Dispatcher_ElfExports, CorruptedHeadersAreRejected) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string stubPath = GetStubLibPath();
+    ASSERT_FALSE(stubPath.empty());
+
+    std::vector<char> image = ReadImage(stubPath);
+    ASSERT_GE(image.size(), sizeof(ElfW(Ehdr)));
+    ASSERT_NE(GetDyn(image, DT_SYMENT), nullptr);
+    ASSERT_NE(GetDyn(image, DT_GNU_HASH), nullptr);
+    ASSERT_EQ(GetDyn(image, DT_HASH), nullptr);
+
+    size_t imageSize = image.size();
+
+    const std::vector<void (*)(std::vector<char> &)> corruptions = {
+        [](std::vector<char> &image) {
+            GetEhdr(image)->e_ident[EI_MAG1] = 'X';
+        },
+        [](std::vector<char> &image) {
+            // other ELF class
+            GetEhdr(image)->e_ident[EI_CLASS] ^= (ELFCLASS32 ^ ELFCLASS64);
+        },
+        [](std::vector<char> &image) {
+            GetEhdr(image)->e_type = ET_EXEC;
+        },
+        [](std::vector<char> &image) {
+            GetEhdr(image)->e_phentsize = 0;
+        },
+        [](std::vector<char> &image) {
+            GetEhdr(image)->e_phoff = image.size();
+        },
+        [](std::vector<char> &image) {
+            GetEhdr(image)->e_phoff += 1;
+        },
+        [](std::vector<char> &image) {
+            GetEhdr(image)->e_phnum = 0xFFFF;
+        },
+        [](std::vector<char> &image) {
+            GetPhdr(image, PT_DYNAMIC)->p_type = PT_NULL;
+        },
+        [](std::vector<char> &image) {
+            GetPhdr(image, PT_DYNAMIC)->p_offset = image.size();
+        },
+        [](std::vector<char> &image) {
+            GetPhdr(image, PT_DYNAMIC)->p_filesz = image.size();
+        },
+        [](std::vector<char> &image) {
+            GetDyn(image, DT_SYMENT)->d_un.d_val = 0;
+        },
+        [](std::vector<char> &image) {
+            GetDyn(image, DT_STRSZ)->d_un.d_val = image.size();
+        },
+        [](std::vector<char> &image) {
+            GetDyn(image, DT_SYMTAB)->d_un.d_ptr = ~(ElfW(Addr))0;
+        },
+        [](std::vector<char> &image) {
+            GetDyn(image, DT_STRTAB)->d_un.d_ptr = ~(ElfW(Addr))0;
+        },
+        [](std::vector<char> &image) {
+            // without a hash table the number of symbols is not known
+            GetDyn(image, DT_GNU_HASH)->d_tag = DT_DEBUG;
+        },
+    };
+
+    for (size_t i = 0; i < corruptions.size(); i++) {
+        std::vector<char> corrupted = image;
+        corruptions[i](corrupted);
+        ASSERT_EQ(corrupted.size(), imageSize);
+
+        bool bFound   = true;
+        mfxStatus sts = CheckImage(corrupted, "MFXInitialize", &bFound);
+        EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED) << "corruption " << i;
+        EXPECT_FALSE(bFound) << "corruption " << i;
+    }
+}
+
+TEST(Dispatcher_ElfExports, CorruptedGnuHashTableIsNotFollowed) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string stubPath = GetStubLibPath();
+    ASSERT_FALSE(stubPath.empty());
+
+    std::vector<char> image = ReadImage(stubPath);
+    ASSERT_GE(image.size(), sizeof(ElfW(Ehdr)));
+
+    mfxU32 *gnuHash = GetTable(image, DT_GNU_HASH);
+    mfxU32 *symTab  = GetTable(image, DT_SYMTAB);
+    ASSERT_NE(gnuHash, nullptr);
+    ASSERT_NE(symTab, nullptr);
+
+    // header: nbuckets, symoffset, bloom size, bloom shift
+    mfxU32 numBuckets     = gnuHash[0];
+    mfxU32 bloomSize      = gnuHash[2];
+    size_t gnuHashOffset  = reinterpret_cast<char *>(gnuHash) - image.data();
+    size_t bloomOffset    = gnuHashOffset + 4 * sizeof(mfxU32);
+    size_t bucketsOffset  = bloomOffset + bloomSize * sizeof(ElfW(Addr));
+    size_t chainOffset    = bucketsOffset + numBuckets * sizeof(mfxU32);
+    size_t symTabOffset   = reinterpret_cast<char *>(symTab) - image.data();
+    const mfxU32 hugeSize = 0xFFFFFFFF;
+
+    // linker puts the symbol table right after the hash table
+    ASSERT_GT(symTabOffset, chainOffset);
+
+    bool bFound   = false;
+    mfxStatus sts = CheckImage(image, "MFXInitialize", &bFound);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_TRUE(bFound);
+
+    for (mfxU32 field : { 0, 2 }) {
+        for (mfxU32 value : { (mfxU32)0, hugeSize }) {
+            std::vector<char> corrupted = image;
+            memcpy(&corrupted[gnuHashOffset + field * sizeof(mfxU32)], &value, sizeof(value));
+
+            sts = CheckImage(corrupted, "MFXInitialize", &bFound);
+            EXPECT_EQ(sts, MFX_ERR_NONE);
+            EXPECT_FALSE(bFound) << "field " << field << ", value " << value;
+        }
+    }
+
+    // bloom filter passes every name, and buckets point to symbols past the end of the file
+    std::vector<char> corrupted = image;
+    memset(&corrupted[bloomOffset], 0xFF, bucketsOffset - bloomOffset);
+    for (size_t offset = bucketsOffset; offset < chainOffset; offset += sizeof(mfxU32))
+        memcpy(&corrupted[offset], &hugeSize, sizeof(hugeSize));
+
+    sts = CheckImage(corrupted, "MFXInitialize", &bFound);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_FALSE(bFound);
+
+    // chain entries do not match the name and have no end marker, so the lookup continues
+    //   into the tables which follow, but not past the end of the file
+    corrupted = image;
+    memset(&corrupted[bloomOffset], 0xFF, bucketsOffset - bloomOffset);
+    memset(&corrupted[chainOffset], 0, symTabOffset - chainOffset);
+
+    sts = CheckImage(corrupted, "MFXInitialize", &bFound);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_FALSE(bFound);
+}
+
+TEST(Dispatcher_ElfExports, CorruptedSysvHashTableIsNotFollowed) {
+    std::vector<char> image = ReadImage(ELF_TEST_SYSV_HASH_LIB);
+    ASSERT_GE(image.size(), sizeof(ElfW(Ehdr)));
+
+    mfxU32 *sysvHash = GetTable(image, DT_HASH);
+    ASSERT_NE(sysvHash, nullptr);
+
+    // header: nbucket, nchain
+    mfxU32 numBuckets     = sysvHash[0];
+    mfxU32 numChain       = sysvHash[1];
+    size_t sysvHashOffset = reinterpret_cast<char *>(sysvHash) - image.data();
+    size_t bucketsOffset  = sysvHashOffset + 2 * sizeof(mfxU32);
+    size_t chainOffset    = bucketsOffset + numBuckets * sizeof(mfxU32);
+
+    for (mfxU32 field : { 0, 1 }) {
+        std::vector<char> corrupted = image;
+        mfxU32 value                = 0xFFFFFFFF;
+        memcpy(&corrupted[sysvHashOffset + field * sizeof(mfxU32)], &value, sizeof(value));
+
+        bool bFound   = false;
+        mfxStatus sts = CheckImage(corrupted, "ElfTestFunction", &bFound);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+        EXPECT_FALSE(bFound) << "field " << field;
+    }
+
+    // every chain is a loop, so the lookup of a name which is not defined stops after nchain steps
+    std::vector<char> corrupted = image;
+    for (mfxU32 i = 0; i < numChain; i++)
+        memcpy(&corrupted[chainOffset + i * sizeof(mfxU32)], &i, sizeof(i));
+
+    bool bFound   = false;
+    mfxStatus sts = CheckImage(corrupted, "MFXInitialize", &bFound);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_FALSE(bFound);
+}
+
+TEST(Dispatcher_ElfExports, RandomlyCorruptedImageDoesNotCrash) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string stubPath = GetStubLibPath();
+    ASSERT_FALSE(stubPath.empty());
+
+    std::vector<char> image = ReadImage(stubPath);
+    ASSERT_GE(image.size(), sizeof(ElfW(Ehdr)));
+
+    // bytes are changed in the first loadable segment, which contains the ELF headers and the
+    //   symbol, string, and hash tables, and in the dynamic section
+    ElfW(Phdr) *loadPhdr = GetPhdr(image, PT_LOAD);
+    ElfW(Phdr) *dynPhdr  = GetPhdr(image, PT_DYNAMIC);
+    ASSERT_NE(loadPhdr, nullptr);
+    ASSERT_NE(dynPhdr, nullptr);
+
+    size_t loadSize  = std::min((size_t)loadPhdr->p_filesz, image.size());
+    size_t dynOffset = dynPhdr->p_offset;
+    size_t dynSize   = dynPhdr->p_filesz;
+    ASSERT_LE(dynOffset + dynSize, image.size());
+
+    // fixed seed, so that a failure can be reproduced
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<size_t> position(0, loadSize + dynSize - 1);
+
+    for (mfxU32 i = 0; i < 500; i++) {
+        std::vector<char> corrupted = image;
+        for (mfxU32 j = 0; j < 8; j++) {
+            size_t offset = position(rng);
+            if (offset >= loadSize)
+                offset = dynOffset + (offset - loadSize);
+            corrupted[offset] = (char)rng();
+        }
+
+        bool bFound = false;
+        CheckImage(corrupted, "MFXInitialize", &bFound);
+    }
+}
+
+TEST(Dispatcher_ElfExports, RuntimeWithoutExportsIsNotLoaded) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string stubPath = GetStubLibPath();
+    ASSERT_FALSE(stubPath.empty());
+
+    std::string dispPath = GetDispatcherLibPath();
+    ASSERT_FALSE(dispPath.empty());
+
+    EnableManifest({ "1 " + dispPath, "2 " + stubPath });
+
+    // exports of the dispatcher are read from its symbol table, without loading it again
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    std::vector<std::string> implPaths = GetImplPaths();
+    CheckOutputLog(("required exports not found, not loaded -- " + dispPath).c_str());
+    CleanupOutputLog();
+
+    EXPECT_FALSE(implPaths.empty());
+    for (const auto &implPath : implPaths)
+        EXPECT_EQ(implPath, stubPath);
+
+    DisableManifest();
+}
+
+TEST(Dispatcher_ElfExports, ExportCheckCanBeDisabled) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string stubPath = GetStubLibPath();
+    ASSERT_FALSE(stubPath.empty());
+
+    std::string dispPath = GetDispatcherLibPath();
+    ASSERT_FALSE(dispPath.empty());
+
+    EnableManifest({ "1 " + dispPath, "2 " + stubPath });
+    SetEnv("ONEVPL_EXPORT_CHECK", "OFF");
+
+    // dispatcher is loaded and rejected after checking its exports with dlsym()
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    std::vector<std::string> implPaths = GetImplPaths();
+    CheckOutputLog("required exports not found", false);
+    CleanupOutputLog();
+
+    EXPECT_FALSE(implPaths.empty());
+    for (const auto &implPath : implPaths)
+        EXPECT_EQ(implPath, stubPath);
+
+    SetEnv("ONEVPL_EXPORT_CHECK", nullptr);
+    DisableManifest();
+}
+
+#endif
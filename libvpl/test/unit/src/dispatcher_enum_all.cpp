@@ -0,0 +1,111 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for bulk enumeration (MFXEnumAllImplementations()).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+TEST(Dispatcher_Stub_EnumAll, ReturnsHandlesInIndexOrder) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("VPL_STUB_SYNTH", "impls=3");
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // query number of implementations
+    mfxU32 numImpls = 0;
+    sts = MFXEnumAllImplementations(loader, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, nullptr, &numImpls);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_EQ(numImpls, 3);
+
+    mfxHDL idescs[4] = {};
+    sts = MFXEnumAllImplementations(loader, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, idescs, &numImpls);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(numImpls, 3);
+
+    // same handles as enumerating one at a time
+    for (mfxU32 idx = 0; idx < numImpls; idx++) {
+        mfxHDL idesc = nullptr;
+        sts          = MFXEnumImplementations(loader, idx, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &idesc);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+        EXPECT_EQ(idesc, idescs[idx]);
+
+        EXPECT_EQ(reinterpret_cast<mfxImplDescription *>(idescs[idx])->VendorImplID, idx);
+    }
+
+    for (mfxU32 idx = 0; idx < numImpls; idx++) {
+        sts = MFXDispReleaseImplDescription(loader, idescs[idx]);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+    }
+
+    // unknown handle
+    sts = MFXDispReleaseImplDescription(loader, &numImpls);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_HANDLE);
+
+    MFXUnload(loader);
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+
+TEST(Dispatcher_Stub_EnumAll, SmallArrayReturnsNotEnoughBuffer) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("VPL_STUB_SYNTH", "impls=3");
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxHDL idescs[2] = {};
+    mfxU32 numImpls  = 2;
+    sts = MFXEnumAllImplementations(loader, MFX_IMPLCAPS_IMPLPATH, idescs, &numImpls);
+    EXPECT_EQ(sts, MFX_ERR_NOT_ENOUGH_BUFFER);
+    EXPECT_EQ(numImpls, 3);
+
+    MFXUnload(loader);
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+
+TEST(Dispatcher_Stub_EnumAll, FollowsFilterChanges) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxHDL idesc    = nullptr;
+    mfxU32 numImpls = 1;
+    sts = MFXEnumAllImplementations(loader, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &idesc, &numImpls);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(numImpls, 1);
+
+    // stub does not support this encoder, so no implementation is left
+    sts = SetConfigFilterProperty<mfxU32>(loader,
+                                          "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+                                          MFX_CODEC_JPEG);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXEnumAllImplementations(loader, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, nullptr, &numImpls);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    MFXUnload(loader);
+}
+#endif
@@ -0,0 +1,65 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for the session creation fast path (ONEVPL_SESSION_FAST_PATH).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+// create several sessions from one loader and check whether the fast path was used
+static void CreateStubSessions(bool bExpectFastPath) {
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    for (int i = 0; i < 3; i++) {
+        mfxSession session = nullptr;
+        sts                = MFXCreateSession(loader, 0, &session);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+
+        if (session) {
+            mfxIMPL impl = 0;
+            sts          = MFXQueryIMPL(session, &impl);
+            EXPECT_EQ(sts, MFX_ERR_NONE);
+
+            MFXClose(session);
+        }
+    }
+
+    MFXUnload(loader);
+
+    CheckOutputLog("session created with fast path", bExpectFastPath);
+    CleanupOutputLog();
+}
+
+TEST(Dispatcher_Stub_CreateSession, FastPathReusesLoadedRuntime) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+#if defined(_WIN32) || defined(_WIN64)
+    // fast path is only implemented on Linux
+    CreateStubSessions(false);
+#else
+    CreateStubSessions(true);
+#endif
+}
+
+TEST(Dispatcher_Stub_CreateSession, FastPathDisabledByEnvVar) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("ONEVPL_SESSION_FAST_PATH", "OFF");
+
+    CreateStubSessions(false);
+
+    SetEnv("ONEVPL_SESSION_FAST_PATH", nullptr);
+}
@@ -0,0 +1,283 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for comparison and alternative filters (MFXSetConfigFilterPropertyOp(), MFXCreateConfigAlternative()).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+static mfxVariant MakeVariantU32(mfxU32 value) {
+    mfxVariant var      = {};
+    var.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_U32;
+    var.Data.U32        = value;
+
+    return var;
+}
+
+TEST(Dispatcher_Stub_FilterOp, ComparisonsSelectImplementations) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("VPL_STUB_SYNTH", "impls=3");
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg            = MFXCreateConfig(loader);
+    const mfxU8 *propName    = (const mfxU8 *)"mfxImplDescription.VendorImplID";
+    mfxVariant setValues[2]  = { MakeVariantU32(0), MakeVariantU32(2) };
+    mfxVariant rangeValues[] = { MakeVariantU32(0), MakeVariantU32(1) };
+
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_IN_SET, setValues, 2);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(GetValidVendorImplIDs(loader), std::vector<mfxU32>({ 0, 2 }));
+
+    // each call replaces the comparison of the property
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_NOT_EQUAL, setValues, 1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(GetValidVendorImplIDs(loader), std::vector<mfxU32>({ 1, 2 }));
+
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_RANGE, rangeValues, 2);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(GetValidVendorImplIDs(loader), std::vector<mfxU32>({ 0, 1 }));
+
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_NOT_IN_SET, setValues, 2);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(GetValidVendorImplIDs(loader), std::vector<mfxU32>({ 1 }));
+
+    // single value, same as MFXSetConfigFilterProperty()
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_EQUAL, &setValues[1], 1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(GetValidVendorImplIDs(loader), std::vector<mfxU32>({ 2 }));
+
+    MFXUnload(loader);
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+
+TEST(Dispatcher_Stub_FilterOp, CodecSetMatchesDescription) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // stub does not support JPEG encode, but does support HEVC
+    mfxConfig cfg = MFXCreateConfig(loader);
+    const mfxU8 *propName =
+        (const mfxU8 *)"mfxImplDescription.mfxEncoderDescription.encoder.CodecID";
+    mfxVariant codecs[2] = { MakeVariantU32(MFX_CODEC_JPEG), MakeVariantU32(MFX_CODEC_HEVC) };
+
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_IN_SET, codecs, 1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_TRUE(GetValidVendorImplIDs(loader).empty());
+
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_IN_SET, codecs, 2);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_FilterOp, InvalidParamsReturnErrors) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg         = MFXCreateConfig(loader);
+    const mfxU8 *propName = (const mfxU8 *)"mfxImplDescription.VendorImplID";
+    mfxVariant values[2]  = { MakeVariantU32(2), MakeVariantU32(1) };
+
+    mfxStatus sts =
+        MFXSetConfigFilterPropertyOp(nullptr, propName, MFX_FILTER_OP_IN_SET, values, 1);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXSetConfigFilterPropertyOp(cfg, nullptr, MFX_FILTER_OP_IN_SET, values, 1);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_IN_SET, nullptr, 1);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXSetConfigFilterPropertyOp(cfg,
+                                       (const mfxU8 *)"mfxImplDescription.Unknown",
+                                       MFX_FILTER_OP_IN_SET,
+                                       values,
+                                       1);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    // wrong number of values, or range in reverse order
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_NOT_EQUAL, values, 2);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_RANGE, values, 1);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_RANGE, values, 2);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_IN_SET, values, 0);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, (mfxConfigFilterOp)100, values, 1);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    // value type does not match property
+    mfxVariant valueU16      = {};
+    valueU16.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    valueU16.Type            = MFX_VARIANT_TYPE_U16;
+
+    sts = MFXSetConfigFilterPropertyOp(cfg, propName, MFX_FILTER_OP_IN_SET, &valueU16, 1);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    // properties which do not support comparisons
+    const char *unsupportedNames[] = {
+        "mfxImplDescription.AccelerationMode",
+        "mfxImplDescription.ApiVersion.Version",
+        "mfxImplDescription.mfxEncoderDescription.encoder.ReportedStats",
+        "NumThread",
+    };
+    for (const char *name : unsupportedNames) {
+        sts = MFXSetConfigFilterPropertyOp(cfg,
+                                           (const mfxU8 *)name,
+                                           MFX_FILTER_OP_NOT_EQUAL,
+                                           values,
+                                           1);
+        EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED) << name;
+    }
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_ConfigAlternative, ReportsMatchedAlternative) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("VPL_STUB_SYNTH", "impls=3");
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    const mfxU8 *propName = (const mfxU8 *)"mfxImplDescription.VendorImplID";
+
+    mfxConfig cfg  = MFXCreateConfig(loader);
+    mfxConfig alt0 = MFXCreateConfigAlternative(cfg);
+    mfxConfig alt1 = MFXCreateConfigAlternative(cfg);
+    ASSERT_FALSE(alt0 == nullptr);
+    ASSERT_FALSE(alt1 == nullptr);
+
+    sts = MFXSetConfigFilterProperty(alt0, propName, MakeVariantU32(2));
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXSetConfigFilterProperty(alt1, propName, MakeVariantU32(0));
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    EXPECT_EQ(GetValidVendorImplIDs(loader), std::vector<mfxU32>({ 0, 2 }));
+
+    mfxU32 alternative = 0;
+    sts                = MFXQueryConfigAlternative(loader, 0, cfg, &alternative);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(alternative, 1);
+
+    sts = MFXQueryConfigAlternative(loader, 1, cfg, &alternative);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(alternative, 0);
+
+    sts = MFXQueryConfigAlternative(loader, 2, cfg, &alternative);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    // properties of the config apply to every alternative
+    sts = MFXSetConfigFilterProperty(cfg, propName, MakeVariantU32(2));
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(GetValidVendorImplIDs(loader), std::vector<mfxU32>({ 2 }));
+
+    // changed alternative is checked again
+    sts = MFXSetConfigFilterProperty(alt0, propName, MakeVariantU32(1));
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_TRUE(GetValidVendorImplIDs(loader).empty());
+
+    // alternative with no properties matches every implementation
+    mfxConfig alt2 = MFXCreateConfigAlternative(cfg);
+    ASSERT_FALSE(alt2 == nullptr);
+
+    sts = MFXQueryConfigAlternative(loader, 0, cfg, &alternative);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(alternative, 2);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+
+TEST(Dispatcher_Stub_ConfigAlternative, InvalidParamsReturnErrors) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_TRUE(MFXCreateConfigAlternative(nullptr) == nullptr);
+
+    mfxU32 alternative = 0;
+    sts                = MFXQueryConfigAlternative(loader, 0, cfg, &alternative);
+    EXPECT_EQ(sts, MFX_ERR_NOT_INITIALIZED);
+
+    mfxConfig alt = MFXCreateConfigAlternative(cfg);
+    ASSERT_FALSE(alt == nullptr);
+
+    // alternatives are not nested
+    EXPECT_TRUE(MFXCreateConfigAlternative(alt) == nullptr);
+
+    // properties used to create the session are not allowed in alternatives
+    sts = MFXSetConfigFilterProperty(alt, (const mfxU8 *)"NumThread", MakeVariantU32(2));
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    sts = MFXSetConfigFilterProperty(alt,
+                                     (const mfxU8 *)"mfxImplDescription.AccelerationMode",
+                                     MakeVariantU32(MFX_ACCEL_MODE_NA));
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    sts = MFXQueryConfigAlternative(loader, 0, alt, &alternative);
+    EXPECT_EQ(sts, MFX_ERR_INVALID_HANDLE);
+
+    sts = MFXQueryConfigAlternative(loader, 0, cfg, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXQueryConfigAlternative(loader, 0, cfg, &alternative);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(alternative, 0);
+
+    MFXUnload(loader);
+}
+#endif
@@ -0,0 +1,120 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for batch filter properties (MFXSetConfigFilterProperties()).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+TEST(Dispatcher_Stub_SetConfigFilterProperties, AllPropertiesAreSet) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxConfigFilterProperty props[3] = {};
+    for (auto &prop : props) {
+        prop.Value.Version.Version = MFX_VARIANT_VERSION;
+        prop.Value.Type            = MFX_VARIANT_TYPE_U32;
+    }
+
+    // stub library is selected by ImplName, see SetConfigImpl()
+    props[0].Name           = (const mfxU8 *)"mfxImplDescription.ImplName";
+    props[0].Value.Type     = MFX_VARIANT_TYPE_PTR;
+    props[0].Value.Data.Ptr = (mfxHDL) "Stub Implementation";
+    props[1].Name           = (const mfxU8 *)"mfxImplDescription.VendorID";
+    props[1].Value.Data.U32 = 0x8086;
+    props[2].Name = (const mfxU8 *)"mfxImplDescription.mfxEncoderDescription.encoder.CodecID";
+    props[2].Value.Data.U32 = MFX_CODEC_HEVC;
+
+    mfxStatus propSts[3] = { MFX_ERR_UNKNOWN, MFX_ERR_UNKNOWN, MFX_ERR_UNKNOWN };
+
+    mfxStatus sts = MFXSetConfigFilterProperties(cfg, props, 3, propSts);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(propSts[0], MFX_ERR_NONE);
+    EXPECT_EQ(propSts[1], MFX_ERR_NONE);
+    EXPECT_EQ(propSts[2], MFX_ERR_NONE);
+    EXPECT_TRUE(IsImplAvailable(loader));
+
+    // propSts is optional
+    props[1].Value.Data.U32 = 0x1234;
+    sts                     = MFXSetConfigFilterProperties(cfg, props, 3, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_FALSE(IsImplAvailable(loader));
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_SetConfigFilterProperties, NothingIsSetIfAnyPropertyFails) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxConfigFilterProperty props[3] = {};
+    for (auto &prop : props) {
+        prop.Value.Version.Version = MFX_VARIANT_VERSION;
+        prop.Value.Type            = MFX_VARIANT_TYPE_U32;
+    }
+
+    // stub does not support VP9 encode, so the impl is only found if it is not set
+    props[0].Name = (const mfxU8 *)"mfxImplDescription.mfxEncoderDescription.encoder.CodecID";
+    props[0].Value.Data.U32 = MFX_CODEC_VP9;
+    props[1].Name           = (const mfxU8 *)"mfxImplDescription.NoSuchProperty";
+    props[1].Value.Data.U32 = 0;
+    props[2].Name           = (const mfxU8 *)"mfxImplDescription.ImplName";
+    props[2].Value.Data.U32 = 0;
+
+    mfxStatus propSts[3] = { MFX_ERR_UNKNOWN, MFX_ERR_UNKNOWN, MFX_ERR_UNKNOWN };
+
+    sts = MFXSetConfigFilterProperties(cfg, props, 3, propSts);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+    EXPECT_EQ(propSts[0], MFX_ERR_NONE);
+    EXPECT_EQ(propSts[1], MFX_ERR_NOT_FOUND);
+    EXPECT_EQ(propSts[2], MFX_ERR_UNSUPPORTED);
+    EXPECT_TRUE(IsImplAvailable(loader));
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_SetConfigFilterProperties, NullParamsReturnErrNull) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxConfigFilterProperty prop = {};
+
+    mfxStatus sts = MFXSetConfigFilterProperties(nullptr, &prop, 1, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXSetConfigFilterProperties(cfg, nullptr, 1, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    // NULL name in an entry
+    sts = MFXSetConfigFilterProperties(cfg, &prop, 1, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    MFXUnload(loader);
+}
+#endif // ONEVPL_EXPERIMENTAL
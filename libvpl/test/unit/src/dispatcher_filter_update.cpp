@@ -0,0 +1,59 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for filter re-validation after a filter change.
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+TEST(Dispatcher_Stub_FilterUpdate, RejectedImplIsCheckedAgainAfterFilterChange) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    // stub does not support VP9 encode
+    SetConfigFilterProperty<mfxU32>(loader,
+                                    cfg,
+                                    "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+                                    MFX_CODEC_VP9);
+    EXPECT_FALSE(IsImplAvailable(loader));
+
+    // same property in the same cfg object, now supported
+    SetConfigFilterProperty<mfxU32>(loader,
+                                    cfg,
+                                    "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+                                    MFX_CODEC_HEVC);
+    EXPECT_TRUE(IsImplAvailable(loader));
+
+    // other cfg objects are combined with the result already checked for cfg
+    mfxConfig cfg2 = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg2 == nullptr);
+
+    SetConfigFilterProperty<mfxU32>(loader, cfg2, "mfxImplDescription.VendorID", 0x1234);
+    EXPECT_FALSE(IsImplAvailable(loader));
+
+    SetConfigFilterProperty<mfxU32>(loader, cfg2, "mfxImplDescription.VendorID", 0x8086);
+    EXPECT_TRUE(IsImplAvailable(loader));
+
+    SetConfigFilterProperty<mfxU32>(loader,
+                                    cfg,
+                                    "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+                                    MFX_CODEC_VP9);
+    EXPECT_FALSE(IsImplAvailable(loader));
+
+    MFXUnload(loader);
+}
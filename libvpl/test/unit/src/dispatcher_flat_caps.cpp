@@ -0,0 +1,226 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for the flat caps format (MFXFindCapsFlatEntry()).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+TEST(Dispatcher_Stub_FlatCaps, EveryEncoderDescriptionIsFound) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplDescription *implDesc = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplCapsFlat *caps = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_FLAT, (mfxHDL *)&caps);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_NE(caps, nullptr);
+
+    EXPECT_EQ(caps->Version.Version, MFX_IMPLCAPSFLAT_VERSION);
+    EXPECT_EQ(caps->ApiVersion.Version, implDesc->ApiVersion.Version);
+    EXPECT_EQ(std::string(caps->ImplName), std::string(implDesc->ImplName));
+
+    // same descriptor is returned by later queries
+    mfxImplCapsFlat *caps2 = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_FLAT, (mfxHDL *)&caps2);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(caps, caps2);
+
+    mfxU32 numDescriptions = 0;
+    for (mfxU32 c = 0; c < implDesc->Enc.NumCodecs; c++) {
+        const auto *encCodec = &implDesc->Enc.Codecs[c];
+        for (mfxU32 p = 0; p < encCodec->NumProfiles; p++) {
+            const auto *encProfile = &encCodec->Profiles[p];
+            for (mfxU32 m = 0; m < encProfile->NumMemTypes; m++) {
+                const auto *encMemDesc = &encProfile->MemDesc[m];
+                for (mfxU32 f = 0; f < encMemDesc->NumColorFormats; f++) {
+                    mfxCapsFlatEntry query = {};
+                    query.ID               = encCodec->CodecID;
+                    query.Profile          = encProfile->Profile;
+                    query.MemHandleType    = encMemDesc->MemHandleType;
+                    query.Format           = encMemDesc->ColorFormats[f];
+                    query.Width.Max        = encMemDesc->Width.Max;
+                    query.Height.Max       = encMemDesc->Height.Max;
+
+                    const mfxCapsFlatEntry *entry = nullptr;
+                    sts = MFXFindCapsFlatEntry(caps, &caps->Enc, &query, &entry);
+                    EXPECT_EQ(sts, MFX_ERR_NONE);
+                    if (entry) {
+                        EXPECT_EQ(entry->MaxcodecLevel, encCodec->MaxcodecLevel);
+                    }
+
+                    numDescriptions++;
+                }
+            }
+        }
+    }
+    EXPECT_GT(numDescriptions, 0u);
+    EXPECT_EQ(caps->Enc.NumEntries, numDescriptions);
+
+    // tables are sorted by ID
+    const mfxCapsFlatEntry *encTable =
+        (const mfxCapsFlatEntry *)((const mfxU8 *)caps + caps->Enc.Offset);
+    for (mfxU32 i = 1; i < caps->Enc.NumEntries; i++)
+        EXPECT_LE(encTable[i - 1].ID, encTable[i].ID);
+
+    sts = MFXDispReleaseImplDescription(loader, caps);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXDispReleaseImplDescription(loader, implDesc);
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_FlatCaps, CopyOfDescriptorCanBeSearched) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplCapsFlat *caps = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_FLAT, (mfxHDL *)&caps);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_NE(caps, nullptr);
+
+    // descriptor has no pointers, so a copy is usable after the loader is unloaded
+    std::vector<mfxU64> buf((caps->Size + 7) / 8);
+    memcpy(buf.data(), caps, caps->Size);
+    MFXUnload(loader);
+
+    mfxImplCapsFlat *capsCopy     = (mfxImplCapsFlat *)buf.data();
+    const mfxCapsFlatEntry *entry = nullptr;
+
+    // HEVC SCC is only supported with I010, at up to 4096x4096
+    mfxCapsFlatEntry query = {};
+    query.ID               = MFX_CODEC_HEVC;
+    query.Profile          = MFX_PROFILE_HEVC_SCC;
+    query.MemHandleType    = MFX_RESOURCE_SYSTEM_SURFACE;
+    query.Width.Max        = 3840;
+    query.Height.Max       = 2160;
+    sts                    = MFXFindCapsFlatEntry(capsCopy, &capsCopy->Enc, &query, &entry);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->Format, (mfxU32)MFX_FOURCC_I010);
+
+    query.Width.Max  = 7680;
+    query.Height.Max = 4320;
+    sts              = MFXFindCapsFlatEntry(capsCopy, &capsCopy->Enc, &query, &entry);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+    EXPECT_EQ(entry, nullptr);
+
+    // any AVC profile with I010 - only main profile
+    query           = {};
+    query.ID        = MFX_CODEC_AVC;
+    query.Format    = MFX_FOURCC_I010;
+    sts             = MFXFindCapsFlatEntry(capsCopy, &capsCopy->Enc, &query, &entry);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->Profile, (mfxU32)MFX_PROFILE_AVC_MAIN);
+
+    // stub does not report any decoders
+    sts = MFXFindCapsFlatEntry(capsCopy, &capsCopy->Dec, &query, &entry);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    mfxCapsFlatTable otherTable = capsCopy->Enc;
+    sts = MFXFindCapsFlatEntry(capsCopy, &otherTable, &query, &entry);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    sts = MFXFindCapsFlatEntry(capsCopy, &capsCopy->Enc, nullptr, &entry);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+}
+
+TEST(Dispatcher_Stub_FlatCaps, EveryFilterDescriptionIsFound) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("VPL_STUB_SYNTH", "vpp=4, formats=3");
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplDescription *implDesc = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplCapsFlat *caps = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_FLAT, (mfxHDL *)&caps);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_NE(caps, nullptr);
+
+    mfxU32 numDescriptions = 0;
+    for (mfxU32 f = 0; f < implDesc->VPP.NumFilters; f++) {
+        const auto *filter = &implDesc->VPP.Filters[f];
+        for (mfxU32 m = 0; m < filter->NumMemTypes; m++) {
+            const auto *memDesc = &filter->MemDesc[m];
+            for (mfxU32 i = 0; i < memDesc->NumInFormats; i++) {
+                const auto *format = &memDesc->Formats[i];
+                for (mfxU32 o = 0; o < format->NumOutFormat; o++) {
+                    mfxCapsFlatEntry query = {};
+                    query.ID               = filter->FilterFourCC;
+                    query.MemHandleType    = memDesc->MemHandleType;
+                    query.Format           = format->InFormat;
+                    query.OutFormat        = format->OutFormats[o];
+
+                    const mfxCapsFlatEntry *entry = nullptr;
+                    sts = MFXFindCapsFlatEntry(caps, &caps->VPP, &query, &entry);
+                    EXPECT_EQ(sts, MFX_ERR_NONE);
+                    if (entry) {
+                        EXPECT_EQ(entry->ID, filter->FilterFourCC);
+                        EXPECT_EQ(entry->Format, format->InFormat);
+                        EXPECT_EQ(entry->OutFormat, format->OutFormats[o]);
+                    }
+
+                    numDescriptions++;
+                }
+            }
+        }
+    }
+    EXPECT_GT(numDescriptions, 0u);
+    EXPECT_EQ(caps->VPP.NumEntries, numDescriptions);
+
+    // VPP entries have no profile, so a query with a profile is not matched
+    const mfxCapsFlatEntry *vppTable =
+        (const mfxCapsFlatEntry *)((const mfxU8 *)caps + caps->VPP.Offset);
+    mfxCapsFlatEntry query        = vppTable[0];
+    query.Profile                 = MFX_PROFILE_AVC_MAIN;
+    const mfxCapsFlatEntry *entry = nullptr;
+    sts                           = MFXFindCapsFlatEntry(caps, &caps->VPP, &query, &entry);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    // VPP table is sorted by ID, MemHandleType, Format, OutFormat
+    for (mfxU32 i = 1; i < caps->VPP.NumEntries; i++) {
+        const mfxCapsFlatEntry &e1 = vppTable[i - 1];
+        const mfxCapsFlatEntry &e2 = vppTable[i];
+        EXPECT_TRUE(std::make_tuple(e1.ID, e1.MemHandleType, e1.Format, e1.OutFormat) <=
+                    std::make_tuple(e2.ID, e2.MemHandleType, e2.Format, e2.OutFormat));
+    }
+
+    MFXDispReleaseImplDescription(loader, caps);
+    MFXDispReleaseImplDescription(loader, implDesc);
+    MFXUnload(loader);
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+#endif // ONEVPL_EXPERIMENTAL
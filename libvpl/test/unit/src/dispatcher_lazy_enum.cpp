@@ -0,0 +1,64 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for lazy enumeration (ONEVPL_LAZY_ENUM).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+// create session with first stub implementation and return its name
+static void CreateStubSessionAndGetName(std::string &implName) {
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    mfxImplDescription *implDesc = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (implDesc) {
+        implName = implDesc->ImplName;
+        MFXDispReleaseImplDescription(loader, implDesc);
+    }
+
+    // only a single stub implementation is expected
+    sts = MFXEnumImplementations(loader, 1, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_EnumImpls, LazyEnumSelectsSameImplAsFullEnum) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string implNameFull, implNameLazy;
+    CreateStubSessionAndGetName(implNameFull);
+
+    SetEnv("ONEVPL_LAZY_ENUM", "ON");
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    CreateStubSessionAndGetName(implNameLazy);
+    CheckOutputLog("message:  lazy enumeration -- probing");
+    CleanupOutputLog();
+
+    SetEnv("ONEVPL_LAZY_ENUM", nullptr);
+
+    EXPECT_FALSE(implNameFull.empty());
+    EXPECT_EQ(implNameFull, implNameLazy);
+}
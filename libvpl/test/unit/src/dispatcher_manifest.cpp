@@ -0,0 +1,95 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for pinned-runtime manifest (ONEVPL_MANIFEST).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "src/dispatcher_common.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+TEST(Dispatcher_Stub_Manifest, OnlyListedRuntimesAreLoaded) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string stubPath = GetStubLibPath();
+    ASSERT_FALSE(stubPath.empty());
+
+    EnableManifest({ "# stub runtime only", "", "5 api=2.0 " + stubPath });
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+    std::vector<std::string> implPaths = GetImplPaths();
+    CheckOutputLog("message:  using manifest");
+    CleanupOutputLog();
+
+    EXPECT_FALSE(implPaths.empty());
+    for (const auto &implPath : implPaths)
+        EXPECT_EQ(implPath, stubPath);
+
+    DisableManifest();
+}
+
+TEST(Dispatcher_Stub_Manifest, RuntimeBelowMinApiVersionIsExcluded) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::string stubPath = GetStubLibPath();
+    ASSERT_FALSE(stubPath.empty());
+
+    EnableManifest({ "special api=99.0 " + stubPath });
+
+    std::vector<std::string> implPaths = GetImplPaths();
+    EXPECT_TRUE(implPaths.empty());
+
+    DisableManifest();
+}
+
+TEST(Dispatcher_Stub_Manifest, MissingRuntimeIsNotFound) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    EnableManifest({ "1 /nonexistent/libvpl-runtime.so" });
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxSession session = nullptr;
+    mfxStatus sts      = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    MFXUnload(loader);
+
+    DisableManifest();
+}
+
+TEST(Dispatcher_Stub_Manifest, ManifestWithoutRuntimesIsIgnored) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    EnableManifest({ "# no runtimes", "badpriority /some/lib.so", "3" });
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+
+    DisableManifest();
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for parallel probing of candidate runtimes (ONEVPL_PROBE_THREADS).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+// enumerate all implementations and return "path:name" for each, in enumeration order
+static void GetImplList(const char *probeThreads, std::vector<std::string> &implList) {
+    SetEnv("ONEVPL_PROBE_THREADS", probeThreads);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxU32 idx = 0;
+    while (1) {
+        mfxImplDescription *implDesc = nullptr;
+        mfxStatus sts                = MFXEnumImplementations(loader,
+                                               idx,
+                                               MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                               (mfxHDL *)&implDesc);
+        if (sts != MFX_ERR_NONE)
+            break;
+
+        mfxChar *implPath = nullptr;
+        sts = MFXEnumImplementations(loader, idx, MFX_IMPLCAPS_IMPLPATH, (mfxHDL *)&implPath);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+
+        if (implPath) {
+            implList.push_back(std::string(implPath) + ":" + implDesc->ImplName);
+            MFXDispReleaseImplDescription(loader, implPath);
+        }
+        MFXDispReleaseImplDescription(loader, implDesc);
+
+        idx++;
+    }
+
+    MFXUnload(loader);
+
+    SetEnv("ONEVPL_PROBE_THREADS", nullptr);
+}
+
+TEST(Dispatcher_Stub_EnumImpls, ParallelProbeMatchesSerialOrder) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    std::vector<std::string> implListSerial, implListParallel;
+    GetImplList("1", implListSerial);
+    GetImplList("8", implListParallel);
+
+    EXPECT_FALSE(implListSerial.empty());
+    EXPECT_EQ(implListSerial, implListParallel);
+}
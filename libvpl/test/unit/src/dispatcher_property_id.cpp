@@ -0,0 +1,144 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for property IDs (MFXSetConfigFilterPropertyById()) and property name lookup.
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+TEST(Dispatcher_Stub_SetConfigFilterPropertyById, IdMatchesPropertyName) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxVariant var      = {};
+    var.Version.Version = MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_PTR;
+    var.Data.Ptr        = (mfxHDL) "Stub Implementation";
+
+    mfxStatus sts = MFXSetConfigFilterPropertyById(cfg, MFX_FILTER_PROP_IMPL_NAME, var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    var.Type     = MFX_VARIANT_TYPE_U32;
+    var.Data.U32 = MFX_CODEC_HEVC;
+    sts          = MFXSetConfigFilterPropertyById(cfg, MFX_FILTER_PROP_ENC_CODEC_ID, var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_TRUE(IsImplAvailable(loader));
+
+    // stub does not support VP9 encode
+    var.Data.U32 = MFX_CODEC_VP9;
+    sts          = MFXSetConfigFilterPropertyById(cfg, MFX_FILTER_PROP_ENC_CODEC_ID, var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_FALSE(IsImplAvailable(loader));
+
+    // same property set by name replaces the value set by ID
+    SetConfigFilterProperty<mfxU32>(loader,
+                                    cfg,
+                                    "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+                                    MFX_CODEC_AVC);
+    EXPECT_TRUE(IsImplAvailable(loader));
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_SetConfigFilterPropertyById, InvalidIdOrTypeReturnsError) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxVariant var      = {};
+    var.Version.Version = MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_U32;
+    var.Data.U32        = MFX_CODEC_HEVC;
+
+    mfxStatus sts = MFXSetConfigFilterPropertyById(nullptr, MFX_FILTER_PROP_ENC_CODEC_ID, var);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXSetConfigFilterPropertyById(cfg, (mfxConfigFilterPropertyId)0x7fff, var);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    // MaxcodecLevel is U16
+    sts = MFXSetConfigFilterPropertyById(cfg, MFX_FILTER_PROP_ENC_MAX_CODEC_LEVEL, var);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    MFXUnload(loader);
+}
+#endif // ONEVPL_EXPERIMENTAL
+
+TEST(Dispatcher_Stub_SetConfigFilterProperty, OtherSpellingsOfNameAreAccepted) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxVariant var      = {};
+    var.Version.Version = MFX_VARIANT_VERSION;
+    var.Type            = MFX_VARIANT_TYPE_U32;
+    var.Data.U32        = MFX_FOURCC_NV12;
+
+    const char *validNames[] = {
+        "mfxImplDescription.mfxEncoderDescription.encoder.encprofile.encmemdesc.ColorFormat",
+        "mfxImplDescription.mfxVPPDescription.filter.memdesc.format.OutFormats",
+        // extra parts after a known name are ignored
+        "mfxImplDescription.VendorID.Extra",
+        "mfxImplDescription.VendorID.",
+    };
+
+    for (auto name : validNames) {
+        mfxStatus sts = MFXSetConfigFilterProperty(cfg, (const mfxU8 *)name, var);
+        EXPECT_EQ(sts, MFX_ERR_NONE) << name;
+    }
+
+    // DeviceID may be given without "device", as U16 or as a string
+    var.Type     = MFX_VARIANT_TYPE_U16;
+    var.Data.U16 = 0x1234;
+    mfxStatus sts = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxDeviceDescription.DeviceID",
+        var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    var.Type     = MFX_VARIANT_TYPE_PTR;
+    var.Data.Ptr = (mfxHDL) "1234";
+    sts          = MFXSetConfigFilterProperty(
+        cfg,
+        (const mfxU8 *)"mfxImplDescription.mfxDeviceDescription.device.DeviceID",
+        var);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    const char *invalidNames[] = {
+        "mfxImplDescription.ApiVersion",
+        "mfxImplDescription..VendorID",
+        "mfxImplDescription.VendorI",
+        "xmfxImplDescription.VendorID",
+        "",
+    };
+
+    var.Type     = MFX_VARIANT_TYPE_U32;
+    var.Data.U32 = 0;
+    for (auto name : invalidNames) {
+        sts = MFXSetConfigFilterProperty(cfg, (const mfxU8 *)name, var);
+        EXPECT_EQ(sts, MFX_ERR_NOT_FOUND) << name;
+    }
+
+    MFXUnload(loader);
+}
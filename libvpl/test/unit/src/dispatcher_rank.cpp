@@ -0,0 +1,158 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for throughput ranking (ONEVPL_RANK_POLICY).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+TEST(Dispatcher_Stub_Rank, FastestEncoderIsFirst) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    // encode time per frame of each implementation, by VendorImplID
+    SetEnv("VPL_STUB_SYNTH", "impls=3, encode_frame_us=4000:0:2000");
+    SetEnv("ONEVPL_RANK_POLICY", "THROUGHPUT");
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    sts           = SetConfigFilterProperty<mfxU32>(
+        loader,
+        cfg,
+        "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+        MFX_CODEC_AVC);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    EXPECT_EQ(GetValidVendorImplIDs(loader), std::vector<mfxU32>({ 1, 2, 0 }));
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+
+    SetEnv("ONEVPL_RANK_POLICY", nullptr);
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+
+TEST(Dispatcher_Stub_Rank, SpecOrderIsKeptWithoutScores) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("VPL_STUB_SYNTH", "impls=3, encode_frame_us=4000:0:2000");
+    SetEnv("ONEVPL_RANK_POLICY", "THROUGHPUT");
+
+    // no encoder requested, benchmark is not run
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    EXPECT_EQ(GetValidVendorImplIDs(loader), std::vector<mfxU32>({ 0, 1, 2 }));
+
+    MFXUnload(loader);
+
+    // runtime does not encode, all benchmarks fail
+    SetEnv("VPL_STUB_SYNTH", "impls=3");
+
+    loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    sts           = SetConfigFilterProperty<mfxU32>(
+        loader,
+        cfg,
+        "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+        MFX_CODEC_AVC);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    EXPECT_EQ(GetValidVendorImplIDs(loader), std::vector<mfxU32>({ 0, 1, 2 }));
+
+    MFXUnload(loader);
+
+    SetEnv("ONEVPL_RANK_POLICY", nullptr);
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+// VendorImplID of the valid implementations of a new loader, in ranked order
+static std::vector<mfxU32> GetRankedVendorImplIDs() {
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    sts           = SetConfigFilterProperty<mfxU32>(
+        loader,
+        cfg,
+        "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+        MFX_CODEC_AVC);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    std::vector<mfxU32> vendorImplIDs = GetValidVendorImplIDs(loader);
+
+    MFXUnload(loader);
+
+    return vendorImplIDs;
+}
+
+// number of scores in the rank file
+static mfxU32 GetNumStoredScores(const std::string &cacheDir) {
+    std::ifstream rankFile(cacheDir + PATH_SEPARATOR + "rank.txt");
+
+    mfxU32 numScores = 0;
+    std::string line;
+    while (std::getline(rankFile, line)) {
+        if (!line.empty() && line[0] != '#')
+            numScores++;
+    }
+
+    return numScores;
+}
+
+TEST(Dispatcher_Stub_Rank, FailedScoresAreNotStored) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    // scores are stored in the caps cache directory
+    std::string cacheDir;
+    EnableCapsCache(cacheDir);
+    SetEnv("ONEVPL_RANK_POLICY", "THROUGHPUT");
+
+    // runtime does not encode, all benchmarks fail
+    SetEnv("VPL_STUB_SYNTH", "impls=3");
+    EXPECT_EQ(GetRankedVendorImplIDs(), std::vector<mfxU32>({ 0, 1, 2 }));
+    EXPECT_EQ(GetNumStoredScores(cacheDir), 0u);
+
+    // same library file, benchmarks are run again and succeed
+    SetEnv("VPL_STUB_SYNTH", "impls=3, encode_frame_us=4000:0:2000");
+    EXPECT_EQ(GetRankedVendorImplIDs(), std::vector<mfxU32>({ 1, 2, 0 }));
+    EXPECT_EQ(GetNumStoredScores(cacheDir), 3u);
+
+    // stored scores are reused, benchmarks are not run again
+    SetEnv("VPL_STUB_SYNTH", "impls=3, encode_frame_us=0:4000:2000");
+    EXPECT_EQ(GetRankedVendorImplIDs(), std::vector<mfxU32>({ 1, 2, 0 }));
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+    SetEnv("ONEVPL_RANK_POLICY", nullptr);
+    DisableCapsCache(cacheDir);
+}
+#endif
@@ -0,0 +1,223 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for asynchronous session creation (MFXCreateSessionAsync()).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+// runtime init is slowed down so that requests are still running when checked
+    #define SESSION_ASYNC_SYNTH "init_delay_us=200000"
+
+TEST(Dispatcher_Stub_SessionAsync, WaitReturnsSession) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("VPL_STUB_SYNTH", SESSION_ASYNC_SYNTH);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSessionRequest request = nullptr;
+    sts = MFXCreateSessionAsync(loader, 0, nullptr, nullptr, &request);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_NE(request, nullptr);
+
+    mfxSession session = nullptr;
+    sts                = MFXWaitSessionRequest(request, 0, &session);
+    EXPECT_EQ(sts, MFX_WRN_IN_EXECUTION);
+    EXPECT_EQ(session, nullptr);
+
+    sts = MFXWaitSessionRequest(request, MFX_INFINITE, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_NE(session, nullptr);
+
+    // session is only returned once
+    mfxSession session2 = nullptr;
+    sts                 = MFXWaitSessionRequest(request, MFX_INFINITE, &session2);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+    EXPECT_EQ(session2, nullptr);
+
+    if (session) {
+        mfxIMPL impl = 0;
+        sts          = MFXQueryIMPL(session, &impl);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+
+        MFXClose(session);
+    }
+
+    sts = MFXReleaseSessionRequest(request);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXUnload(loader);
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+
+struct SessionAsyncCallbackCtx {
+    mfxSessionRequest request;
+    mfxStatus sts;
+    mfxSession session;
+    int numCalls;
+};
+
+static void MFX_CDECL SessionAsyncCallback(mfxSessionRequest request,
+                                           mfxStatus sts,
+                                           mfxHDL user_data) {
+    SessionAsyncCallbackCtx *ctx = reinterpret_cast<SessionAsyncCallbackCtx *>(user_data);
+
+    ctx->request = request;
+    ctx->sts     = sts;
+    ctx->numCalls++;
+
+    // request is complete, so this does not wait
+    MFXWaitSessionRequest(request, 0, &ctx->session);
+}
+
+TEST(Dispatcher_Stub_SessionAsync, CallbackTakesSession) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    SessionAsyncCallbackCtx ctx = {};
+    ctx.sts                     = MFX_ERR_UNKNOWN;
+
+    mfxSessionRequest request = nullptr;
+    sts = MFXCreateSessionAsync(loader, 0, SessionAsyncCallback, &ctx, &request);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // waits for the worker, so the callback has returned
+    sts = MFXReleaseSessionRequest(request);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    EXPECT_EQ(ctx.numCalls, 1);
+    EXPECT_EQ(ctx.request, request);
+    EXPECT_EQ(ctx.sts, MFX_ERR_NONE);
+    EXPECT_NE(ctx.session, nullptr);
+
+    if (ctx.session)
+        MFXClose(ctx.session);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_SessionAsync, FilterChangesDoNotAffectRequest) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("VPL_STUB_SYNTH", "impls=2, " SESSION_ASYNC_SYNTH);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSessionRequest request = nullptr;
+    sts = MFXCreateSessionAsync(loader, 1, nullptr, nullptr, &request);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    // remove implementation 1 while its session is being created
+    sts = SetConfigFilterProperty<mfxU32>(loader, "mfxImplDescription.VendorImplID", 0);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 1, &session);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    sts = MFXWaitSessionRequest(request, MFX_INFINITE, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_NE(session, nullptr);
+
+    if (session)
+        MFXClose(session);
+
+    MFXReleaseSessionRequest(request);
+
+    MFXUnload(loader);
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+
+TEST(Dispatcher_Stub_SessionAsync, UnloadReleasesRequests) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("VPL_STUB_SYNTH", SESSION_ASYNC_SYNTH);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // still running, and done but not taken
+    mfxSessionRequest request = nullptr;
+    sts = MFXCreateSessionAsync(loader, 0, nullptr, nullptr, &request);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXCreateSessionAsync(loader, 0, nullptr, nullptr, &request);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXWaitSessionRequest(request, MFX_INFINITE, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    MFXClose(session);
+
+    MFXUnload(loader);
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+
+TEST(Dispatcher_Stub_SessionAsync, InvalidParamsReturnErrors) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxSessionRequest request = nullptr;
+    mfxSession session        = nullptr;
+
+    mfxStatus sts = MFXCreateSessionAsync(nullptr, 0, nullptr, nullptr, &request);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXWaitSessionRequest(nullptr, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXReleaseSessionRequest(nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXCreateSessionAsync(loader, 0, nullptr, nullptr, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXCreateSessionAsync(loader, 1, nullptr, nullptr, &request);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+    EXPECT_EQ(request, nullptr);
+
+    sts = MFXCreateSessionAsync(loader, 0, nullptr, nullptr, &request);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXWaitSessionRequest(request, MFX_INFINITE, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXReleaseSessionRequest(request);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    MFXUnload(loader);
+}
+#endif
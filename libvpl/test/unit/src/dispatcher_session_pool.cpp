@@ -0,0 +1,253 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for session pools (MFXCreateSessionPool(), MFXAcquireSession()).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+// stub sessions take well under a millisecond to create, but the wait is doubled until
+//   the pool was refilled in time, so that tests also pass on a slow or loaded machine
+    #define SESSION_POOL_REFILL_WAIT_MS    10
+    #define SESSION_POOL_REFILL_TIMEOUT_MS 20000
+
+// run test with the dispatcher log captured, again with a longer wait for the refill
+//   while a session was acquired from an empty pool
+// log is still captured on return, so that the caller can check it
+static void RunSessionPoolTest(void (*runTest)(mfxU32 waitMs)) {
+    for (mfxU32 waitMs = SESSION_POOL_REFILL_WAIT_MS;; waitMs *= 2) {
+        CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+        runTest(waitMs);
+
+        if (!FindOutputLog("message:  session pool empty") ||
+            waitMs >= SESSION_POOL_REFILL_TIMEOUT_MS)
+            return;
+
+        CleanupOutputLog();
+    }
+}
+
+static void AcquirePrewarmedSessions(mfxU32 waitMs) {
+    const mfxU32 poolSize = 2;
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // pooled sessions should also get special config properties
+    SetConfigFilterProperty<mfxU32>(loader, "NumThread", 2);
+
+    sts = MFXCreateSessionPool(loader, 0, poolSize);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // take all sessions from the full pool, twice, to check that it was refilled
+    for (int pass = 0; pass < 2; pass++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+
+        std::vector<mfxSession> sessions;
+        for (mfxU32 i = 0; i < poolSize; i++) {
+            mfxSession session = nullptr;
+            sts                = MFXAcquireSession(loader, 0, &session);
+            EXPECT_EQ(sts, MFX_ERR_NONE);
+            EXPECT_NE(session, nullptr);
+
+            if (session) {
+                mfxIMPL impl = 0;
+                sts          = MFXQueryIMPL(session, &impl);
+                EXPECT_EQ(sts, MFX_ERR_NONE);
+
+                sessions.push_back(session);
+            }
+        }
+
+        for (auto session : sessions)
+            MFXClose(session);
+    }
+
+    // sessions still in the pool are closed here
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_SessionPool, AcquireTakesPrewarmedSessionsAndRefills) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    RunSessionPoolTest(AcquirePrewarmedSessions);
+
+    // every session was a handoff from the pool, not a runtime initialization
+    CheckOutputLog("message:  session pool created -- implementation 0, size 2");
+    CheckOutputLog("message:  session taken from pool");
+    CheckOutputLog("message:  session pool empty", false);
+    CheckOutputLog("message:  extBuf enabled -- NumThread (2)");
+    CleanupOutputLog();
+}
+
+TEST(Dispatcher_Stub_SessionPool, EmptyPoolCreatesSession) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXCreateSessionPool(loader, 0, 1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // more sessions than the pool size, some are created by the calling thread
+    std::vector<mfxSession> sessions;
+    for (int i = 0; i < 4; i++) {
+        mfxSession session = nullptr;
+        sts                = MFXAcquireSession(loader, 0, &session);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+        EXPECT_NE(session, nullptr);
+
+        if (session)
+            sessions.push_back(session);
+    }
+
+    for (auto session : sessions)
+        MFXClose(session);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_SessionPool, InvalidParamsReturnErrors) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxSession session = nullptr;
+
+    mfxStatus sts = MFXCreateSessionPool(nullptr, 0, 1);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    sts = MFXAcquireSession(nullptr, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXCreateSessionPool(loader, 0, 0);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    sts = MFXCreateSessionPool(loader, 1, 1);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    sts = MFXAcquireSession(loader, 0, nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+
+    // no pool was created
+    sts = MFXAcquireSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NOT_INITIALIZED);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_SessionPool, PoolFollowsImplementationWhenFiltersChange) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("VPL_STUB_SYNTH", "impls=3");
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // pool for VendorImplID 1
+    sts = MFXCreateSessionPool(loader, 1, 1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // VendorImplID 1 moves to index 0
+    mfxConfig cfg = MFXCreateConfig(loader);
+    sts = SetConfigFilterProperty<mfxU32>(loader, cfg, "mfxImplDescription.VendorImplID", 1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXAcquireSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    // no pool for VendorImplID 2, although index 0 had one
+    sts = SetConfigFilterProperty<mfxU32>(loader, cfg, "mfxImplDescription.VendorImplID", 2);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    session = nullptr;
+    sts     = MFXAcquireSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NOT_INITIALIZED);
+
+    // index 1 is out of range with the new filters
+    sts = MFXAcquireSession(loader, 1, &session);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  session pool created -- implementation 1, size 1");
+    CleanupOutputLog();
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+
+static void RestartFailedWorker(mfxU32 waitMs) {
+    // first session creation fails (fast path and fallback), so the worker stops
+    SetEnv("VPL_STUB_SYNTH", "init_fail=2");
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXCreateSessionPool(loader, 0, 1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+
+    // same size, worker is started again
+    sts = MFXCreateSessionPool(loader, 0, 1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+
+    mfxSession session = nullptr;
+    sts                = MFXAcquireSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_SessionPool, ResizeRestartsFailedWorker) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    RunSessionPoolTest(RestartFailedWorker);
+
+    CheckOutputLog("message:  session pool worker restarted -- implementation 0");
+    CheckOutputLog("message:  session taken from pool");
+    CheckOutputLog("message:  session pool empty", false);
+    CleanupOutputLog();
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+#endif // ONEVPL_EXPERIMENTAL
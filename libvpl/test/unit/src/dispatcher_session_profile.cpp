@@ -0,0 +1,133 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for per-session call profiling (ONEVPL_SESSION_PROFILE).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+    // session profile is implemented in the Linux dispatcher only
+    #if !defined(_WIN32) && !defined(_WIN64)
+
+// return profile of the named function, or false if not found
+static bool GetFunctionProfile(mfxDispatcherProfileInterface *iface,
+                               const char *funcName,
+                               mfxFunctionProfile *profile) {
+    for (mfxU32 idx = 0;; idx++) {
+        const mfxChar *name = nullptr;
+        mfxStatus sts       = iface->GetFunctionProfile(iface, idx, &name, profile);
+        if (sts != MFX_ERR_NONE)
+            return false;
+
+        if (std::string(name) == funcName)
+            return true;
+    }
+}
+
+// create stub session, call MFXQueryIMPL() three times, and check the profile
+static void CheckSessionProfile(mfxLoader loader) {
+    mfxSession session = nullptr;
+    mfxStatus sts      = MFXCreateSession(loader, 0, &session);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+
+    mfxIMPL impl = {};
+    for (mfxU32 i = 0; i < 3; i++) {
+        sts = MFXQueryIMPL(session, &impl);
+        EXPECT_EQ(sts, MFX_ERR_NONE);
+    }
+
+    mfxDispatcherProfileInterface *iface = nullptr;
+    sts = MFXGetDispatcherProfileInterface(session, &iface);
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    ASSERT_NE(iface, nullptr);
+
+    mfxFunctionProfile profile = {};
+    EXPECT_TRUE(GetFunctionProfile(iface, "MFXQueryIMPL", &profile));
+    EXPECT_EQ(profile.NumCalls, 3u);
+    EXPECT_EQ(profile.StatusCount[MFX_PROFILE_STATUS_OFFSET + MFX_ERR_NONE], 3u);
+
+    mfxU64 numBucketCalls = 0;
+    for (mfxU32 i = 0; i < MFX_PROFILE_NUM_LATENCY_BUCKETS; i++)
+        numBucketCalls += profile.LatencyHistogram[i];
+    EXPECT_EQ(numBucketCalls, 3u);
+
+    // profiled 2.x functions follow the 1.x functions
+    EXPECT_TRUE(GetFunctionProfile(iface, "MFXVideoVPP_ProcessFrameAsync", &profile));
+    EXPECT_EQ(profile.NumCalls, 0u);
+
+    sts = iface->ResetProfile(iface);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_TRUE(GetFunctionProfile(iface, "MFXQueryIMPL", &profile));
+    EXPECT_EQ(profile.NumCalls, 0u);
+
+    MFXClose(session);
+}
+
+TEST(Dispatcher_Stub_SessionProfile, EnvVarEnablesProfile) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("ONEVPL_SESSION_PROFILE", "ON");
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    CheckSessionProfile(loader);
+
+    MFXUnload(loader);
+
+    SetEnv("ONEVPL_SESSION_PROFILE", nullptr);
+}
+
+TEST(Dispatcher_Stub_SessionProfile, PropertyEnablesProfile) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = SetConfigFilterProperty<mfxU16>(loader, "SessionProfile", 1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    CheckSessionProfile(loader);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_SessionProfile, DisabledByDefault) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxDispatcherProfileInterface *iface = nullptr;
+    sts = MFXGetDispatcherProfileInterface(session, &iface);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+}
+
+    #endif
+#endif // ONEVPL_EXPERIMENTAL
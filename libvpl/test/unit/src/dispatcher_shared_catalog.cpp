@@ -0,0 +1,101 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for the shared runtime catalog (ONEVPL_SHARED_CATALOG) and MFXResetConfigFilters().
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+TEST(Dispatcher_Stub_SharedCatalog, SecondLoaderAttachesToCatalog) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("ONEVPL_SHARED_CATALOG", "ON");
+
+    mfxLoader loader1 = MFXLoad();
+    EXPECT_FALSE(loader1 == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader1, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplDescription *implDesc1 = nullptr;
+    sts = MFXEnumImplementations(loader1, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader2 = MFXLoad();
+    EXPECT_FALSE(loader2 == nullptr);
+
+    sts = SetConfigImpl(loader2, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    // caps descriptors are shared, not queried again
+    mfxImplDescription *implDesc2 = nullptr;
+    sts = MFXEnumImplementations(loader2, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc2);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(implDesc1, implDesc2);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader2, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXDispReleaseImplDescription(loader1, implDesc1);
+    MFXDispReleaseImplDescription(loader2, implDesc2);
+
+    // catalog is released with the last loader
+    MFXUnload(loader1);
+    MFXUnload(loader2);
+
+    CheckOutputLog("message:  shared catalog attached");
+    CheckOutputLog("message:  shared catalog released");
+    CleanupOutputLog();
+
+    SetEnv("ONEVPL_SHARED_CATALOG", nullptr);
+}
+
+#ifdef ONEVPL_EXPERIMENTAL
+TEST(Dispatcher_Stub_ResetConfigFilters, LoaderCanBeReusedWithNewFilters) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    // stub does not report an implementation of this type
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_SOFTWARE);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    // implementations excluded by the previous filters are available again
+    sts = MFXResetConfigFilters(loader);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_ResetConfigFilters, NullLoaderReturnsErrNullPtr) {
+    mfxStatus sts = MFXResetConfigFilters(nullptr);
+    EXPECT_EQ(sts, MFX_ERR_NULL_PTR);
+}
+#endif // ONEVPL_EXPERIMENTAL
@@ -0,0 +1,102 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for startup timing (ONEVPL_STARTUP_TIMING).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+#ifdef ONEVPL_EXPERIMENTAL
+TEST(Dispatcher_Stub_StartupTiming, PhasesAreTimed) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("ONEVPL_STARTUP_TIMING", "ON");
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxLoaderTimings timings = {};
+    sts                      = MFXQueryLoaderTimings(loader, &timings);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    EXPECT_GT(timings.Count[MFX_LOADER_PHASE_SEARCH], 0u);
+    EXPECT_GT(timings.Count[MFX_LOADER_PHASE_LOAD], 0u);
+    EXPECT_GT(timings.Count[MFX_LOADER_PHASE_QUERY_CAPS], 0u);
+    EXPECT_EQ(timings.Count[MFX_LOADER_PHASE_CREATE_SESSION], 1u);
+
+    mfxImplTimings implTimings = {};
+    sts                        = MFXQueryImplTimings(loader, 0, &implTimings);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(implTimings.NumSessions, 1u);
+    EXPECT_GT(implTimings.QueryTimeNs, 0u);
+    EXPECT_GT(implTimings.SessionTimeNs, 0u);
+
+    sts = MFXQueryImplTimings(loader, 99, &implTimings);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+
+    SetEnv("ONEVPL_STARTUP_TIMING", nullptr);
+}
+
+TEST(Dispatcher_Stub_StartupTiming, DisabledByDefault) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxLoaderTimings timings = {};
+    sts                      = MFXQueryLoaderTimings(loader, &timings);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    mfxImplTimings implTimings = {};
+    sts                        = MFXQueryImplTimings(loader, 0, &implTimings);
+    EXPECT_EQ(sts, MFX_ERR_UNSUPPORTED);
+
+    MFXUnload(loader);
+}
+
+TEST(Dispatcher_Stub_StartupTiming, PhasesAreLogged) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+
+    CheckOutputLog("startup timing -- create session");
+    CleanupOutputLog();
+}
+#endif // ONEVPL_EXPERIMENTAL
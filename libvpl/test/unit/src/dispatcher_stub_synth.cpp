@@ -0,0 +1,91 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for synthetic caps of the stub runtime (VPL_STUB_SYNTH).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+TEST(Dispatcher_Stub_Synth, CapsAreGeneratedFromConfig) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("VPL_STUB_SYNTH",
+           "impls=3, dec=2, enc=5, vpp=4\nprofiles=2,formats=3 # comment\napi=2.5");
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    for (mfxU32 idx = 0; idx < 3; idx++) {
+        mfxImplDescription *implDesc = nullptr;
+        sts = MFXEnumImplementations(loader,
+                                     idx,
+                                     MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                     reinterpret_cast<mfxHDL *>(&implDesc));
+        ASSERT_EQ(sts, MFX_ERR_NONE);
+
+        EXPECT_EQ(implDesc->VendorImplID, idx);
+        EXPECT_EQ(implDesc->ApiVersion.Major, 2);
+        EXPECT_EQ(implDesc->ApiVersion.Minor, 5);
+
+        ASSERT_EQ(implDesc->Dec.NumCodecs, 2);
+        EXPECT_EQ(implDesc->Dec.Codecs[0].CodecID, (mfxU32)MFX_CODEC_AVC);
+        EXPECT_EQ(implDesc->Dec.Codecs[1].NumProfiles, 2);
+        EXPECT_EQ(implDesc->Dec.Codecs[1].Profiles[1].MemDesc[0].NumColorFormats, 3);
+
+        ASSERT_EQ(implDesc->Enc.NumCodecs, 5);
+        EXPECT_EQ(implDesc->Enc.Codecs[4].NumProfiles, 2);
+
+        ASSERT_EQ(implDesc->VPP.NumFilters, 4);
+        EXPECT_EQ(implDesc->VPP.Filters[3].MemDesc[0].NumInFormats, 3);
+        EXPECT_EQ(implDesc->VPP.Filters[3].MemDesc[0].Formats[2].NumOutFormat, 3);
+
+        MFXDispReleaseImplDescription(loader, implDesc);
+    }
+
+    mfxHDL implDesc = nullptr;
+    sts = MFXEnumImplementations(loader, 3, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &implDesc);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    MFXUnload(loader);
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+
+TEST(Dispatcher_Stub_Synth, CapsFilterMatchesSynthCodec) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    // encoders after the list of real codec IDs have synthetic FourCC codes
+    SetEnv("VPL_STUB_SYNTH", "enc=12");
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = SetConfigFilterProperty<mfxU32>(loader,
+                                          "mfxImplDescription.mfxEncoderDescription.encoder.CodecID",
+                                          MFX_MAKEFOURCC('S', 'E', 0, 11));
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
@@ -0,0 +1,127 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for concurrent use of a single loader.
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "src/dispatcher_common.h"
+
+// stress test for concurrent use of a single loader
+// to check for data races, build with -fsanitize=thread and run with
+//   --gtest_filter=Dispatcher_Stub_ThreadSafety.*
+#define THREAD_SAFETY_NUM_THREADS    8
+#define THREAD_SAFETY_NUM_ITERATIONS 50
+
+TEST(Dispatcher_Stub_ThreadSafety, ConcurrentEnumAndCreateSessionWithFilterUpdates) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxConfig cfg = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfg == nullptr);
+
+    mfxVariant implValue      = {};
+    implValue.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    implValue.Type            = MFX_VARIANT_TYPE_PTR;
+    implValue.Data.Ptr        = (mfxHDL) "Stub Implementation";
+
+    mfxStatus sts =
+        MFXSetConfigFilterProperty(cfg, (const mfxU8 *)"mfxImplDescription.ImplName", implValue);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxVersion minVersion = {};
+    minVersion.Major      = 2;
+    minVersion.Minor      = 0;
+
+    mfxVariant apiValue      = {};
+    apiValue.Version.Version = (mfxU16)MFX_VARIANT_VERSION;
+    apiValue.Type            = MFX_VARIANT_TYPE_U32;
+    apiValue.Data.U32        = minVersion.Version;
+
+    mfxConfig cfgApi = MFXCreateConfig(loader);
+    EXPECT_FALSE(cfgApi == nullptr);
+
+    sts = MFXSetConfigFilterProperty(cfgApi,
+                                     (const mfxU8 *)"mfxImplDescription.ApiVersion.Version",
+                                     apiValue);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    std::atomic<int> numErrors(0);
+    std::atomic<bool> bDone(false);
+
+    // readers - enumerate and create sessions with the first implementation
+    std::vector<std::thread> readers;
+    for (int t = 0; t < THREAD_SAFETY_NUM_THREADS; t++) {
+        readers.emplace_back([loader, &numErrors]() {
+            for (int n = 0; n < THREAD_SAFETY_NUM_ITERATIONS; n++) {
+                mfxImplDescription *implDesc = nullptr;
+                mfxStatus stsThread          = MFXEnumImplementations(loader,
+                                                             0,
+                                                             MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                                             (mfxHDL *)&implDesc);
+                if (stsThread != MFX_ERR_NONE || !implDesc ||
+                    std::string(implDesc->ImplName) != "Stub Implementation") {
+                    numErrors++;
+                }
+                if (implDesc)
+                    MFXDispReleaseImplDescription(loader, implDesc);
+
+                mfxSession session = nullptr;
+                stsThread          = MFXCreateSession(loader, 0, &session);
+                if (stsThread != MFX_ERR_NONE || !session) {
+                    numErrors++;
+                    continue;
+                }
+
+                mfxIMPL impl = 0;
+                if (MFXQueryIMPL(session, &impl) != MFX_ERR_NONE)
+                    numErrors++;
+
+                MFXClose(session);
+            }
+        });
+    }
+
+    // writer - keep setting filters which do not change the result, so the list
+    //   of valid implementations is re-validated while readers are using it
+    std::thread writer([cfg, cfgApi, implValue, apiValue, &bDone, &numErrors]() {
+        while (!bDone) {
+            mfxStatus stsThread =
+                MFXSetConfigFilterProperty(cfg,
+                                           (const mfxU8 *)"mfxImplDescription.ImplName",
+                                           implValue);
+            if (stsThread != MFX_ERR_NONE)
+                numErrors++;
+
+            stsThread =
+                MFXSetConfigFilterProperty(cfgApi,
+                                           (const mfxU8 *)"mfxImplDescription.ApiVersion.Version",
+                                           apiValue);
+            if (stsThread != MFX_ERR_NONE)
+                numErrors++;
+
+            std::this_thread::yield();
+        }
+    });
+
+    for (auto &reader : readers)
+        reader.join();
+
+    bDone = true;
+    writer.join();
+
+    EXPECT_EQ(numErrors, 0);
+
+    MFXUnload(loader);
+}
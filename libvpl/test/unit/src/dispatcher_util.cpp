@@ -8,6 +8,14 @@
 
 #include "src/dispatcher_common.h"
 
+#if !defined(_WIN32) && !defined(_WIN64)
+    #include <unistd.h>
+
+    #define CAPS_CACHE_TEST_DIR "utestCapsCache"
+#endif
+
+#define MANIFEST_TEST_FILE "utestManifest.txt"
+
 // globals - only one unit test logger may be active at the same time
 static CaptureLogType g_captureLogType = CAPTURE_LOG_DISABLED;
 static std::streambuf *g_coutSB;
@@ -48,16 +56,13 @@ void CaptureOutputLog(CaptureLogType type) {
     g_captureLogType = type;
 }
 
-// check for expectedString anywhere in outputLog (e.g. look for string in part of a long log file)
-// generally this should be called AFTER MFXUnload(), so that log file handle (if any) is closed
-void CheckOutputLog(const char *expectedString, bool expectMatch) {
-    std::string outputLog;
-
+// read captured output into outputLog, returns false if the log file cannot be opened
+static bool ReadOutputLog(std::string &outputLog) {
     if (g_captureLogType == CAPTURE_LOG_DISPATCHER || g_captureLogType == CAPTURE_LOG_FILE) {
         std::ifstream logFile(CAPTURE_LOG_DEF_FILENAME);
         if (!logFile) {
             fprintf(stderr, "Error: failed to open log file %s\n", CAPTURE_LOG_DEF_FILENAME);
-            FAIL();
+            return false;
         }
 
         // read log file into string
@@ -71,6 +76,16 @@ void CheckOutputLog(const char *expectedString, bool expectMatch) {
         outputLog = g_logSS.str();
     }
 
+    return true;
+}
+
+// check for expectedString anywhere in outputLog (e.g. look for string in part of a long log file)
+// generally this should be called AFTER MFXUnload(), so that log file handle (if any) is closed
+void CheckOutputLog(const char *expectedString, bool expectMatch) {
+    std::string outputLog;
+    if (!ReadOutputLog(outputLog))
+        FAIL();
+
     size_t logPos = outputLog.find(expectedString);
 
     fprintf(stderr,
@@ -84,6 +99,15 @@ void CheckOutputLog(const char *expectedString, bool expectMatch) {
         EXPECT_EQ(logPos, std::string::npos);
 }
 
+// same as CheckOutputLog(), but only return whether expectedString was found
+bool FindOutputLog(const char *expectedString) {
+    std::string outputLog;
+    if (!ReadOutputLog(outputLog))
+        return false;
+
+    return (outputLog.find(expectedString) != std::string::npos);
+}
+
 // call after MFXUnload() to ensure that log file (if any) has been closed
 void CleanupOutputLog(void) {
     if (g_captureLogType == CAPTURE_LOG_DISPATCHER) {
@@ -109,6 +133,138 @@ void CleanupOutputLog(void) {
     g_captureLogType = CAPTURE_LOG_DISABLED;
 }
 
+void SetEnv(const char *name, const char *value) {
+#if defined(_WIN32) || defined(_WIN64)
+    SetEnvironmentVariable(name, value);
+#else
+    if (value)
+        setenv(name, value, 1);
+    else
+        unsetenv(name);
+#endif
+}
+
+bool IsImplAvailable(mfxLoader loader) {
+    mfxImplDescription *implDesc = nullptr;
+    mfxStatus sts =
+        MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, (mfxHDL *)&implDesc);
+
+    return (sts == MFX_ERR_NONE && implDesc != nullptr);
+}
+
+std::vector<mfxU32> GetValidVendorImplIDs(mfxLoader loader) {
+    std::vector<mfxU32> vendorImplIDs;
+
+    mfxImplDescription *implDesc = nullptr;
+    for (mfxU32 idx = 0; MFXEnumImplementations(loader,
+                                                idx,
+                                                MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                                reinterpret_cast<mfxHDL *>(&implDesc)) ==
+                         MFX_ERR_NONE;
+         idx++) {
+        vendorImplIDs.push_back(implDesc->VendorImplID);
+        MFXDispReleaseImplDescription(loader, implDesc);
+    }
+
+    return vendorImplIDs;
+}
+
+std::string GetStubLibPath() {
+    std::string stubPath;
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxChar *implPath = nullptr;
+    sts = MFXEnumImplementations(loader, 0, MFX_IMPLCAPS_IMPLPATH, (mfxHDL *)&implPath);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (implPath) {
+        stubPath = implPath;
+        MFXDispReleaseImplDescription(loader, implPath);
+    }
+
+    MFXUnload(loader);
+
+    return stubPath;
+}
+
+void EnableManifest(const std::vector<std::string> &lines) {
+    std::ofstream manifestFile(MANIFEST_TEST_FILE, std::ios::trunc);
+    for (const auto &line : lines)
+        manifestFile << line << "\n";
+    manifestFile.close();
+
+    SetEnv("ONEVPL_MANIFEST", MANIFEST_TEST_FILE);
+}
+
+void DisableManifest() {
+    std::remove(MANIFEST_TEST_FILE);
+    SetEnv("ONEVPL_MANIFEST", nullptr);
+}
+
+std::vector<std::string> GetImplPaths() {
+    std::vector<std::string> implPaths;
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxU32 idx = 0;
+    while (1) {
+        mfxChar *implPath = nullptr;
+        mfxStatus sts =
+            MFXEnumImplementations(loader, idx, MFX_IMPLCAPS_IMPLPATH, (mfxHDL *)&implPath);
+        if (sts != MFX_ERR_NONE)
+            break;
+
+        if (implPath) {
+            implPaths.push_back(implPath);
+            MFXDispReleaseImplDescription(loader, implPath);
+        }
+        idx++;
+    }
+
+    MFXUnload(loader);
+
+    return implPaths;
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+void EnableCapsCache(std::string &cacheDir) {
+    char cwd[PATH_MAX] = "";
+    ASSERT_NE(getcwd(cwd, sizeof(cwd)), nullptr);
+
+    std::string cacheHome = std::string(cwd) + PATH_SEPARATOR + CAPS_CACHE_TEST_DIR;
+    mkdir(cacheHome.c_str(), 0700);
+
+    cacheDir = cacheHome + PATH_SEPARATOR + "vpl";
+
+    SetEnv("XDG_CACHE_HOME", cacheHome.c_str());
+    SetEnv("ONEVPL_CAPS_CACHE", "ON");
+}
+
+void DisableCapsCache(const std::string &cacheDir) {
+    DIR *pSearchDir = opendir(cacheDir.c_str());
+    if (pSearchDir) {
+        struct dirent *currFile;
+        while ((currFile = readdir(pSearchDir)) != NULL) {
+            std::string fileName = currFile->d_name;
+            if (fileName != "." && fileName != "..")
+                std::remove((cacheDir + PATH_SEPARATOR + fileName).c_str());
+        }
+        closedir(pSearchDir);
+    }
+    rmdir(cacheDir.c_str());
+    rmdir(CAPS_CACHE_TEST_DIR);
+
+    SetEnv("XDG_CACHE_HOME", nullptr);
+    SetEnv("ONEVPL_CAPS_CACHE", nullptr);
+}
+#endif
+
 // C-style allocate and free of new ext buffers to illustrate how it might be done in FFmpeg
 mfxStatus AllocateExtBuf(mfxVideoParam &par,
                          std::vector<mfxExtBuffer *> &extBufVector,
@@ -0,0 +1,83 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Unit tests for background warm-up of the runtime list (ONEVPL_WARMUP).
+///
+/// @file
+
+#include <gtest/gtest.h>
+
+#include "src/dispatcher_common.h"
+
+TEST(Dispatcher_Stub_WarmUp, FiltersSetDuringWarmUpAreApplied) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    // query is slowed down so that filters are set while the warm-up thread runs
+    SetEnv("VPL_STUB_SYNTH", "impls=2, query_delay_us=100000");
+    SetEnv("ONEVPL_WARMUP", "ON");
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    mfxStatus sts = SetConfigImpl(loader, MFX_IMPL_TYPE_STUB);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    sts = SetConfigFilterProperty<mfxU32>(loader, "mfxImplDescription.VendorImplID", 1);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    mfxImplDescription *implDesc = nullptr;
+    sts = MFXEnumImplementations(loader,
+                                 0,
+                                 MFX_IMPLCAPS_IMPLDESCSTRUCTURE,
+                                 reinterpret_cast<mfxHDL *>(&implDesc));
+    ASSERT_EQ(sts, MFX_ERR_NONE);
+    EXPECT_EQ(implDesc->VendorImplID, 1);
+    MFXDispReleaseImplDescription(loader, implDesc);
+
+    mfxHDL hdl = nullptr;
+    sts        = MFXEnumImplementations(loader, 1, MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &hdl);
+    EXPECT_EQ(sts, MFX_ERR_NOT_FOUND);
+
+    mfxSession session = nullptr;
+    sts                = MFXCreateSession(loader, 0, &session);
+    EXPECT_EQ(sts, MFX_ERR_NONE);
+
+    if (session)
+        MFXClose(session);
+
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  warm-up started");
+    CheckOutputLog("message:  warm-up finished -- sts 0");
+    CleanupOutputLog();
+
+    SetEnv("ONEVPL_WARMUP", nullptr);
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
+
+TEST(Dispatcher_Stub_WarmUp, UnloadWaitsForWarmUp) {
+    SKIP_IF_DISP_STUB_DISABLED();
+
+    SetEnv("VPL_STUB_SYNTH", "query_delay_us=100000");
+    SetEnv("ONEVPL_WARMUP", "ON");
+
+    CaptureOutputLog(CAPTURE_LOG_DISPATCHER);
+
+    // libraries are still being queried when the loader is unloaded
+    mfxLoader loader = MFXLoad();
+    EXPECT_FALSE(loader == nullptr);
+
+    MFXUnload(loader);
+
+    CheckOutputLog("message:  warm-up finished -- sts 0");
+    CleanupOutputLog();
+
+    SetEnv("ONEVPL_WARMUP", nullptr);
+    SetEnv("VPL_STUB_SYNTH", nullptr);
+}
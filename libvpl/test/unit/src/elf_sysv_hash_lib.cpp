@@ -0,0 +1,24 @@
+/*############################################################################
+  # Copyright (C) Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+///
+/// Shared library which is linked with only a SysV hash table (DT_HASH), used by
+/// the unit tests of the ELF export check (dispatcher_elf.cpp).
+///
+/// @file
+
+extern "C" {
+
+__attribute__((visibility("default"))) int ElfTestFunction(void) {
+    return 0;
+}
+
+__attribute__((visibility("hidden"))) int ElfTestHiddenFunction(void) {
+    return 0;
+}
+
+__attribute__((visibility("default"))) int ElfTestVariable = 0;
+}